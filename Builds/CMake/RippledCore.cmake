@@ -65,6 +65,7 @@ target_sources (xrpl_core PRIVATE
     main sources:
       subdir: json
   #]===============================]
+  src/ripple/json/impl/Document.cpp
   src/ripple/json/impl/JsonPropertyStream.cpp
   src/ripple/json/impl/Object.cpp
   src/ripple/json/impl/Output.cpp
@@ -101,7 +102,9 @@ target_sources (xrpl_core PRIVATE
   src/ripple/protocol/impl/STBlob.cpp
   src/ripple/protocol/impl/STInteger.cpp
   src/ripple/protocol/impl/STLedgerEntry.cpp
+  src/ripple/protocol/impl/STLedgerEntryView.cpp
   src/ripple/protocol/impl/STObject.cpp
+  src/ripple/protocol/impl/STObjectView.cpp
   src/ripple/protocol/impl/STParsedJSON.cpp
   src/ripple/protocol/impl/STPathSet.cpp
   src/ripple/protocol/impl/STTx.cpp
@@ -189,6 +192,7 @@ install (
   DESTINATION include/ripple/crypto)
 install (
   FILES
+    src/ripple/json/Document.h
     src/ripple/json/JsonPropertyStream.h
     src/ripple/json/Object.h
     src/ripple/json/Output.h
@@ -235,7 +239,9 @@ install (
     src/ripple/protocol/STExchange.h
     src/ripple/protocol/STInteger.h
     src/ripple/protocol/STLedgerEntry.h
+    src/ripple/protocol/STLedgerEntryView.h
     src/ripple/protocol/STObject.h
+    src/ripple/protocol/STObjectView.h
     src/ripple/protocol/STParsedJSON.h
     src/ripple/protocol/STPathSet.h
     src/ripple/protocol/STTx.h
@@ -361,6 +367,7 @@ target_sources (rippled PRIVATE
   src/ripple/app/ledger/impl/InboundLedger.cpp
   src/ripple/app/ledger/impl/InboundLedgers.cpp
   src/ripple/app/ledger/impl/InboundTransactions.cpp
+  src/ripple/app/ledger/impl/LedgerBulkReplay.cpp
   src/ripple/app/ledger/impl/LedgerCleaner.cpp
   src/ripple/app/ledger/impl/LedgerDeltaAcquire.cpp
   src/ripple/app/ledger/impl/LedgerMaster.cpp
@@ -371,6 +378,7 @@ target_sources (rippled PRIVATE
   src/ripple/app/ledger/impl/LedgerToJson.cpp
   src/ripple/app/ledger/impl/LocalTxs.cpp
   src/ripple/app/ledger/impl/OpenLedger.cpp
+  src/ripple/app/ledger/impl/PeerRequestWindow.cpp
   src/ripple/app/ledger/impl/SkipListAcquire.cpp
   src/ripple/app/ledger/impl/TimeoutCounter.cpp
   src/ripple/app/ledger/impl/TransactionAcquire.cpp
@@ -395,6 +403,7 @@ target_sources (rippled PRIVATE
   src/ripple/app/misc/detail/impl/WorkSSL.cpp
   src/ripple/app/misc/impl/AccountTxPaging.cpp
   src/ripple/app/misc/impl/AmendmentTable.cpp
+  src/ripple/app/misc/impl/CacheSnapshot.cpp
   src/ripple/app/misc/impl/LoadFeeTrack.cpp
   src/ripple/app/misc/impl/Manifest.cpp
   src/ripple/app/misc/impl/Transaction.cpp
@@ -405,6 +414,7 @@ target_sources (rippled PRIVATE
   src/ripple/app/paths/AccountCurrencies.cpp
   src/ripple/app/paths/Credit.cpp
   src/ripple/app/paths/Flow.cpp
+  src/ripple/app/paths/PathCache.cpp
   src/ripple/app/paths/PathRequest.cpp
   src/ripple/app/paths/PathRequests.cpp
   src/ripple/app/paths/Pathfinder.cpp
@@ -419,6 +429,7 @@ target_sources (rippled PRIVATE
   src/ripple/app/rdb/backend/detail/impl/Shard.cpp
   src/ripple/app/rdb/backend/impl/PostgresDatabase.cpp
   src/ripple/app/rdb/backend/impl/SQLiteDatabase.cpp
+  src/ripple/app/rdb/impl/AccountTxIndex.cpp
   src/ripple/app/rdb/impl/Download.cpp
   src/ripple/app/rdb/impl/PeerFinder.cpp
   src/ripple/app/rdb/impl/RelationalDatabase.cpp
@@ -512,7 +523,9 @@ target_sources (rippled PRIVATE
   src/ripple/ledger/impl/ApplyView.cpp
   src/ripple/ledger/impl/ApplyViewBase.cpp
   src/ripple/ledger/impl/ApplyViewImpl.cpp
+  src/ripple/ledger/impl/BookCache.cpp
   src/ripple/ledger/impl/BookDirs.cpp
+  src/ripple/ledger/impl/CachedSLEs.cpp
   src/ripple/ledger/impl/CachedView.cpp
   src/ripple/ledger/impl/Directory.cpp
   src/ripple/ledger/impl/OpenView.cpp
@@ -533,6 +546,7 @@ target_sources (rippled PRIVATE
   src/ripple/net/impl/RPCErr.cpp
   src/ripple/net/impl/RPCSub.cpp
   src/ripple/net/impl/RegisterSSLCerts.cpp
+  src/ripple/net/impl/StreamMessage.cpp
   #[===============================[
      main sources:
        subdir: nodestore
@@ -658,11 +672,13 @@ target_sources (rippled PRIVATE
   src/ripple/rpc/handlers/ValidatorListSites.cpp
   src/ripple/rpc/handlers/Validators.cpp
   src/ripple/rpc/handlers/WalletPropose.cpp
+  src/ripple/rpc/impl/BinaryEncoding.cpp
   src/ripple/rpc/impl/DeliveredAmount.cpp
   src/ripple/rpc/impl/Handler.cpp
   src/ripple/rpc/impl/LegacyPathFind.cpp
   src/ripple/rpc/impl/RPCHandler.cpp
   src/ripple/rpc/impl/RPCHelpers.cpp
+  src/ripple/rpc/impl/ResponseStream.cpp
   src/ripple/rpc/impl/Role.cpp
   src/ripple/rpc/impl/ServerHandlerImp.cpp
   src/ripple/rpc/impl/ShardArchiveHandler.cpp
@@ -702,9 +718,11 @@ target_sources (rippled PRIVATE
 if (tests)
   target_sources (rippled PRIVATE
     src/test/app/AccountDelete_test.cpp
+    src/test/app/AccountTxIndex_test.cpp
     src/test/app/AccountTxPaging_test.cpp
     src/test/app/AmendmentTable_test.cpp
     src/test/app/BaseFee_test.cpp
+    src/test/app/CacheSnapshot_test.cpp
     src/test/app/Check_test.cpp
     src/test/app/ClaimReward_test.cpp
     src/test/app/CrossingLimits_test.cpp
@@ -720,10 +738,13 @@ if (tests)
     src/test/app/HashRouter_test.cpp
     src/test/app/Import_test.cpp
     src/test/app/Invoke_test.cpp
+    src/test/app/LedgerBulkReplay_test.cpp
     src/test/app/LedgerHistory_test.cpp
     src/test/app/LedgerLoad_test.cpp
     src/test/app/LedgerMaster_test.cpp
     src/test/app/LedgerReplay_test.cpp
+    src/test/app/LedgerSave_test.cpp
+    src/test/app/LedgerToJson_test.cpp
     src/test/app/LoadFeeTrack_test.cpp
     src/test/app/Manifest_test.cpp
     src/test/app/MultiSign_test.cpp
@@ -734,9 +755,11 @@ if (tests)
     src/test/app/OfferStream_test.cpp
     src/test/app/Offer_test.cpp
     src/test/app/OversizeMeta_test.cpp
+    src/test/app/PathCache_test.cpp
     src/test/app/Path_test.cpp
     src/test/app/PayChan_test.cpp
     src/test/app/PayStrand_test.cpp
+    src/test/app/PeerRequestWindow_test.cpp
     src/test/app/PseudoTx_test.cpp
     src/test/app/RCLCensorshipDetector_test.cpp
     src/test/app/RCLValidations_test.cpp
@@ -766,12 +789,14 @@ if (tests)
          subdir: basics
     #]===============================]
     src/test/basics/Buffer_test.cpp
+    src/test/basics/DecimalMath_test.cpp
     src/test/basics/DetectCrash_test.cpp
     src/test/basics/Expected_test.cpp
     src/test/basics/FileUtilities_test.cpp
     src/test/basics/IOUAmount_test.cpp
     src/test/basics/KeyCache_test.cpp
     src/test/basics/Number_test.cpp
+    src/test/basics/ParallelFor_test.cpp
     src/test/basics/PerfLog_test.cpp
     src/test/basics/RangeSet_test.cpp
     src/test/basics/scope_test.cpp
@@ -846,6 +871,7 @@ if (tests)
        test sources:
          subdir: json
     #]===============================]
+    src/test/json/Document_test.cpp
     src/test/json/Object_test.cpp
     src/test/json/Output_test.cpp
     src/test/json/Writer_test.cpp
@@ -908,9 +934,15 @@ if (tests)
        test sources:
          subdir: ledger
     #]===============================]
+    src/test/ledger/ApplyStateTableBench_test.cpp
+    src/test/ledger/BookCacheBench_test.cpp
+    src/test/ledger/BookCache_test.cpp
     src/test/ledger/BookDirs_test.cpp
+    src/test/ledger/CachedSLEs_test.cpp
     src/test/ledger/Directory_test.cpp
+    src/test/ledger/InvariantsBench_test.cpp
     src/test/ledger/Invariants_test.cpp
+    src/test/ledger/LedgerBuildBench_test.cpp
     src/test/ledger/PaymentSandbox_test.cpp
     src/test/ledger/PendingSaves_test.cpp
     src/test/ledger/SkipList_test.cpp
@@ -961,6 +993,8 @@ if (tests)
     src/test/protocol/Quality_test.cpp
     src/test/protocol/STAccount_test.cpp
     src/test/protocol/STAmount_test.cpp
+    src/test/protocol/STObjectBench_test.cpp
+    src/test/protocol/STObjectView_test.cpp
     src/test/protocol/STObject_test.cpp
     src/test/protocol/STTx_test.cpp
     src/test/protocol/STValidation_test.cpp
@@ -987,6 +1021,7 @@ if (tests)
     src/test/rpc/AccountSet_test.cpp
     src/test/rpc/AccountTx_test.cpp
     src/test/rpc/AmendmentBlocked_test.cpp
+    src/test/rpc/BinaryEncoding_test.cpp
     src/test/rpc/Book_test.cpp
     src/test/rpc/DepositAuthorized_test.cpp
     src/test/rpc/DeliveredAmount_test.cpp
@@ -1006,6 +1041,7 @@ if (tests)
     src/test/rpc/OwnerInfo_test.cpp
     src/test/rpc/Peers_test.cpp
     src/test/rpc/ReportingETL_test.cpp
+    src/test/rpc/ResponseStream_test.cpp
     src/test/rpc/Roles_test.cpp
     src/test/rpc/RPCCall_test.cpp
     src/test/rpc/RPCOverload_test.cpp
@@ -1014,6 +1050,7 @@ if (tests)
     src/test/rpc/ServerInfo_test.cpp
     src/test/rpc/ShardArchiveHandler_test.cpp
     src/test/rpc/Status_test.cpp
+    src/test/rpc/SubscribeFanout_test.cpp
     src/test/rpc/Subscribe_test.cpp
     src/test/rpc/Transaction_test.cpp
     src/test/rpc/TransactionEntry_test.cpp
@@ -1032,6 +1069,8 @@ if (tests)
          subdir: shamap
     #]===============================]
     src/test/shamap/FetchPack_test.cpp
+    src/test/shamap/SHAMapLoadBench_test.cpp
+    src/test/shamap/SHAMapMissingNodesBench_test.cpp
     src/test/shamap/SHAMapSync_test.cpp
     src/test/shamap/SHAMap_test.cpp
     #[===============================[
@@ -41,8 +41,10 @@ public:
     /** Constructor
 
         @param txn The transaction to wrap
+
+        @note The item is shared with the map it was found in, not copied.
     */
-    RCLCxTx(SHAMapItem const& txn) : tx_{txn}
+    RCLCxTx(SHAMapItem const& txn) : tx_{&txn}
     {
     }
 
@@ -50,11 +52,11 @@ public:
     ID const&
     id() const
     {
-        return tx_.key();
+        return tx_->key();
     }
 
     //! The SHAMapItem that represents the transaction.
-    SHAMapItem const tx_;
+    boost::intrusive_ptr<SHAMapItem const> tx_;
 };
 
 /** Represents a set of transactions in RCLConsensus.
@@ -90,8 +92,7 @@ public:
         bool
         insert(Tx const& t)
         {
-            return map_->addItem(
-                SHAMapNodeType::tnTRANSACTION_NM, SHAMapItem{t.tx_});
+            return map_->addItem(SHAMapNodeType::tnTRANSACTION_NM, t.tx_);
         }
 
         /** Remove a transaction from the set.
@@ -140,12 +141,12 @@ public:
         @return A shared pointer to the SHAMapItem.
 
         @note Since find may not succeed, this returns a
-              `std::shared_ptr<const SHAMapItem>` rather than a Tx, which
+              `boost::intrusive_ptr<SHAMapItem const>` rather than a Tx, which
               cannot refer to a missing transaction.  The generic consensus
-              code uses the shared_ptr semantics to know whether the find
+              code uses the pointer semantics to know whether the find
               was successful and properly creates a Tx as needed.
     */
-    std::shared_ptr<const SHAMapItem> const&
+    boost::intrusive_ptr<SHAMapItem const> const&
     find(Tx::ID const& entry) const
     {
         return map_->peekItem(entry);
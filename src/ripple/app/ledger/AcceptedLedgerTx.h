@@ -88,6 +88,13 @@ public:
     std::string
     getEscMeta() const;
 
+    /** The serialized metadata. */
+    Blob const&
+    getRawMeta() const
+    {
+        return mRawMeta;
+    }
+
     Json::Value const&
     getJson() const
     {
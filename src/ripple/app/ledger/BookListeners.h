@@ -52,13 +52,16 @@ public:
         Uses havePublished to prevent sending duplicate transactions to clients
         that have subscribed to multiple books.
 
-        @param jvObj JSON transaction data to publish
+        @param message Produces the serialized transaction data to publish,
+                       in the encoding each subscriber negotiated.
         @param havePublished InfoSub sequence numbers that have already
                              published this transaction.
 
     */
     void
-    publish(Json::Value const& jvObj, hash_set<std::uint64_t>& havePublished);
+    publish(
+        StreamMessageFactory const& message,
+        hash_set<std::uint64_t>& havePublished);
 
 private:
     std::recursive_mutex mLock;
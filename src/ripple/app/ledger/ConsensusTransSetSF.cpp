@@ -89,9 +89,10 @@ ConsensusTransSetSF::getNode(SHAMapHash const& nodeHash) const
     {
         // this is a transaction, and we have it
         JLOG(j_.trace()) << "Node in our acquiring TX set is TXN we have";
-        Serializer s;
+        auto const& sttx = txn->getSTransaction();
+        Serializer s(sttx->getSerialized().size() + 4);
         s.add32(HashPrefix::transactionID);
-        txn->getSTransaction()->add(s);
+        s.addRaw(sttx->getSerialized());
         assert(sha512Half(s.slice()) == nodeHash.as_uint256());
         nodeData = s.peekData();
         return nodeData;
@@ -21,10 +21,12 @@
 #define RIPPLE_APP_LEDGER_INBOUNDLEDGER_H_INCLUDED
 
 #include <ripple/app/ledger/Ledger.h>
+#include <ripple/app/ledger/impl/PeerRequestWindow.h>
 #include <ripple/app/ledger/impl/TimeoutCounter.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/basics/CountedObject.h>
 #include <ripple/overlay/PeerSet.h>
+#include <map>
 #include <mutex>
 #include <set>
 #include <utility>
@@ -125,11 +127,24 @@ private:
     void
     filterNodes(
         std::vector<std::pair<SHAMapNodeID, uint256>>& nodes,
-        TriggerReason reason);
+        TriggerReason reason,
+        std::size_t limit);
 
     void
     trigger(std::shared_ptr<Peer> const&, TriggerReason);
 
+    void
+    sendRequest(
+        protocol::TMGetLedger const& tmGL,
+        std::shared_ptr<Peer> const& peer);
+
+    void
+    sendNodeRequests(
+        protocol::TMGetLedger& tmGL,
+        std::vector<std::pair<SHAMapNodeID, uint256>> const& nodes,
+        std::size_t perRequest,
+        std::shared_ptr<Peer> const& peer);
+
     std::vector<neededHash_t>
     getNeededHashes();
 
@@ -167,10 +182,16 @@ private:
     takeAsRootNode(Slice const& data, SHAMapAddNode&);
 
     std::vector<uint256>
-    neededTxHashes(int max, SHAMapSyncFilter* filter) const;
+    neededTxHashes(
+        int max,
+        SHAMapSyncFilter* filter,
+        SHAMap::ScanProgress* progress = nullptr) const;
 
     std::vector<uint256>
-    neededStateHashes(int max, SHAMapSyncFilter* filter) const;
+    neededStateHashes(
+        int max,
+        SHAMapSyncFilter* filter,
+        SHAMap::ScanProgress* progress = nullptr) const;
 
     clock_type& m_clock;
     clock_type::time_point mLastAction;
@@ -195,6 +216,14 @@ private:
         mReceivedData;
     bool mReceiveDispatched;
     std::unique_ptr<PeerSet> mPeerSet;
+
+    // The requests in flight to, and the data received from, each peer
+    std::mutex mPeerWindowsLock;
+    std::map<Peer::id_t, PeerRequestWindow> mPeerWindows;
+
+    // The progress of the searches for missing nodes in each map
+    SHAMap::ScanProgress mStateScan;
+    SHAMap::ScanProgress mTxScan;
 };
 
 /** Deserialize a ledger header from a byte array. */
@@ -119,7 +119,7 @@ public:
     sles_type::value_type
     dereference() const override
     {
-        auto const item = *iter_;
+        auto const& item = *iter_;
         SerialIter sit(item.slice());
         return std::make_shared<SLE const>(sit, item.key());
     }
@@ -168,7 +168,7 @@ public:
     txs_type::value_type
     dereference() const override
     {
-        auto const item = *iter_;
+        auto const& item = *iter_;
         if (metadata_)
             return deserializeTxPlusMeta(item);
         return {deserializeTx(item), nullptr};
@@ -310,6 +310,44 @@ Ledger::Ledger(
     }
 }
 
+Ledger::Ledger(
+    LedgerInfo const& info,
+    std::shared_ptr<SHAMap> txMap,
+    bool& loaded,
+    Config const& config,
+    Family& family,
+    beast::Journal j)
+    : mImmutable(true)
+    , txMap_(std::move(txMap))
+    , stateMap_(
+          std::make_shared<SHAMap>(SHAMapType::STATE, info.accountHash, family))
+    , rules_(config.features)
+    , info_(info)
+    , j_(j)
+{
+    loaded = true;
+
+    if (txMap_->getHash().as_uint256() != info_.txHash)
+    {
+        loaded = false;
+        JLOG(j.warn()) << "Transactions do not match ledger " << info_.seq;
+    }
+
+    if (info_.accountHash.isNonZero() &&
+        !stateMap_->fetchRoot(SHAMapHash{info_.accountHash}, nullptr))
+    {
+        loaded = false;
+        JLOG(j.warn()) << "Don't have state data root for ledger" << info_.seq;
+    }
+
+    txMap_->setImmutable();
+    stateMap_->setImmutable();
+
+    defaultFees(config);
+    if (!setup())
+        loaded = false;
+}
+
 // Create a new ledger that follows this one
 Ledger::Ledger(Ledger const& prevLedger, NetClock::time_point closeTime)
     : mImmutable(false)
@@ -414,9 +452,11 @@ Ledger::setAccepted(
 bool
 Ledger::addSLE(SLE const& sle)
 {
-    auto const s = sle.getSerializer();
-    SHAMapItem item(sle.key(), s.slice());
-    return stateMap_->addItem(SHAMapNodeType::tnACCOUNT_STATE, std::move(item));
+    ScratchSerializer s;
+    sle.add(*s);
+    return stateMap_->addItem(
+        SHAMapNodeType::tnACCOUNT_STATE,
+        make_shamapitem(sle.key(), s->slice()));
 }
 
 //------------------------------------------------------------------------------
@@ -488,6 +528,36 @@ Ledger::read(Keylet const& k) const
     return sle;
 }
 
+std::optional<SLEView>
+Ledger::readLazy(Keylet const& k) const
+{
+    if (k.key == beast::zero)
+    {
+        assert(false);
+        return std::nullopt;
+    }
+    auto const& item = stateMap_->peekItem(k.key);
+    if (!item)
+        return std::nullopt;
+    // The view keeps the item, and so the bytes it views, alive
+    std::optional<SLEView> sle(
+        std::in_place,
+        item->slice(),
+        item->key(),
+        std::shared_ptr<void const>(item.get(), [item](void const*) {}));
+    if (!k.check(*sle))
+        return std::nullopt;
+    return sle;
+}
+
+std::shared_ptr<BookOffers const>
+Ledger::bookOffers(uint256 const& book) const
+{
+    if (!mImmutable)
+        return nullptr;
+    return books_.get(*this, book);
+}
+
 //------------------------------------------------------------------------------
 
 auto
@@ -572,22 +642,22 @@ Ledger::rawErase(uint256 const& key)
 void
 Ledger::rawInsert(std::shared_ptr<SLE> const& sle)
 {
-    Serializer ss;
-    sle->add(ss);
+    ScratchSerializer ss;
+    sle->add(*ss);
     if (!stateMap_->addGiveItem(
             SHAMapNodeType::tnACCOUNT_STATE,
-            std::make_shared<SHAMapItem const>(sle->key(), ss.slice())))
+            make_shamapitem(sle->key(), ss->slice())))
         LogicError("Ledger::rawInsert: key already exists");
 }
 
 void
 Ledger::rawReplace(std::shared_ptr<SLE> const& sle)
 {
-    Serializer ss;
-    sle->add(ss);
+    ScratchSerializer ss;
+    sle->add(*ss);
     if (!stateMap_->updateGiveItem(
             SHAMapNodeType::tnACCOUNT_STATE,
-            std::make_shared<SHAMapItem const>(sle->key(), ss.slice())))
+            make_shamapitem(sle->key(), ss->slice())))
         LogicError("Ledger::rawReplace: key not found");
 }
 
@@ -600,12 +670,13 @@ Ledger::rawTxInsert(
     assert(metaData);
 
     // low-level - just add to table
-    Serializer s(txn->getDataLength() + metaData->getDataLength() + 16);
-    s.addVL(txn->peekData());
-    s.addVL(metaData->peekData());
+    ScratchSerializer s;
+    s->reserve(txn->getDataLength() + metaData->getDataLength() + 16);
+    s->addVL(txn->peekData());
+    s->addVL(metaData->peekData());
     if (!txMap().addGiveItem(
             SHAMapNodeType::tnTRANSACTION_MD,
-            std::make_shared<SHAMapItem const>(key, s.slice())))
+            make_shamapitem(key, s->slice())))
         LogicError("duplicate_tx: " + to_string(key));
 }
 
@@ -618,10 +689,11 @@ Ledger::rawTxInsertWithHash(
     assert(metaData);
 
     // low-level - just add to table
-    Serializer s(txn->getDataLength() + metaData->getDataLength() + 16);
-    s.addVL(txn->peekData());
-    s.addVL(metaData->peekData());
-    auto item = std::make_shared<SHAMapItem const>(key, s.slice());
+    ScratchSerializer s;
+    s->reserve(txn->getDataLength() + metaData->getDataLength() + 16);
+    s->addVL(txn->peekData());
+    s->addVL(metaData->peekData());
+    auto item = make_shamapitem(key, s->slice());
     auto hash = sha512Half(HashPrefix::txNode, item->slice(), item->key());
     if (!txMap().addGiveItem(SHAMapNodeType::tnTRANSACTION_MD, std::move(item)))
         LogicError("duplicate_tx: " + to_string(key));
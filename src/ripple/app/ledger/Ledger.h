@@ -117,6 +117,21 @@ public:
         Family& family,
         beast::Journal j);
 
+    /** Used for ledgers whose transactions are at hand
+
+        The state map is read from the node store as it is needed.
+
+        @param txMap The transactions of the ledger, which must hash to
+                     the transaction hash in the header
+    */
+    Ledger(
+        LedgerInfo const& info,
+        std::shared_ptr<SHAMap> txMap,
+        bool& loaded,
+        Config const& config,
+        Family& family,
+        beast::Journal j);
+
     /** Create a new ledger following a previous ledger
 
         The ledger will have the sequence number that
@@ -181,6 +196,12 @@ public:
     std::shared_ptr<SLE const>
     read(Keylet const& k) const override;
 
+    std::optional<SLEView>
+    readLazy(Keylet const& k) const override;
+
+    std::shared_ptr<BookOffers const>
+    bookOffers(uint256 const& book) const override;
+
     std::unique_ptr<sles_type::iter_base>
     slesBegin() const override;
 
@@ -411,6 +432,10 @@ private:
     Rules rules_;
     LedgerInfo info_;
     beast::Journal j_;
+
+    // The tops of the most recently used order books, read once the
+    // ledger is immutable
+    BookCache mutable books_;
 };
 
 /** A ledger wrapped in a CachedView. */
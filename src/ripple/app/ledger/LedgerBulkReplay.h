@@ -0,0 +1,169 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_LEDGER_LEDGERBULKREPLAY_H_INCLUDED
+#define RIPPLE_APP_LEDGER_LEDGERBULKREPLAY_H_INCLUDED
+
+#include <ripple/basics/chrono.h>
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/json/json_value.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ripple {
+
+class Application;
+class Ledger;
+class STTx;
+
+/** Replays a range of ledgers from local history, as fast as it can.
+
+    Each ledger is rebuilt from its parent and its transactions, as
+    buildLedger does for a ledger replay, and the hash of its state map
+    compared with that in the stored header. Nothing is published and
+    nothing is written to the relational databases, so this measures how
+    fast ledgers are applied, and checks that a new build or amendment
+    applies history as it was.
+
+    The ledgers and transactions ahead of the one being applied are read
+    on other threads. When the state of a rebuilt ledger does not match,
+    the stored ledger becomes the parent of the next one, so that one
+    difference is reported once.
+
+    The server is never started, so its sweep timer does not run. The
+    caches the replay fills are swept here instead, every few ledgers.
+*/
+class LedgerBulkReplay
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    struct Result
+    {
+        std::uint32_t seq;
+        std::size_t transactions;
+
+        // Time spent waiting for the ledger to be read
+        std::chrono::microseconds wait;
+
+        // Time spent building the ledger
+        std::chrono::microseconds apply;
+
+        // Whether the state map matched the stored ledger
+        bool matched;
+    };
+
+    /** The number of ledgers replayed between sweeps of the caches. */
+    static constexpr std::uint32_t defaultSweepInterval = 256;
+
+    /** Prepare to replay the ledgers `first` through `last`.
+
+        @param ahead The number of ledgers to read ahead, at least 1
+        @param sweepInterval The number of ledgers between sweeps, at
+                             least 1
+    */
+    LedgerBulkReplay(
+        Application& app,
+        std::uint32_t first,
+        std::uint32_t last,
+        std::size_t ahead,
+        beast::Journal j,
+        std::uint32_t sweepInterval = defaultSweepInterval);
+
+    LedgerBulkReplay(LedgerBulkReplay const&) = delete;
+    LedgerBulkReplay&
+    operator=(LedgerBulkReplay const&) = delete;
+
+    /** Replay the ledgers.
+
+        @return `false` if a ledger could not be read, in which case the
+                ledgers before it were still replayed.
+    */
+    bool
+    run();
+
+    /** The ledgers replayed so far, in order. */
+    std::vector<Result> const&
+    results() const
+    {
+        return results_;
+    }
+
+    /** The number of ledgers whose state did not match. */
+    std::size_t
+    mismatches() const;
+
+    /** The number of times the caches were swept. */
+    std::size_t
+    sweeps() const
+    {
+        return sweeps_;
+    }
+
+    /** A report of the replay, including every ledger replayed. */
+    Json::Value
+    getJson() const;
+
+private:
+    struct Fetched
+    {
+        std::shared_ptr<Ledger const> ledger;
+        std::map<std::uint32_t, std::shared_ptr<STTx const>> txns;
+    };
+
+    void
+    fetch();
+
+    Fetched
+    fetch(std::uint32_t seq);
+
+    void
+    sweep();
+
+    Application& app_;
+    std::uint32_t const first_;
+    std::uint32_t const last_;
+    std::size_t const ahead_;
+    beast::Journal const j_;
+    std::uint32_t const sweepInterval_;
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+
+    // The next ledger to read, and the one being applied
+    std::uint32_t next_;
+    std::uint32_t applying_;
+    bool stopping_ = false;
+
+    // Ledgers which were read and are waiting to be applied
+    std::map<std::uint32_t, Fetched> fetched_;
+
+    std::vector<Result> results_;
+    std::chrono::microseconds elapsed_{0};
+    std::size_t sweeps_ = 0;
+};
+
+}  // namespace ripple
+
+#endif
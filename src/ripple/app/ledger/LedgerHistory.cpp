@@ -19,10 +19,15 @@
 
 #include <ripple/app/ledger/LedgerHistory.h>
 #include <ripple/app/ledger/LedgerToJson.h>
+#include <ripple/basics/CompressionAlgorithms.h>
 #include <ripple/basics/Log.h>
 #include <ripple/basics/chrono.h>
 #include <ripple/basics/contract.h>
+#include <ripple/core/JobQueue.h>
 #include <ripple/json/to_string.h>
+#include <ripple/protocol/jss.h>
+#include <ripple/rpc/BookChanges.h>
+#include <ripple/shamap/SHAMapMissingNode.h>
 
 namespace ripple {
 
@@ -40,12 +45,19 @@ LedgerHistory::LedgerHistory(
           std::chrono::seconds{app_.config().getValueFor(SizedItem::ledgerAge)},
           stopwatch(),
           app_.journal("TaggedCache"))
+    , m_book_changes(
+          "BookChangesCache",
+          app_.config().getValueFor(SizedItem::ledgerSize),
+          std::chrono::seconds{app_.config().getValueFor(SizedItem::ledgerAge)},
+          stopwatch(),
+          app_.journal("TaggedCache"))
     , m_consensus_validated(
           "ConsensusValidated",
           64,
           std::chrono::minutes{5},
           stopwatch(),
           app_.journal("TaggedCache"))
+    , lightLimit_(app_.config().LEDGER_LIGHT_HISTORY)
     , j_(app.journal("LedgerHistory"))
 {
 }
@@ -68,6 +80,19 @@ LedgerHistory::insert(std::shared_ptr<Ledger const> ledger, bool validated)
     return alreadyHad;
 }
 
+std::shared_ptr<Json::Value const>
+LedgerHistory::getBookChanges(std::shared_ptr<ReadView const> const& ledger)
+{
+    auto const& hash = ledger->info().hash;
+    if (auto ret = m_book_changes.fetch(hash))
+        return ret;
+
+    auto ret =
+        std::make_shared<Json::Value const>(RPC::computeBookChanges(ledger));
+    m_book_changes.canonicalize_replace_client(hash, ret);
+    return ret;
+}
+
 LedgerHash
 LedgerHistory::getLedgerHash(LedgerIndex index)
 {
@@ -125,7 +150,10 @@ LedgerHistory::getLedgerByHash(LedgerHash const& hash)
         return ret;
     }
 
-    ret = loadByHash(hash, app_);
+    ret = expandLight(hash);
+
+    if (!ret)
+        ret = loadByHash(hash, app_);
 
     if (!ret)
         return ret;
@@ -480,6 +508,18 @@ LedgerHistory::validatedLedger(
     LedgerHash hash = ledger->info().hash;
     assert(!hash.isZero());
 
+    // Compressing the transactions takes a while, and the ledger master's
+    // lock is held here
+    if (lightLimit_ != 0)
+    {
+        if (auto job = lightJobs_.wrap(
+                [this, ledger]() { retainLight(*ledger); }))
+        {
+            app_.getJobQueue().addJob(
+                jtADVANCE, "LedgerHistory::retainLight", std::move(*job));
+        }
+    }
+
     std::unique_lock sl(m_consensus_validated.peekMutex());
 
     auto entry = std::make_shared<cv_entry>();
@@ -535,6 +575,166 @@ LedgerHistory::clearLedgerCachePrior(LedgerIndex seq)
         if (!ledger || ledger->info().seq < seq)
             m_ledgers_by_hash.del(it, false);
     }
+
+    std::lock_guard lock(lightMutex_);
+    while (!m_light_by_index.empty() && m_light_by_index.begin()->first < seq)
+        dropLight(m_light_by_index.begin());
+}
+
+void
+LedgerHistory::dropLight(std::map<LedgerIndex, LedgerHash>::iterator it)
+{
+    auto const light = m_light_ledgers.find(it->second);
+    lightBytes_ -= light->second->bytes();
+    m_light_ledgers.erase(light);
+    m_light_by_index.erase(it);
+}
+
+void
+LedgerHistory::retainLight(Ledger const& ledger)
+{
+    if (lightLimit_ == 0)
+        return;
+
+    auto const& info = ledger.info();
+    {
+        std::lock_guard lock(lightMutex_);
+        if (m_light_ledgers.count(info.hash))
+            return;
+    }
+
+    auto light = std::make_shared<LightLedger>();
+    light->info = info;
+
+    try
+    {
+        Serializer s;
+        for (auto const& item : ledger.txMap())
+        {
+            s.addBitString(item.key());
+            s.addVL(item.slice());
+        }
+        light->size = s.size();
+
+        if (light->size != 0)
+        {
+            light->txns.resize(compression_algorithms::lz4Compress(
+                s.data(), s.size(), [&](std::size_t size) {
+                    light->txns.resize(size);
+                    return light->txns.data();
+                }));
+            light->txns.shrink_to_fit();
+        }
+    }
+    catch (SHAMapMissingNode const& e)
+    {
+        JLOG(j_.debug()) << "Not keeping ledger " << info.seq
+                         << " in light form: " << e.what();
+        return;
+    }
+
+    std::lock_guard lock(lightMutex_);
+
+    // Another ledger with this index may have been validated before
+    if (auto const it = m_light_by_index.find(info.seq);
+        it != m_light_by_index.end())
+        dropLight(it);
+
+    if (!m_light_ledgers.emplace(info.hash, light).second)
+        return;
+    m_light_by_index.emplace(info.seq, info.hash);
+    lightBytes_ += light->bytes();
+
+    while (m_light_by_index.size() > lightLimit_)
+        dropLight(m_light_by_index.begin());
+}
+
+std::shared_ptr<Ledger const>
+LedgerHistory::expandLight(LedgerHash const& hash)
+{
+    std::shared_ptr<LightLedger const> light;
+    {
+        std::lock_guard lock(lightMutex_);
+        auto const it = m_light_ledgers.find(hash);
+        if (it == m_light_ledgers.end())
+            return {};
+        light = it->second;
+    }
+
+    using namespace std::chrono;
+    auto const start = steady_clock::now();
+
+    auto& family = app_.getNodeFamily();
+    std::shared_ptr<Ledger> ledger;
+
+    try
+    {
+        auto txMap = std::make_shared<SHAMap>(SHAMapType::TRANSACTION, family);
+        if (light->size != 0)
+        {
+            Blob txns(light->size);
+            compression_algorithms::lz4Decompress(
+                light->txns.data(),
+                light->txns.size(),
+                txns.data(),
+                txns.size());
+
+            SerialIter sit(makeSlice(txns));
+            while (!sit.empty())
+            {
+                auto const key = sit.get256();
+                auto const data = sit.getSlice(sit.getVLDataLength());
+                txMap->addGiveItem(
+                    SHAMapNodeType::tnTRANSACTION_MD,
+                    make_shamapitem(key, data));
+            }
+        }
+
+        bool loaded;
+        ledger = std::make_shared<Ledger>(
+            light->info,
+            std::move(txMap),
+            loaded,
+            app_.config(),
+            family,
+            app_.journal("Ledger"));
+        if (!loaded)
+            return {};
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(j_.warn()) << "Unable to expand ledger " << light->info.seq
+                        << ": " << e.what();
+        return {};
+    }
+
+    ledger->setFull();
+
+    ++expansions_;
+    expansionTime_ +=
+        duration_cast<microseconds>(steady_clock::now() - start).count();
+
+    JLOG(j_.debug()) << "Expanded ledger " << light->info.seq;
+    return ledger;
+}
+
+Json::Value
+LedgerHistory::getRetainedJson() const
+{
+    Json::Value ret(Json::objectValue);
+    ret[jss::full] = m_ledgers_by_hash.getCacheSize();
+    {
+        std::lock_guard lock(lightMutex_);
+        ret[jss::light] = static_cast<Json::UInt>(m_light_ledgers.size());
+        ret[jss::light_bytes] = std::to_string(lightBytes_);
+    }
+
+    auto const expansions = expansions_.load();
+    ret[jss::expansions] = std::to_string(expansions);
+    if (expansions != 0)
+        ret[jss::expansion_us] =
+            std::to_string(expansionTime_.load() / expansions);
+    return ret;
 }
 
 }  // namespace ripple
@@ -22,17 +22,30 @@
 
 #include <ripple/app/ledger/Ledger.h>
 #include <ripple/app/main/Application.h>
+#include <ripple/basics/UnorderedContainers.h>
 #include <ripple/beast/insight/Collector.h>
 #include <ripple/beast/insight/Event.h>
+#include <ripple/core/Job.h>
 #include <ripple/protocol/RippleLedgerHash.h>
 
+#include <atomic>
+#include <map>
+#include <mutex>
 #include <optional>
 
 namespace ripple {
 
 // VFALCO TODO Rename to OldLedgers ?
 
-/** Retains historical ledgers. */
+/** Retains historical ledgers.
+
+    Recent ledgers are held in full, in a cache. Validated ledgers are also
+    held in a light form, which costs far less memory: the header, and the
+    transactions and their metadata, compressed. A light ledger which is
+    asked for after the full one was dropped is expanded again: its
+    transaction tree is rebuilt, and its state tree is read from the node
+    store as it is needed.
+*/
 class LedgerHistory
 {
 public:
@@ -55,6 +68,12 @@ public:
         return m_ledgers_by_hash.getHitRate();
     }
 
+    /** The ledgers held in full and in light form, the memory used by the
+        light ones, and how long expanding them took, for get_counts.
+    */
+    Json::Value
+    getRetainedJson() const;
+
     /** Get a ledger given its sequence number */
     std::shared_ptr<Ledger const>
     getLedgerBySeq(LedgerIndex ledgerIndex);
@@ -63,6 +82,18 @@ public:
     std::shared_ptr<Ledger const>
     getLedgerByHash(LedgerHash const& ledgerHash);
 
+    /** Get the order book changes in a ledger
+
+        The changes are computed the first time they are asked for, which
+        for a validated ledger is when it is published, and are kept for
+        as long as recent ledgers are.
+
+        @param ledger A closed ledger
+        @return The `book_changes` message for the ledger
+    */
+    std::shared_ptr<Json::Value const>
+    getBookChanges(std::shared_ptr<ReadView const> const& ledger);
+
     /** Get a ledger's hash given its sequence number
         @param ledgerIndex The sequence number of the desired ledger
         @return The hash of the specified ledger
@@ -77,6 +108,7 @@ public:
     {
         m_ledgers_by_hash.sweep();
         m_consensus_validated.sweep();
+        m_book_changes.sweep();
     }
 
     /** Report that we have locally built a particular ledger */
@@ -122,6 +154,23 @@ private:
         std::optional<uint256> const& validatedConsensusHash,
         Json::Value const& consensus);
 
+    /** Keep a validated ledger in light form. Called from a job, since
+        validatedLedger runs under the ledger master's lock.
+    */
+    void
+    retainLight(Ledger const& ledger);
+
+    /** Stop keeping a ledger in light form. The caller holds lightMutex_. */
+    void
+    dropLight(std::map<LedgerIndex, LedgerHash>::iterator it);
+
+    /** Rebuild a ledger kept in light form.
+        @return The ledger, or nullptr if it is not kept or the state tree
+                is not in the node store
+    */
+    std::shared_ptr<Ledger const>
+    expandLight(LedgerHash const& hash);
+
     Application& app_;
     beast::insight::Collector::ptr collector_;
     beast::insight::Counter mismatch_counter_;
@@ -130,6 +179,10 @@ private:
 
     LedgersByHash m_ledgers_by_hash;
 
+    // The order book changes in recent ledgers, by ledger hash
+    using BookChangesByHash = TaggedCache<LedgerHash, Json::Value const>;
+    BookChangesByHash m_book_changes;
+
     // Maps ledger indexes to the corresponding hashes
     // For debug and logging purposes
     struct cv_entry
@@ -151,7 +204,40 @@ private:
     // Maps ledger indexes to the corresponding hash.
     std::map<LedgerIndex, LedgerHash> mLedgersByIndex;  // validated ledgers
 
+    // A ledger in light form
+    struct LightLedger
+    {
+        LedgerInfo info;
+
+        // The transactions and their metadata, each preceded by its key,
+        // compressed, and their size before they were compressed
+        Blob txns;
+        std::size_t size = 0;
+
+        std::size_t
+        bytes() const
+        {
+            return sizeof(LightLedger) + txns.capacity();
+        }
+    };
+
+    // The most light ledgers to keep
+    std::size_t const lightLimit_;
+
+    // The light ledgers, by hash and by index, and the memory they use
+    mutable std::mutex lightMutex_;
+    hash_map<LedgerHash, std::shared_ptr<LightLedger const>> m_light_ledgers;
+    std::map<LedgerIndex, LedgerHash> m_light_by_index;
+    std::size_t lightBytes_ = 0;
+
+    // The number of light ledgers expanded, and the time it took
+    std::atomic<std::uint64_t> expansions_{0};
+    std::atomic<std::uint64_t> expansionTime_{0};  // microseconds
+
     beast::Journal j_;
+
+    // The jobs building light ledgers, waited for on destruction
+    JobCounter lightJobs_;
 };
 
 }  // namespace ripple
@@ -196,6 +196,10 @@ public:
     std::shared_ptr<Ledger const>
     getLedgerByHash(uint256 const& hash);
 
+    /** The order book changes in a closed ledger, computed once. */
+    std::shared_ptr<Json::Value const>
+    getBookChanges(std::shared_ptr<ReadView const> const& ledger);
+
     void
     setLedgerRangePresent(std::uint32_t minV, std::uint32_t maxV);
 
@@ -223,6 +227,8 @@ public:
     sweep();
     float
     getCacheHitRate();
+    Json::Value
+    getRetainedLedgersJson() const;
 
     void
     checkAccept(std::shared_ptr<Ledger const> const& ledger);
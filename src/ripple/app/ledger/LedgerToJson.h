@@ -23,6 +23,7 @@
 #include <ripple/app/ledger/Ledger.h>
 #include <ripple/app/misc/TxQ.h>
 #include <ripple/basics/StringUtilities.h>
+#include <ripple/json/Document.h>
 #include <ripple/json/Object.h>
 #include <ripple/protocol/STTx.h>
 #include <ripple/protocol/jss.h>
@@ -66,6 +67,16 @@ struct LedgerFill
 void
 addJson(Json::Value&, LedgerFill const&);
 
+/** Fill a Json::Document with a description of the ledger, exactly as
+    addJson does for a Json::Value. */
+void
+addJson(Json::Document::Node&, LedgerFill const&);
+
+/** Write a description of the ledger to a streaming Json::Object, exactly
+    as addJson does for a Json::Value. */
+void
+addJson(Json::Object&, LedgerFill const&);
+
 /** Return a new Json::Value representing the ledger with given options.*/
 Json::Value
 getJson(LedgerFill const&);
@@ -58,12 +58,13 @@ public:
     BookListeners::pointer
     makeBookListeners(Book const&);
 
-    // see if this txn effects any orderbook
+    // see if this txn effects any orderbook. The message is only built if
+    // some book has listeners.
     void
     processTxn(
         std::shared_ptr<ReadView const> const& ledger,
         const AcceptedLedgerTx& alTx,
-        Json::Value const& jvObj);
+        StreamMessageFactory const& message);
 
 private:
     Application& app_;
@@ -27,6 +27,7 @@
 #include <ripple/basics/Log.h>
 #include <ripple/core/JobQueue.h>
 #include <ripple/nodestore/DatabaseShard.h>
+#include <ripple/overlay/Message.h>
 #include <ripple/overlay/Overlay.h>
 #include <ripple/protocol/HashPrefix.h>
 #include <ripple/protocol/jss.h>
@@ -236,7 +237,9 @@ neededHashes(
     uint256 const& root,
     SHAMap& map,
     int max,
-    SHAMapSyncFilter* filter)
+    SHAMapSyncFilter* filter,
+    std::size_t threads,
+    SHAMap::ScanProgress* progress)
 {
     std::vector<uint256> ret;
 
@@ -246,7 +249,7 @@ neededHashes(
             ret.push_back(root);
         else
         {
-            auto mn = map.getMissingNodes(max, filter);
+            auto mn = map.getMissingNodes(max, filter, threads, progress);
             ret.reserve(mn.size());
             for (auto const& n : mn)
                 ret.push_back(n.second);
@@ -256,17 +259,36 @@ neededHashes(
     return ret;
 }
 
+// Searches which report their progress are part of acquiring the ledger,
+// and may use as many threads as adding nodes does.
 std::vector<uint256>
-InboundLedger::neededTxHashes(int max, SHAMapSyncFilter* filter) const
+InboundLedger::neededTxHashes(
+    int max,
+    SHAMapSyncFilter* filter,
+    SHAMap::ScanProgress* progress) const
 {
-    return neededHashes(mLedger->info().txHash, mLedger->txMap(), max, filter);
+    return neededHashes(
+        mLedger->info().txHash,
+        mLedger->txMap(),
+        max,
+        filter,
+        progress ? app_.config().LEDGER_FETCH_THREADS : 1,
+        progress);
 }
 
 std::vector<uint256>
-InboundLedger::neededStateHashes(int max, SHAMapSyncFilter* filter) const
+InboundLedger::neededStateHashes(
+    int max,
+    SHAMapSyncFilter* filter,
+    SHAMap::ScanProgress* progress) const
 {
     return neededHashes(
-        mLedger->info().accountHash, mLedger->stateMap(), max, filter);
+        mLedger->info().accountHash,
+        mLedger->stateMap(),
+        max,
+        filter,
+        progress ? app_.config().LEDGER_FETCH_THREADS : 1,
+        progress);
 }
 
 LedgerInfo
@@ -382,7 +404,7 @@ InboundLedger::tryDB(NodeStore::Database& srcDB)
             if (mLedger->txMap().fetchRoot(
                     SHAMapHash{mLedger->info().txHash}, &filter))
             {
-                if (neededTxHashes(1, &filter).empty())
+                if (neededTxHashes(1, &filter, &mTxScan).empty())
                 {
                     JLOG(journal_.trace()) << "Had full txn map locally";
                     mHaveTransactions = true;
@@ -405,7 +427,7 @@ InboundLedger::tryDB(NodeStore::Database& srcDB)
         if (mLedger->stateMap().fetchRoot(
                 SHAMapHash{mLedger->info().accountHash}, &filter))
         {
-            if (neededStateHashes(1, &filter).empty())
+            if (neededStateHashes(1, &filter, &mStateScan).empty())
             {
                 JLOG(journal_.trace()) << "Had full AS map locally";
                 mHaveState = true;
@@ -429,6 +451,21 @@ InboundLedger::onTimer(bool wasProgress, ScopedLockType&)
 {
     mRecentNodes.clear();
 
+    {
+        // Requests this old have most likely been dropped. Their nodes
+        // are no longer recent, so they will be asked for again.
+        std::lock_guard sl(mPeerWindowsLock);
+        auto const now = m_clock.now();
+        for (auto& [id, window] : mPeerWindows)
+        {
+            if (auto const n = window.expire(now, ledgerAcquireTimeout))
+            {
+                JLOG(journal_.debug())
+                    << n << " requests to peer " << id << " expired";
+            }
+        }
+    }
+
     if (isDone())
     {
         JLOG(journal_.info()) << "Already done " << hash_;
@@ -657,7 +694,7 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
             tmGL.set_ledgerseq(mSeq);
         JLOG(journal_.trace()) << "Sending header request to "
                                << (peer ? "selected peer" : "all peers");
-        mPeerSet->sendRequest(tmGL, peer);
+        sendRequest(tmGL, peer);
         return;
     }
 
@@ -677,6 +714,26 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
     else
         tmGL.set_querydepth(1);
 
+    // A peer which has just replied may be sent as many requests for nodes
+    // as its window has room for. Everything else is sent one.
+    std::size_t requests = 1;
+    if (peer && reason == TriggerReason::reply)
+    {
+        std::lock_guard wl(mPeerWindowsLock);
+        requests = mPeerWindows[peer->id()].available();
+    }
+
+    if (requests == 0)
+    {
+        JLOG(journal_.trace())
+            << "No room for requests to peer " << peer->id();
+        return;
+    }
+
+    std::size_t const perRequest =
+        (reason == TriggerReason::reply) ? reqNodesReply : reqNodes;
+    int const find = missingNodesFind * static_cast<int>(requests);
+
     // Get the state data first because it's the most likely to be useful
     // if we wind up abandoning this fetch.
     if (mHaveHeader && !mHaveState && !failed_)
@@ -694,7 +751,7 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
             *tmGL.add_nodeids() = SHAMapNodeID().getRawString();
             JLOG(journal_.trace()) << "Sending AS root request to "
                                    << (peer ? "selected peer" : "all peers");
-            mPeerSet->sendRequest(tmGL, peer);
+            sendRequest(tmGL, peer);
             return;
         }
         else
@@ -704,8 +761,11 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
 
             // Release the lock while we process the large state map
             sl.unlock();
-            auto nodes =
-                mLedger->stateMap().getMissingNodes(missingNodesFind, &filter);
+            auto nodes = mLedger->stateMap().getMissingNodes(
+                find,
+                &filter,
+                app_.config().LEDGER_FETCH_THREADS,
+                &mStateScan);
             sl.lock();
 
             // Make sure nothing happened while we released the lock
@@ -725,21 +785,16 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
                 }
                 else
                 {
-                    filterNodes(nodes, reason);
+                    filterNodes(nodes, reason, perRequest * requests);
 
                     if (!nodes.empty())
                     {
                         tmGL.set_itype(protocol::liAS_NODE);
-                        for (auto const& id : nodes)
-                        {
-                            *(tmGL.add_nodeids()) = id.first.getRawString();
-                        }
-
                         JLOG(journal_.trace())
                             << "Sending AS node request (" << nodes.size()
                             << ") to "
                             << (peer ? "selected peer" : "all peers");
-                        mPeerSet->sendRequest(tmGL, peer);
+                        sendNodeRequests(tmGL, nodes, perRequest, peer);
                         return;
                     }
                     else
@@ -766,7 +821,7 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
             *(tmGL.add_nodeids()) = SHAMapNodeID().getRawString();
             JLOG(journal_.trace()) << "Sending TX root request to "
                                    << (peer ? "selected peer" : "all peers");
-            mPeerSet->sendRequest(tmGL, peer);
+            sendRequest(tmGL, peer);
             return;
         }
         else
@@ -774,8 +829,8 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
             TransactionStateSF filter(
                 mLedger->txMap().family().db(), app_.getLedgerMaster());
 
-            auto nodes =
-                mLedger->txMap().getMissingNodes(missingNodesFind, &filter);
+            auto nodes = mLedger->txMap().getMissingNodes(
+                find, &filter, app_.config().LEDGER_FETCH_THREADS, &mTxScan);
 
             if (nodes.empty())
             {
@@ -791,19 +846,15 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
             }
             else
             {
-                filterNodes(nodes, reason);
+                filterNodes(nodes, reason, perRequest * requests);
 
                 if (!nodes.empty())
                 {
                     tmGL.set_itype(protocol::liTX_NODE);
-                    for (auto const& n : nodes)
-                    {
-                        *(tmGL.add_nodeids()) = n.first.getRawString();
-                    }
                     JLOG(journal_.trace())
                         << "Sending TX node request (" << nodes.size()
                         << ") to " << (peer ? "selected peer" : "all peers");
-                    mPeerSet->sendRequest(tmGL, peer);
+                    sendNodeRequests(tmGL, nodes, perRequest, peer);
                     return;
                 }
                 else
@@ -824,10 +875,46 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
     }
 }
 
+/** Send a request, and note it against the window of the peer it is for
+ */
+void
+InboundLedger::sendRequest(
+    protocol::TMGetLedger const& tmGL,
+    std::shared_ptr<Peer> const& peer)
+{
+    if (peer)
+    {
+        std::lock_guard sl(mPeerWindowsLock);
+        mPeerWindows[peer->id()].onRequest(m_clock.now());
+    }
+
+    mPeerSet->sendRequest(tmGL, peer);
+}
+
+/** Ask for nodes, at most perRequest of them in each request
+ */
+void
+InboundLedger::sendNodeRequests(
+    protocol::TMGetLedger& tmGL,
+    std::vector<std::pair<SHAMapNodeID, uint256>> const& nodes,
+    std::size_t perRequest,
+    std::shared_ptr<Peer> const& peer)
+{
+    for (std::size_t i = 0; i < nodes.size(); i += perRequest)
+    {
+        tmGL.clear_nodeids();
+        auto const last = std::min(nodes.size(), i + perRequest);
+        for (auto j = i; j < last; ++j)
+            *(tmGL.add_nodeids()) = nodes[j].first.getRawString();
+        sendRequest(tmGL, peer);
+    }
+}
+
 void
 InboundLedger::filterNodes(
     std::vector<std::pair<SHAMapNodeID, uint256>>& nodes,
-    TriggerReason reason)
+    TriggerReason reason,
+    std::size_t limit)
 {
     // Sort nodes so that the ones we haven't recently
     // requested come before the ones we have.
@@ -856,9 +943,6 @@ InboundLedger::filterNodes(
         nodes.erase(dup, nodes.end());
     }
 
-    std::size_t const limit =
-        (reason == TriggerReason::reply) ? reqNodesReply : reqNodes;
-
     if (nodes.size() > limit)
         nodes.resize(limit);
 
@@ -960,6 +1044,9 @@ InboundLedger::receiveNode(protocol::TMLedgerData& packet, SHAMapAddNode& san)
     {
         auto const f = filter.get();
 
+        std::vector<std::pair<SHAMapNodeID, Slice>> nodes;
+        nodes.reserve(packet.nodes().size());
+
         for (auto const& node : packet.nodes())
         {
             auto const nodeID = deserializeSHAMapNodeID(node.nodeid());
@@ -970,17 +1057,27 @@ InboundLedger::receiveNode(protocol::TMLedgerData& packet, SHAMapAddNode& san)
             if (nodeID->isRoot())
             {
                 san += map.addRootNode(rootHash, makeSlice(node.nodedata()), f);
+
+                if (!san.isGood())
+                {
+                    JLOG(journal_.warn()) << "Received bad node data";
+                    return;
+                }
             }
             else
             {
-                san += map.addKnownNode(*nodeID, makeSlice(node.nodedata()), f);
+                nodes.emplace_back(*nodeID, makeSlice(node.nodedata()));
             }
+        }
 
-            if (!san.isGood())
-            {
-                JLOG(journal_.warn()) << "Received bad node data";
-                return;
-            }
+        // Nodes in different branches of the root are verified and hooked
+        // into the map in parallel.
+        san += map.addKnownNodes(nodes, f, app_.config().LEDGER_FETCH_THREADS);
+
+        if (!san.isGood())
+        {
+            JLOG(journal_.warn()) << "Received bad node data";
+            return;
         }
     }
     catch (std::exception const& e)
@@ -1100,6 +1197,14 @@ InboundLedger::gotData(
     std::weak_ptr<Peer> peer,
     std::shared_ptr<protocol::TMLedgerData> const& data)
 {
+    if (auto const p = peer.lock())
+    {
+        // Time the reply as it arrives rather than when it is processed
+        std::lock_guard sl(mPeerWindowsLock);
+        mPeerWindows[p->id()].onReply(
+            m_clock.now(), Message::totalSize(*data), data->nodes_size());
+    }
+
     std::lock_guard sl(mReceivedDataLock);
 
     if (isDone())
@@ -1349,6 +1454,20 @@ InboundLedger::runData()
     });
 }
 
+static Json::Value
+scanJson(SHAMap::ScanProgress const& progress)
+{
+    Json::Value ret(Json::objectValue);
+    ret[jss::scans] = std::to_string(progress.scans);
+    ret[jss::running] = progress.running != 0;
+    ret[jss::inner_nodes] = std::to_string(progress.innerNodes);
+    ret[jss::reads] = std::to_string(progress.reads);
+    ret[jss::reads_done] = std::to_string(progress.readsDone);
+    ret[jss::missing] = std::to_string(progress.missing);
+    ret[jss::duration_us] = std::to_string(progress.duration);
+    return ret;
+}
+
 Json::Value
 InboundLedger::getJson(int)
 {
@@ -1367,6 +1486,30 @@ InboundLedger::getJson(int)
     if (!complete_ && !failed_)
         ret[jss::peers] = static_cast<int>(mPeerSet->getPeerIds().size());
 
+    {
+        std::lock_guard wl(mPeerWindowsLock);
+        if (!mPeerWindows.empty())
+        {
+            Json::Value& stats = ret[jss::peer_stats] = Json::arrayValue;
+            for (auto const& [id, window] : mPeerWindows)
+            {
+                Json::Value& ps = stats.append(Json::objectValue);
+                ps[jss::peer_id] = id;
+                ps[jss::bytes] = std::to_string(window.bytes());
+                ps[jss::nodes] = std::to_string(window.nodes());
+                ps[jss::bytes_per_second] =
+                    static_cast<Json::UInt>(window.bytesPerSecond());
+                ps[jss::nodes_per_second] =
+                    static_cast<Json::UInt>(window.nodesPerSecond());
+                ps[jss::outstanding] =
+                    static_cast<Json::UInt>(window.outstanding());
+                ps[jss::window] = static_cast<Json::UInt>(window.window());
+                if (auto const rtt = window.rtt())
+                    ps[jss::rtt] = static_cast<Json::UInt>(rtt->count());
+            }
+        }
+    }
+
     ret[jss::have_header] = mHaveHeader;
 
     if (mHaveHeader)
@@ -1377,6 +1520,14 @@ InboundLedger::getJson(int)
 
     ret[jss::timeouts] = timeouts_;
 
+    // Searches for missing nodes run without the lock, so a search under
+    // way shows how far it has got.
+    if (mStateScan.scans != 0)
+        ret[jss::state_scan] = scanJson(mStateScan);
+
+    if (mTxScan.scans != 0)
+        ret[jss::transaction_scan] = scanJson(mTxScan);
+
     if (mHaveHeader && !mHaveState)
     {
         Json::Value hv(Json::arrayValue);
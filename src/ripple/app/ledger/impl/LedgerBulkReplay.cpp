@@ -0,0 +1,277 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/BuildLedger.h>
+#include <ripple/app/ledger/Ledger.h>
+#include <ripple/app/ledger/LedgerBulkReplay.h>
+#include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/app/ledger/LedgerReplay.h>
+#include <ripple/app/main/Application.h>
+#include <ripple/basics/scope.h>
+#include <ripple/ledger/CachedSLEs.h>
+#include <ripple/nodestore/Database.h>
+#include <ripple/shamap/Family.h>
+#include <ripple/protocol/jss.h>
+#include <algorithm>
+#include <cassert>
+#include <thread>
+
+namespace ripple {
+
+LedgerBulkReplay::LedgerBulkReplay(
+    Application& app,
+    std::uint32_t first,
+    std::uint32_t last,
+    std::size_t ahead,
+    beast::Journal j,
+    std::uint32_t sweepInterval)
+    : app_(app)
+    , first_(first)
+    , last_(last)
+    , ahead_(std::max<std::size_t>(ahead, 1))
+    , j_(j)
+    , sweepInterval_(std::max<std::uint32_t>(sweepInterval, 1))
+    , next_(first)
+    , applying_(first)
+{
+    assert(first > 1 && first <= last);
+}
+
+// Read the ledgers ahead of the one being applied, until there are none
+// left to read.
+void
+LedgerBulkReplay::fetch()
+{
+    std::unique_lock lock(mutex_);
+    while (true)
+    {
+        cond_.wait(lock, [this] {
+            return stopping_ || next_ > last_ || next_ < applying_ + ahead_;
+        });
+
+        if (stopping_ || next_ > last_)
+            return;
+
+        auto const seq = next_++;
+        lock.unlock();
+        auto fetched = fetch(seq);
+        lock.lock();
+
+        fetched_.emplace(seq, std::move(fetched));
+        cond_.notify_all();
+    }
+}
+
+LedgerBulkReplay::Fetched
+LedgerBulkReplay::fetch(std::uint32_t seq)
+{
+    Fetched ret;
+    try
+    {
+        auto ledger = app_.getLedgerMaster().getLedgerBySeq(seq);
+        if (!ledger)
+            return ret;
+
+        // As LedgerReplay does, but here rather than on the thread which
+        // applies the transactions
+        for (auto const& item : ledger->txMap())
+        {
+            auto txPair = ledger->txRead(item.key());
+            auto const txIndex = (*txPair.second)[sfTransactionIndex];
+            ret.txns.emplace(txIndex, std::move(txPair.first));
+        }
+
+        ret.ledger = std::move(ledger);
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(j_.error()) << "Reading ledger " << seq << ": " << e.what();
+        ret.txns.clear();
+    }
+    return ret;
+}
+
+// As Application's sweep timer would, for the caches a replay fills
+void
+LedgerBulkReplay::sweep()
+{
+    app_.getLedgerMaster().sweep();
+    app_.getNodeFamily().sweep();
+    app_.getNodeStore().sweep();
+    app_.cachedSLEs().sweep();
+    ++sweeps_;
+}
+
+bool
+LedgerBulkReplay::run()
+{
+    using namespace std::chrono;
+
+    auto const start = clock_type::now();
+    scope_exit recordElapsed([&] {
+        elapsed_ = duration_cast<microseconds>(clock_type::now() - start);
+    });
+
+    std::shared_ptr<Ledger const> parent =
+        app_.getLedgerMaster().getLedgerBySeq(first_ - 1);
+    if (!parent)
+    {
+        JLOG(j_.error()) << "Ledger " << first_ - 1 << " is not available";
+        return false;
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve(ahead_);
+    scope_exit join([&] {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        cond_.notify_all();
+        for (auto& worker : workers)
+            worker.join();
+    });
+    for (std::size_t i = 0; i < ahead_; ++i)
+        workers.emplace_back([this] { fetch(); });
+
+    for (auto seq = first_; seq <= last_; ++seq)
+    {
+        auto const waitStart = clock_type::now();
+        Fetched fetched;
+        {
+            std::unique_lock lock(mutex_);
+            applying_ = seq;
+            cond_.notify_all();
+            cond_.wait(lock, [&] { return fetched_.count(seq) != 0; });
+
+            auto const it = fetched_.find(seq);
+            fetched = std::move(it->second);
+            fetched_.erase(it);
+        }
+        auto const wait =
+            duration_cast<microseconds>(clock_type::now() - waitStart);
+
+        auto const& stored = fetched.ledger;
+        if (!stored)
+        {
+            JLOG(j_.error()) << "Ledger " << seq << " is not available";
+            return false;
+        }
+
+        if (stored->info().parentHash != parent->info().hash)
+        {
+            JLOG(j_.error()) << "Ledger " << seq << " does not follow ledger "
+                             << parent->info().seq;
+            return false;
+        }
+
+        auto const transactions = fetched.txns.size();
+        auto const applyStart = clock_type::now();
+        LedgerReplay replayData(parent, stored, std::move(fetched.txns));
+        auto const built = buildLedger(replayData, tapNONE, app_, j_);
+        auto const apply =
+            duration_cast<microseconds>(clock_type::now() - applyStart);
+
+        bool const matched =
+            built->info().accountHash == stored->info().accountHash;
+
+        if (!matched)
+        {
+            JLOG(j_.error()) << "Ledger " << seq << ": state "
+                             << built->info().accountHash
+                             << " does not match "
+                             << stored->info().accountHash;
+        }
+        else if (built->info().hash != stored->info().hash)
+        {
+            JLOG(j_.warn()) << "Ledger " << seq << ": state matches, but "
+                            << built->info().hash << " does not match "
+                            << stored->info().hash;
+        }
+        else
+        {
+            JLOG(j_.info()) << "Ledger " << seq << ": " << transactions
+                            << " transactions in " << apply.count() << "us";
+        }
+
+        // Carry on from the stored ledger, so that one difference does not
+        // make every later ledger differ too
+        if (built->info().hash == stored->info().hash)
+            parent = built;
+        else
+            parent = stored;
+
+        results_.push_back({seq, transactions, wait, apply, matched});
+
+        if (results_.size() % sweepInterval_ == 0)
+        {
+            JLOG(j_.debug()) << "Sweeping caches after ledger " << seq;
+            sweep();
+        }
+    }
+
+    return true;
+}
+
+std::size_t
+LedgerBulkReplay::mismatches() const
+{
+    return std::count_if(
+        results_.begin(), results_.end(), [](Result const& r) {
+            return !r.matched;
+        });
+}
+
+Json::Value
+LedgerBulkReplay::getJson() const
+{
+    Json::Value ret(Json::objectValue);
+    ret[jss::ledger_min] = first_;
+    ret[jss::ledger_max] = last_;
+    ret[jss::duration_us] = std::to_string(elapsed_.count());
+
+    std::chrono::microseconds wait{0};
+    std::chrono::microseconds apply{0};
+    std::size_t transactions = 0;
+
+    Json::Value& ledgers = (ret[jss::ledgers] = Json::arrayValue);
+    Json::Value& mismatched = (ret[jss::mismatches] = Json::arrayValue);
+    for (auto const& r : results_)
+    {
+        Json::Value& entry = ledgers.append(Json::objectValue);
+        entry[jss::ledger_index] = r.seq;
+        entry[jss::transactions] = static_cast<Json::UInt>(r.transactions);
+        entry[jss::wait_us] = std::to_string(r.wait.count());
+        entry[jss::apply_us] = std::to_string(r.apply.count());
+
+        if (!r.matched)
+            mismatched.append(r.seq);
+
+        wait += r.wait;
+        apply += r.apply;
+        transactions += r.transactions;
+    }
+
+    ret[jss::transactions] = std::to_string(transactions);
+    ret[jss::wait_us] = std::to_string(wait.count());
+    ret[jss::apply_us] = std::to_string(apply.count());
+    return ret;
+}
+
+}  // namespace ripple
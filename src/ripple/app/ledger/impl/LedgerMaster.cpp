@@ -1868,6 +1868,12 @@ LedgerMaster::getLedgerByHash(uint256 const& hash)
     return {};
 }
 
+std::shared_ptr<Json::Value const>
+LedgerMaster::getBookChanges(std::shared_ptr<ReadView const> const& ledger)
+{
+    return mLedgerHistory.getBookChanges(ledger);
+}
+
 void
 LedgerMaster::setLedgerRangePresent(std::uint32_t minV, std::uint32_t maxV)
 {
@@ -1888,6 +1894,12 @@ LedgerMaster::getCacheHitRate()
     return mLedgerHistory.getCacheHitRate();
 }
 
+Json::Value
+LedgerMaster::getRetainedLedgersJson() const
+{
+    return mLedgerHistory.getRetainedJson();
+}
+
 void
 LedgerMaster::clearPriorLedgers(LedgerIndex seq)
 {
@@ -106,18 +106,15 @@ fillJsonBinary(Object& json, bool closed, LedgerInfo const& info)
     }
 }
 
-Json::Value
+template <class Object>
+void
 fillJsonTx(
+    Object& txJson,
     LedgerFill const& fill,
     bool bBinary,
-    bool bExpanded,
     std::shared_ptr<STTx const> const& txn,
     std::shared_ptr<STObject const> const& stMeta)
 {
-    if (!bExpanded)
-        return to_string(txn->getTransactionID());
-
-    Json::Value txJson{Json::objectValue};
     auto const txnType = txn->getTxnType();
     if (bBinary)
     {
@@ -130,15 +127,16 @@ fillJsonTx(
         copyFrom(txJson, txn->getJson(JsonOptions::none));
         if (stMeta)
         {
-            txJson[jss::metaData] = stMeta->getJson(JsonOptions::none);
+            Json::Value metaData = stMeta->getJson(JsonOptions::none);
             if (txnType == ttPAYMENT || txnType == ttCHECK_CASH)
             {
                 // Insert delivered amount
                 auto txMeta = std::make_shared<TxMeta>(
                     txn->getTransactionID(), fill.ledger.seq(), *stMeta);
                 RPC::insertDeliveredAmount(
-                    txJson[jss::metaData], fill.ledger, txn, *txMeta);
+                    metaData, fill.ledger, txn, *txMeta);
             }
+            txJson[jss::metaData] = std::move(metaData);
         }
     }
 
@@ -161,7 +159,21 @@ fillJsonTx(
             txJson[jss::owner_funds] = ownerFunds.getText();
         }
     }
+}
+
+Json::Value
+fillJsonTx(
+    LedgerFill const& fill,
+    bool bBinary,
+    bool bExpanded,
+    std::shared_ptr<STTx const> const& txn,
+    std::shared_ptr<STObject const> const& stMeta)
+{
+    if (!bExpanded)
+        return to_string(txn->getTransactionID());
 
+    Json::Value txJson{Json::objectValue};
+    fillJsonTx(txJson, fill, bBinary, txn, stMeta);
     return txJson;
 }
 
@@ -178,8 +190,15 @@ fillJsonTx(Object& json, LedgerFill const& fill)
         auto appendAll = [&](auto const& txs) {
             for (auto& i : txs)
             {
-                txns.append(
-                    fillJsonTx(fill, bBinary, bExpanded, i.first, i.second));
+                if (!bExpanded)
+                {
+                    txns.append(to_string(i.first->getTransactionID()));
+                }
+                else
+                {
+                    auto&& txJson = appendObject(txns);
+                    fillJsonTx(txJson, fill, bBinary, i.first, i.second);
+                }
             }
         };
 
@@ -280,16 +299,39 @@ fillJson(Object& json, LedgerFill const& fill)
         fillJsonState(json, fill);
 }
 
+template <class Object>
+void
+addJsonLedger(Object& json, LedgerFill const& fill)
+{
+    {
+        // A streaming object must be closed before its parent is written
+        // to again.
+        auto&& object = Json::addObject(json, jss::ledger);
+        fillJson(object, fill);
+    }
+
+    if ((fill.options & LedgerFill::dumpQueue) && !fill.txQueue.empty())
+        fillJsonQueue(json, fill);
+}
+
 }  // namespace
 
 void
 addJson(Json::Value& json, LedgerFill const& fill)
 {
-    auto&& object = Json::addObject(json, jss::ledger);
-    fillJson(object, fill);
+    addJsonLedger(json, fill);
+}
 
-    if ((fill.options & LedgerFill::dumpQueue) && !fill.txQueue.empty())
-        fillJsonQueue(json, fill);
+void
+addJson(Json::Document::Node& json, LedgerFill const& fill)
+{
+    addJsonLedger(json, fill);
+}
+
+void
+addJson(Json::Object& json, LedgerFill const& fill)
+{
+    addJsonLedger(json, fill);
 }
 
 Json::Value
@@ -62,6 +62,7 @@ OpenLedger::current_unsafe() const
 bool
 OpenLedger::modify(modify_type const& f)
 {
+    CachedSLEs::Scope const scope(CachedSLEs::Caller::transaction);
     std::lock_guard lock1(modify_mutex_);
     auto next = std::make_shared<OpenView>(*current_);
     auto const changed = f(*next, j_);
@@ -86,6 +87,7 @@ OpenLedger::accept(
     modify_type const& f)
 {
     JLOG(j_.trace()) << "accept ledger " << ledger->seq() << " " << suffix;
+    CachedSLEs::Scope const scope(CachedSLEs::Caller::transaction);
     auto next = create(rules, ledger);
     if (retriesFirst)
     {
@@ -136,9 +138,7 @@ OpenLedger::accept(
         {
             JLOG(j_.debug()) << "Relaying recovered tx " << txId;
             protocol::TMTransaction msg;
-            Serializer s;
-
-            tx->add(s);
+            auto const s = tx->getSerialized();
             msg.set_rawtransaction(s.data(), s.size());
             msg.set_status(protocol::tsNEW);
             msg.set_receivetimestamp(
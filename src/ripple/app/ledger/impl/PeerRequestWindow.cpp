@@ -0,0 +1,133 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/impl/PeerRequestWindow.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace ripple {
+
+namespace {
+
+double
+seconds(PeerRequestWindow::clock_type::duration d)
+{
+    return std::chrono::duration<double>(d).count();
+}
+
+// Exponentially weighted moving average, with a weight of 1/8 for the
+// newest sample
+void
+smooth(std::optional<double>& average, double sample)
+{
+    average = average ? (7 * *average + sample) / 8 : sample;
+}
+
+}  // namespace
+
+std::size_t
+PeerRequestWindow::available() const
+{
+    return window_ > sent_.size() ? window_ - sent_.size() : 0;
+}
+
+void
+PeerRequestWindow::onRequest(time_point now)
+{
+    if (!first_)
+        first_ = now;
+    sent_.push_back(now);
+}
+
+void
+PeerRequestWindow::onReply(time_point now, std::size_t bytes, std::size_t nodes)
+{
+    bytes_ += bytes;
+    nodes_ += nodes;
+
+    if (sent_.empty())
+        return;
+
+    auto const sent = sent_.front();
+    sent_.pop_front();
+
+    auto const rtt = seconds(now - sent);
+    smooth(srtt_, rtt);
+    minRtt_ = minRtt_ ? std::min(*minRtt_, rtt) : rtt;
+
+    // The time this peer took to deliver the reply: since its previous
+    // reply if it was already busy with this request, else since the
+    // request was sent.
+    auto const from = lastReply_ ? std::max(*lastReply_, sent) : sent;
+    smooth(interval_, seconds(now - from));
+    lastReply_ = now;
+
+    auto target = window_ + 1;
+    if (*interval_ > 0)
+        target = static_cast<std::size_t>(std::ceil(*minRtt_ / *interval_)) + 1;
+
+    window_ = std::clamp(target, minWindow, std::min(maxWindow, window_ + 1));
+}
+
+std::size_t
+PeerRequestWindow::expire(time_point now, clock_type::duration age)
+{
+    std::size_t count = 0;
+    while (!sent_.empty() && now - sent_.front() >= age)
+    {
+        sent_.pop_front();
+        ++count;
+    }
+
+    if (count != 0)
+        window_ = std::max(minWindow, window_ / 2);
+
+    return count;
+}
+
+std::optional<std::chrono::milliseconds>
+PeerRequestWindow::rtt() const
+{
+    if (!srtt_)
+        return std::nullopt;
+    return std::chrono::milliseconds{std::lround(*srtt_ * 1000)};
+}
+
+double
+PeerRequestWindow::perSecond(std::uint64_t count) const
+{
+    if (!first_ || !lastReply_ || *lastReply_ <= *first_)
+        return 0;
+    return count / seconds(*lastReply_ - *first_);
+}
+
+double
+PeerRequestWindow::bytesPerSecond() const
+{
+    return perSecond(bytes_);
+}
+
+double
+PeerRequestWindow::nodesPerSecond() const
+{
+    return perSecond(nodes_);
+}
+
+}  // namespace ripple
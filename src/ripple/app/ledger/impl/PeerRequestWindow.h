@@ -0,0 +1,147 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_LEDGER_PEERREQUESTWINDOW_H_INCLUDED
+#define RIPPLE_APP_LEDGER_PEERREQUESTWINDOW_H_INCLUDED
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <optional>
+
+namespace ripple {
+
+/** The requests for ledger nodes in flight to one peer.
+
+    Rather than wait for each reply before asking again, an acquisition may
+    keep several requests outstanding with a peer. The window is the number
+    allowed at once. It is sized from the peer's replies, to cover the
+    replies the peer can deliver in one round trip:
+
+        window = ceil(minimum round trip / interval between replies) + 1
+
+    While the pipe is not full, replies arrive one round trip apart and the
+    window grows by one with each. Once the peer delivers as fast as it can,
+    the interval stops shrinking and the window settles. The minimum round
+    trip is used because a queue at the peer lengthens the observed one.
+
+    Requests which go unanswered for too long are forgotten and the window
+    is halved.
+
+    Replies are matched to requests in the order they were sent. This is
+    only used for timing, so a reply which arrives out of order does no
+    harm.
+*/
+class PeerRequestWindow
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+    using time_point = clock_type::time_point;
+
+    /** The fewest requests a peer may have in flight. */
+    static constexpr std::size_t minWindow = 1;
+
+    /** The most requests a peer may have in flight. */
+    static constexpr std::size_t maxWindow = 16;
+
+    /** The number of further requests which may be sent now. */
+    std::size_t
+    available() const;
+
+    /** Record a request sent at `now`. */
+    void
+    onRequest(time_point now);
+
+    /** Record a reply carrying `bytes` bytes and `nodes` nodes.
+
+        A reply which matches no outstanding request is counted but does
+        not change the window.
+    */
+    void
+    onReply(time_point now, std::size_t bytes, std::size_t nodes);
+
+    /** Forget the requests sent `age` or longer before `now`.
+
+        @return The number of requests forgotten.
+    */
+    std::size_t
+    expire(time_point now, clock_type::duration age);
+
+    std::size_t
+    window() const
+    {
+        return window_;
+    }
+
+    std::size_t
+    outstanding() const
+    {
+        return sent_.size();
+    }
+
+    /** The smoothed round trip time, if it has been measured. */
+    std::optional<std::chrono::milliseconds>
+    rtt() const;
+
+    std::uint64_t
+    bytes() const
+    {
+        return bytes_;
+    }
+
+    std::uint64_t
+    nodes() const
+    {
+        return nodes_;
+    }
+
+    /** The bytes received per second, between the first request and the
+        latest reply. */
+    double
+    bytesPerSecond() const;
+
+    /** The nodes received per second, between the first request and the
+        latest reply. */
+    double
+    nodesPerSecond() const;
+
+private:
+    double
+    perSecond(std::uint64_t count) const;
+
+    std::size_t window_ = minWindow;
+
+    // The time each outstanding request was sent, oldest first
+    std::deque<time_point> sent_;
+
+    std::optional<time_point> first_;
+    std::optional<time_point> lastReply_;
+
+    // Round trip and reply interval estimates, in seconds
+    std::optional<double> srtt_;
+    std::optional<double> minRtt_;
+    std::optional<double> interval_;
+
+    std::uint64_t bytes_ = 0;
+    std::uint64_t nodes_ = 0;
+};
+
+}  // namespace ripple
+
+#endif
@@ -37,6 +37,7 @@
 #include <ripple/app/main/NodeStoreScheduler.h>
 #include <ripple/app/main/Tuning.h>
 #include <ripple/app/misc/AmendmentTable.h>
+#include <ripple/app/misc/CacheSnapshot.h>
 #include <ripple/app/misc/HashRouter.h>
 #include <ripple/app/misc/LoadFeeTrack.h>
 #include <ripple/app/misc/NetworkOPs.h>
@@ -193,6 +194,7 @@ public:
     std::unique_ptr<NodeStore::Database> m_nodeStore;
     NodeFamily nodeFamily_;
     std::unique_ptr<NodeStore::DatabaseShard> shardStore_;
+    std::unique_ptr<CacheSnapshot> cacheSnapshot_;
     std::unique_ptr<ShardFamily> shardFamily_;
     std::unique_ptr<RPC::ShardArchiveHandler> shardArchiveHandler_;
     // VFALCO TODO Make OrderBookDB abstract
@@ -342,13 +344,6 @@ public:
               stopwatch(),
               logs_->journal("TaggedCache"))
 
-        , cachedSLEs_(
-              "Cached SLEs",
-              0,
-              std::chrono::minutes(1),
-              stopwatch(),
-              logs_->journal("CachedSLEs"))
-
         , validatorKeys_(*config_, m_journal)
 
         , m_resourceManager(Resource::make_Manager(
@@ -783,6 +778,12 @@ public:
         return cachedSLEs_;
     }
 
+    CacheSnapshot*
+    getCacheSnapshot() override
+    {
+        return cacheSnapshot_.get();
+    }
+
     AmendmentTable&
     getAmendmentTable() override
     {
@@ -1229,6 +1230,15 @@ ApplicationImp::setup(boost::program_options::variables_map const& cmdline)
 
     Pathfinder::initPathTable();
 
+    if (!config_->CACHE_SNAPSHOT_PATH.empty() && !config_->reporting())
+    {
+        cacheSnapshot_ = std::make_unique<CacheSnapshot>(
+            config_->CACHE_SNAPSHOT_PATH,
+            config_->CACHE_SNAPSHOT_DATA,
+            logs_->journal("CacheSnapshot"));
+        cacheSnapshot_->warm(nodeFamily_, cachedSLEs_, *m_nodeStore);
+    }
+
     auto const startUp = config_->START_UP;
     JLOG(m_journal.debug()) << "startUp: " << startUp;
     if (!config_->reporting())
@@ -1646,6 +1656,8 @@ ApplicationImp::run()
         reportingETL_->stop();
     if (auto pg = dynamic_cast<PostgresDatabase*>(&*mRelationalDatabase))
         pg->stop();
+    if (cacheSnapshot_)
+        cacheSnapshot_->save(nodeFamily_, cachedSLEs_, *m_nodeStore);
     m_nodeStore->stop();
     perfLog_->stop();
 
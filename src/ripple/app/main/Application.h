@@ -64,8 +64,9 @@ template <
 class TaggedCache;
 class STLedgerEntry;
 using SLE = STLedgerEntry;
-using CachedSLEs = TaggedCache<uint256, SLE const>;
+class CachedSLEs;
 
+class CacheSnapshot;
 class CollectorManager;
 class Family;
 class HashRouter;
@@ -181,6 +182,9 @@ public:
     getTempNodeCache() = 0;
     virtual CachedSLEs&
     cachedSLEs() = 0;
+    /** The snapshot of the caches kept across restarts, if configured. */
+    virtual CacheSnapshot*
+    getCacheSnapshot() = 0;
     virtual AmendmentTable&
     getAmendmentTable() = 0;
     virtual HashRouter&
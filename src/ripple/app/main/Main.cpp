@@ -16,14 +16,17 @@
     OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 //==============================================================================
+#include <ripple/app/ledger/LedgerBulkReplay.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/main/DBInit.h>
+#include <ripple/app/rdb/AccountTxIndex.h>
 #include <ripple/app/rdb/Vacuum.h>
 #include <ripple/basics/Log.h>
 #include <ripple/basics/StringUtilities.h>
 #include <ripple/basics/contract.h>
 #include <ripple/beast/clock/basic_seconds_clock.h>
 #include <ripple/beast/core/CurrentThreadName.h>
+#include <ripple/beast/core/LexicalCast.h>
 #include <ripple/core/Config.h>
 #include <ripple/core/ConfigSections.h>
 #include <ripple/core/TimeKeeper.h>
@@ -47,6 +50,7 @@
 
 #include <cstdlib>
 #include <iostream>
+#include <limits>
 #include <stdexcept>
 #include <utility>
 
@@ -392,9 +396,21 @@ run(int argc, char** argv)
         po::value<std::string>(),
         "Load the specified ledger file.")(
         "load", "Load the current ledger from the local DB.")(
+        "migrate_account_tx",
+        "Copy the AccountTransactions table into the account_tx_index.")(
         "net", "Get the initial ledger from the network.")(
         "nodetoshard", "Import node store into shards")(
         "replay", "Replay a ledger close.")(
+        "replay_ahead",
+        po::value<std::size_t>(),
+        "With --replay_count, the number of ledgers to read ahead of the one "
+        "being replayed. Default 8.")(
+        "replay_count",
+        po::value<std::uint32_t>(),
+        "With --ledger and --replay, replay this many ledgers from local "
+        "history, starting with the one given, without publishing them or "
+        "writing them to the databases. Compare the state of each with the "
+        "stored ledger, report the results and exit.")(
         "start", "Start from a fresh Ledger.")(
         "startReporting",
         po::value<std::string>(),
@@ -604,6 +620,31 @@ run(int argc, char** argv)
         return 0;
     }
 
+    if (vm.count("migrate_account_tx"))
+    {
+        if (config->standalone())
+        {
+            std::cerr << "migrate_account_tx not applicable in standalone "
+                         "mode.\n";
+            return -1;
+        }
+
+        try
+        {
+            auto setup = setup_DatabaseCon(*config);
+            if (!doMigrateAccountTxDB(*config, setup))
+                return -1;
+        }
+        catch (std::exception const& e)
+        {
+            std::cerr << "exception " << e.what() << " in function " << __func__
+                      << std::endl;
+            return -1;
+        }
+
+        return 0;
+    }
+
     if (vm.count("start"))
     {
         config->START_UP = Config::FRESH;
@@ -629,7 +670,13 @@ run(int argc, char** argv)
     if (vm.count("ledger"))
     {
         config->START_LEDGER = vm["ledger"].as<std::string>();
-        if (vm.count("replay"))
+        if (vm.count("replay_count"))
+        {
+            // LedgerBulkReplay reads the ledgers itself, once the server is
+            // set up, so start from a genesis ledger which is never used.
+            config->START_UP = Config::NORMAL;
+        }
+        else if (vm.count("replay"))
             config->START_UP = Config::REPLAY;
         else
             config->START_UP = Config::LOAD;
@@ -644,10 +691,32 @@ run(int argc, char** argv)
         config->START_UP = Config::LOAD;
     }
 
+    std::uint32_t replayFirst = 0;
+    if (vm.count("replay_count"))
+    {
+        if (!vm.count("ledger") || !vm.count("replay") ||
+            !beast::lexicalCastChecked(replayFirst, config->START_LEDGER) ||
+            replayFirst < 2)
+        {
+            std::cerr << "replay_count requires --replay and the sequence "
+                         "number of a ledger after the first with --ledger"
+                      << std::endl;
+            return -1;
+        }
+
+        if (vm["replay_count"].as<std::uint32_t>() == 0 ||
+            vm["replay_count"].as<std::uint32_t>() >
+                std::numeric_limits<std::uint32_t>::max() - replayFirst)
+        {
+            std::cerr << "Invalid replay_count" << std::endl;
+            return -1;
+        }
+    }
+
     if (vm.count("net") && !config->FAST_LOAD)
     {
         if ((config->START_UP == Config::LOAD) ||
-            (config->START_UP == Config::REPLAY))
+            (config->START_UP == Config::REPLAY) || vm.count("replay_count"))
         {
             std::cerr << "Net and load/replay options are incompatible"
                       << std::endl;
@@ -762,6 +831,26 @@ run(int argc, char** argv)
         if (!app->setup(vm))
             return -1;
 
+        if (vm.count("replay_count"))
+        {
+            // Replay the ledgers instead of starting the server
+            LedgerBulkReplay replay(
+                *app,
+                replayFirst,
+                replayFirst + vm["replay_count"].as<std::uint32_t>() - 1,
+                vm.count("replay_ahead") ? vm["replay_ahead"].as<std::size_t>()
+                                         : 8,
+                app->journal("LedgerBulkReplay"));
+
+            bool const complete = replay.run();
+            std::cout << replay.getJson().toStyledString();
+
+            app->signalStop();
+            app->run();
+
+            return (complete && replay.mismatches() == 0) ? 0 : -1;
+        }
+
         // With our configuration parsed, ensure we have
         // enough file descriptors available:
         if (!adjustDescriptorLimit(
@@ -0,0 +1,121 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_MISC_CACHESNAPSHOT_H_INCLUDED
+#define RIPPLE_APP_MISC_CACHESNAPSHOT_H_INCLUDED
+
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/json/json_value.h>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace ripple {
+
+namespace NodeStore {
+class Database;
+}
+
+class CachedSLEs;
+class Family;
+
+/** Keeps the caches of a server warm across a restart.
+
+    On a clean shutdown, the hashes of the entries in the tree node cache,
+    the full below cache and the cache of ledger entries are written to a
+    file, optionally with the nodes themselves. On startup the file is read
+    and removed, and the caches are filled again before the server joins
+    the network: the nodes whose bytes the file holds are checked against
+    their hashes, and the others are read from the node store, many at a
+    time, with Database::asyncFetch.
+
+    An entry of the full below cache says that every node below it is in
+    the node store, which is only known to be true of the store the
+    snapshot was taken of. Those entries are restored only if the store has
+    the same name, and only for nodes which were found.
+*/
+class CacheSnapshot
+{
+public:
+    /** What warming the caches achieved. */
+    struct Stats
+    {
+        // Entries listed in the snapshot
+        std::size_t entries = 0;
+
+        // Tree nodes, full below entries and ledger entries restored
+        std::size_t treeNodes = 0;
+        std::size_t fullBelow = 0;
+        std::size_t ledgerEntries = 0;
+
+        // Nodes whose bytes were taken from the snapshot
+        std::size_t fromSnapshot = 0;
+
+        // Nodes which could not be found, or did not match their hash
+        std::size_t missing = 0;
+
+        std::chrono::milliseconds duration{0};
+    };
+
+    /** @param path The file to write the snapshot to and read it from
+        @param withData Whether the snapshot holds the nodes themselves
+    */
+    CacheSnapshot(std::string path, bool withData, beast::Journal j);
+
+    CacheSnapshot(CacheSnapshot const&) = delete;
+    CacheSnapshot&
+    operator=(CacheSnapshot const&) = delete;
+
+    /** Write the entries of the caches to the snapshot.
+
+        @return `false` if the snapshot could not be written.
+    */
+    bool
+    save(
+        Family& family,
+        CachedSLEs const& cachedSLEs,
+        NodeStore::Database const& db) const;
+
+    /** Fill the caches from the snapshot, if there is one, and remove it.
+
+        Returns once every node has been read.
+    */
+    void
+    warm(Family& family, CachedSLEs& cachedSLEs, NodeStore::Database& db);
+
+    Stats
+    stats() const;
+
+    /** What warming the caches achieved, for server_info. */
+    Json::Value
+    getJson() const;
+
+private:
+    std::string const path_;
+    bool const withData_;
+    beast::Journal const j_;
+
+    mutable std::mutex mutex_;
+    Stats stats_;
+};
+
+}  // namespace ripple
+
+#endif
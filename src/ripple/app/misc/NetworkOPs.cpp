@@ -30,6 +30,7 @@
 #include <ripple/app/ledger/TransactionMaster.h>
 #include <ripple/app/main/LoadManager.h>
 #include <ripple/app/misc/AmendmentTable.h>
+#include <ripple/app/misc/CacheSnapshot.h>
 #include <ripple/app/misc/HashRouter.h>
 #include <ripple/app/misc/LoadFeeTrack.h>
 #include <ripple/app/misc/NetworkOPs.h>
@@ -53,6 +54,7 @@
 #include <ripple/crypto/RFC1751.h>
 #include <ripple/crypto/csprng.h>
 #include <ripple/json/to_string.h>
+#include <ripple/ledger/CachedSLEs.h>
 #include <ripple/net/RPCErr.h>
 #include <ripple/nodestore/DatabaseShard.h>
 #include <ripple/overlay/Cluster.h>
@@ -63,16 +65,19 @@
 #include <ripple/protocol/STParsedJSON.h>
 #include <ripple/resource/Fees.h>
 #include <ripple/resource/ResourceManager.h>
-#include <ripple/rpc/BookChanges.h>
+#include <ripple/rpc/BinaryEncoding.h>
 #include <ripple/rpc/CTID.h>
 #include <ripple/rpc/DeliveredAmount.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
+#include <ripple/shamap/Family.h>
 #include <boost/asio/ip/host_name.hpp>
 #include <boost/asio/steady_timer.hpp>
 
+#include <array>
 #include <exception>
 #include <mutex>
 #include <set>
+#include <shared_mutex>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -563,6 +568,8 @@ public:
     addRpcSub(std::string const& strUrl, InfoSub::ref) override;
     bool
     tryRemoveRpcSub(std::string const& strUrl) override;
+    void
+    removeRpcSub(std::string const& strUrl, InfoSub const& sub) override;
 
     void
     stop() override
@@ -626,6 +633,19 @@ private:
         bool validated,
         std::shared_ptr<ReadView const> const& ledger);
 
+    /** Build one encoding of a transaction stream message.
+
+        @param accepted The validated transaction, or null if the
+                        transaction has only been proposed.
+    */
+    StreamMessage::pointer
+    transactionMessage(
+        std::shared_ptr<ReadView const> const& ledger,
+        std::shared_ptr<STTx const> const& transaction,
+        TER result,
+        AcceptedLedgerTx const* accepted,
+        bool binary);
+
     void
     pubValidatedTransaction(
         std::shared_ptr<ReadView const> const& ledger,
@@ -634,7 +654,8 @@ private:
     void
     pubAccountTransaction(
         std::shared_ptr<ReadView const> const& ledger,
-        AcceptedLedgerTx const& transaction);
+        AcceptedLedgerTx const& transaction,
+        StreamMessageFactory const& message);
 
     void
     pubProposedAccountTransaction(
@@ -737,6 +758,10 @@ private:
 
     LedgerMaster& m_ledgerMaster;
 
+    // Every published transaction looks up its affected accounts here,
+    // while subscriptions change rarely, so mSubAccount and mSubRTAccount
+    // are guarded by their own reader/writer lock instead of mSubLock.
+    std::shared_mutex mSubAccountLock;
     SubInfoMapType mSubAccount;
     SubInfoMapType mSubRTAccount;
 
@@ -760,6 +785,64 @@ private:
     };
     std::array<SubMapType, SubTypes::sLastEntry + 1> mStreamMaps;
 
+    /** Return the live subscribers of the given streams.
+
+        Expired subscribers are pruned as a side effect. The lock is only
+        held while the stream maps are walked, so that callers can build,
+        serialize and deliver the message without holding mSubLock.
+    */
+    std::vector<InfoSub::pointer>
+    collectListeners(std::initializer_list<SubTypes> streams);
+
+    /** Deliver a message to every listener. */
+    static void
+    sendToListeners(
+        std::vector<InfoSub::pointer> const& listeners,
+        StreamMessage::pointer const& msg);
+
+    /** Serialize a message once and deliver it to every listener. */
+    static void
+    sendToListeners(
+        std::vector<InfoSub::pointer> const& listeners,
+        Json::Value&& jvObj);
+
+    /** Deliver to every listener the encoding it negotiated. */
+    static void
+    sendToListeners(
+        std::vector<InfoSub::pointer> const& listeners,
+        StreamMessageFactory const& message);
+
+    /** Add the live subscribers of any of the given accounts to `notify`.
+
+        @param rt `true` for real time (proposed and validated)
+                  subscriptions, `false` for validated ones.
+        @return The number of subscriptions matched.
+    */
+    template <class Accounts>
+    int
+    collectAccountListeners(
+        Accounts const& accounts,
+        bool rt,
+        hash_set<InfoSub::pointer>& notify);
+
+    template <class Accounts>
+    void
+    pruneAccountListeners(Accounts const& accounts, bool rt);
+
+    // The number of account notifications which may be waiting for
+    // delivery to a single subscriber before it is disconnected.
+    static constexpr std::size_t subscriberQueueLimit = 1024;
+
+    /** Hand a delivery to a subscriber's queue, scheduling a job to
+        drain it if necessary. A subscriber whose queue is full is
+        disconnected.
+    */
+    void
+    queueDelivery(
+        InfoSub::ref sub,
+        InfoSub::Delivery&& delivery,
+        std::size_t limit = subscriberQueueLimit);
+
     ServerFeeSummary mLastFeeSummary;
 
     JobQueue& m_job_queue;
@@ -1540,9 +1623,8 @@ NetworkOPsImp::apply(std::unique_lock<std::mutex>& batchLock)
                 if (toSkip && !isEmitted)
                 {
                     protocol::TMTransaction tx;
-                    Serializer s;
-
-                    e.transaction->getSTransaction()->add(s);
+                    auto const s =
+                        e.transaction->getSTransaction()->getSerialized();
                     tx.set_rawtransaction(s.data(), s.size());
                     tx.set_status(protocol::tsCURRENT);
                     tx.set_receivetimestamp(
@@ -2019,13 +2101,177 @@ NetworkOPsImp::consensusViewChange()
     }
 }
 
-void
-NetworkOPsImp::pubManifest(Manifest const& mo)
+std::vector<InfoSub::pointer>
+NetworkOPsImp::collectListeners(std::initializer_list<SubTypes> streams)
 {
-    // VFALCO consider std::shared_mutex
+    std::vector<InfoSub::pointer> listeners;
+
     std::lock_guard sl(mSubLock);
 
-    if (!mStreamMaps[sManifests].empty())
+    for (auto const stream : streams)
+    {
+        auto& streamMap = mStreamMaps[stream];
+        listeners.reserve(listeners.size() + streamMap.size());
+
+        for (auto i = streamMap.begin(); i != streamMap.end();)
+        {
+            if (auto p = i->second.lock())
+            {
+                listeners.push_back(std::move(p));
+                ++i;
+            }
+            else
+            {
+                i = streamMap.erase(i);
+            }
+        }
+    }
+
+    return listeners;
+}
+
+void
+NetworkOPsImp::sendToListeners(
+    std::vector<InfoSub::pointer> const& listeners,
+    StreamMessage::pointer const& msg)
+{
+    for (auto const& p : listeners)
+        p->send(msg, true);
+}
+
+void
+NetworkOPsImp::sendToListeners(
+    std::vector<InfoSub::pointer> const& listeners,
+    Json::Value&& jvObj)
+{
+    if (!listeners.empty())
+        sendToListeners(listeners, makeStreamMessage(std::move(jvObj)));
+}
+
+void
+NetworkOPsImp::sendToListeners(
+    std::vector<InfoSub::pointer> const& listeners,
+    StreamMessageFactory const& message)
+{
+    for (auto const& p : listeners)
+        p->send(message(p->binaryEncoding()), true);
+}
+
+template <class Accounts>
+int
+NetworkOPsImp::collectAccountListeners(
+    Accounts const& accounts,
+    bool rt,
+    hash_set<InfoSub::pointer>& notify)
+{
+    int found = 0;
+    bool expired = false;
+
+    {
+        std::shared_lock sl(mSubAccountLock);
+
+        auto const& subMap = rt ? mSubRTAccount : mSubAccount;
+        if (subMap.empty())
+            return 0;
+
+        for (auto const& account : accounts)
+        {
+            auto const simiIt = subMap.find(account);
+            if (simiIt == subMap.end())
+                continue;
+
+            for (auto const& sub : simiIt->second)
+            {
+                if (auto p = sub.second.lock())
+                {
+                    notify.insert(std::move(p));
+                    ++found;
+                }
+                else
+                {
+                    expired = true;
+                }
+            }
+        }
+    }
+
+    // Subscribers remove themselves from the index when they are
+    // destroyed; this only catches those which expired in between.
+    if (expired)
+        pruneAccountListeners(accounts, rt);
+
+    return found;
+}
+
+template <class Accounts>
+void
+NetworkOPsImp::pruneAccountListeners(Accounts const& accounts, bool rt)
+{
+    std::lock_guard sl(mSubAccountLock);
+
+    auto& subMap = rt ? mSubRTAccount : mSubAccount;
+
+    for (auto const& account : accounts)
+    {
+        auto const simiIt = subMap.find(account);
+        if (simiIt == subMap.end())
+            continue;
+
+        auto& subs = simiIt->second;
+        for (auto it = subs.begin(); it != subs.end();)
+        {
+            if (it->second.expired())
+                it = subs.erase(it);
+            else
+                ++it;
+        }
+
+        if (subs.empty())
+            subMap.erase(simiIt);
+    }
+}
+
+void
+NetworkOPsImp::queueDelivery(
+    InfoSub::ref sub,
+    InfoSub::Delivery&& delivery,
+    std::size_t limit)
+{
+    switch (sub->queueDelivery(std::move(delivery), limit))
+    {
+        case InfoSub::Queued::overflow:
+            // Rather than lose messages without the subscriber knowing,
+            // disconnect it. Those already queued are still delivered.
+            JLOG(m_journal.info())
+                << "queueDelivery: subscriber " << sub->getSeq()
+                << " is too slow, disconnecting";
+            sub->disconnect();
+            break;
+
+        case InfoSub::Queued::pending:
+            break;
+
+        case InfoSub::Queued::drain:
+            if (!m_job_queue.addJob(
+                    jtCLIENT_SUBSCRIBE,
+                    "NetworkOPs::deliver",
+                    [wptr = InfoSub::wptr(sub)]() {
+                        if (auto p = wptr.lock())
+                            p->drainDeliveries();
+                    }))
+            {
+                // The job queue is stopping, deliver on this thread.
+                sub->drainDeliveries();
+            }
+            break;
+    }
+}
+
+void
+NetworkOPsImp::pubManifest(Manifest const& mo)
+{
+    if (auto const listeners = collectListeners({sManifests});
+        !listeners.empty())
     {
         Json::Value jvObj(Json::objectValue);
 
@@ -2042,19 +2288,7 @@ NetworkOPsImp::pubManifest(Manifest const& mo)
             jvObj[jss::domain] = mo.domain;
         jvObj[jss::manifest] = strHex(mo.serialized);
 
-        for (auto i = mStreamMaps[sManifests].begin();
-             i != mStreamMaps[sManifests].end();)
-        {
-            if (auto p = i->second.lock())
-            {
-                p->send(jvObj, true);
-                ++i;
-            }
-            else
-            {
-                i = mStreamMaps[sManifests].erase(i);
-            }
-        }
+        sendToListeners(listeners, std::move(jvObj));
     }
 }
 
@@ -2101,13 +2335,7 @@ trunc32(std::uint64_t v)
 void
 NetworkOPsImp::pubServer()
 {
-    // VFALCO TODO Don't hold the lock across calls to send...make a copy of the
-    //             list into a local array while holding the lock then release
-    //             the lock and call send on everyone.
-    //
-    std::lock_guard sl(mSubLock);
-
-    if (!mStreamMaps[sServer].empty())
+    if (auto const listeners = collectListeners({sServer}); !listeners.empty())
     {
         Json::Value jvObj(Json::objectValue);
 
@@ -2143,63 +2371,34 @@ NetworkOPsImp::pubServer()
         else
             jvObj[jss::load_factor] = f.loadFactorServer;
 
-        mLastFeeSummary = f;
-
-        for (auto i = mStreamMaps[sServer].begin();
-             i != mStreamMaps[sServer].end();)
         {
-            InfoSub::pointer p = i->second.lock();
-
-            // VFALCO TODO research the possibility of using thread queues and
-            //             linearizing the deletion of subscribers with the
-            //             sending of JSON data.
-            if (p)
-            {
-                p->send(jvObj, true);
-                ++i;
-            }
-            else
-            {
-                i = mStreamMaps[sServer].erase(i);
-            }
+            std::lock_guard sl(mSubLock);
+            mLastFeeSummary = f;
         }
+
+        sendToListeners(listeners, std::move(jvObj));
     }
 }
 
 void
 NetworkOPsImp::pubConsensus(ConsensusPhase phase)
 {
-    std::lock_guard sl(mSubLock);
-
-    auto& streamMap = mStreamMaps[sConsensusPhase];
-    if (!streamMap.empty())
+    if (auto const listeners = collectListeners({sConsensusPhase});
+        !listeners.empty())
     {
         Json::Value jvObj(Json::objectValue);
         jvObj[jss::type] = "consensusPhase";
         jvObj[jss::consensus] = to_string(phase);
 
-        for (auto i = streamMap.begin(); i != streamMap.end();)
-        {
-            if (auto p = i->second.lock())
-            {
-                p->send(jvObj, true);
-                ++i;
-            }
-            else
-            {
-                i = streamMap.erase(i);
-            }
-        }
+        sendToListeners(listeners, std::move(jvObj));
     }
 }
 
 void
 NetworkOPsImp::pubValidation(std::shared_ptr<STValidation> const& val)
 {
-    // VFALCO consider std::shared_mutex
-    std::lock_guard sl(mSubLock);
-
-    if (!mStreamMaps[sValidations].empty())
+    if (auto const listeners = collectListeners({sValidations});
+        !listeners.empty())
     {
         Json::Value jvObj(Json::objectValue);
 
@@ -2269,48 +2468,21 @@ NetworkOPsImp::pubValidation(std::shared_ptr<STValidation> const& val)
             reserveIncXRP && reserveIncXRP->native())
             jvObj[jss::reserve_inc] = reserveIncXRP->xrp().jsonClipped();
 
-        for (auto i = mStreamMaps[sValidations].begin();
-             i != mStreamMaps[sValidations].end();)
-        {
-            if (auto p = i->second.lock())
-            {
-                p->send(jvObj, true);
-                ++i;
-            }
-            else
-            {
-                i = mStreamMaps[sValidations].erase(i);
-            }
-        }
+        sendToListeners(listeners, std::move(jvObj));
     }
 }
 
 void
 NetworkOPsImp::pubPeerStatus(std::function<Json::Value(void)> const& func)
 {
-    std::lock_guard sl(mSubLock);
-
-    if (!mStreamMaps[sPeerStatus].empty())
+    if (auto const listeners = collectListeners({sPeerStatus});
+        !listeners.empty())
     {
         Json::Value jvObj(func());
 
         jvObj[jss::type] = "peerStatusChange";
 
-        for (auto i = mStreamMaps[sPeerStatus].begin();
-             i != mStreamMaps[sPeerStatus].end();)
-        {
-            InfoSub::pointer p = i->second.lock();
-
-            if (p)
-            {
-                p->send(jvObj, true);
-                ++i;
-            }
-            else
-            {
-                i = mStreamMaps[sPeerStatus].erase(i);
-            }
-        }
+        sendToListeners(listeners, std::move(jvObj));
     }
 }
 
@@ -2766,6 +2938,16 @@ NetworkOPsImp::getServerInfo(bool human, bool admin, bool counters)
             std::to_string(app_.overlay().getPeerDisconnect());
         info[jss::peer_disconnects_resources] =
             std::to_string(app_.overlay().getPeerDisconnectCharges());
+
+        if (auto const snapshot = app_.getCacheSnapshot())
+        {
+            // How long the caches took to warm up, and how well they
+            // have served since.
+            auto& warmup = info[jss::cache_warmup] = snapshot->getJson();
+            warmup[jss::treenode_hit_rate] =
+                app_.getNodeFamily().getTreeNodeCache(0)->getHitRate();
+            warmup[jss::SLE_hit_rate] = app_.cachedSLEs().rate();
+        }
     }
     else
     {
@@ -2797,26 +2979,17 @@ NetworkOPsImp::pubProposedTransaction(
     if (hook::isEmittedTxn(*transaction))
         return;
 
-    Json::Value jvObj = transJson(*transaction, result, false, ledger);
-
+    if (auto const listeners = collectListeners({sRTTransactions});
+        !listeners.empty())
     {
-        std::lock_guard sl(mSubLock);
-
-        auto it = mStreamMaps[sRTTransactions].begin();
-        while (it != mStreamMaps[sRTTransactions].end())
-        {
-            InfoSub::pointer p = it->second.lock();
-
-            if (p)
-            {
-                p->send(jvObj, true);
-                ++it;
-            }
-            else
-            {
-                it = mStreamMaps[sRTTransactions].erase(it);
-            }
-        }
+        std::array<StreamMessage::pointer, 2> msgs;
+        sendToListeners(listeners, [&](bool binary) {
+            auto& msg = msgs[binary];
+            if (!msg)
+                msg = transactionMessage(
+                    ledger, transaction, result, nullptr, binary);
+            return msg;
+        });
     }
 
     pubProposedAccountTransaction(ledger, transaction, result);
@@ -2830,24 +3003,11 @@ NetworkOPsImp::forwardProposedTransaction(Json::Value const& jvObj)
     // etl process writes a validated ledger
     if (jvObj[jss::validated].asBool())
         return;
-    {
-        std::lock_guard sl(mSubLock);
 
-        auto it = mStreamMaps[sRTTransactions].begin();
-        while (it != mStreamMaps[sRTTransactions].end())
-        {
-            InfoSub::pointer p = it->second.lock();
-
-            if (p)
-            {
-                p->send(jvObj, true);
-                ++it;
-            }
-            else
-            {
-                it = mStreamMaps[sRTTransactions].erase(it);
-            }
-        }
+    if (auto const listeners = collectListeners({sRTTransactions});
+        !listeners.empty())
+    {
+        sendToListeners(listeners, Json::Value(jvObj));
     }
 
     forwardProposedAccountTransaction(jvObj);
@@ -2856,40 +3016,20 @@ NetworkOPsImp::forwardProposedTransaction(Json::Value const& jvObj)
 void
 NetworkOPsImp::forwardValidation(Json::Value const& jvObj)
 {
-    std::lock_guard sl(mSubLock);
-
-    for (auto i = mStreamMaps[sValidations].begin();
-         i != mStreamMaps[sValidations].end();)
+    if (auto const listeners = collectListeners({sValidations});
+        !listeners.empty())
     {
-        if (auto p = i->second.lock())
-        {
-            p->send(jvObj, true);
-            ++i;
-        }
-        else
-        {
-            i = mStreamMaps[sValidations].erase(i);
-        }
+        sendToListeners(listeners, Json::Value(jvObj));
     }
 }
 
 void
 NetworkOPsImp::forwardManifest(Json::Value const& jvObj)
 {
-    std::lock_guard sl(mSubLock);
-
-    for (auto i = mStreamMaps[sManifests].begin();
-         i != mStreamMaps[sManifests].end();)
+    if (auto const listeners = collectListeners({sManifests});
+        !listeners.empty())
     {
-        if (auto p = i->second.lock())
-        {
-            p->send(jvObj, true);
-            ++i;
-        }
-        else
-        {
-            i = mStreamMaps[sManifests].erase(i);
-        }
+        sendToListeners(listeners, Json::Value(jvObj));
     }
 }
 
@@ -2914,11 +3054,9 @@ getAccounts(Json::Value const& jvObj, std::vector<AccountID>& accounts)
 void
 NetworkOPsImp::forwardProposedAccountTransaction(Json::Value const& jvObj)
 {
-    hash_set<InfoSub::pointer> notify;
-    int iProposed = 0;
     // check if there are any subscribers before attempting to parse the JSON
     {
-        std::lock_guard sl(mSubLock);
+        std::shared_lock sl(mSubAccountLock);
 
         if (mSubRTAccount.empty())
             return;
@@ -2940,42 +3078,18 @@ NetworkOPsImp::forwardProposedAccountTransaction(Json::Value const& jvObj)
             return;
         }
     }
-    {
-        std::lock_guard sl(mSubLock);
 
-        if (!mSubRTAccount.empty())
-        {
-            for (auto const& affectedAccount : accounts)
-            {
-                auto simiIt = mSubRTAccount.find(affectedAccount);
-                if (simiIt != mSubRTAccount.end())
-                {
-                    auto it = simiIt->second.begin();
-
-                    while (it != simiIt->second.end())
-                    {
-                        InfoSub::pointer p = it->second.lock();
+    hash_set<InfoSub::pointer> notify;
+    int const iProposed = collectAccountListeners(accounts, true, notify);
 
-                        if (p)
-                        {
-                            notify.insert(p);
-                            ++it;
-                            ++iProposed;
-                        }
-                        else
-                            it = simiIt->second.erase(it);
-                    }
-                }
-            }
-        }
-    }
     JLOG(m_journal.trace()) << "forwardProposedAccountTransaction:"
                             << " iProposed=" << iProposed;
 
     if (!notify.empty())
     {
+        auto const msg = makeStreamMessage(jvObj);
         for (InfoSub::ref isrListener : notify)
-            isrListener->send(jvObj, true);
+            isrListener->send(msg, true);
     }
 }
 
@@ -3001,10 +3115,28 @@ NetworkOPsImp::pubLedger(std::shared_ptr<ReadView const> const& lpAccepted)
             << "Publishing ledger " << lpAccepted->info().seq << " "
             << lpAccepted->info().hash;
 
-        std::lock_guard sl(mSubLock);
-
-        if (!mStreamMaps[sLedger].empty())
+        if (auto const listeners = collectListeners({sLedger});
+            !listeners.empty())
         {
+            std::string validatedLedgers;
+            if (mMode >= OperatingMode::SYNCING)
+                validatedLedgers = app_.getLedgerMaster().getCompleteLedgers();
+
+            StreamMessage::pointer binaryMsg;
+            auto const binary = [&]() {
+                if (!binaryMsg)
+                {
+                    Serializer s;
+                    RPC::addBinaryLedgerClosed(
+                        s,
+                        *lpAccepted,
+                        static_cast<std::uint32_t>(alpAccepted->size()),
+                        validatedLedgers);
+                    binaryMsg = makeStreamMessage(s.slice());
+                }
+                return binaryMsg;
+            };
+
             Json::Value jvObj(Json::objectValue);
 
             jvObj[jss::type] = "ledgerClosed";
@@ -3024,44 +3156,26 @@ NetworkOPsImp::pubLedger(std::shared_ptr<ReadView const> const& lpAccepted)
             jvObj[jss::txn_count] = Json::UInt(alpAccepted->size());
 
             if (mMode >= OperatingMode::SYNCING)
-            {
-                jvObj[jss::validated_ledgers] =
-                    app_.getLedgerMaster().getCompleteLedgers();
-            }
+                jvObj[jss::validated_ledgers] = validatedLedgers;
 
-            auto it = mStreamMaps[sLedger].begin();
-            while (it != mStreamMaps[sLedger].end())
-            {
-                InfoSub::pointer p = it->second.lock();
-                if (p)
-                {
-                    p->send(jvObj, true);
-                    ++it;
-                }
-                else
-                    it = mStreamMaps[sLedger].erase(it);
-            }
+            auto const json = makeStreamMessage(std::move(jvObj));
+            sendToListeners(listeners, [&](bool isBinary) {
+                return isBinary ? binary() : json;
+            });
         }
 
-        if (!mStreamMaps[sBookChanges].empty())
+        // Compute the book changes now, whether or not anyone listens, so
+        // that book_changes requests for this ledger find them cached.
+        auto const bookChanges = m_ledgerMaster.getBookChanges(lpAccepted);
+        if (auto const listeners = collectListeners({sBookChanges});
+            !listeners.empty())
         {
-            Json::Value jvObj = ripple::RPC::computeBookChanges(lpAccepted);
-
-            auto it = mStreamMaps[sBookChanges].begin();
-            while (it != mStreamMaps[sBookChanges].end())
-            {
-                InfoSub::pointer p = it->second.lock();
-                if (p)
-                {
-                    p->send(jvObj, true);
-                    ++it;
-                }
-                else
-                    it = mStreamMaps[sBookChanges].erase(it);
-            }
+            sendToListeners(listeners, makeStreamMessage(*bookChanges));
         }
 
         {
+            std::lock_guard sl(mSubLock);
+
             static bool firstTime = true;
             if (firstTime)
             {
@@ -3210,119 +3324,96 @@ NetworkOPsImp::transJson(
     return jvObj;
 }
 
-void
-NetworkOPsImp::pubValidatedTransaction(
+StreamMessage::pointer
+NetworkOPsImp::transactionMessage(
     std::shared_ptr<ReadView const> const& ledger,
-    const AcceptedLedgerTx& transaction)
+    std::shared_ptr<STTx const> const& transaction,
+    TER result,
+    AcceptedLedgerTx const* accepted,
+    bool binary)
 {
-    auto const& stTxn = transaction.getTxn();
+    if (binary)
+    {
+        Serializer s;
+        RPC::addBinaryTransaction(
+            s,
+            *ledger,
+            *transaction,
+            result,
+            accepted != nullptr,
+            accepted ? makeSlice(accepted->getRawMeta()) : Slice{});
+        return makeStreamMessage(s.slice());
+    }
 
     Json::Value jvObj =
-        transJson(*stTxn, transaction.getResult(), true, ledger);
+        transJson(*transaction, result, accepted != nullptr, ledger);
 
+    if (accepted)
     {
-        auto const& meta = transaction.getMeta();
+        auto const& meta = accepted->getMeta();
         jvObj[jss::meta] = meta.getJson(JsonOptions::none);
-        RPC::insertDeliveredAmount(jvObj[jss::meta], *ledger, stTxn, meta);
+        RPC::insertDeliveredAmount(
+            jvObj[jss::meta], *ledger, transaction, meta);
     }
 
-    {
-        std::lock_guard sl(mSubLock);
-
-        auto it = mStreamMaps[sTransactions].begin();
-        while (it != mStreamMaps[sTransactions].end())
-        {
-            InfoSub::pointer p = it->second.lock();
-
-            if (p)
-            {
-                p->send(jvObj, true);
-                ++it;
-            }
-            else
-                it = mStreamMaps[sTransactions].erase(it);
-        }
-
-        it = mStreamMaps[sRTTransactions].begin();
+    return makeStreamMessage(std::move(jvObj));
+}
 
-        while (it != mStreamMaps[sRTTransactions].end())
-        {
-            InfoSub::pointer p = it->second.lock();
+void
+NetworkOPsImp::pubValidatedTransaction(
+    std::shared_ptr<ReadView const> const& ledger,
+    const AcceptedLedgerTx& transaction)
+{
+    // The transaction, book and account streams all carry the same
+    // message, so each encoding is built the first time a stream needs it
+    // and then shared. Nothing is built if no one is listening.
+    std::array<StreamMessage::pointer, 2> msgs;
+    StreamMessageFactory const message = [&](bool binary) {
+        auto& msg = msgs[binary];
+        if (!msg)
+            msg = transactionMessage(
+                ledger,
+                transaction.getTxn(),
+                transaction.getResult(),
+                &transaction,
+                binary);
+        return msg;
+    };
 
-            if (p)
-            {
-                p->send(jvObj, true);
-                ++it;
-            }
-            else
-                it = mStreamMaps[sRTTransactions].erase(it);
-        }
+    if (auto const listeners =
+            collectListeners({sTransactions, sRTTransactions});
+        !listeners.empty())
+    {
+        sendToListeners(listeners, message);
     }
 
     if (isTesSuccess(transaction.getResult()))
-        app_.getOrderBookDB().processTxn(ledger, transaction, jvObj);
+        app_.getOrderBookDB().processTxn(ledger, transaction, message);
 
-    pubAccountTransaction(ledger, transaction);
+    pubAccountTransaction(ledger, transaction, message);
 }
 
 void
 NetworkOPsImp::pubAccountTransaction(
     std::shared_ptr<ReadView const> const& ledger,
-    AcceptedLedgerTx const& transaction)
+    AcceptedLedgerTx const& transaction,
+    StreamMessageFactory const& message)
 {
+    auto const& affected = transaction.getAffected();
+
     hash_set<InfoSub::pointer> notify;
-    int iProposed = 0;
-    int iAccepted = 0;
+    int const iProposed = collectAccountListeners(affected, true, notify);
+    int const iAccepted = collectAccountListeners(affected, false, notify);
 
     std::vector<SubAccountHistoryInfo> accountHistoryNotify;
     auto const currLedgerSeq = ledger->seq();
     {
         std::lock_guard sl(mSubLock);
 
-        if (!mSubAccount.empty() || !mSubRTAccount.empty() ||
-            !mSubAccountHistory.empty())
+        if (!mSubAccountHistory.empty())
         {
-            for (auto const& affectedAccount : transaction.getAffected())
+            for (auto const& affectedAccount : affected)
             {
-                if (auto simiIt = mSubRTAccount.find(affectedAccount);
-                    simiIt != mSubRTAccount.end())
-                {
-                    auto it = simiIt->second.begin();
-
-                    while (it != simiIt->second.end())
-                    {
-                        InfoSub::pointer p = it->second.lock();
-
-                        if (p)
-                        {
-                            notify.insert(p);
-                            ++it;
-                            ++iProposed;
-                        }
-                        else
-                            it = simiIt->second.erase(it);
-                    }
-                }
-
-                if (auto simiIt = mSubAccount.find(affectedAccount);
-                    simiIt != mSubAccount.end())
-                {
-                    auto it = simiIt->second.begin();
-                    while (it != simiIt->second.end())
-                    {
-                        InfoSub::pointer p = it->second.lock();
-
-                        if (p)
-                        {
-                            notify.insert(p);
-                            ++it;
-                            ++iAccepted;
-                        }
-                        else
-                            it = simiIt->second.erase(it);
-                    }
-                }
-
                 if (auto histoIt = mSubAccountHistory.find(affectedAccount);
                     histoIt != mSubAccountHistory.end())
                 {
@@ -3359,32 +3450,40 @@ NetworkOPsImp::pubAccountTransaction(
         << "pubAccountTransaction: "
         << "proposed=" << iProposed << ", accepted=" << iAccepted;
 
-    if (!notify.empty() || !accountHistoryNotify.empty())
-    {
-        auto const& stTxn = transaction.getTxn();
-
-        Json::Value jvObj =
-            transJson(*stTxn, transaction.getResult(), true, ledger);
-
-        {
-            auto const& meta = transaction.getMeta();
+    if (notify.empty() && accountHistoryNotify.empty())
+        return;
 
-            jvObj[jss::meta] = meta.getJson(JsonOptions::none);
-            RPC::insertDeliveredAmount(jvObj[jss::meta], *ledger, stTxn, meta);
-        }
+    // Delivery goes through each subscriber's own queue, so that a slow
+    // subscriber can not hold up the publication of the ledger.
+    for (InfoSub::ref isrListener : notify)
+    {
+        queueDelivery(
+            isrListener,
+            [msg = message(isrListener->binaryEncoding())](InfoSub& sub) {
+                sub.send(msg, true);
+            });
+    }
 
-        for (InfoSub::ref isrListener : notify)
-            isrListener->send(jvObj, true);
+    if (accountHistoryNotify.empty())
+        return;
 
-        assert(!jvObj.isMember(jss::account_history_tx_stream));
-        for (auto& info : accountHistoryNotify)
-        {
-            auto& index = info.index_;
-            if (index->forwardTxIndex_ == 0 && !index->haveHistorical_)
-                jvObj[jss::account_history_tx_first] = true;
-            jvObj[jss::account_history_tx_index] = index->forwardTxIndex_++;
-            info.sink_->send(jvObj, true);
-        }
+    // The account history stream is always JSON. Clients rely on
+    // account_history_tx_index having no gaps, so a subscriber which falls
+    // behind is disconnected like any other rather than sent fewer.
+    auto const msg = message(false);
+    assert(!msg->json().isMember(jss::account_history_tx_stream));
+    for (auto& info : accountHistoryNotify)
+    {
+        queueDelivery(
+            info.sink_,
+            [msg, index = info.index_](InfoSub& sub) {
+                Json::Value jvObj = msg->json();
+                if (index->forwardTxIndex_ == 0 && !index->haveHistorical_)
+                    jvObj[jss::account_history_tx_first] = true;
+                jvObj[jss::account_history_tx_index] =
+                    index->forwardTxIndex_++;
+                sub.send(jvObj, true);
+            });
     }
 }
 
@@ -3395,61 +3494,21 @@ NetworkOPsImp::pubProposedAccountTransaction(
     TER result)
 {
     hash_set<InfoSub::pointer> notify;
-    int iProposed = 0;
-
-    std::vector<SubAccountHistoryInfo> accountHistoryNotify;
-
-    {
-        std::lock_guard sl(mSubLock);
-
-        if (mSubRTAccount.empty())
-            return;
-
-        if (!mSubAccount.empty() || !mSubRTAccount.empty() ||
-            !mSubAccountHistory.empty())
-        {
-            for (auto const& affectedAccount : tx->getMentionedAccounts())
-            {
-                if (auto simiIt = mSubRTAccount.find(affectedAccount);
-                    simiIt != mSubRTAccount.end())
-                {
-                    auto it = simiIt->second.begin();
-
-                    while (it != simiIt->second.end())
-                    {
-                        InfoSub::pointer p = it->second.lock();
-
-                        if (p)
-                        {
-                            notify.insert(p);
-                            ++it;
-                            ++iProposed;
-                        }
-                        else
-                            it = simiIt->second.erase(it);
-                    }
-                }
-            }
-        }
-    }
+    int const iProposed =
+        collectAccountListeners(tx->getMentionedAccounts(), true, notify);
 
     JLOG(m_journal.trace()) << "pubProposedAccountTransaction: " << iProposed;
 
-    if (!notify.empty() || !accountHistoryNotify.empty())
+    if (!notify.empty())
     {
-        Json::Value jvObj = transJson(*tx, result, false, ledger);
-
+        std::array<StreamMessage::pointer, 2> msgs;
         for (InfoSub::ref isrListener : notify)
-            isrListener->send(jvObj, true);
-
-        assert(!jvObj.isMember(jss::account_history_tx_stream));
-        for (auto& info : accountHistoryNotify)
         {
-            auto& index = info.index_;
-            if (index->forwardTxIndex_ == 0 && !index->haveHistorical_)
-                jvObj[jss::account_history_tx_first] = true;
-            jvObj[jss::account_history_tx_index] = index->forwardTxIndex_++;
-            info.sink_->send(jvObj, true);
+            bool const binary = isrListener->binaryEncoding();
+            if (!msgs[binary])
+                msgs[binary] =
+                    transactionMessage(ledger, tx, result, nullptr, binary);
+            isrListener->send(msgs[binary], true);
         }
     }
 }
@@ -3474,7 +3533,7 @@ NetworkOPsImp::subAccount(
         isrListener->insertSubAccountInfo(naAccountID, rt);
     }
 
-    std::lock_guard sl(mSubLock);
+    std::lock_guard sl(mSubAccountLock);
 
     for (auto const& naAccountID : vnaAccountIDs)
     {
@@ -3517,7 +3576,7 @@ NetworkOPsImp::unsubAccountInternal(
     hash_set<AccountID> const& vnaAccountIDs,
     bool rt)
 {
-    std::lock_guard sl(mSubLock);
+    std::lock_guard sl(mSubAccountLock);
 
     SubInfoMapType& subMap = rt ? mSubRTAccount : mSubAccount;
 
@@ -4280,6 +4339,17 @@ NetworkOPsImp::tryRemoveRpcSub(std::string const& strUrl)
     return true;
 }
 
+void
+NetworkOPsImp::removeRpcSub(std::string const& strUrl, InfoSub const& sub)
+{
+    std::lock_guard sl(mSubLock);
+
+    // The URL may have been subscribed again since
+    if (auto const it = mRpcSubMap.find(strUrl);
+        it != mRpcSubMap.end() && it->second.get() == &sub)
+        mRpcSubMap.erase(it);
+}
+
 #ifndef USE_NEW_BOOK_PAGE
 
 // NIKB FIXME this should be looked at. There's no reason why this shouldn't
@@ -0,0 +1,392 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/misc/CacheSnapshot.h>
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/ledger/CachedSLEs.h>
+#include <ripple/nodestore/Database.h>
+#include <ripple/protocol/HashPrefix.h>
+#include <ripple/protocol/digest.h>
+#include <ripple/protocol/jss.h>
+#include <ripple/shamap/Family.h>
+#include <ripple/shamap/SHAMapLeafNode.h>
+#include <boost/filesystem.hpp>
+#include <array>
+#include <condition_variable>
+#include <fstream>
+
+namespace ripple {
+
+namespace {
+
+// The file starts with a tag and the version of its format, then the name
+// of the node store. Each record that follows holds the caches an entry is
+// in, its hash, and the size and bytes of the node, the size being zero
+// when the node is not included.
+std::array<char, 4> constexpr tag{'C', 'S', 'N', 'P'};
+std::uint32_t constexpr version = 1;
+
+// The caches an entry is in
+enum Kind : std::uint8_t {
+    treeNode = 1,
+    fullBelow = 2,
+    ledgerEntry = 4,
+};
+
+// No node comes close to this size
+std::uint32_t constexpr maxNodeSize = 1024 * 1024;
+
+// The number of reads to keep in flight while warming
+std::size_t constexpr maxReads = 4096;
+
+void
+write32(std::ostream& out, std::uint32_t v)
+{
+    std::array<char, 4> const bytes{
+        static_cast<char>(v >> 24),
+        static_cast<char>(v >> 16),
+        static_cast<char>(v >> 8),
+        static_cast<char>(v)};
+    out.write(bytes.data(), bytes.size());
+}
+
+bool
+read32(std::istream& in, std::uint32_t& v)
+{
+    std::array<unsigned char, 4> bytes;
+    if (!in.read(reinterpret_cast<char*>(bytes.data()), bytes.size()))
+        return false;
+    v = (std::uint32_t{bytes[0]} << 24) | (std::uint32_t{bytes[1]} << 16) |
+        (std::uint32_t{bytes[2]} << 8) | std::uint32_t{bytes[3]};
+    return true;
+}
+
+void
+writeRecord(
+    std::ostream& out,
+    std::uint8_t kinds,
+    uint256 const& hash,
+    Slice data)
+{
+    out.put(static_cast<char>(kinds));
+    out.write(reinterpret_cast<char const*>(hash.data()), hash.size());
+    write32(out, data.size());
+    out.write(reinterpret_cast<char const*>(data.data()), data.size());
+}
+
+}  // namespace
+
+CacheSnapshot::CacheSnapshot(
+    std::string path,
+    bool withData,
+    beast::Journal j)
+    : path_(std::move(path)), withData_(withData), j_(j)
+{
+}
+
+bool
+CacheSnapshot::save(
+    Family& family,
+    CachedSLEs const& cachedSLEs,
+    NodeStore::Database const& db) const
+{
+    using namespace std::chrono;
+    auto const start = steady_clock::now();
+
+    auto const treeNodes = family.getTreeNodeCache(0);
+
+    hash_map<uint256, std::uint8_t> kinds;
+    for (auto const& hash : treeNodes->getKeys())
+        kinds[hash] |= treeNode;
+    for (auto const& hash : family.getFullBelowCache(0)->getKeys())
+        kinds[hash] |= fullBelow;
+
+    hash_map<uint256, std::shared_ptr<SLE const>> sles;
+    cachedSLEs.visit(
+        [&](uint256 const& digest, std::shared_ptr<SLE const> const& sle) {
+            kinds[digest] |= ledgerEntry;
+            if (withData_)
+                sles.emplace(digest, sle);
+        });
+
+    auto const temp = path_ + ".tmp";
+    try
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        out.exceptions(std::ios::failbit | std::ios::badbit);
+
+        out.write(tag.data(), tag.size());
+        write32(out, version);
+        auto const name = db.getName();
+        write32(out, name.size());
+        out.write(name.data(), name.size());
+
+        Serializer s;
+        for (auto const& [hash, k] : kinds)
+        {
+            s.erase();
+            if (withData_)
+            {
+                std::shared_ptr<SHAMapTreeNode> node;
+                if (k & treeNode)
+                    node = treeNodes->fetch(hash);
+
+                if (node)
+                {
+                    node->serializeWithPrefix(s);
+                }
+                else if (auto const it = sles.find(hash); it != sles.end())
+                {
+                    // The account state leaf the entry was read from
+                    s.add32(HashPrefix::leafNode);
+                    it->second->add(s);
+                    s.addBitString(it->second->key());
+                }
+            }
+            writeRecord(out, k, hash, s.slice());
+        }
+
+        out.close();
+        boost::filesystem::rename(temp, path_);
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(j_.error()) << "Unable to write the cache snapshot to " << path_
+                         << ": " << e.what();
+        boost::system::error_code ec;
+        boost::filesystem::remove(temp, ec);
+        return false;
+    }
+
+    JLOG(j_.info()) << "Wrote " << kinds.size() << " cache entries to "
+                    << path_ << " in "
+                    << duration_cast<milliseconds>(steady_clock::now() - start)
+                           .count()
+                    << "ms";
+    return true;
+}
+
+void
+CacheSnapshot::warm(
+    Family& family,
+    CachedSLEs& cachedSLEs,
+    NodeStore::Database& db)
+{
+    using namespace std::chrono;
+    auto const start = steady_clock::now();
+
+    auto const treeNodes = family.getTreeNodeCache(0);
+    auto const fullBelowCache = family.getFullBelowCache(0);
+
+    std::size_t entries = 0;
+    bool sameStore = false;
+    std::atomic<std::size_t> restoredNodes{0};
+    std::atomic<std::size_t> restoredFullBelow{0};
+    std::atomic<std::size_t> restoredSLEs{0};
+    std::atomic<std::size_t> missing{0};
+    std::size_t fromSnapshot = 0;
+
+    // Put a node into the caches it was in, from any thread
+    auto restore = [&](uint256 const& hash, std::uint8_t kinds, Slice data) {
+        try
+        {
+            auto node = SHAMapTreeNode::makeFromPrefix(data, SHAMapHash{hash});
+            if (!node)
+            {
+                ++missing;
+                return;
+            }
+
+            if (kinds & treeNode)
+            {
+                treeNodes->canonicalize_replace_client(hash, node);
+                ++restoredNodes;
+            }
+
+            if ((kinds & fullBelow) && sameStore && node->isInner())
+            {
+                fullBelowCache->insert(hash);
+                ++restoredFullBelow;
+            }
+
+            if ((kinds & ledgerEntry) &&
+                node->getType() == SHAMapNodeType::tnACCOUNT_STATE)
+            {
+                auto const& item =
+                    static_cast<SHAMapLeafNode const&>(*node).peekItem();
+                cachedSLEs.preload(
+                    hash,
+                    std::make_shared<SLE const>(
+                        SerialIter{item->slice()}, item->key()));
+                ++restoredSLEs;
+            }
+        }
+        catch (std::exception const& e)
+        {
+            JLOG(j_.debug()) << "Cache snapshot node " << hash << ": "
+                             << e.what();
+            ++missing;
+        }
+    };
+
+    std::mutex m;
+    std::condition_variable cv;
+    std::size_t reads = 0;
+
+    // Restore a node from its bytes in the snapshot if they are intact,
+    // otherwise read it from the node store.
+    auto warmOne = [&](uint256 const& hash, std::uint8_t kinds, Blob& data) {
+        if (!data.empty() && sha512Half(makeSlice(data)) == hash)
+        {
+            restore(hash, kinds, makeSlice(data));
+            ++fromSnapshot;
+            return;
+        }
+
+        {
+            std::unique_lock lock(m);
+            cv.wait(lock, [&] { return reads < maxReads; });
+            ++reads;
+        }
+
+        db.asyncFetch(
+            hash,
+            0,
+            [&, hash, kinds](std::shared_ptr<NodeObject> const& object) {
+                if (object)
+                    restore(hash, kinds, makeSlice(object->getData()));
+                else
+                    ++missing;
+
+                std::lock_guard lock(m);
+                --reads;
+                cv.notify_all();
+            });
+    };
+
+    {
+        std::ifstream in(path_, std::ios::binary);
+        if (!in)
+        {
+            JLOG(j_.info()) << "No cache snapshot at " << path_;
+            return;
+        }
+
+        std::array<char, 4> t;
+        std::uint32_t v;
+        std::uint32_t size;
+        std::string name;
+        if (!in.read(t.data(), t.size()) || t != tag || !read32(in, v) ||
+            v != version || !read32(in, size) || size > maxNodeSize)
+        {
+            JLOG(j_.warn()) << "Ignoring the cache snapshot at " << path_
+                            << ": not a snapshot of this version";
+        }
+        else
+        {
+            name.resize(size);
+            if (in.read(name.data(), size))
+                sameStore = name == db.getName();
+
+            if (!sameStore)
+            {
+                JLOG(j_.warn()) << "The cache snapshot was taken of another "
+                                   "node store; not restoring the full below "
+                                   "cache";
+            }
+
+            // Each hash is written once, so every record is warmed as soon
+            // as it is read rather than after the whole file is loaded.
+            uint256 hash;
+            char kinds;
+            Blob data;
+            while (in.get(kinds) &&
+                   in.read(reinterpret_cast<char*>(hash.data()), hash.size()) &&
+                   read32(in, size) && size <= maxNodeSize)
+            {
+                data.resize(size);
+                if (!in.read(reinterpret_cast<char*>(data.data()), size))
+                    break;
+
+                ++entries;
+                warmOne(hash, static_cast<std::uint8_t>(kinds), data);
+            }
+
+            if (!in.eof())
+            {
+                JLOG(j_.warn()) << "The cache snapshot at " << path_
+                                << " is damaged; using what could be read";
+            }
+        }
+    }
+
+    {
+        std::unique_lock lock(m);
+        cv.wait(lock, [&] { return reads == 0; });
+    }
+
+    boost::system::error_code ec;
+    boost::filesystem::remove(path_, ec);
+    if (ec)
+    {
+        JLOG(j_.warn()) << "Unable to remove the cache snapshot at " << path_
+                        << ": " << ec.message();
+    }
+
+    std::lock_guard lock(mutex_);
+    stats_.entries = entries;
+    stats_.treeNodes = restoredNodes;
+    stats_.fullBelow = restoredFullBelow;
+    stats_.ledgerEntries = restoredSLEs;
+    stats_.fromSnapshot = fromSnapshot;
+    stats_.missing = missing;
+    stats_.duration =
+        duration_cast<milliseconds>(steady_clock::now() - start);
+
+    JLOG(j_.info()) << "Warmed the caches with " << stats_.treeNodes
+                    << " tree nodes, " << stats_.fullBelow
+                    << " full below entries and " << stats_.ledgerEntries
+                    << " ledger entries in " << stats_.duration.count()
+                    << "ms; " << stats_.missing << " nodes were missing";
+}
+
+CacheSnapshot::Stats
+CacheSnapshot::stats() const
+{
+    std::lock_guard lock(mutex_);
+    return stats_;
+}
+
+Json::Value
+CacheSnapshot::getJson() const
+{
+    auto const s = stats();
+
+    Json::Value ret(Json::objectValue);
+    ret[jss::entries] = static_cast<Json::UInt>(s.entries);
+    ret[jss::tree_nodes] = static_cast<Json::UInt>(s.treeNodes);
+    ret[jss::full_below] = static_cast<Json::UInt>(s.fullBelow);
+    ret[jss::ledger_entries] = static_cast<Json::UInt>(s.ledgerEntries);
+    ret[jss::from_snapshot] = static_cast<Json::UInt>(s.fromSnapshot);
+    ret[jss::missing] = static_cast<Json::UInt>(s.missing);
+    ret[jss::duration_ms] = static_cast<Json::UInt>(s.duration.count());
+    return ret;
+}
+
+}  // namespace ripple
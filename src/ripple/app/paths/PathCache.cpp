@@ -0,0 +1,219 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/paths/PathCache.h>
+#include <ripple/protocol/LedgerFormats.h>
+#include <ripple/protocol/TxMeta.h>
+#include <algorithm>
+#include <limits>
+
+namespace ripple {
+
+// The decimal order of magnitude of an amount, negated for negative amounts
+static int
+magnitude(STAmount const& amount)
+{
+    if (amount == beast::zero)
+        return std::numeric_limits<int>::min();
+
+    int result = amount.native() ? 0 : amount.exponent();
+    for (auto m = amount.mantissa(); m >= 10; m /= 10)
+        ++result;
+
+    // Keep the negative and positive ranges apart
+    return amount.negative() ? -1000 - result : result;
+}
+
+PathCache::PathCache(beast::Journal j) : j_(j)
+{
+}
+
+PathCache::Key
+PathCache::makeKey(
+    AccountID const& srcAccount,
+    AccountID const& dstAccount,
+    Currency const& srcCurrency,
+    std::optional<AccountID> const& srcIssuer,
+    STAmount const& srcAmount,
+    STAmount const& dstAmount,
+    int searchLevel,
+    int maxPaths)
+{
+    return {
+        srcAccount,
+        dstAccount,
+        srcCurrency,
+        srcIssuer,
+        dstAmount.issue(),
+        magnitude(dstAmount),
+        srcAmount.issue(),
+        magnitude(srcAmount),
+        searchLevel,
+        maxPaths};
+}
+
+std::shared_ptr<PathCache::RankedPaths const>
+PathCache::fetch(Key const& key, ReadView const& ledger)
+{
+    std::lock_guard lock(mutex_);
+
+    if (auto const it = entries_.find(key);
+        it != entries_.end() && !ledger.open() &&
+        it->second.ledger == ledger.info().hash)
+    {
+        ++hits_;
+        return it->second.paths;
+    }
+
+    ++misses_;
+    return {};
+}
+
+void
+PathCache::insert(
+    Key const& key,
+    ReadView const& ledger,
+    std::shared_ptr<RankedPaths const> const& paths)
+{
+    // An open ledger has no hash to tell it from the next one
+    if (ledger.open())
+        return;
+
+    std::lock_guard lock(mutex_);
+
+    if (entries_.size() >= maxSize && !entries_.count(key))
+        return;
+
+    entries_[key] = {paths, ledger.info().hash, ledger.info().seq};
+}
+
+void
+PathCache::advance(ReadView const& ledger)
+{
+    if (ledger.open())
+        return;
+
+    std::lock_guard lock(mutex_);
+
+    if (entries_.empty())
+        return;
+
+    auto const& info = ledger.info();
+
+    // What the ledger changed: every account its transactions affected, and
+    // the order books, by taker pays, of every offer they touched.
+    hash_set<AccountID> accounts;
+    hash_set<Issue> books;
+    bool changes = false;
+    auto collect = [&]() {
+        changes = true;
+        for (auto const& [tx, meta] : ledger.txs)
+        {
+            if (!meta)
+                continue;
+
+            TxMeta const txMeta(tx->getTransactionID(), info.seq, *meta);
+            for (auto const& account : txMeta.getAffectedAccounts())
+                accounts.insert(account);
+
+            for (auto const& node : txMeta.getNodes())
+            {
+                if (node.getFieldU16(sfLedgerEntryType) != ltOFFER)
+                    continue;
+
+                auto const& fields = node.getFName() == sfCreatedNode
+                    ? sfNewFields
+                    : sfFinalFields;
+                auto const index = node.getFieldIndex(fields);
+                if (index == -1)
+                    continue;
+
+                auto const inner =
+                    dynamic_cast<STObject const*>(&node.peekAtIndex(index));
+                if (inner && inner->isFieldPresent(sfTakerPays))
+                    books.insert(inner->getFieldAmount(sfTakerPays).issue());
+            }
+        }
+    };
+
+    std::size_t carried = 0;
+    for (auto it = entries_.begin(); it != entries_.end();)
+    {
+        auto& entry = it->second;
+
+        if (entry.ledger == info.hash)
+        {
+            ++it;
+            continue;
+        }
+
+        if (entry.ledger == info.parentHash && info.seq - entry.found < maxAge)
+        {
+            if (!changes)
+                collect();
+
+            auto const& paths = *entry.paths;
+            bool const stale =
+                std::any_of(
+                    paths.accounts.begin(),
+                    paths.accounts.end(),
+                    [&](AccountID const& a) { return accounts.count(a); }) ||
+                std::any_of(
+                    paths.books.begin(),
+                    paths.books.end(),
+                    [&](Issue const& i) { return books.count(i); });
+
+            if (!stale)
+            {
+                entry.ledger = info.hash;
+                ++carried;
+                ++it;
+                continue;
+            }
+        }
+
+        it = entries_.erase(it);
+    }
+
+    JLOG(j_.debug()) << "Carried " << carried << " of " << entries_.size()
+                     << " paths to ledger " << info.seq;
+}
+
+std::size_t
+PathCache::size() const
+{
+    std::lock_guard lock(mutex_);
+    return entries_.size();
+}
+
+std::uint64_t
+PathCache::getHits() const
+{
+    std::lock_guard lock(mutex_);
+    return hits_;
+}
+
+std::uint64_t
+PathCache::getMisses() const
+{
+    std::lock_guard lock(mutex_);
+    return misses_;
+}
+
+}  // namespace ripple
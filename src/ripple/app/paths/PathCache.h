@@ -0,0 +1,146 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_PATHS_PATHCACHE_H_INCLUDED
+#define RIPPLE_APP_PATHS_PATHCACHE_H_INCLUDED
+
+#include <ripple/app/paths/Pathfinder.h>
+#include <ripple/basics/CountedObject.h>
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/ledger/ReadView.h>
+#include <ripple/protocol/Issue.h>
+#include <ripple/protocol/RippleLedgerHash.h>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace ripple {
+
+/** Shares the paths found and ranked by Pathfinder between path requests.
+
+    Clients mostly ask for paths between the same few currencies, and every
+    active path request is recomputed for every ledger. The search and the
+    ranking of its paths are by far the costliest part of pathfinding, so
+    their result is kept here, keyed by everything which shapes the search,
+    with amounts rounded to their decimal order of magnitude.
+
+    A result is found for one ledger. When the next ledger is pathfound, a
+    result is carried forward to it unless the ledger changed an account
+    whose trust lines or settings the search read, or an offer in an order
+    book which it read, and unless it is maxAge ledgers old.
+*/
+class PathCache final : public CountedObject<PathCache>
+{
+public:
+    /** What a search depends on, besides the ledger. */
+    struct Key
+    {
+        AccountID srcAccount;
+        AccountID dstAccount;
+        Currency srcCurrency;
+        std::optional<AccountID> srcIssuer;
+        Issue dstIssue;
+        int dstMagnitude = 0;
+        Issue srcAmountIssue;
+        int srcAmountMagnitude = 0;
+        int searchLevel = 0;
+        int maxPaths = 0;
+
+        friend auto
+        operator<=>(Key const&, Key const&) = default;
+    };
+
+    using RankedPaths = Pathfinder::RankedPaths;
+
+    // How many ledgers a result may be carried forward
+    static constexpr LedgerIndex maxAge = 8;
+
+    // The most results kept
+    static constexpr std::size_t maxSize = 4096;
+
+    explicit PathCache(beast::Journal j);
+
+    /** Make a key for a search.
+
+        @param srcAmount The amount the search may spend, or a negative
+                         amount if it is unlimited.
+        @param dstAmount The amount the search must deliver.
+    */
+    static Key
+    makeKey(
+        AccountID const& srcAccount,
+        AccountID const& dstAccount,
+        Currency const& srcCurrency,
+        std::optional<AccountID> const& srcIssuer,
+        STAmount const& srcAmount,
+        STAmount const& dstAmount,
+        int searchLevel,
+        int maxPaths);
+
+    /** Return the paths of a search on a ledger, if known. */
+    std::shared_ptr<RankedPaths const>
+    fetch(Key const& key, ReadView const& ledger);
+
+    /** Remember the paths of a search on a ledger. */
+    void
+    insert(
+        Key const& key,
+        ReadView const& ledger,
+        std::shared_ptr<RankedPaths const> const& paths);
+
+    /** Carry the results found for the parent of a ledger to that ledger,
+        unless the ledger changed what they were found from.
+    */
+    void
+    advance(ReadView const& ledger);
+
+    std::size_t
+    size() const;
+
+    std::uint64_t
+    getHits() const;
+
+    std::uint64_t
+    getMisses() const;
+
+private:
+    struct Entry
+    {
+        std::shared_ptr<RankedPaths const> paths;
+
+        // The ledger for which the paths are known to be current
+        LedgerHash ledger;
+
+        // The sequence of the ledger the paths were found on
+        LedgerIndex found;
+    };
+
+    beast::Journal const j_;
+
+    std::mutex mutable mutex_;
+    std::map<Key, Entry> entries_;
+    std::uint64_t hits_ = 0;
+    std::uint64_t misses_ = 0;
+};
+
+}  // namespace ripple
+
+#endif
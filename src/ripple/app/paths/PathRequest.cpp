@@ -484,10 +484,19 @@ PathRequest::getPathFinder(
         dst_amount,
         saSendMax,
         app_);
-    if (pathfinder->findPaths(level, continueCallback))
-        pathfinder->computePathRanks(max_paths_, continueCallback);
-    else
-        pathfinder.reset();  // It's a bad request - clear it.
+    if (!pathfinder->findCachedPaths(level, max_paths_))
+    {
+        if (pathfinder->findPaths(level, continueCallback))
+        {
+            pathfinder->computePathRanks(max_paths_, continueCallback);
+
+            // Only share the paths if the search ran to completion
+            if (!continueCallback || continueCallback())
+                pathfinder->cachePaths(level, max_paths_);
+        }
+        else
+            pathfinder.reset();  // It's a bad request - clear it.
+    }
     return currency_map[currency] = std::move(pathfinder);
 }
 
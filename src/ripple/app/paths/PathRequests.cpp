@@ -22,6 +22,7 @@
 #include <ripple/app/paths/PathRequests.h>
 #include <ripple/basics/Log.h>
 #include <ripple/core/JobQueue.h>
+#include <ripple/ledger/CachedSLEs.h>
 #include <ripple/net/RPCErr.h>
 #include <ripple/protocol/ErrorCodes.h>
 #include <ripple/protocol/jss.h>
@@ -58,8 +59,9 @@ PathRequests::getLineCache(
         // Assign to the local before the member, because the member is a
         // weak_ptr, and will immediately discard it if there are no other
         // references.
+        pathCache_->advance(*ledger);
         lineCache_ = lineCache = std::make_shared<RippleLineCache>(
-            ledger, app_.journal("RippleLineCache"));
+            ledger, app_.journal("RippleLineCache"), pathCache_);
     }
     return lineCache;
 }
@@ -69,6 +71,7 @@ PathRequests::updateAll(std::shared_ptr<ReadView const> const& inLedger)
 {
     auto event =
         app_.getJobQueue().makeLoadEvent(jtPATH_FIND, "PathRequest::updateAll");
+    CachedSLEs::Scope const scope(CachedSLEs::Caller::pathfinding);
 
     std::vector<PathRequest::wptr> requests;
     std::shared_ptr<RippleLineCache> cache;
@@ -303,7 +306,7 @@ PathRequests::doLegacyPathRequest(
     Json::Value const& request)
 {
     auto cache = std::make_shared<RippleLineCache>(
-        inLedger, app_.journal("RippleLineCache"));
+        inLedger, app_.journal("RippleLineCache"), pathCache_);
 
     auto req = std::make_shared<PathRequest>(
         app_, [] {}, consumer, ++mLastIdentifier, *this, mJournal);
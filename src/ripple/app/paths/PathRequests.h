@@ -21,6 +21,7 @@
 #define RIPPLE_APP_PATHS_PATHREQUESTS_H_INCLUDED
 
 #include <ripple/app/main/Application.h>
+#include <ripple/app/paths/PathCache.h>
 #include <ripple/app/paths/PathRequest.h>
 #include <ripple/app/paths/RippleLineCache.h>
 #include <ripple/core/Job.h>
@@ -38,7 +39,10 @@ public:
         Application& app,
         beast::Journal journal,
         beast::insight::Collector::ptr const& collector)
-        : app_(app), mJournal(journal), mLastIdentifier(0)
+        : app_(app)
+        , mJournal(journal)
+        , pathCache_(std::make_shared<PathCache>(journal))
+        , mLastIdentifier(0)
     {
         mFast = collector->make_event("pathfind_fast");
         mFull = collector->make_event("pathfind_full");
@@ -114,6 +118,9 @@ private:
     // Use a RippleLineCache
     std::weak_ptr<RippleLineCache> lineCache_;
 
+    // Paths found for earlier ledgers, shared by every request
+    std::shared_ptr<PathCache> const pathCache_;
+
     std::atomic<int> mLastIdentifier;
 
     std::recursive_mutex mutable mLock;
@@ -19,17 +19,21 @@
 
 #include <ripple/app/ledger/OrderBookDB.h>
 #include <ripple/app/main/Application.h>
+#include <ripple/app/paths/PathCache.h>
 #include <ripple/app/paths/Pathfinder.h>
 #include <ripple/app/paths/RippleCalc.h>
 #include <ripple/app/paths/RippleLineCache.h>
 #include <ripple/app/paths/impl/PathfinderUtils.h>
 #include <ripple/basics/Log.h>
+#include <ripple/basics/ParallelFor.h>
 #include <ripple/basics/join.h>
 #include <ripple/core/Config.h>
 #include <ripple/core/JobQueue.h>
 #include <ripple/json/to_string.h>
 #include <ripple/ledger/PaymentSandbox.h>
 
+#include <atomic>
+#include <thread>
 #include <tuple>
 
 /*
@@ -411,6 +415,79 @@ void
 Pathfinder::computePathRanks(
     int maxPaths,
     std::function<bool(void)> const& continueCallback)
+{
+    computeRemainingAmount();
+    rankPaths(maxPaths, mCompletePaths, mPathRanks, continueCallback);
+}
+
+bool
+Pathfinder::findCachedPaths(int searchLevel, int maxPaths)
+{
+    auto const& pathCache = mRLCache->getPathCache();
+    if (!pathCache || !mLedger)
+        return false;
+
+    auto const paths = pathCache->fetch(
+        PathCache::makeKey(
+            mSrcAccount,
+            mDstAccount,
+            mSrcCurrency,
+            mSrcIssuer,
+            mSrcAmount,
+            mDstAmount,
+            searchLevel,
+            maxPaths),
+        *mLedger);
+    if (!paths)
+        return false;
+
+    JLOG(j_.debug()) << "findPaths: " << paths->completePaths.size()
+                     << " cached paths";
+
+    mCompletePaths = paths->completePaths;
+    mPathRanks = paths->pathRanks;
+
+    // The default path depends on the exact amount, and is cheap to find
+    computeRemainingAmount();
+    return true;
+}
+
+void
+Pathfinder::cachePaths(int searchLevel, int maxPaths) const
+{
+    auto const& pathCache = mRLCache->getPathCache();
+    if (!pathCache || !mLedger)
+        return;
+
+    auto paths = std::make_shared<RankedPaths>();
+    paths->completePaths = mCompletePaths;
+    paths->pathRanks = mPathRanks;
+    paths->accounts = mAccountsRead;
+    paths->books = mBooksRead;
+
+    // The ends of the default path, which the ranking also read
+    paths->accounts.insert(mSrcAccount);
+    paths->accounts.insert(mDstAccount);
+    paths->accounts.insert(mEffectiveDst);
+    if (mSrcIssuer)
+        paths->accounts.insert(*mSrcIssuer);
+
+    pathCache->insert(
+        PathCache::makeKey(
+            mSrcAccount,
+            mDstAccount,
+            mSrcCurrency,
+            mSrcIssuer,
+            mSrcAmount,
+            mDstAmount,
+            searchLevel,
+            maxPaths),
+        *mLedger,
+        paths);
+}
+
+void
+Pathfinder::computeRemainingAmount()
 {
     mRemainingAmount = convertAmount(mDstAmount, convert_all_);
 
@@ -447,8 +524,6 @@ Pathfinder::computePathRanks(
     {
         JLOG(j_.debug()) << "Default path causes exception";
     }
-
-    rankPaths(maxPaths, mCompletePaths, mPathRanks, continueCallback);
 }
 
 static bool
@@ -509,34 +584,87 @@ Pathfinder::rankPaths(
         return largestAmount(mDstAmount);
     }();
 
-    for (int i = 0; i < paths.size(); ++i)
+    struct Liquidity
     {
-        if (continueCallback && !continueCallback())
+        TER result;
+        STAmount amount;
+        uint64_t quality;
+    };
+
+    // Every path is checked in a sandbox of its own over the same ledger,
+    // so the paths may be checked on several threads at once. The results
+    // are ranked in the order of the paths, whatever order they finish in.
+    std::vector<std::optional<Liquidity>> liquidities(paths.size());
+    std::atomic<bool> stopped = false;
+
+    // The other threads do arithmetic the way this one does.
+    bool const numberSO = *stNumberSwitchover;
+    bool const amountSO = *stAmountCanonicalizeSwitchover;
+    auto const round = Number::getround();
+    auto const caller = std::this_thread::get_id();
+
+    auto const check = [&](std::size_t i) {
+        // Only the calling thread asks whether to continue.
+        bool const onCaller = std::this_thread::get_id() == caller;
+        if (onCaller && continueCallback && !continueCallback())
+            stopped = true;
+        if (stopped || paths[i].empty())
             return;
-        auto const& currentPath = paths[i];
-        if (!currentPath.empty())
+
+        std::optional<NumberSO> stNumberSO;
+        std::optional<STAmountSO> stAmountSO;
+        std::optional<saveNumberRoundMode> saved;
+        if (!onCaller)
         {
-            STAmount liquidity;
-            uint64_t uQuality;
-            auto const resultCode = getPathLiquidity(
-                currentPath, saMinDstAmount, liquidity, uQuality);
-            if (!isTesSuccess(resultCode))
-            {
-                JLOG(j_.debug())
-                    << "findPaths: dropping : " << transToken(resultCode)
-                    << ": " << currentPath.getJson(JsonOptions::none);
-            }
-            else
-            {
-                JLOG(j_.debug()) << "findPaths: quality: " << uQuality << ": "
-                                 << currentPath.getJson(JsonOptions::none);
+            stNumberSO.emplace(numberSO);
+            stAmountSO.emplace(amountSO);
+            saved.emplace(Number::setround(round));
+        }
 
-                rankedPaths.push_back(
-                    {uQuality, currentPath.size(), liquidity, i});
-            }
+        Liquidity l{tesSUCCESS, STAmount{}, 0};
+        l.result =
+            getPathLiquidity(paths[i], saMinDstAmount, l.amount, l.quality);
+        liquidities[i] = std::move(l);
+    };
+
+    parallelFor(
+        paths.size(),
+        app_.config().PATH_SEARCH_THREADS - 1,
+        [this](std::function<void()> work) {
+            return app_.getJobQueue().addJob(
+                jtCLIENT_RPC, "Pathfinder::rankPaths", std::move(work));
+        },
+        check);
+
+    for (int i = 0; i < paths.size(); ++i)
+    {
+        auto const& currentPath = paths[i];
+        auto const& liquidity = liquidities[i];
+        if (!liquidity)
+            continue;
+
+        if (!isTesSuccess(liquidity->result))
+        {
+            JLOG(j_.debug())
+                << "findPaths: dropping : " << transToken(liquidity->result)
+                << ": " << currentPath.getJson(JsonOptions::none);
+        }
+        else
+        {
+            JLOG(j_.debug()) << "findPaths: quality: " << liquidity->quality
+                             << ": " << currentPath.getJson(JsonOptions::none);
+
+            rankedPaths.push_back(
+                {liquidity->quality,
+                 currentPath.size(),
+                 liquidity->amount,
+                 i});
         }
     }
 
+    if (stopped)
+        return;
+
     // Sort paths by:
     //    cost of path (when considering quality)
     //    width of path
@@ -721,6 +849,7 @@ Pathfinder::getPathsOut(
     if (!inserted)
         return it->second;
 
+    mAccountsRead.insert(account);
     auto sleAccount = mLedger->read(keylet::account(account));
 
     if (!sleAccount)
@@ -734,6 +863,7 @@ Pathfinder::getPathsOut(
 
     if (!bFrozen)
     {
+        mBooksRead.insert(issue);
         count = app_.getOrderBookDB().getBookSize(issue);
 
         if (auto const lines = mRLCache->getRippleLines(account, direction))
@@ -887,6 +1017,8 @@ Pathfinder::isNoRipple(
     AccountID const& toAccount,
     Currency const& currency)
 {
+    mAccountsRead.insert(fromAccount);
+    mAccountsRead.insert(toAccount);
     auto sleRipple =
         mLedger->read(keylet::line(toAccount, fromAccount, currency));
 
@@ -970,6 +1102,7 @@ Pathfinder::addLink(
         else
         {
             // search for accounts to add
+            mAccountsRead.insert(uEndAccount);
             auto const sleEnd = mLedger->read(keylet::account(uEndAccount));
 
             if (sleEnd)
@@ -1118,6 +1251,8 @@ Pathfinder::addLink(
         if (addFlags & afOB_XRP)
         {
             // to XRP only
+            if (!bOnXRP)
+                mBooksRead.insert({uEndCurrency, uEndIssuer});
             if (!bOnXRP &&
                 app_.getOrderBookDB().isBookToXRP({uEndCurrency, uEndIssuer}))
             {
@@ -1132,6 +1267,7 @@ Pathfinder::addLink(
         else
         {
             bool bDestOnly = (addFlags & afOB_LAST) != 0;
+            mBooksRead.insert({uEndCurrency, uEndIssuer});
             auto books = app_.getOrderBookDB().getBooksByTakerPays(
                 {uEndCurrency, uEndIssuer});
             JLOG(j_.trace())
@@ -23,6 +23,7 @@
 #include <ripple/app/ledger/Ledger.h>
 #include <ripple/app/paths/RippleLineCache.h>
 #include <ripple/basics/CountedObject.h>
+#include <ripple/basics/UnorderedContainers.h>
 #include <ripple/core/LoadEvent.h>
 #include <ripple/protocol/STAmount.h>
 #include <ripple/protocol/STPathSet.h>
@@ -67,6 +68,25 @@ public:
         int maxPaths,
         std::function<bool(void)> const& continueCallback = {});
 
+    /** Use the ranked paths of an equivalent search, if the path cache of
+        the line cache has one for this ledger.
+
+        On success, the pathfinder is ready for getBestPaths() and neither
+        findPaths() nor computePathRanks() should be called.
+
+        @return `true` if cached paths were found.
+    */
+    bool
+    findCachedPaths(int searchLevel, int maxPaths);
+
+    /** Offer the paths found by findPaths() and ranked by
+        computePathRanks() to the path cache of the line cache.
+
+        Only call this if neither search was cut short.
+    */
+    void
+    cachePaths(int searchLevel, int maxPaths) const;
+
     /* Get the best paths, up to maxPaths in number, from mCompletePaths.
 
        On return, if fullLiquidityPath is not empty, then it contains the best
@@ -110,6 +130,19 @@ public:
         int index;
     };
 
+    /** The result of a search, and the ledger state it was found from. */
+    struct RankedPaths
+    {
+        STPathSet completePaths;
+        std::vector<PathRank> pathRanks;
+
+        // The accounts whose trust lines or settings the search read
+        hash_set<AccountID> accounts;
+
+        // The issues whose order books, by taker pays, the search read
+        hash_set<Issue> books;
+    };
+
 private:
     /*
       Call graph of Pathfinder methods.
@@ -131,6 +164,10 @@ private:
       getBestPaths
      */
 
+    // Remove the liquidity of the default path from mRemainingAmount.
+    void
+    computeRemainingAmount();
+
     // Add all paths of one type to mCompletePaths.
     STPathSet&
     addPathsForType(
@@ -216,6 +253,10 @@ private:
 
     hash_map<Issue, int> mPathsOutCountMap;
 
+    // What the search read, so that cached paths can be invalidated
+    hash_set<AccountID> mAccountsRead;
+    hash_set<Issue> mBooksRead;
+
     Application& app_;
     beast::Journal const j_;
 
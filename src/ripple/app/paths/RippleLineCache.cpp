@@ -25,8 +25,9 @@ namespace ripple {
 
 RippleLineCache::RippleLineCache(
     std::shared_ptr<ReadView const> const& ledger,
-    beast::Journal j)
-    : ledger_(ledger), journal_(j)
+    beast::Journal j,
+    std::shared_ptr<PathCache> pathCache)
+    : ledger_(ledger), pathCache_(std::move(pathCache)), journal_(j)
 {
     JLOG(journal_.debug()) << "created for ledger " << ledger_->info().seq;
 }
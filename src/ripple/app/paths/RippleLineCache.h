@@ -32,13 +32,16 @@
 
 namespace ripple {
 
+class PathCache;
+
 // Used by Pathfinder
 class RippleLineCache final : public CountedObject<RippleLineCache>
 {
 public:
     explicit RippleLineCache(
         std::shared_ptr<ReadView const> const& l,
-        beast::Journal j);
+        beast::Journal j,
+        std::shared_ptr<PathCache> pathCache = {});
     ~RippleLineCache();
 
     std::shared_ptr<ReadView const> const&
@@ -47,6 +50,15 @@ public:
         return ledger_;
     }
 
+    /** The cache of ranked paths shared by the pathfinders which use this
+        line cache, or null if they do not share their paths.
+    */
+    std::shared_ptr<PathCache> const&
+    getPathCache() const
+    {
+        return pathCache_;
+    }
+
     /** Find the trust lines associated with an account.
 
        @param accountID The account
@@ -67,6 +79,7 @@ private:
 
     ripple::hardened_hash<> hasher_;
     std::shared_ptr<ReadView const> ledger_;
+    std::shared_ptr<PathCache> const pathCache_;
 
     beast::Journal journal_;
 
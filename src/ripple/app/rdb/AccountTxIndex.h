@@ -0,0 +1,151 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_RDB_ACCOUNTTXINDEX_H_INCLUDED
+#define RIPPLE_APP_RDB_ACCOUNTTXINDEX_H_INCLUDED
+
+#include <ripple/basics/base_uint.h>
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/core/Config.h>
+#include <ripple/core/DatabaseCon.h>
+#include <ripple/protocol/AccountID.h>
+#include <ripple/protocol/Protocol.h>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace ripple {
+
+/**
+ * @brief AccountTxIndex is an append-only history of the transactions which
+ *        affected each account, kept in an embedded key-value store instead
+ *        of the AccountTransactions table of the transaction database.
+ *
+ *        The entries of an account are stored contiguously and sorted by
+ *        (ledger sequence, transaction sequence), so a page of an account's
+ *        history is found with one seek and read with a sequential scan,
+ *        however deep into the history it starts. The transactions
+ *        themselves stay in the Transactions table; the index only maps
+ *        positions in an account's history to transaction IDs.
+ */
+class AccountTxIndex
+{
+public:
+    /** A position in the history of an account. */
+    struct Position
+    {
+        std::uint32_t ledgerSeq = 0;
+        std::uint32_t txnSeq = 0;
+
+        friend auto
+        operator<=>(Position const&, Position const&) = default;
+    };
+
+    /** A transaction which affected an account. */
+    struct Entry
+    {
+        AccountID account;
+        std::uint32_t txnSeq;
+        uint256 txID;
+    };
+
+    virtual ~AccountTxIndex() = default;
+
+    /**
+     * @brief saveLedger Replaces the entries of a ledger with the given
+     *        ones, in a single atomic write.
+     * @param ledgerSeq Ledger sequence.
+     * @param entries The transactions of the ledger and the accounts each
+     *        of them affected.
+     */
+    virtual void
+    saveLedger(LedgerIndex ledgerSeq, std::vector<Entry> const& entries) = 0;
+
+    /**
+     * @brief deleteBeforeLedgerSeq Deletes the entries of all ledgers
+     *        before the given one.
+     * @param ledgerSeq Ledger sequence.
+     */
+    virtual void
+    deleteBeforeLedgerSeq(LedgerIndex ledgerSeq) = 0;
+
+    /**
+     * @brief getMinLedgerSeq Returns the lowest ledger sequence with
+     *        entries in the index.
+     * @return Ledger sequence or no value if the index is empty.
+     */
+    virtual std::optional<LedgerIndex>
+    getMinLedgerSeq() = 0;
+
+    /**
+     * @brief getEntryCount Returns the number of entries in the index,
+     *        which is kept up to date as the index changes.
+     * @return Number of (account, transaction) entries.
+     */
+    virtual std::size_t
+    getEntryCount() = 0;
+
+    /**
+     * @brief forEach Visits the history of an account between two
+     *        positions, both included, until the callback returns false.
+     *        The history is visited in ascending order if `from` is not
+     *        after `to` and in descending order otherwise.
+     * @param account The account.
+     * @param from The first position to visit.
+     * @param to The last position to visit.
+     * @param visit Callback function to call with the position and ID of
+     *        each transaction.
+     */
+    virtual void
+    forEach(
+        AccountID const& account,
+        Position const& from,
+        Position const& to,
+        std::function<bool(Position const&, uint256 const&)> const& visit) = 0;
+};
+
+/**
+ * @brief makeAccountTxIndex Opens the account transaction index selected by
+ *        the `account_tx_index` key of the [relational_db] section.
+ *
+ *        The index is kept at the path given by `account_tx_path`, which
+ *        defaults to the "account_tx" directory of the database path.
+ * @param config Config object.
+ * @param j Journal.
+ * @return The index, or null if the AccountTransactions table is used.
+ */
+std::unique_ptr<AccountTxIndex>
+makeAccountTxIndex(Config const& config, beast::Journal j);
+
+/**
+ * @brief doMigrateAccountTxDB Copies the AccountTransactions table of the
+ *        transaction database into the configured account transaction
+ *        index.
+ * @param config Config object.
+ * @param setup Path to the transaction database and other opening
+ *        parameters.
+ * @return True if the migration completed successfully.
+ */
+bool
+doMigrateAccountTxDB(Config const& config, DatabaseCon::Setup const& setup);
+
+}  // namespace ripple
+
+#endif
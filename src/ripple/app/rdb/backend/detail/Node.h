@@ -22,6 +22,7 @@
 
 #include <ripple/app/ledger/Ledger.h>
 #include <ripple/app/misc/Manifest.h>
+#include <ripple/app/rdb/AccountTxIndex.h>
 #include <ripple/app/rdb/RelationalDatabase.h>
 #include <ripple/core/Config.h>
 #include <ripple/overlay/PeerReservationTable.h>
@@ -127,6 +128,9 @@ getRowsMinMax(soci::session& session, TableType type);
  * @param app Application object.
  * @param ledger The ledger.
  * @param current True if ledger is current.
+ * @param accountTxIndex The account transaction index to save the accounts
+ *        affected by each transaction to, or null to save them to the
+ *        AccountTransactions table.
  * @return True is saving was successfull.
  */
 bool
@@ -135,7 +139,70 @@ saveValidatedLedger(
     DatabaseCon& txnDB,
     Application& app,
     std::shared_ptr<Ledger const> const& ledger,
-    bool current);
+    bool current,
+    AccountTxIndex* accountTxIndex = nullptr);
+
+/**
+ * @brief ValidatedLedgerRows holds what saving a validated ledger writes to
+ *        the transaction database, built before the database is taken.
+ */
+struct ValidatedLedgerRows
+{
+    std::shared_ptr<Ledger const> ledger;
+
+    /** The values of each Transactions row, from STTx::getMetaSQL(). */
+    std::vector<std::string> transactions;
+
+    /** The values of each AccountTransactions row. */
+    std::vector<std::string> accountTransactions;
+
+    /** The ID and sequence in the ledger of each transaction. */
+    std::vector<std::pair<uint256, std::uint32_t>> txns;
+
+    /** The entries for the account transaction index, if it is used. */
+    std::vector<AccountTxIndex::Entry> indexEntries;
+};
+
+/**
+ * @brief makeValidatedLedgerRows Checks a validated ledger, stores its
+ *        header in the node store and builds the rows which save it.
+ *        This is the part of saving a ledger which needs no database,
+ *        so several ledgers may be prepared while another is written.
+ * @param app Application object.
+ * @param ledger The ledger.
+ * @param current True if ledger is current.
+ * @param indexed True if the accounts affected by each transaction are
+ *        saved to the account transaction index rather than to the
+ *        AccountTransactions table.
+ * @return The rows, or no value if the ledger is missing nodes.
+ */
+std::optional<ValidatedLedgerRows>
+makeValidatedLedgerRows(
+    Application& app,
+    std::shared_ptr<Ledger const> const& ledger,
+    bool current,
+    bool indexed);
+
+/**
+ * @brief writeValidatedLedgers Writes the rows of one or more validated
+ *        ledgers, in a single database transaction per database.
+ *        Transactions rows and AccountTransactions rows are written with
+ *        one multi-row statement per table and ledger.
+ * @param lgrDB Link to ledgers database.
+ * @param txnDB Link to transactions database.
+ * @param app Application object.
+ * @param batch The rows of the ledgers, as built by makeValidatedLedgerRows.
+ * @param accountTxIndex The account transaction index to save the accounts
+ *        affected by each transaction to, or null to save them to the
+ *        AccountTransactions table.
+ */
+void
+writeValidatedLedgers(
+    DatabaseCon& ldgDB,
+    DatabaseCon& txnDB,
+    Application& app,
+    std::vector<ValidatedLedgerRows> const& batch,
+    AccountTxIndex* accountTxIndex = nullptr);
 
 /**
  * @brief getLedgerInfoByIndex Returns ledger by its sequence.
@@ -446,6 +513,66 @@ newestAccountTxPage(
     int limit_used,
     std::uint32_t page_length);
 
+/**
+ * @brief indexedAccountTxPage Searches the transactions of the given
+ *        account in the account transaction index, starting from the given
+ *        marker, and calls the callback with each found transaction as
+ *        read from the Transactions table.
+ * @param session Session with database.
+ * @param index The account transaction index.
+ * @param onUnsavedLedger Callback function to call on each found unsaved
+ *        ledger within given range.
+ * @param onTransaction Callback function to call on each found transaction.
+ * @param options Struct AccountTxPageOptions which contain criteria to
+ *        match: the account, minimum and maximum ledger numbers to search,
+ *        marker of first returned entry, number of transactions to return,
+ *        flag if this number unlimited.
+ * @param page_length Total number of transactions to return.
+ * @param forward True for ascending order, false for descending.
+ * @return Marker for the next search if the search was not finished.
+ */
+std::optional<RelationalDatabase::AccountTxMarker>
+indexedAccountTxPage(
+    soci::session& session,
+    AccountTxIndex& index,
+    std::function<void(std::uint32_t)> const& onUnsavedLedger,
+    std::function<
+        void(std::uint32_t, std::string const&, Blob&&, Blob&&)> const&
+        onTransaction,
+    RelationalDatabase::AccountTxPageOptions const& options,
+    std::uint32_t page_length,
+    bool forward);
+
+/**
+ * @brief indexedAccountTxs Searches the transactions of the given account
+ *        in the account transaction index, starting from the given offset,
+ *        and calls the callback with each found transaction as read from
+ *        the Transactions table.
+ * @param session Session with database.
+ * @param index The account transaction index.
+ * @param onUnsavedLedger Callback function to call on each found unsaved
+ *        ledger within given range.
+ * @param onTransaction Callback function to call on each found transaction.
+ * @param options Struct AccountTxOptions which contain criteria to match:
+ *        the account, minimum and maximum ledger numbers to search,
+ *        offset of first entry to return, number of transactions to return,
+ *        flag if this number unlimited.
+ * @param binary True if the transactions are returned in binary form,
+ *        which allows longer pages.
+ * @param descending True for descending order, false for ascending.
+ */
+void
+indexedAccountTxs(
+    soci::session& session,
+    AccountTxIndex& index,
+    std::function<void(std::uint32_t)> const& onUnsavedLedger,
+    std::function<
+        void(std::uint32_t, std::string const&, Blob&&, Blob&&)> const&
+        onTransaction,
+    RelationalDatabase::AccountTxOptions const& options,
+    bool binary,
+    bool descending);
+
 /**
  * @brief getTransaction Returns transaction with given hash. If not found
  *        and range given then check if all ledgers from the range are
@@ -183,18 +183,16 @@ getRowsMinMax(soci::session& session, TableType type)
     return res;
 }
 
-bool
-saveValidatedLedger(
-    DatabaseCon& ldgDB,
-    DatabaseCon& txnDB,
+std::optional<ValidatedLedgerRows>
+makeValidatedLedgerRows(
     Application& app,
     std::shared_ptr<Ledger const> const& ledger,
-    bool current)
+    bool current,
+    bool indexed)
 {
     auto j = app.journal("Ledger");
     auto seq = ledger->info().seq;
 
-    // TODO(tom): Fix this hard-coded SQL!
     JLOG(j.trace()) << "saveValidatedLedger " << (current ? "" : "fromAcquire ")
                     << seq;
 
@@ -242,144 +240,270 @@ saveValidatedLedger(
         // Clients can now trust the database for information about this
         // ledger sequence.
         app.pendingSaves().finishWork(seq);
-        return false;
+        return {};
     }
 
+    ValidatedLedgerRows rows;
+    rows.ledger = ledger;
+
+    if (!app.config().useTxTables())
+        return rows;
+
+    std::string const ledgerSeq(std::to_string(seq));
+
+    rows.transactions.reserve(aLedger->size());
+    rows.txns.reserve(aLedger->size());
+
+    for (auto const& acceptedLedgerTx : *aLedger)
     {
-        static boost::format deleteLedger(
-            "DELETE FROM Ledgers WHERE LedgerSeq = %u;");
-        static boost::format deleteTrans1(
-            "DELETE FROM Transactions WHERE LedgerSeq = %u;");
-        static boost::format deleteTrans2(
-            "DELETE FROM AccountTransactions WHERE LedgerSeq = %u;");
-        static boost::format deleteAcctTrans(
-            "DELETE FROM AccountTransactions WHERE TransID = '%s';");
+        uint256 transactionID = acceptedLedgerTx->getTransactionID();
 
+        std::string const txnId(to_string(transactionID));
+        std::string const txnSeq(std::to_string(acceptedLedgerTx->getTxnSeq()));
+
+        auto const& accts = acceptedLedgerTx->getAffected();
+
+        for (auto const& account : accts)
         {
-            auto db = ldgDB.checkoutDb();
-            *db << boost::str(deleteLedger % seq);
+            if (indexed)
+            {
+                rows.indexEntries.push_back(
+                    {account, acceptedLedgerTx->getTxnSeq(), transactionID});
+                continue;
+            }
+
+            // Try to make an educated guess on how much space we'll need
+            // for our arguments. In argument order we have: 64 + 34 + 10
+            // + 10 = 118 + 10 extra = 128 bytes
+            std::string row;
+            row.reserve(128);
+            row += "('";
+            row += txnId;
+            row += "','";
+            row += toBase58(account);
+            row += "',";
+            row += ledgerSeq;
+            row += ",";
+            row += txnSeq;
+            row += ")";
+            rows.accountTransactions.push_back(std::move(row));
         }
 
-        if (app.config().useTxTables())
+        if (accts.empty())
         {
-            auto db = txnDB.checkoutDb();
+            if (auto const& sleTxn = acceptedLedgerTx->getTxn();
+                !isPseudoTx(*sleTxn))
+            {
+                // It's okay for pseudo transactions to not affect any
+                // accounts.  But otherwise...
+                JLOG(j.warn()) << "Transaction in ledger " << seq
+                               << " affects no accounts";
+                JLOG(j.warn()) << sleTxn->getJson(JsonOptions::none);
+            }
+        }
 
-            soci::transaction tr(*db);
+        rows.transactions.push_back(acceptedLedgerTx->getTxn()->getMetaSQL(
+            seq, acceptedLedgerTx->getEscMeta()));
+        rows.txns.emplace_back(transactionID, acceptedLedgerTx->getTxnSeq());
+    }
 
-            *db << boost::str(deleteTrans1 % seq);
-            *db << boost::str(deleteTrans2 % seq);
+    return rows;
+}
 
-            std::string const ledgerSeq(std::to_string(seq));
+/**
+ * @brief insertRows Runs a multi-row statement, in chunks small enough
+ *        for SQLite, for each of the given rows.
+ * @param session Session with database.
+ * @param header The statement, up to and including "VALUES ".
+ * @param rows The values of each row, including their parentheses.
+ */
+static void
+insertRows(
+    soci::session& session,
+    std::string const& header,
+    std::vector<std::string> const& rows)
+{
+    // SQLite before 3.8.8 limits a VALUES list to 500 rows
+    static constexpr std::size_t maxRowsPerStatement = 500;
 
-            for (auto const& acceptedLedgerTx : *aLedger)
-            {
-                uint256 transactionID = acceptedLedgerTx->getTransactionID();
+    std::string sql;
+    for (std::size_t i = 0; i < rows.size(); i += maxRowsPerStatement)
+    {
+        auto const end = std::min(rows.size(), i + maxRowsPerStatement);
+
+        sql = header;
+        for (std::size_t k = i; k < end; ++k)
+        {
+            if (k != i)
+                sql += ", ";
+            sql += rows[k];
+        }
+        sql += ";";
+        session << sql;
+    }
+}
+
+void
+writeValidatedLedgers(
+    DatabaseCon& ldgDB,
+    DatabaseCon& txnDB,
+    Application& app,
+    std::vector<ValidatedLedgerRows> const& batch,
+    AccountTxIndex* accountTxIndex)
+{
+    // TODO(tom): Fix this hard-coded SQL!
+    static boost::format deleteLedger(
+        "DELETE FROM Ledgers WHERE LedgerSeq = %u;");
+    static boost::format deleteTrans1(
+        "DELETE FROM Transactions WHERE LedgerSeq = %u;");
+    static boost::format deleteTrans2(
+        "DELETE FROM AccountTransactions WHERE LedgerSeq = %u;");
+    static std::string const& insertTrans =
+        STTx::getMetaSQLInsertReplaceHeader();
+    static std::string const insertAcctTrans(
+        "INSERT INTO AccountTransactions "
+        "(TransID, Account, LedgerSeq, TxnSeq) VALUES ");
+
+    {
+        auto db = ldgDB.checkoutDb();
+        soci::transaction tr(*db);
+        for (auto const& rows : batch)
+            *db << boost::str(deleteLedger % rows.ledger->info().seq);
+        tr.commit();
+    }
 
-                std::string const txnId(to_string(transactionID));
-                std::string const txnSeq(
-                    std::to_string(acceptedLedgerTx->getTxnSeq()));
+    if (app.config().useTxTables())
+    {
+        auto db = txnDB.checkoutDb();
 
-                *db << boost::str(deleteAcctTrans % transactionID);
+        soci::transaction tr(*db);
 
-                auto const& accts = acceptedLedgerTx->getAffected();
+        std::string sql;
+        for (auto const& rows : batch)
+        {
+            auto const seq = rows.ledger->info().seq;
 
-                if (!accts.empty())
+            *db << boost::str(deleteTrans1 % seq);
+            if (accountTxIndex)
+            {
+                insertRows(*db, insertTrans, rows.transactions);
+
+                // Index the ledger before its transactions are committed.
+                // If the commit then fails, readers skip the entries whose
+                // transactions are missing, and saving the ledger again
+                // replaces them.
+                accountTxIndex->saveLedger(seq, rows.indexEntries);
+                continue;
+            }
+
+            *db << boost::str(deleteTrans2 % seq);
+
+            // The transactions may have been saved in another ledger
+            if (!rows.txns.empty())
+            {
+                sql = "DELETE FROM AccountTransactions WHERE TransID IN (";
+                bool first = true;
+                for (auto const& [id, txnSeq] : rows.txns)
                 {
-                    std::string sql(
-                        "INSERT INTO AccountTransactions "
-                        "(TransID, Account, LedgerSeq, TxnSeq) VALUES ");
-
-                    // Try to make an educated guess on how much space we'll
-                    // need for our arguments. In argument order we have: 64
-                    // + 34 + 10 + 10 = 118 + 10 extra = 128 bytes
-                    sql.reserve(sql.length() + (accts.size() * 128));
-
-                    bool first = true;
-                    for (auto const& account : accts)
-                    {
-                        if (!first)
-                            sql += ", ('";
-                        else
-                        {
-                            sql += "('";
-                            first = false;
-                        }
-
-                        sql += txnId;
-                        sql += "','";
-                        sql += toBase58(account);
-                        sql += "',";
-                        sql += ledgerSeq;
+                    if (!first)
                         sql += ",";
-                        sql += txnSeq;
-                        sql += ")";
-                    }
-                    sql += ";";
-                    JLOG(j.trace()) << "ActTx: " << sql;
-                    *db << sql;
+                    first = false;
+                    sql += "'";
+                    sql += to_string(id);
+                    sql += "'";
                 }
-                else if (auto const& sleTxn = acceptedLedgerTx->getTxn();
-                         !isPseudoTx(*sleTxn))
-                {
-                    // It's okay for pseudo transactions to not affect any
-                    // accounts.  But otherwise...
-                    JLOG(j.warn()) << "Transaction in ledger " << seq
-                                   << " affects no accounts";
-                    JLOG(j.warn()) << sleTxn->getJson(JsonOptions::none);
-                }
-
-                *db
-                    << (STTx::getMetaSQLInsertReplaceHeader() +
-                        acceptedLedgerTx->getTxn()->getMetaSQL(
-                            seq, acceptedLedgerTx->getEscMeta()) +
-                        ";");
-
-                app.getMasterTransaction().inLedger(
-                    transactionID,
-                    seq,
-                    acceptedLedgerTx->getTxnSeq(),
-                    app.config().NETWORK_ID);
+                sql += ");";
+                *db << sql;
             }
 
-            tr.commit();
+            insertRows(*db, insertAcctTrans, rows.accountTransactions);
+            insertRows(*db, insertTrans, rows.transactions);
         }
 
+        tr.commit();
+
+        for (auto const& rows : batch)
         {
-            static std::string addLedger(
-                R"sql(INSERT OR REPLACE INTO Ledgers
+            auto const seq = rows.ledger->info().seq;
+
+            for (auto const& [id, txnSeq] : rows.txns)
+                app.getMasterTransaction().inLedger(
+                    id, seq, txnSeq, app.config().NETWORK_ID);
+        }
+    }
+
+    {
+        static std::string addLedger(
+            R"sql(INSERT OR REPLACE INTO Ledgers
                 (LedgerHash,LedgerSeq,PrevHash,TotalCoins,ClosingTime,PrevClosingTime,
                 CloseTimeRes,CloseFlags,AccountSetHash,TransSetHash)
             VALUES
                 (:ledgerHash,:ledgerSeq,:prevHash,:totalCoins,:closingTime,:prevClosingTime,
                 :closeTimeRes,:closeFlags,:accountSetHash,:transSetHash);)sql");
 
-            auto db(ldgDB.checkoutDb());
-
-            soci::transaction tr(*db);
-
-            auto const hash = to_string(ledger->info().hash);
-            auto const parentHash = to_string(ledger->info().parentHash);
-            auto const drops = to_string(ledger->info().drops);
-            auto const closeTime =
-                ledger->info().closeTime.time_since_epoch().count();
-            auto const parentCloseTime =
-                ledger->info().parentCloseTime.time_since_epoch().count();
-            auto const closeTimeResolution =
-                ledger->info().closeTimeResolution.count();
-            auto const closeFlags = ledger->info().closeFlags;
-            auto const accountHash = to_string(ledger->info().accountHash);
-            auto const txHash = to_string(ledger->info().txHash);
-
-            *db << addLedger, soci::use(hash), soci::use(seq),
-                soci::use(parentHash), soci::use(drops), soci::use(closeTime),
-                soci::use(parentCloseTime), soci::use(closeTimeResolution),
-                soci::use(closeFlags), soci::use(accountHash),
-                soci::use(txHash);
-
-            tr.commit();
+        auto db(ldgDB.checkoutDb());
+
+        soci::transaction tr(*db);
+
+        std::string hash, parentHash, drops, accountHash, txHash;
+        LedgerIndex seq = 0;
+        NetClock::rep closeTime = 0, parentCloseTime = 0;
+        NetClock::rep closeTimeResolution = 0;
+        decltype(LedgerInfo::closeFlags) closeFlags = 0;
+
+        // Prepared once, for every ledger of the batch
+        soci::statement st =
+            (db->prepare << addLedger,
+             soci::use(hash),
+             soci::use(seq),
+             soci::use(parentHash),
+             soci::use(drops),
+             soci::use(closeTime),
+             soci::use(parentCloseTime),
+             soci::use(closeTimeResolution),
+             soci::use(closeFlags),
+             soci::use(accountHash),
+             soci::use(txHash));
+
+        for (auto const& rows : batch)
+        {
+            auto const& info = rows.ledger->info();
+
+            hash = to_string(info.hash);
+            seq = info.seq;
+            parentHash = to_string(info.parentHash);
+            drops = to_string(info.drops);
+            closeTime = info.closeTime.time_since_epoch().count();
+            parentCloseTime = info.parentCloseTime.time_since_epoch().count();
+            closeTimeResolution = info.closeTimeResolution.count();
+            closeFlags = info.closeFlags;
+            accountHash = to_string(info.accountHash);
+            txHash = to_string(info.txHash);
+
+            st.execute(true);
         }
+
+        tr.commit();
     }
+}
+
+bool
+saveValidatedLedger(
+    DatabaseCon& ldgDB,
+    DatabaseCon& txnDB,
+    Application& app,
+    std::shared_ptr<Ledger const> const& ledger,
+    bool current,
+    AccountTxIndex* accountTxIndex)
+{
+    auto rows = makeValidatedLedgerRows(
+        app, ledger, current, accountTxIndex != nullptr);
+    if (!rows)
+        return false;
 
+    std::vector<ValidatedLedgerRows> batch;
+    batch.push_back(std::move(*rows));
+    writeValidatedLedgers(ldgDB, txnDB, app, batch, accountTxIndex);
     return true;
 }
 
@@ -1290,6 +1414,208 @@ newestAccountTxPage(
         false);
 }
 
+/**
+ * @brief forEachIndexedTransaction Reads the transactions of an account
+ *        between two positions of its history in the account transaction
+ *        index from the Transactions table, and calls the callback with
+ *        each of them until it returns false. Index entries for which the
+ *        Transactions table has no row in the same ledger, because the
+ *        ledger was saved again or deleted since, are skipped.
+ * @param session Session with database.
+ * @param index The account transaction index.
+ * @param account The account.
+ * @param from The first position to visit.
+ * @param to The last position to visit.
+ * @param onTransaction Callback function to call on each found transaction.
+ */
+static void
+forEachIndexedTransaction(
+    soci::session& session,
+    AccountTxIndex& index,
+    AccountID const& account,
+    AccountTxIndex::Position const& from,
+    AccountTxIndex::Position const& to,
+    std::function<bool(
+        AccountTxIndex::Position const&,
+        std::string const&,
+        Blob&&,
+        Blob&&)> const& onTransaction)
+{
+    std::string txnId;
+
+    // SOCI requires boost::optional (not std::optional) as parameters.
+    boost::optional<std::uint64_t> ledgerSeq;
+    boost::optional<std::string> status;
+    soci::blob txnData(session);
+    soci::blob txnMeta(session);
+    soci::indicator dataPresent, metaPresent;
+
+    soci::statement st =
+        (session.prepare << "SELECT LedgerSeq,Status,RawTxn,TxnMeta "
+                            "FROM Transactions WHERE TransID = :id;",
+         soci::use(txnId),
+         soci::into(ledgerSeq),
+         soci::into(status),
+         soci::into(txnData, dataPresent),
+         soci::into(txnMeta, metaPresent));
+
+    Blob rawData;
+    Blob rawMeta;
+
+    index.forEach(
+        account,
+        from,
+        to,
+        [&](AccountTxIndex::Position const& pos, uint256 const& id) {
+            txnId = to_string(id);
+            if (!st.execute(true) || ledgerSeq.value_or(0) != pos.ledgerSeq)
+                return true;
+
+            if (dataPresent == soci::i_ok)
+                convert(txnData, rawData);
+            else
+                rawData.clear();
+
+            if (metaPresent == soci::i_ok)
+                convert(txnMeta, rawMeta);
+            else
+                rawMeta.clear();
+
+            return onTransaction(
+                pos,
+                status.value_or(""),
+                std::move(rawData),
+                std::move(rawMeta));
+        });
+}
+
+std::optional<RelationalDatabase::AccountTxMarker>
+indexedAccountTxPage(
+    soci::session& session,
+    AccountTxIndex& index,
+    std::function<void(std::uint32_t)> const& onUnsavedLedger,
+    std::function<
+        void(std::uint32_t, std::string const&, Blob&&, Blob&&)> const&
+        onTransaction,
+    RelationalDatabase::AccountTxPageOptions const& options,
+    std::uint32_t page_length,
+    bool forward)
+{
+    std::uint32_t numberOfResults;
+
+    if (options.limit == 0 || options.limit == UINT32_MAX ||
+        (options.limit > page_length && !options.bAdmin))
+        numberOfResults = page_length;
+    else
+        numberOfResults = options.limit;
+
+    // The marker is the position of the first transaction to return.
+    AccountTxIndex::Position const first{
+        options.minLedger, std::numeric_limits<std::uint32_t>::min()};
+    AccountTxIndex::Position const last{
+        options.maxLedger, std::numeric_limits<std::uint32_t>::max()};
+
+    AccountTxIndex::Position from = forward ? first : last;
+    if (options.marker)
+        from = {options.marker->ledgerSeq, options.marker->txnSeq};
+    auto const to = forward ? last : first;
+
+    if (forward ? to < from : from < to)
+        return {};
+
+    std::optional<RelationalDatabase::AccountTxMarker> newmarker;
+    forEachIndexedTransaction(
+        session,
+        index,
+        options.account,
+        from,
+        to,
+        [&](AccountTxIndex::Position const& pos,
+            std::string const& status,
+            Blob&& rawData,
+            Blob&& rawMeta) {
+            if (numberOfResults == 0)
+            {
+                newmarker = {pos.ledgerSeq, pos.txnSeq};
+                return false;
+            }
+
+            // Work around a bug that could leave the metadata missing
+            if (rawMeta.size() == 0)
+                onUnsavedLedger(pos.ledgerSeq);
+
+            onTransaction(
+                pos.ledgerSeq, status, std::move(rawData), std::move(rawMeta));
+            --numberOfResults;
+            return true;
+        });
+
+    return newmarker;
+}
+
+void
+indexedAccountTxs(
+    soci::session& session,
+    AccountTxIndex& index,
+    std::function<void(std::uint32_t)> const& onUnsavedLedger,
+    std::function<
+        void(std::uint32_t, std::string const&, Blob&&, Blob&&)> const&
+        onTransaction,
+    RelationalDatabase::AccountTxOptions const& options,
+    bool binary,
+    bool descending)
+{
+    constexpr std::uint32_t NONBINARY_PAGE_LENGTH = 200;
+    constexpr std::uint32_t BINARY_PAGE_LENGTH = 500;
+
+    std::uint32_t numberOfResults;
+
+    if (options.limit == UINT32_MAX)
+        numberOfResults = binary ? BINARY_PAGE_LENGTH : NONBINARY_PAGE_LENGTH;
+    else if (!options.bUnlimited)
+        numberOfResults = std::min(
+            binary ? BINARY_PAGE_LENGTH : NONBINARY_PAGE_LENGTH, options.limit);
+    else
+        numberOfResults = options.limit;
+
+    // A zero bound leaves that end of the range open.
+    AccountTxIndex::Position const first{
+        options.minLedger, std::numeric_limits<std::uint32_t>::min()};
+    AccountTxIndex::Position const last{
+        options.maxLedger ? options.maxLedger
+                          : std::numeric_limits<std::uint32_t>::max(),
+        std::numeric_limits<std::uint32_t>::max()};
+
+    if (numberOfResults == 0 || last < first)
+        return;
+
+    std::uint32_t skip = options.offset;
+    forEachIndexedTransaction(
+        session,
+        index,
+        options.account,
+        descending ? last : first,
+        descending ? first : last,
+        [&](AccountTxIndex::Position const& pos,
+            std::string const& status,
+            Blob&& rawData,
+            Blob&& rawMeta) {
+            if (skip)
+            {
+                --skip;
+                return true;
+            }
+
+            // Work around a bug that could leave the metadata missing
+            if (rawMeta.size() == 0)
+                onUnsavedLedger(pos.ledgerSeq);
+
+            onTransaction(
+                pos.ledgerSeq, status, std::move(rawData), std::move(rawMeta));
+            return --numberOfResults != 0;
+        });
+}
+
 std::variant<RelationalDatabase::AccountTx, TxSearched>
 getTransaction(
     soci::session& session,
@@ -23,6 +23,7 @@
 #include <ripple/app/ledger/TransactionMaster.h>
 #include <ripple/app/misc/Manifest.h>
 #include <ripple/app/misc/impl/AccountTxPaging.h>
+#include <ripple/app/rdb/AccountTxIndex.h>
 #include <ripple/app/rdb/backend/SQLiteDatabase.h>
 #include <ripple/app/rdb/backend/detail/Node.h>
 #include <ripple/app/rdb/backend/detail/Shard.h>
@@ -33,6 +34,9 @@
 #include <ripple/json/to_string.h>
 #include <ripple/nodestore/DatabaseShard.h>
 #include <soci/sqlite3/soci-sqlite3.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 
 namespace ripple {
 
@@ -45,6 +49,10 @@ public:
         JobQueue& jobQueue)
         : app_(app)
         , useTxTables_(config.useTxTables())
+        , saveBatchLedgers_(std::max<std::size_t>(
+              get<std::size_t>(
+                  config.section("sqlite"), "save_batch_ledgers", 16),
+              1))
         , j_(app_.journal("SQLiteDatabaseImp"))
     {
         DatabaseCon::Setup const setup = setup_DatabaseCon(config, j_);
@@ -72,6 +80,9 @@ public:
             JLOG(j_.fatal()) << error;
             Throw<std::runtime_error>(error.data());
         }
+
+        if (useTxTables_)
+            accountTxIndex_ = makeAccountTxIndex(config, j_);
     }
 
     std::optional<LedgerIndex>
@@ -193,10 +204,38 @@ public:
 private:
     Application& app_;
     bool const useTxTables_;
+    std::size_t const saveBatchLedgers_;
     beast::Journal j_;
     std::unique_ptr<DatabaseCon> lgrdb_, txdb_;
     std::unique_ptr<DatabaseCon> lgrMetaDB_, txMetaDB_;
 
+    // Replaces the AccountTransactions table when configured
+    std::unique_ptr<AccountTxIndex> accountTxIndex_;
+
+    // A validated ledger waiting to be written by writeValidatedLedger
+    struct PendingSave
+    {
+        detail::ValidatedLedgerRows rows;
+        bool done = false;
+        std::exception_ptr error;
+    };
+
+    std::mutex saveMutex_;
+    std::condition_variable saveCond_;
+    std::deque<PendingSave*> saveQueue_;
+    bool saveWriting_ = false;
+
+    /**
+     * @brief writeValidatedLedger Writes the rows of a validated ledger
+     *        and returns once they are committed. Ledgers saved while
+     *        another is being written are queued, and the first of their
+     *        callers to find the databases free writes up to
+     *        saveBatchLedgers_ of them in one database transaction.
+     * @param rows The rows of the ledger.
+     */
+    void
+    writeValidatedLedger(detail::ValidatedLedgerRows&& rows);
+
     /**
      * @brief makeLedgerDBs Opens ledger and transaction databases for the node
      *        store, and stores their descriptors in private member variables.
@@ -528,6 +567,9 @@ SQLiteDatabaseImp::getAccountTransactionsMinLedgerSeq()
     if (!useTxTables_)
         return {};
 
+    if (accountTxIndex_ && existsTransaction())
+        return accountTxIndex_->getMinLedgerSeq();
+
     if (existsTransaction())
     {
         auto db = checkoutTransaction();
@@ -654,6 +696,12 @@ SQLiteDatabaseImp::deleteAccountTransactionsBeforeLedgerSeq(
     if (!useTxTables_)
         return;
 
+    if (accountTxIndex_ && existsTransaction())
+    {
+        accountTxIndex_->deleteBeforeLedgerSeq(ledgerSeq);
+        return;
+    }
+
     if (existsTransaction())
     {
         auto db = checkoutTransaction();
@@ -707,6 +755,9 @@ SQLiteDatabaseImp::getAccountTransactionCount()
     if (!useTxTables_)
         return 0;
 
+    if (accountTxIndex_ && existsTransaction())
+        return accountTxIndex_->getEntryCount();
+
     if (existsTransaction())
     {
         auto db = checkoutTransaction();
@@ -766,9 +817,11 @@ SQLiteDatabaseImp::saveValidatedLedger(
 {
     if (existsLedger())
     {
-        if (!detail::saveValidatedLedger(
-                *lgrdb_, *txdb_, app_, ledger, current))
+        auto rows = detail::makeValidatedLedgerRows(
+            app_, ledger, current, accountTxIndex_ != nullptr);
+        if (!rows)
             return false;
+        writeValidatedLedger(std::move(*rows));
     }
 
     if (auto shardStore = app_.getShardStore(); shardStore)
@@ -795,6 +848,62 @@ SQLiteDatabaseImp::saveValidatedLedger(
     return true;
 }
 
+void
+SQLiteDatabaseImp::writeValidatedLedger(detail::ValidatedLedgerRows&& rows)
+{
+    PendingSave pending{std::move(rows)};
+
+    std::unique_lock lock(saveMutex_);
+    saveQueue_.push_back(&pending);
+    while (!pending.done)
+    {
+        if (saveWriting_)
+        {
+            saveCond_.wait(lock);
+            continue;
+        }
+
+        // Write the oldest queued ledgers, which may or may not include
+        // this one, while other callers keep preparing theirs.
+        saveWriting_ = true;
+        auto const count = std::min(saveQueue_.size(), saveBatchLedgers_);
+        std::vector<PendingSave*> const saves(
+            saveQueue_.begin(), saveQueue_.begin() + count);
+        saveQueue_.erase(saveQueue_.begin(), saveQueue_.begin() + count);
+        lock.unlock();
+
+        std::vector<detail::ValidatedLedgerRows> batch;
+        batch.reserve(saves.size());
+        for (auto save : saves)
+            batch.push_back(std::move(save->rows));
+
+        std::exception_ptr error;
+        try
+        {
+            detail::writeValidatedLedgers(
+                *lgrdb_, *txdb_, app_, batch, accountTxIndex_.get());
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        JLOG(j_.trace()) << "Wrote " << batch.size() << " validated ledgers";
+
+        lock.lock();
+        for (auto save : saves)
+        {
+            save->error = error;
+            save->done = true;
+        }
+        saveWriting_ = false;
+        saveCond_.notify_all();
+    }
+
+    if (pending.error)
+        std::rethrow_exception(pending.error);
+}
+
 std::optional<LedgerInfo>
 SQLiteDatabaseImp::getLedgerInfoByIndex(LedgerIndex ledgerSeq)
 {
@@ -1087,6 +1196,33 @@ SQLiteDatabaseImp::getOldestAccountTxs(AccountTxOptions const& options)
     if (!useTxTables_)
         return {};
 
+    if (accountTxIndex_ && existsTransaction())
+    {
+        auto onUnsavedLedger =
+            std::bind(saveLedgerAsync, std::ref(app_), std::placeholders::_1);
+        AccountTxs ret;
+        Application& app = app_;
+        auto onTransaction = [&ret, &app](
+                                 std::uint32_t ledger_index,
+                                 std::string const& status,
+                                 Blob&& rawTxn,
+                                 Blob&& rawMeta) {
+            convertBlobsToTxResult(
+                ret, ledger_index, status, rawTxn, rawMeta, app);
+        };
+
+        auto db = checkoutTransaction();
+        detail::indexedAccountTxs(
+            *db,
+            *accountTxIndex_,
+            onUnsavedLedger,
+            onTransaction,
+            options,
+            false,
+            false);
+        return ret;
+    }
+
     LedgerMaster& ledgerMaster = app_.getLedgerMaster();
 
     if (existsTransaction())
@@ -1147,6 +1283,33 @@ SQLiteDatabaseImp::getNewestAccountTxs(AccountTxOptions const& options)
     if (!useTxTables_)
         return {};
 
+    if (accountTxIndex_ && existsTransaction())
+    {
+        auto onUnsavedLedger =
+            std::bind(saveLedgerAsync, std::ref(app_), std::placeholders::_1);
+        AccountTxs ret;
+        Application& app = app_;
+        auto onTransaction = [&ret, &app](
+                                 std::uint32_t ledger_index,
+                                 std::string const& status,
+                                 Blob&& rawTxn,
+                                 Blob&& rawMeta) {
+            convertBlobsToTxResult(
+                ret, ledger_index, status, rawTxn, rawMeta, app);
+        };
+
+        auto db = checkoutTransaction();
+        detail::indexedAccountTxs(
+            *db,
+            *accountTxIndex_,
+            onUnsavedLedger,
+            onTransaction,
+            options,
+            false,
+            true);
+        return ret;
+    }
+
     LedgerMaster& ledgerMaster = app_.getLedgerMaster();
 
     if (existsTransaction())
@@ -1207,6 +1370,32 @@ SQLiteDatabaseImp::getOldestAccountTxsB(AccountTxOptions const& options)
     if (!useTxTables_)
         return {};
 
+    if (accountTxIndex_ && existsTransaction())
+    {
+        auto onUnsavedLedger =
+            std::bind(saveLedgerAsync, std::ref(app_), std::placeholders::_1);
+        MetaTxsList ret;
+        auto onTransaction = [&ret](
+                                 std::uint32_t ledgerIndex,
+                                 std::string const& status,
+                                 Blob&& rawTxn,
+                                 Blob&& rawMeta) {
+            ret.emplace_back(
+                std::move(rawTxn), std::move(rawMeta), ledgerIndex);
+        };
+
+        auto db = checkoutTransaction();
+        detail::indexedAccountTxs(
+            *db,
+            *accountTxIndex_,
+            onUnsavedLedger,
+            onTransaction,
+            options,
+            true,
+            false);
+        return ret;
+    }
+
     if (existsTransaction())
     {
         auto db = checkoutTransaction();
@@ -1263,6 +1452,32 @@ SQLiteDatabaseImp::getNewestAccountTxsB(AccountTxOptions const& options)
     if (!useTxTables_)
         return {};
 
+    if (accountTxIndex_ && existsTransaction())
+    {
+        auto onUnsavedLedger =
+            std::bind(saveLedgerAsync, std::ref(app_), std::placeholders::_1);
+        MetaTxsList ret;
+        auto onTransaction = [&ret](
+                                 std::uint32_t ledgerIndex,
+                                 std::string const& status,
+                                 Blob&& rawTxn,
+                                 Blob&& rawMeta) {
+            ret.emplace_back(
+                std::move(rawTxn), std::move(rawMeta), ledgerIndex);
+        };
+
+        auto db = checkoutTransaction();
+        detail::indexedAccountTxs(
+            *db,
+            *accountTxIndex_,
+            onUnsavedLedger,
+            onTransaction,
+            options,
+            true,
+            true);
+        return ret;
+    }
+
     if (existsTransaction())
     {
         auto db = checkoutTransaction();
@@ -1334,6 +1549,20 @@ SQLiteDatabaseImp::oldestAccountTxPage(AccountTxPageOptions const& options)
         convertBlobsToTxResult(ret, ledger_index, status, rawTxn, rawMeta, app);
     };
 
+    if (accountTxIndex_ && existsTransaction())
+    {
+        auto db = checkoutTransaction();
+        auto newmarker = detail::indexedAccountTxPage(
+            *db,
+            *accountTxIndex_,
+            onUnsavedLedger,
+            onTransaction,
+            options,
+            page_length,
+            true);
+        return {ret, newmarker};
+    }
+
     if (existsTransaction())
     {
         auto db = checkoutTransaction();
@@ -1396,6 +1625,20 @@ SQLiteDatabaseImp::newestAccountTxPage(AccountTxPageOptions const& options)
         convertBlobsToTxResult(ret, ledger_index, status, rawTxn, rawMeta, app);
     };
 
+    if (accountTxIndex_ && existsTransaction())
+    {
+        auto db = checkoutTransaction();
+        auto newmarker = detail::indexedAccountTxPage(
+            *db,
+            *accountTxIndex_,
+            onUnsavedLedger,
+            onTransaction,
+            options,
+            page_length,
+            false);
+        return {ret, newmarker};
+    }
+
     if (existsTransaction())
     {
         auto db = checkoutTransaction();
@@ -1457,6 +1700,20 @@ SQLiteDatabaseImp::oldestAccountTxPageB(AccountTxPageOptions const& options)
         ret.emplace_back(std::move(rawTxn), std::move(rawMeta), ledgerIndex);
     };
 
+    if (accountTxIndex_ && existsTransaction())
+    {
+        auto db = checkoutTransaction();
+        auto newmarker = detail::indexedAccountTxPage(
+            *db,
+            *accountTxIndex_,
+            onUnsavedLedger,
+            onTransaction,
+            options,
+            page_length,
+            true);
+        return {ret, newmarker};
+    }
+
     if (existsTransaction())
     {
         auto db = checkoutTransaction();
@@ -1518,6 +1775,20 @@ SQLiteDatabaseImp::newestAccountTxPageB(AccountTxPageOptions const& options)
         ret.emplace_back(std::move(rawTxn), std::move(rawMeta), ledgerIndex);
     };
 
+    if (accountTxIndex_ && existsTransaction())
+    {
+        auto db = checkoutTransaction();
+        auto newmarker = detail::indexedAccountTxPage(
+            *db,
+            *accountTxIndex_,
+            onUnsavedLedger,
+            onTransaction,
+            options,
+            page_length,
+            false);
+        return {ret, newmarker};
+    }
+
     if (existsTransaction())
     {
         auto db = checkoutTransaction();
@@ -0,0 +1,449 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/unity/rocksdb.h>
+
+#include <ripple/app/main/DBInit.h>
+#include <ripple/app/rdb/AccountTxIndex.h>
+#include <ripple/basics/contract.h>
+#include <ripple/core/ConfigSections.h>
+#include <ripple/core/SociDB.h>
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/filesystem.hpp>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+
+namespace ripple {
+
+#if RIPPLE_ROCKSDB_AVAILABLE
+
+namespace {
+
+// The index holds two kinds of key, each starting with a tag byte and
+// followed by big-endian fields so that keys sort in numeric order:
+//
+//   'a' account ledgerSeq txnSeq  ->  transaction ID
+//   'l' ledgerSeq txnSeq account  ->  (empty)
+//
+// The first kind is the history of each account. The second finds the
+// entries of a ledger, to replace or delete them. A single 'c' key holds
+// the number of entries, updated in the same batch as the entries.
+char constexpr accountTag = 'a';
+char constexpr countTag = 'c';
+char constexpr ledgerTag = 'l';
+
+std::size_t constexpr accountKeySize = 1 + 20 + 4 + 4;
+std::size_t constexpr ledgerKeySize = 1 + 4 + 4 + 20;
+
+// The number of deletions after which a batch deleting many ledgers is
+// written out, at the next ledger.
+std::size_t constexpr deleteBatchSize = 10000;
+
+void
+putBigEndian(char* out, std::uint32_t v)
+{
+    out[0] = static_cast<char>(v >> 24);
+    out[1] = static_cast<char>(v >> 16);
+    out[2] = static_cast<char>(v >> 8);
+    out[3] = static_cast<char>(v);
+}
+
+std::uint32_t
+getBigEndian(char const* in)
+{
+    auto const p = reinterpret_cast<unsigned char const*>(in);
+    return (std::uint32_t{p[0]} << 24) | (std::uint32_t{p[1]} << 16) |
+        (std::uint32_t{p[2]} << 8) | std::uint32_t{p[3]};
+}
+
+std::string
+accountKey(AccountID const& account, AccountTxIndex::Position const& pos)
+{
+    std::string key(accountKeySize, '\0');
+    key[0] = accountTag;
+    std::memcpy(&key[1], account.data(), account.size());
+    putBigEndian(&key[21], pos.ledgerSeq);
+    putBigEndian(&key[25], pos.txnSeq);
+    return key;
+}
+
+std::string const countKey(1, countTag);
+
+std::string
+ledgerKey(std::uint32_t ledgerSeq, std::uint32_t txnSeq = 0)
+{
+    std::string key(ledgerKeySize, '\0');
+    key[0] = ledgerTag;
+    putBigEndian(&key[1], ledgerSeq);
+    putBigEndian(&key[5], txnSeq);
+    return key;
+}
+
+}  // namespace
+
+class AccountTxIndexRocksDB final : public AccountTxIndex
+{
+public:
+    AccountTxIndexRocksDB(std::string const& path, beast::Journal j) : j_(j)
+    {
+        rocksdb::Options options;
+        options.create_if_missing = true;
+        options.compression = rocksdb::kSnappyCompression;
+
+        rocksdb::DB* db = nullptr;
+        auto const status = rocksdb::DB::Open(options, path, &db);
+        if (!status.ok() || !db)
+            Throw<std::runtime_error>(
+                "Unable to open/create the account transaction index: " +
+                status.ToString());
+        db_.reset(db);
+
+        std::string value;
+        auto const found =
+            db_->Get(rocksdb::ReadOptions(), countKey, &value);
+        if (found.ok() && value.size() == 8)
+        {
+            count_ = (std::uint64_t{getBigEndian(value.data())} << 32) |
+                getBigEndian(value.data() + 4);
+        }
+        else
+        {
+            // Written before the count was kept: count the entries once.
+            count_ = countEntries();
+            rocksdb::WriteBatch batch;
+            write(batch);
+        }
+    }
+
+    void
+    saveLedger(LedgerIndex ledgerSeq, std::vector<Entry> const& entries)
+        override
+    {
+        std::lock_guard lock(mutex_);
+
+        rocksdb::WriteBatch batch;
+        deleteRange(ledgerKey(ledgerSeq), ledgerKey(ledgerSeq + 1), batch);
+
+        for (auto const& entry : entries)
+        {
+            auto const lkey = ledgerKey(ledgerSeq, entry.txnSeq);
+            std::string key(lkey);
+            std::memcpy(&key[9], entry.account.data(), entry.account.size());
+            batch.Put(key, rocksdb::Slice());
+            batch.Put(
+                accountKey(entry.account, {ledgerSeq, entry.txnSeq}),
+                rocksdb::Slice(
+                    reinterpret_cast<char const*>(entry.txID.data()),
+                    entry.txID.size()));
+        }
+
+        write(batch, entries.size());
+    }
+
+    void
+    deleteBeforeLedgerSeq(LedgerIndex ledgerSeq) override
+    {
+        std::lock_guard lock(mutex_);
+
+        rocksdb::WriteBatch batch;
+        deleteRange(ledgerKey(0), ledgerKey(ledgerSeq), batch);
+        write(batch);
+    }
+
+    std::optional<LedgerIndex>
+    getMinLedgerSeq() override
+    {
+        std::string const last(1, ledgerTag + 1);
+        rocksdb::Slice const upper(last);
+        rocksdb::ReadOptions options;
+        options.iterate_upper_bound = &upper;
+
+        std::unique_ptr<rocksdb::Iterator> it(db_->NewIterator(options));
+        it->Seek(ledgerKey(0));
+        if (!it->Valid())
+            return std::nullopt;
+        return getBigEndian(it->key().data() + 1);
+    }
+
+    std::size_t
+    getEntryCount() override
+    {
+        std::lock_guard lock(mutex_);
+        return count_;
+    }
+
+    void
+    forEach(
+        AccountID const& account,
+        Position const& from,
+        Position const& to,
+        std::function<bool(Position const&, uint256 const&)> const& visit)
+        override
+    {
+        bool const forward = from <= to;
+        auto const first = accountKey(account, from);
+        auto const last = accountKey(account, to);
+
+        std::unique_ptr<rocksdb::Iterator> it(
+            db_->NewIterator(rocksdb::ReadOptions()));
+        if (forward)
+            it->Seek(first);
+        else
+            it->SeekForPrev(first);
+
+        for (; it->Valid(); forward ? it->Next() : it->Prev())
+        {
+            auto const key = it->key();
+            if (key.size() != accountKeySize ||
+                (forward ? key.compare(last) > 0 : key.compare(last) < 0))
+                break;
+
+            auto const value = it->value();
+            if (value.size() != uint256::size())
+            {
+                JLOG(j_.error()) << "Malformed account transaction entry";
+                continue;
+            }
+
+            Position const pos{
+                getBigEndian(key.data() + 21), getBigEndian(key.data() + 25)};
+            if (!visit(pos, uint256::fromVoid(value.data())))
+                break;
+        }
+
+        if (!it->status().ok())
+            Throw<std::runtime_error>(
+                "Account transaction index read failed: " +
+                it->status().ToString());
+    }
+
+private:
+    std::uint64_t
+    countEntries()
+    {
+        std::string const last(1, ledgerTag + 1);
+        rocksdb::Slice const upper(last);
+        rocksdb::ReadOptions options;
+        options.iterate_upper_bound = &upper;
+
+        std::uint64_t count = 0;
+        std::unique_ptr<rocksdb::Iterator> it(db_->NewIterator(options));
+        for (it->Seek(ledgerKey(0)); it->Valid(); it->Next())
+            ++count;
+        return count;
+    }
+
+    // Add the deletion of the entries of the ledgers from the first key up
+    // to the last to the batch. A batch which grows large is written out
+    // before the next ledger, so the entries of a ledger always go in one
+    // write. The deletions still in the batch are subtracted from the count
+    // when it is written.
+    void
+    deleteRange(
+        std::string const& first,
+        std::string const& last,
+        rocksdb::WriteBatch& batch)
+    {
+        rocksdb::Slice const upper(last);
+        rocksdb::ReadOptions options;
+        options.iterate_upper_bound = &upper;
+
+        std::optional<std::uint32_t> current;
+        std::unique_ptr<rocksdb::Iterator> it(db_->NewIterator(options));
+        for (it->Seek(first); it->Valid(); it->Next())
+        {
+            auto const key = it->key();
+            if (key.size() != ledgerKeySize)
+                continue;
+
+            auto const ledgerSeq = getBigEndian(key.data() + 1);
+            if (ledgerSeq != current)
+            {
+                if (current && batch.Count() >= deleteBatchSize)
+                {
+                    write(batch);
+                    batch.Clear();
+                }
+                current = ledgerSeq;
+            }
+
+            AccountID account;
+            std::memcpy(account.data(), key.data() + 9, account.size());
+            batch.Delete(
+                accountKey(account, {ledgerSeq, getBigEndian(key.data() + 5)}));
+            batch.Delete(key);
+            ++deleted_;
+        }
+    }
+
+    // Write the batch, with the count less the entries it deletes and
+    // plus those it adds.
+    void
+    write(rocksdb::WriteBatch& batch, std::uint64_t added = 0)
+    {
+        auto const count = count_ - deleted_ + added;
+        std::string value(8, '\0');
+        putBigEndian(&value[0], static_cast<std::uint32_t>(count >> 32));
+        putBigEndian(&value[4], static_cast<std::uint32_t>(count));
+        batch.Put(countKey, value);
+
+        deleted_ = 0;
+        auto const status = db_->Write(rocksdb::WriteOptions(), &batch);
+        if (!status.ok())
+            Throw<std::runtime_error>(
+                "Account transaction index write failed: " +
+                status.ToString());
+        count_ = count;
+    }
+
+    beast::Journal j_;
+    std::unique_ptr<rocksdb::DB> db_;
+
+    // Serialises changes, so that the count stays in step with them.
+    std::mutex mutex_;
+    std::uint64_t count_ = 0;
+
+    // Entries deleted in the batch being built.
+    std::uint64_t deleted_ = 0;
+};
+
+#endif
+
+std::unique_ptr<AccountTxIndex>
+makeAccountTxIndex(Config const& config, beast::Journal j)
+{
+    auto const& section = config.section(SECTION_RELATIONAL_DB);
+
+    std::string kind = "sqlite";
+    get_if_exists(section, "account_tx_index", kind);
+    if (boost::iequals(kind, "sqlite"))
+        return {};
+
+    if (!boost::iequals(kind, "rocksdb"))
+        Throw<std::runtime_error>(
+            "Invalid [" SECTION_RELATIONAL_DB "] account_tx_index value: " +
+            kind);
+
+    std::string path;
+    if (!get_if_exists(section, "account_tx_path", path))
+    {
+        boost::filesystem::path const dbPath =
+            config.legacy("database_path");
+        if (dbPath.empty())
+            Throw<std::runtime_error>(
+                "[" SECTION_RELATIONAL_DB "] account_tx_path must be set");
+        path = (dbPath / "account_tx").string();
+    }
+
+#if RIPPLE_ROCKSDB_AVAILABLE
+    JLOG(j.info()) << "Opening the account transaction index at " << path;
+    return std::make_unique<AccountTxIndexRocksDB>(path, j);
+#else
+    Throw<std::runtime_error>(
+        "account_tx_index=rocksdb needs a build with RocksDB support");
+    return {};
+#endif
+}
+
+bool
+doMigrateAccountTxDB(Config const& config, DatabaseCon::Setup const& setup)
+{
+    auto index = makeAccountTxIndex(
+        config, beast::Journal{beast::Journal::getNullSink()});
+    if (!index)
+    {
+        std::cerr << "The [" SECTION_RELATIONAL_DB "] section must set "
+                     "account_tx_index to migrate the AccountTransactions "
+                     "table into.\n";
+        return false;
+    }
+
+    auto txnDB =
+        std::make_unique<DatabaseCon>(setup, TxDBName, TxDBPragma, TxDBInit);
+    auto& session = txnDB->getSession();
+
+    std::cout << "Migrating AccountTransactions into the account transaction "
+                 "index."
+              << std::endl;
+
+    std::string txID;
+    std::string account;
+    std::uint64_t ledgerSeq = 0;
+    std::uint32_t txnSeq = 0;
+
+    soci::statement st =
+        (session.prepare << "SELECT TransID, Account, LedgerSeq, TxnSeq "
+                            "FROM AccountTransactions ORDER BY LedgerSeq;",
+         soci::into(txID),
+         soci::into(account),
+         soci::into(ledgerSeq),
+         soci::into(txnSeq));
+    st.execute();
+
+    std::optional<LedgerIndex> current;
+    std::vector<AccountTxIndex::Entry> entries;
+    std::size_t ledgers = 0;
+    std::size_t rows = 0;
+    std::size_t skipped = 0;
+
+    auto const flush = [&] {
+        if (!current)
+            return;
+        index->saveLedger(*current, entries);
+        entries.clear();
+        if (++ledgers % 10000 == 0)
+            std::cout << "Migrated " << ledgers << " ledgers, up to "
+                      << *current << std::endl;
+    };
+
+    while (st.fetch())
+    {
+        auto const seq = static_cast<LedgerIndex>(ledgerSeq);
+        if (seq != current)
+        {
+            flush();
+            current = seq;
+        }
+
+        uint256 id;
+        auto const acct = parseBase58<AccountID>(account);
+        if (!acct || !id.parseHex(txID))
+        {
+            ++skipped;
+            continue;
+        }
+
+        entries.push_back({*acct, txnSeq, id});
+        ++rows;
+    }
+    flush();
+
+    std::cout << "Migrated " << rows << " entries of " << ledgers
+              << " ledgers";
+    if (skipped)
+        std::cout << ", skipping " << skipped << " malformed rows";
+    std::cout << ". The AccountTransactions table is no longer used and may "
+                 "be dropped."
+              << std::endl;
+
+    return true;
+}
+
+}  // namespace ripple
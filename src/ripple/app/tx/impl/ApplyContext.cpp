@@ -99,13 +99,13 @@ ApplyContext::checkInvariantsHelper(
     {
         auto checkers = getInvariantChecks();
 
-        // call each check's per-entry method
+        // call the per-entry method of the checks which look at the entry
         visit([&checkers](
                   uint256 const& index,
                   bool isDelete,
                   std::shared_ptr<SLE const> const& before,
                   std::shared_ptr<SLE const> const& after) {
-            (..., std::get<Is>(checkers).visitEntry(isDelete, before, after));
+            visitInvariantEntry(checkers, isDelete, before, after);
         });
 
         // Note: do not replace this logic with a `...&&` fold expression.
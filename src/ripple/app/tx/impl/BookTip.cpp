@@ -27,21 +27,78 @@ BookTip::BookTip(ApplyView& view, Book const& book)
     , m_valid(false)
     , m_book(getBookBase(book))
     , m_end(getQualityNext(m_book))
+    , m_cached(view.bookOffers(m_book))
+    , m_next(0)
 {
 }
 
+// Presents the next offer of the cached top of the book. Taking an offer
+// removes it from its directory without reordering the others, so as long
+// as each offer presented was taken, the next one listed is the one that
+// walking the directories would find.
+bool
+BookTip::stepCached()
+{
+    if (m_next == m_cached->size())
+        return false;
+
+    auto const& offer = (*m_cached)[m_next++];
+
+    // Taking the previous offers must have left this one first on its page
+    auto const page = view_.read(Keylet(ltDIR_NODE, offer.dir));
+    if (!page)
+        return false;
+
+    auto const& indexes = page->getFieldV256(sfIndexes);
+    if (indexes.empty() || indexes[0] != offer.index)
+        return false;
+
+    m_dir = offer.dir;
+    m_index = offer.index;
+    m_entry = view_.peek(keylet::offer(m_index));
+    m_quality = offer.quality;
+    m_valid = true;
+
+    // Should the cache be dropped, the next query starts before this
+    // directory
+    m_book = offer.root;
+    --m_book;
+
+    return true;
+}
+
 bool
 BookTip::step(beast::Journal j)
 {
     if (m_valid)
     {
+        // If the offer is missing, or is not where the book listed it,
+        // then removing it need not leave the book in the cached order.
+        if (m_cached)
+        {
+            auto root = m_book;
+            ++root;
+            if (!m_entry || m_entry->getFieldH256(sfBookDirectory) != root ||
+                keylet::page(root, m_entry->getFieldU64(sfBookNode)).key !=
+                    m_dir)
+                m_cached.reset();
+        }
+
         if (m_entry)
         {
-            offerDelete(view_, m_entry, j);
+            if (offerDelete(view_, m_entry, j) != tesSUCCESS)
+                m_cached.reset();
             m_entry = nullptr;
         }
     }
 
+    if (m_cached)
+    {
+        if (stepCached())
+            return true;
+        m_cached.reset();
+    }
+
     for (;;)
     {
         // See if there's an entry at or worse than current quality. Notice
@@ -46,8 +46,19 @@ private:
     std::shared_ptr<SLE> m_entry;
     Quality m_quality;
 
+    // The top of the book as cached by the ledger, if the view has not
+    // changed the book, and the next of its offers to present.
+    std::shared_ptr<BookOffers const> m_cached;
+    std::size_t m_next;
+
+    bool
+    stepCached();
+
 public:
-    /** Create the iterator. */
+    /** Create the iterator.
+
+        The book must not gain offers while the iterator is in use.
+    */
     BookTip(ApplyView& view, Book const& book);
 
     uint256 const&
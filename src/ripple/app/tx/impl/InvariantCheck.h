@@ -25,6 +25,8 @@
 #include <ripple/protocol/STLedgerEntry.h>
 #include <ripple/protocol/STTx.h>
 #include <ripple/protocol/TER.h>
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <map>
 #include <tuple>
@@ -48,6 +50,15 @@ class InvariantChecker_PROTOTYPE
 public:
     explicit InvariantChecker_PROTOTYPE() = default;
 
+    /**
+     * @brief the types of the ledger entries this check looks at.
+     *
+     * Optional: visitEntry is only called for entries whose type, before or
+     * after the transaction, is listed here. A check without this member is
+     * called for every entry.
+     */
+    static constexpr std::array visitedTypes{ltACCOUNT_ROOT};
+
     /**
      * @brief called for each ledger entry in the current transaction.
      *
@@ -92,6 +103,8 @@ public:
 class TransactionFeeCheck
 {
 public:
+    static constexpr std::array<LedgerEntryType, 0> visitedTypes{};
+
     void
     visitEntry(
         bool,
@@ -121,6 +134,11 @@ class XRPNotCreated
     std::uint32_t accountsCreated_ = 0;
 
 public:
+    static constexpr std::array visitedTypes{
+        ltACCOUNT_ROOT,
+        ltPAYCHAN,
+        ltESCROW};
+
     void
     visitEntry(
         bool,
@@ -149,6 +167,8 @@ class AccountRootsNotDeleted
     std::uint32_t accountsDeleted_ = 0;
 
 public:
+    static constexpr std::array visitedTypes{ltACCOUNT_ROOT};
+
     void
     visitEntry(
         bool,
@@ -176,6 +196,8 @@ class XRPBalanceChecks
     bool bad_ = false;
 
 public:
+    static constexpr std::array visitedTypes{ltACCOUNT_ROOT};
+
     void
     visitEntry(
         bool,
@@ -227,6 +249,8 @@ class NoXRPTrustLines
     bool xrpTrustLine_ = false;
 
 public:
+    static constexpr std::array visitedTypes{ltRIPPLE_STATE};
+
     void
     visitEntry(
         bool,
@@ -254,6 +278,8 @@ class NoBadOffers
     bool bad_ = false;
 
 public:
+    static constexpr std::array visitedTypes{ltOFFER};
+
     void
     visitEntry(
         bool,
@@ -278,6 +304,8 @@ class NoZeroEscrow
     bool bad_ = false;
 
 public:
+    static constexpr std::array visitedTypes{ltESCROW};
+
     void
     visitEntry(
         bool,
@@ -304,6 +332,8 @@ class ValidNewAccountRoot
     std::uint32_t accountSeq_ = 0;  // Only meaningful if accountsCreated_ > 0
 
 public:
+    static constexpr std::array visitedTypes{ltACCOUNT_ROOT};
+
     void
     visitEntry(
         bool,
@@ -328,6 +358,8 @@ class ValidNFTokenPage
     bool invalidSize_ = false;
 
 public:
+    static constexpr std::array visitedTypes{ltNFTOKEN_PAGE};
+
     void
     visitEntry(
         bool,
@@ -351,6 +383,8 @@ class NFTokenCountTracking
     std::uint32_t afterBurnedTotal = 0;
 
 public:
+    static constexpr std::array visitedTypes{ltACCOUNT_ROOT};
+
     void
     visitEntry(
         bool,
@@ -395,6 +429,116 @@ getInvariantChecks()
     return InvariantChecks{};
 }
 
+namespace detail {
+
+template <class Check, class = void>
+struct VisitsAllEntries : std::true_type
+{
+};
+
+template <class Check>
+struct VisitsAllEntries<Check, std::void_t<decltype(Check::visitedTypes)>>
+    : std::false_type
+{
+};
+
+template <class Check>
+constexpr bool
+visitsType(std::size_t type)
+{
+    if constexpr (VisitsAllEntries<Check>::value)
+        return true;
+    else
+        return std::find(
+                   Check::visitedTypes.begin(),
+                   Check::visitedTypes.end(),
+                   static_cast<LedgerEntryType>(type)) !=
+            Check::visitedTypes.end();
+}
+
+// For every ledger entry type, a bit for each check which looks at entries
+// of that type. All the types of entries in a ledger fit in one byte.
+template <class... Checks>
+struct InvariantTable
+{
+    static_assert(sizeof...(Checks) <= 32);
+
+    static constexpr std::array<std::uint32_t, 256>
+    make()
+    {
+        std::array<std::uint32_t, 256> table{};
+        for (std::size_t type = 0; type < table.size(); ++type)
+        {
+            std::uint32_t bit = 1;
+            ((table[type] |= visitsType<Checks>(type) ? bit : 0, bit <<= 1),
+             ...);
+        }
+        return table;
+    }
+
+    static constexpr std::array<std::uint32_t, 256> table = make();
+
+    static std::uint32_t
+    checksFor(std::shared_ptr<SLE const> const& sle)
+    {
+        if (!sle)
+            return 0;
+
+        auto const type = static_cast<std::size_t>(sle->getType());
+        return type < table.size() ? table[type] : ~std::uint32_t(0);
+    }
+};
+
+template <class... Checks, std::size_t... Is>
+void
+visitInvariantEntry(
+    std::tuple<Checks...>& checks,
+    std::uint32_t wanted,
+    bool isDelete,
+    std::shared_ptr<SLE const> const& before,
+    std::shared_ptr<SLE const> const& after,
+    std::index_sequence<Is...>)
+{
+    (...,
+     ((wanted & (std::uint32_t(1) << Is))
+          ? std::get<Is>(checks).visitEntry(isDelete, before, after)
+          : void()));
+}
+
+}  // namespace detail
+
+/**
+ * @brief pass a ledger entry modified by the transaction to the checks which
+ * look at entries of its type
+ *
+ * Which checks look at which types of entries is worked out at compile time,
+ * from the visitedTypes of each check, so every entry costs one lookup rather
+ * than a call to each check.
+ *
+ * @param checks the invariant checks, as returned by getInvariantChecks
+ * @param isDelete true if the SLE is being deleted
+ * @param before ledger entry before modification by the transaction
+ * @param after ledger entry after modification by the transaction
+ */
+template <class... Checks>
+void
+visitInvariantEntry(
+    std::tuple<Checks...>& checks,
+    bool isDelete,
+    std::shared_ptr<SLE const> const& before,
+    std::shared_ptr<SLE const> const& after)
+{
+    using Table = detail::InvariantTable<Checks...>;
+
+    detail::visitInvariantEntry(
+        checks,
+        Table::checksFor(before) | Table::checksFor(after),
+        isDelete,
+        before,
+        after,
+        std::index_sequence_for<Checks...>{});
+}
+
 }  // namespace ripple
 
 #endif
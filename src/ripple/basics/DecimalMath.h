@@ -0,0 +1,174 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_BASICS_DECIMALMATH_H_INCLUDED
+#define RIPPLE_BASICS_DECIMALMATH_H_INCLUDED
+
+#include <boost/predef.h>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+#if BOOST_COMP_MSVC
+#include <boost/multiprecision/cpp_int.hpp>
+#endif
+
+/*  Building blocks for the decimal floating point types (Number, IOUAmount
+    and STAmount), which keep a mantissa scaled to a fixed number of decimal
+    digits. Rather than moving a mantissa one digit at a time, by
+    multiplying or dividing by ten in a loop, these find how many digits it
+    has from its highest set bit and scale it by a power of ten in one step.
+    Each function gives exactly the result of the loop it replaces.
+*/
+
+namespace ripple {
+namespace decimal {
+
+#if BOOST_COMP_MSVC
+using uint128_t = boost::multiprecision::uint128_t;
+#else
+using uint128_t = __uint128_t;
+#endif
+
+/** The powers of ten which fit in 64 bits, 10^0 through 10^19. */
+inline constexpr std::array<std::uint64_t, 20> powersOfTen = [] {
+    std::array<std::uint64_t, 20> result{};
+    std::uint64_t power = 1;
+    for (auto& p : result)
+    {
+        p = power;
+        power *= 10;
+    }
+    return result;
+}();
+
+/** Returns 10^n, for n from 0 to 38. */
+inline uint128_t
+pow10(int n)
+{
+    assert(n >= 0 && n <= 38);
+    if (n < 20)
+        return powersOfTen[n];
+    return uint128_t(powersOfTen[19]) * powersOfTen[n - 19];
+}
+
+/** Returns floor(log10(v)), one less than the number of digits of v.
+
+    log10(2) is about 1233/4096, which turns the position of the highest
+    set bit into the number of digits, or one more than it.
+
+    @note v must not be zero.
+*/
+constexpr int
+log10Floor(std::uint64_t v)
+{
+    assert(v != 0);
+    int const t = (std::bit_width(v) * 1233) >> 12;
+    return t - (v < powersOfTen[t]);
+}
+
+inline int
+log10Floor(uint128_t const& v)
+{
+    auto const high = static_cast<std::uint64_t>(v >> 64);
+    if (high == 0)
+        return log10Floor(static_cast<std::uint64_t>(v));
+    int const t = ((std::bit_width(high) + 64) * 1233) >> 12;
+    return t - (v < pow10(t));
+}
+
+/** Returns ceil(log10(v)), the least n for which 10^n >= v, or zero. */
+inline int
+log10Ceil(uint128_t const& v)
+{
+    if (v <= 1)
+        return 0;
+    return log10Floor(uint128_t(v - 1)) + 1;
+}
+
+/** Returns v / 10^n, truncated towards zero.
+
+    Gives the same result as dividing v by ten, n times.
+*/
+template <class Int>
+constexpr Int
+shiftDown(Int v, int n)
+{
+    assert(n >= 0);
+    // |v| is below every power of ten too large for Int
+    if (n >= static_cast<int>(powersOfTen.size()) ||
+        powersOfTen[n] > std::uint64_t(std::numeric_limits<Int>::max()))
+        return 0;
+    return v / static_cast<Int>(powersOfTen[n]);
+}
+
+/** Scale a mantissa up to at least the given number of digits.
+
+    Gives the same result as:
+
+        while (m < 10^(digits - 1) && exponent > minExponent)
+        {
+            m *= 10;
+            --exponent;
+        }
+
+    @note m must not be zero, and digits is at most 19.
+*/
+template <class UInt>
+constexpr void
+scaleUp(UInt& m, int& exponent, int digits, int minExponent)
+{
+    assert(m != 0 && digits <= 19);
+    long long n = digits - 1 - log10Floor(static_cast<std::uint64_t>(m));
+    n = std::min<long long>(n, static_cast<long long>(exponent) - minExponent);
+    if (n <= 0)
+        return;
+    m *= static_cast<UInt>(powersOfTen[n]);
+    exponent -= static_cast<int>(n);
+}
+
+/** The quotient and remainder of v / 10^n, for n from 0 to 38. */
+inline std::pair<uint128_t, uint128_t>
+divPow10(uint128_t const& v, int n)
+{
+    auto const d = pow10(n);
+    uint128_t const q = v / d;
+    return {q, v - q * d};
+}
+
+// unit tests
+static_assert(log10Floor(std::uint64_t{1}) == 0);
+static_assert(log10Floor(std::uint64_t{9}) == 0);
+static_assert(log10Floor(std::uint64_t{10}) == 1);
+static_assert(log10Floor(std::uint64_t{999'999'999'999'999}) == 14);
+static_assert(log10Floor(std::uint64_t{1'000'000'000'000'000}) == 15);
+static_assert(log10Floor(std::numeric_limits<std::uint64_t>::max()) == 19);
+static_assert(shiftDown(123456789, 4) == 12345);
+static_assert(shiftDown(-123456789, 4) == -12345);
+static_assert(shiftDown(std::uint64_t{1}, 25) == 0);
+static_assert(shiftDown(std::numeric_limits<std::int64_t>::min(), 19) == 0);
+
+}  // namespace decimal
+}  // namespace ripple
+
+#endif
@@ -0,0 +1,321 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_BASICS_INSERTONLYMAP_H_INCLUDED
+#define RIPPLE_BASICS_INSERTONLYMAP_H_INCLUDED
+
+#include <ripple/basics/hardened_hash.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace ripple {
+
+/** A hash map which many threads can search and add to without locking.
+
+    Entries are never removed or changed once inserted; the whole map is
+    discarded instead. All the entries are kept in one singly linked list,
+    sorted by the bit-reversed hash of their key, and every bucket points
+    at a marker in the list just ahead of the entries which hash into it.
+    Links are only ever added with a compare-and-swap, so a lookup only
+    follows pointers to entries which are complete and immutable.
+
+    The number of buckets doubles as entries are added, without moving
+    any: each bucket is split in two, and the new half gets its marker, in
+    its place in the list, the first time it is used. Buckets are held in
+    segments which are allocated as they are needed, so a small map costs
+    little.
+*/
+template <class Key, class T, class Hash = hardened_hash<>>
+class InsertOnlyMap
+{
+private:
+    // Either a marker or an entry. The order of an entry has its lowest
+    // bit set, that of a marker has it clear, so a bucket's marker comes
+    // before all of its entries.
+    struct Link
+    {
+        std::uint64_t const order;
+        std::atomic<Link*> next{nullptr};
+
+        explicit Link(std::uint64_t o) : order(o)
+        {
+        }
+    };
+
+    struct Node : Link
+    {
+        Key const key;
+        T const value;
+
+        Node(std::uint64_t order, Key const& k, T v)
+            : Link(order), key(k), value(std::move(v))
+        {
+        }
+    };
+
+    // Segment 0 holds bucket 0, and segment s > 0 the buckets from
+    // 2^(s-1) up to 2^s.
+    static constexpr std::size_t segments = 64;
+
+    // The average number of entries in a bucket before the buckets double
+    static constexpr std::size_t maxLoad = 2;
+
+    using Slot = std::atomic<Link*>;
+
+    mutable std::array<std::atomic<Slot*>, segments> table_{};
+    std::atomic<std::uint64_t> buckets_;
+    std::atomic<std::size_t> size_{0};
+    Hash hash_;
+
+    static std::uint64_t
+    reverse(std::uint64_t v)
+    {
+        v = ((v >> 1) & 0x5555555555555555) | ((v & 0x5555555555555555) << 1);
+        v = ((v >> 2) & 0x3333333333333333) | ((v & 0x3333333333333333) << 2);
+        v = ((v >> 4) & 0x0F0F0F0F0F0F0F0F) | ((v & 0x0F0F0F0F0F0F0F0F) << 4);
+        v = ((v >> 8) & 0x00FF00FF00FF00FF) | ((v & 0x00FF00FF00FF00FF) << 8);
+        v = ((v >> 16) & 0x0000FFFF0000FFFF) |
+            ((v & 0x0000FFFF0000FFFF) << 16);
+        return (v >> 32) | (v << 32);
+    }
+
+    // The bucket a bucket was split from
+    static std::uint64_t
+    parent(std::uint64_t bucket)
+    {
+        return bucket & ~std::bit_floor(bucket);
+    }
+
+    // The slot of a bucket, or nullptr if its segment is not allocated
+    // and allocate is false
+    Slot*
+    slot(std::uint64_t bucket, bool allocate) const
+    {
+        auto const s = std::bit_width(bucket);
+        auto const first = s == 0 ? 0 : std::uint64_t{1} << (s - 1);
+        auto& segment = table_[s];
+        auto slots = segment.load(std::memory_order_acquire);
+        if (!slots)
+        {
+            if (!allocate)
+                return nullptr;
+            auto fresh =
+                std::make_unique<Slot[]>(std::max<std::uint64_t>(first, 1));
+            if (segment.compare_exchange_strong(
+                    slots,
+                    fresh.get(),
+                    std::memory_order_acq_rel,
+                    std::memory_order_acquire))
+                slots = fresh.release();
+        }
+        return &slots[bucket - first];
+    }
+
+    // The marker of the bucket, or of the nearest one it was split from
+    // which has been used. The entries of the bucket follow it.
+    Link*
+    nearest(std::uint64_t bucket) const
+    {
+        for (;;)
+        {
+            if (auto const s = slot(bucket, false))
+            {
+                if (auto const link = s->load(std::memory_order_acquire))
+                    return link;
+            }
+            bucket = parent(bucket);
+        }
+    }
+
+    // The marker of a bucket, added to the list if need be
+    Link*
+    marker(std::uint64_t bucket)
+    {
+        auto& s = *slot(bucket, true);
+        if (auto const link = s.load(std::memory_order_acquire))
+            return link;
+
+        auto fresh = std::make_unique<Link>(reverse(bucket));
+        Link* link = fresh.get();
+        if (add(marker(parent(bucket)), link, nullptr))
+            fresh.release();
+        s.store(link, std::memory_order_release);
+        return link;
+    }
+
+    // Search the list after prev for a link of this order and, for an
+    // entry, key. Leaves prev at the last link ordered before it.
+    static Link*
+    search(Link*& prev, std::uint64_t order, Key const* key)
+    {
+        for (auto link = prev->next.load(std::memory_order_acquire);
+             link && link->order <= order;
+             link = link->next.load(std::memory_order_acquire))
+        {
+            if (link->order == order &&
+                (!key || static_cast<Node const*>(link)->key == *key))
+                return link;
+            prev = link;
+        }
+        return nullptr;
+    }
+
+    // Insert a link after prev, unless an equal one is found first, in
+    // which case link is set to that one. Returns `true` if inserted.
+    static bool
+    add(Link* prev, Link*& link, Key const* key)
+    {
+        for (;;)
+        {
+            if (auto const found = search(prev, link->order, key))
+            {
+                link = found;
+                return false;
+            }
+
+            // Another thread may have added a link here since the search
+            auto next = prev->next.load(std::memory_order_acquire);
+            if (next && next->order <= link->order)
+                continue;
+            link->next.store(next, std::memory_order_relaxed);
+            if (prev->next.compare_exchange_weak(
+                    next,
+                    link,
+                    std::memory_order_release,
+                    std::memory_order_relaxed))
+                return true;
+        }
+    }
+
+public:
+    /** Create a map.
+
+        @param buckets The number of buckets to start with. There are
+                       more as entries are added.
+    */
+    explicit InsertOnlyMap(std::size_t buckets = 16)
+        : buckets_(std::bit_ceil(std::max<std::uint64_t>(buckets, 1)))
+    {
+        slot(0, true)->store(new Link(0), std::memory_order_relaxed);
+    }
+
+    InsertOnlyMap(InsertOnlyMap const&) = delete;
+    InsertOnlyMap&
+    operator=(InsertOnlyMap const&) = delete;
+
+    ~InsertOnlyMap()
+    {
+        auto link = table_[0].load(std::memory_order_relaxed)->load(
+            std::memory_order_relaxed);
+        while (link)
+        {
+            auto const next = link->next.load(std::memory_order_relaxed);
+            if (link->order & 1)
+                delete static_cast<Node*>(link);
+            else
+                delete link;
+            link = next;
+        }
+
+        for (auto& segment : table_)
+            delete[] segment.load(std::memory_order_relaxed);
+    }
+
+    /** Returns the value stored for a key, or nullptr. */
+    T const*
+    find(Key const& key) const
+    {
+        std::uint64_t const hash = hash_(key);
+        Link* prev =
+            nearest(hash & (buckets_.load(std::memory_order_relaxed) - 1));
+        auto const link = search(prev, reverse(hash) | 1, &key);
+        return link ? &static_cast<Node const*>(link)->value : nullptr;
+    }
+
+    /** Store a value for a key unless one is already present.
+
+        @return The value stored for the key, and `true` if it is the
+                one just inserted.
+    */
+    std::pair<T const*, bool>
+    insert(Key const& key, T value)
+    {
+        std::uint64_t const hash = hash_(key);
+        auto const buckets = buckets_.load(std::memory_order_relaxed);
+        auto const order = reverse(hash) | 1;
+
+        Link* prev = marker(hash & (buckets - 1));
+        if (auto const found = search(prev, order, &key))
+            return {&static_cast<Node const*>(found)->value, false};
+
+        auto node = std::make_unique<Node>(order, key, std::move(value));
+        Link* link = node.get();
+        if (!add(prev, link, &key))
+            return {&static_cast<Node const*>(link)->value, false};
+        node.release();
+
+        // Split the buckets once they are loaded. Bucket indexes must fit
+        // in the last segment.
+        auto const size = ++size_;
+        auto expected = buckets;
+        if (size > maxLoad * buckets &&
+            buckets < (std::uint64_t{1} << (segments - 2)))
+            buckets_.compare_exchange_strong(expected, buckets * 2);
+
+        return {&static_cast<Node const*>(link)->value, true};
+    }
+
+    /** The number of entries. */
+    std::size_t
+    size() const
+    {
+        return size_.load(std::memory_order_relaxed);
+    }
+
+    /** Call `f(key, value)` for every entry.
+
+        Entries inserted meanwhile may or may not be visited.
+    */
+    template <class F>
+    void
+    forEach(F&& f) const
+    {
+        for (auto link = table_[0].load(std::memory_order_relaxed)->load(
+                 std::memory_order_relaxed);
+             link != nullptr;
+             link = link->next.load(std::memory_order_acquire))
+        {
+            if (link->order & 1)
+            {
+                auto const node = static_cast<Node const*>(link);
+                f(node->key, node->value);
+            }
+        }
+    }
+};
+
+}  // namespace ripple
+
+#endif
@@ -0,0 +1,124 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_BASICS_PARALLELFOR_H_INCLUDED
+#define RIPPLE_BASICS_PARALLELFOR_H_INCLUDED
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace ripple {
+
+/** Call `work(i)` for each `i` in [0, count) on several threads.
+
+    The calling thread works through the items itself, and `post` is
+    called up to `helpers` times to start other threads (for example
+    JobQueue jobs) which join in. `post` takes a `std::function<void()>`
+    and returns `false` if it could not start one.
+
+    Items are claimed one at a time, so a helper that starts late finds
+    nothing left and returns at once, and the caller only ever waits for
+    items already being worked on. This means the call cannot deadlock
+    when it runs on a thread of the pool it posts to, however busy that
+    pool is.
+
+    If `work` throws, the items not yet started are skipped, and the
+    first exception is rethrown to the caller once the others finish.
+*/
+template <class Post, class Work>
+void
+parallelFor(std::size_t count, std::size_t helpers, Post&& post, Work&& work)
+{
+    struct State
+    {
+        std::size_t const count;
+        std::atomic<std::size_t> next{0};
+        std::atomic<bool> failed{false};
+        std::size_t finished = 0;
+        std::exception_ptr error;
+        std::mutex mutex;
+        std::condition_variable cv;
+
+        // Only used for a claimed item, while the caller is waiting.
+        std::function<void(std::size_t)> work;
+
+        explicit State(std::size_t n) : count(n)
+        {
+        }
+
+        void
+        run()
+        {
+            for (;;)
+            {
+                auto const i = next++;
+                if (i >= count)
+                    return;
+
+                std::exception_ptr e;
+                if (!failed)
+                {
+                    try
+                    {
+                        work(i);
+                    }
+                    catch (...)
+                    {
+                        e = std::current_exception();
+                        failed = true;
+                    }
+                }
+
+                std::lock_guard lock(mutex);
+                if (e && !error)
+                    error = e;
+                if (++finished == count)
+                    cv.notify_all();
+            }
+        }
+    };
+
+    if (count == 0)
+        return;
+
+    auto state = std::make_shared<State>(count);
+    state->work = std::ref(work);
+
+    for (std::size_t i = 1; i < count && i <= helpers; ++i)
+    {
+        if (!post(std::function<void()>([state] { state->run(); })))
+            break;
+    }
+
+    state->run();
+
+    std::unique_lock lock(state->mutex);
+    state->cv.wait(lock, [&] { return state->finished == state->count; });
+    if (state->error)
+        std::rethrow_exception(state->error);
+}
+
+}  // namespace ripple
+
+#endif
@@ -17,11 +17,10 @@
 */
 //==============================================================================
 
+#include <ripple/basics/DecimalMath.h>
 #include <ripple/basics/IOUAmount.h>
 #include <ripple/basics/contract.h>
-#include <boost/multiprecision/cpp_int.hpp>
 #include <algorithm>
-#include <iterator>
 #include <numeric>
 #include <stdexcept>
 
@@ -68,19 +67,16 @@ IOUAmount::normalize()
     if (negative)
         mantissa_ = -mantissa_;
 
-    while ((mantissa_ < minMantissa) && (exponent_ > minExponent))
-    {
-        mantissa_ *= 10;
-        --exponent_;
-    }
+    decimal::scaleUp(mantissa_, exponent_, 16, minExponent);
 
-    while (mantissa_ > maxMantissa)
+    if (mantissa_ > maxMantissa)
     {
-        if (exponent_ >= maxExponent)
+        int const n = decimal::log10Floor(std::uint64_t(mantissa_)) - 15;
+        if (exponent_ + n > maxExponent)
             Throw<std::overflow_error>("IOUAmount::normalize");
 
-        mantissa_ /= 10;
-        ++exponent_;
+        mantissa_ = decimal::shiftDown(mantissa_, n);
+        exponent_ += n;
     }
 
     if ((exponent_ < minExponent) || (mantissa_ < minMantissa))
@@ -164,51 +160,17 @@ mulRatio(
     std::uint32_t den,
     bool roundUp)
 {
-    using namespace boost::multiprecision;
+    using decimal::log10Ceil;
+    using decimal::pow10;
+    using decimal::uint128_t;
 
     if (!den)
         Throw<std::runtime_error>("division by zero");
 
-    // A vector with the value 10^index for indexes from 0 to 29
     // The largest intermediate value we expect is 2^96, which
     // is less than 10^29
-    static auto const powerTable = [] {
-        std::vector<uint128_t> result;
-        result.reserve(30);  // 2^96 is largest intermediate result size
-        uint128_t cur(1);
-        for (int i = 0; i < 30; ++i)
-        {
-            result.push_back(cur);
-            cur *= 10;
-        };
-        return result;
-    }();
-
-    // Return floor(log10(v))
-    // Note: Returns -1 for v == 0
-    static auto log10Floor = [](uint128_t const& v) {
-        // Find the index of the first element >= the requested element, the
-        // index is the log of the element in the log table.
-        auto const l =
-            std::lower_bound(powerTable.begin(), powerTable.end(), v);
-        int index = std::distance(powerTable.begin(), l);
-        // If we're not equal, subtract to get the floor
-        if (*l != v)
-            --index;
-        return index;
-    };
-
-    // Return ceil(log10(v))
-    static auto log10Ceil = [](uint128_t const& v) {
-        // Find the index of the first element >= the requested element, the
-        // index is the log of the element in the log table.
-        auto const l =
-            std::lower_bound(powerTable.begin(), powerTable.end(), v);
-        return int(std::distance(powerTable.begin(), l));
-    };
-
-    static auto const fl64 =
-        log10Floor(std::numeric_limits<std::int64_t>::max());
+    static int constexpr fl64 = decimal::log10Floor(
+        std::uint64_t(std::numeric_limits<std::int64_t>::max()));
 
     bool const neg = amt.mantissa() < 0;
     uint128_t const den128(den);
@@ -234,8 +196,8 @@ mulRatio(
         if (roomToGrow > 0)
         {
             exponent -= roomToGrow;
-            low *= powerTable[roomToGrow];
-            rem *= powerTable[roomToGrow];
+            low *= pow10(roomToGrow);
+            rem *= pow10(roomToGrow);
         }
         auto const addRem = rem / den128;
         low += addRem;
@@ -252,12 +214,12 @@ mulRatio(
     {
         uint128_t const sav(low);
         exponent += mustShrink;
-        low /= powerTable[mustShrink];
+        low /= pow10(mustShrink);
         if (!hasRem)
-            hasRem = bool(sav - low * powerTable[mustShrink]);
+            hasRem = bool(sav - low * pow10(mustShrink));
     }
 
-    std::int64_t mantissa = low.convert_to<std::int64_t>();
+    auto mantissa = static_cast<std::int64_t>(low);
 
     // normalize before rounding
     if (neg)
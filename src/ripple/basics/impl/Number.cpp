@@ -17,8 +17,8 @@
 */
 //==============================================================================
 
+#include <ripple/basics/DecimalMath.h>
 #include <ripple/basics/Number.h>
-#include <boost/predef.h>
 #include <algorithm>
 #include <cassert>
 #include <numeric>
@@ -26,15 +26,10 @@
 #include <type_traits>
 #include <utility>
 
-#ifdef BOOST_COMP_MSVC
-#include <boost/multiprecision/cpp_int.hpp>
-using uint128_t = boost::multiprecision::uint128_t;
-#else   // !defined(_MSVC_LANG)
-using uint128_t = __uint128_t;
-#endif  // !defined(_MSVC_LANG)
-
 namespace ripple {
 
+using decimal::uint128_t;
+
 thread_local Number::rounding_mode Number::mode_ = Number::to_nearest;
 
 Number::rounding_mode
@@ -164,6 +159,35 @@ Number::Guard::round() noexcept
     return 0;
 }
 
+// Returns what Guard::round would after the n lowest digits of a value,
+// whose value is rem, were pushed into a new Guard. Lets a value be scaled
+// down in one division rather than a digit at a time.
+static int
+roundRemainder(uint128_t const& rem, int n, bool negative)
+{
+    if (n == 0)
+        return -1;
+
+    auto const mode = Number::getround();
+
+    if (mode == Number::towards_zero)
+        return -1;
+
+    if (mode == Number::downward)
+        return (negative && rem != 0) ? 1 : -1;
+
+    if (mode == Number::upward)
+        return (!negative && rem != 0) ? 1 : -1;
+
+    // Any remainder of up to 20 digits is below half of 10^20
+    auto const half = 5 * decimal::pow10(std::min(n, 20) - 1);
+    if (rem > half)
+        return 1;
+    if (rem < half)
+        return -1;
+    return 0;
+}
+
 // Number
 
 constexpr Number one{1000000000000000, -15, Number::unchecked{}};
@@ -180,21 +204,18 @@ Number::normalize()
     auto m = static_cast<std::make_unsigned_t<rep>>(mantissa_);
     if (negative)
         m = -m;
-    while ((m < minMantissa) && (exponent_ > minExponent))
+    decimal::scaleUp(m, exponent_, 16, minExponent);
+    int r = -1;
+    if (m > maxMantissa)
     {
-        m *= 10;
-        --exponent_;
-    }
-    Guard g;
-    if (negative)
-        g.set_negative();
-    while (m > maxMantissa)
-    {
-        if (exponent_ >= maxExponent)
+        // Drop the digits past the sixteenth, at most four of them
+        int const n = decimal::log10Floor(m) - 15;
+        if (exponent_ + n > maxExponent)
             throw std::overflow_error("Number::normalize 1");
-        g.push(m % 10);
-        m /= 10;
-        ++exponent_;
+        auto const d = decimal::powersOfTen[n];
+        r = roundRemainder(m % d, n, negative);
+        m /= d;
+        exponent_ += n;
     }
     mantissa_ = m;
     if ((exponent_ < minExponent) || (mantissa_ < minMantissa))
@@ -203,7 +224,6 @@ Number::normalize()
         return;
     }
 
-    auto r = g.round();
     if (r == 1 || (r == 0 && (mantissa_ & 1) == 1))
     {
         ++mantissa_;
@@ -336,34 +356,6 @@ Number::operator+=(Number const& y)
     return *this;
 }
 
-// Optimization equivalent to:
-// auto r = static_cast<unsigned>(u % 10);
-// u /= 10;
-// return r;
-// Derived from Hacker's Delight Second Edition Chapter 10
-// by Henry S. Warren, Jr.
-static inline unsigned
-divu10(uint128_t& u)
-{
-    // q = u * 0.75
-    auto q = (u >> 1) + (u >> 2);
-    // iterate towards q = u * 0.8
-    q += q >> 4;
-    q += q >> 8;
-    q += q >> 16;
-    q += q >> 32;
-    q += q >> 64;
-    // q /= 8 approximately == u / 10
-    q >>= 3;
-    // r = u - q * 10  approximately == u % 10
-    auto r = static_cast<unsigned>(u - ((q << 3) + (q << 1)));
-    // correction c is 1 if r >= 10 else 0
-    auto c = (r + 6) >> 4;
-    u = q + c;
-    r -= c * 10;
-    return r;
-}
-
 Number&
 Number::operator*=(Number const& y)
 {
@@ -394,20 +386,18 @@ Number::operator*=(Number const& y)
     auto zm = uint128_t(xm) * uint128_t(ym);
     auto ze = xe + ye;
     auto zn = xn * yn;
-    Guard g;
-    if (zn == -1)
-        g.set_negative();
-    while (zm > maxMantissa)
-    {
-        // The following is optimization for:
-        // g.push(static_cast<unsigned>(zm % 10));
-        // zm /= 10;
-        g.push(divu10(zm));
-        ++ze;
+    int r = -1;
+    if (zm > maxMantissa)
+    {
+        // The product has up to 32 digits: drop all but 16 in one step
+        int const n = decimal::log10Floor(zm) - 15;
+        auto const [q, rem] = decimal::divPow10(zm, n);
+        r = roundRemainder(rem, n, zn == -1);
+        zm = q;
+        ze += n;
     }
     xm = static_cast<rep>(zm);
     xe = ze;
-    auto r = g.round();
     if (r == 1 || (r == 0 && (xm & 1) == 1))
     {
         ++xm;
@@ -469,18 +459,21 @@ Number::operator rep() const
 {
     rep drops = mantissa_;
     int offset = exponent_;
-    Guard g;
     if (drops != 0)
     {
-        if (drops < 0)
-        {
-            g.set_negative();
+        bool const negative = drops < 0;
+        if (negative)
             drops = -drops;
-        }
-        for (; offset < 0; ++offset)
+        int r = -1;
+        if (offset < 0)
         {
-            g.push(drops % 10);
-            drops /= 10;
+            // Past 20 digits the remainder is all of drops
+            int const n = std::min(-offset, 20);
+            auto const rem =
+                n < 20 ? drops % decimal::powersOfTen[n] : drops;
+            r = roundRemainder(rem, n, negative);
+            drops = decimal::shiftDown(drops, n);
+            offset = 0;
         }
         for (; offset > 0; --offset)
         {
@@ -488,12 +481,11 @@ Number::operator rep() const
                 throw std::overflow_error("Number::operator rep() overflow");
             drops *= 10;
         }
-        auto r = g.round();
         if (r == 1 || (r == 0 && (drops & 1) == 1))
         {
             ++drops;
         }
-        if (g.is_negative())
+        if (negative)
             drops = -drops;
     }
     return drops;
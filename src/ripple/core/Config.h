@@ -214,6 +214,9 @@ public:
     int PATH_SEARCH_FAST = 2;
     int PATH_SEARCH_MAX = 3;
 
+    // The number of threads which check the liquidity of candidate paths.
+    std::size_t PATH_SEARCH_THREADS = 1;
+
     // Validation
     std::optional<std::size_t>
         VALIDATION_QUORUM;  // validations to consider ledger authoritative
@@ -222,8 +225,21 @@ public:
 
     // Node storage configuration
     std::uint32_t LEDGER_HISTORY = 256;
+
+    // The number of recent validated ledgers kept in memory in compact form
+    std::uint32_t LEDGER_LIGHT_HISTORY = 256;
     std::uint32_t FETCH_DEPTH = 1000000000;
 
+    // The number of threads which add, and search for, the nodes of
+    // acquired ledgers.
+    std::size_t LEDGER_FETCH_THREADS = 1;
+
+    // The file the hashes of the entries of the caches are written to on a
+    // clean shutdown, to warm the caches on startup, if any, and whether
+    // the nodes themselves are written too.
+    std::string CACHE_SNAPSHOT_PATH;
+    bool CACHE_SNAPSHOT_DATA = false;
+
     // Tunable that adjusts various parameters, typically associated
     // with hardware parameters (RAM size and CPU cores). The default
     // is 'tiny'.
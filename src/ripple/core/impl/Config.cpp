@@ -641,6 +641,9 @@ Config::loadFromString(std::string const& fileContents)
             LEDGER_HISTORY = beast::lexicalCastThrow<std::uint32_t>(strTemp);
     }
 
+    if (getSingleSection(secConfig, SECTION_LEDGER_LIGHT_HISTORY, strTemp, j_))
+        LEDGER_LIGHT_HISTORY = beast::lexicalCastThrow<std::uint32_t>(strTemp);
+
     if (getSingleSection(secConfig, SECTION_FETCH_DEPTH, strTemp, j_))
     {
         if (boost::iequals(strTemp, "none"))
@@ -654,6 +657,26 @@ Config::loadFromString(std::string const& fileContents)
             FETCH_DEPTH = 10;
     }
 
+    if (getSingleSection(secConfig, SECTION_LEDGER_FETCH_THREADS, strTemp, j_))
+    {
+        LEDGER_FETCH_THREADS = beast::lexicalCastThrow<std::size_t>(strTemp);
+
+        if (LEDGER_FETCH_THREADS < 1 || LEDGER_FETCH_THREADS > 16)
+            Throw<std::runtime_error>(
+                "Invalid " SECTION_LEDGER_FETCH_THREADS
+                ": must be between 1 and 16 inclusive");
+    }
+
+    if (exists(SECTION_CACHE_SNAPSHOT))
+    {
+        auto const sec = section(SECTION_CACHE_SNAPSHOT);
+        CACHE_SNAPSHOT_PATH = sec.value_or("path", std::string{});
+        CACHE_SNAPSHOT_DATA = sec.value_or("data", false);
+        if (CACHE_SNAPSHOT_PATH.empty())
+            Throw<std::runtime_error>(
+                "Invalid " SECTION_CACHE_SNAPSHOT ": path is required");
+    }
+
     // By default, validators don't have pathfinding enabled, unless it is
     // explicitly requested by the server's admin.
     if (exists(SECTION_VALIDATION_SEED) || exists(SECTION_VALIDATOR_TOKEN))
@@ -667,6 +690,15 @@ Config::loadFromString(std::string const& fileContents)
         PATH_SEARCH_FAST = beast::lexicalCastThrow<int>(strTemp);
     if (getSingleSection(secConfig, SECTION_PATH_SEARCH_MAX, strTemp, j_))
         PATH_SEARCH_MAX = beast::lexicalCastThrow<int>(strTemp);
+    if (getSingleSection(secConfig, SECTION_PATH_SEARCH_THREADS, strTemp, j_))
+    {
+        PATH_SEARCH_THREADS = beast::lexicalCastThrow<std::size_t>(strTemp);
+
+        if (PATH_SEARCH_THREADS < 1 || PATH_SEARCH_THREADS > 16)
+            Throw<std::runtime_error>(
+                "Invalid " SECTION_PATH_SEARCH_THREADS
+                ": must be between 1 and 16 inclusive");
+    }
 
     if (getSingleSection(secConfig, SECTION_DEBUG_LOGFILE, strTemp, j_))
         DEBUG_LOGFILE = strTemp;
@@ -0,0 +1,417 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_JSON_DOCUMENT_H_INCLUDED
+#define RIPPLE_JSON_DOCUMENT_H_INCLUDED
+
+#include <ripple/json/json_value.h>
+#include <ripple/json/json_writer.h>
+#include <boost/container/pmr/monotonic_buffer_resource.hpp>
+#include <boost/container/pmr/vector.hpp>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace Json {
+
+/** A JSON document whose values all live in a single arena.
+
+    Building a large response as a Json::Value performs one heap
+    allocation per object member (a std::map node) and one per string.
+    A Document instead takes all of its memory from a monotonic arena
+    which is released in one step when the document is destroyed:
+
+    - Values are never freed individually. Replacing a value, or growing
+      an array or object, leaves the old storage in the arena until the
+      document goes away.
+    - Keys given as a StaticString (all of the `jss::` constants) are
+      referenced rather than copied.
+    - Strings of up to Node::smallSize characters are stored inline.
+    - Object members are kept sorted by key, so a document serializes
+      to exactly the same text as the equivalent Json::Value.
+
+    References to values are stable: appending to an array or adding a
+    member to an object never moves an existing value.
+
+    The conversion layer, Node::operator=(Json::Value const&) and
+    Node::toJson(), lets code which still produces or consumes
+    Json::Value be mixed with code which writes into a document, so that
+    handlers can be migrated one at a time.
+
+    A Document is not thread safe, and is neither copyable nor movable.
+*/
+class Document
+{
+public:
+    class Node;
+
+    explicit Document(std::size_t initialSize = 4096);
+
+    Document(Document const&) = delete;
+    Document&
+    operator=(Document const&) = delete;
+
+    Node&
+    root()
+    {
+        return *root_;
+    }
+
+    Node const&
+    root() const
+    {
+        return *root_;
+    }
+
+    /** Convert the whole document to a Json::Value. */
+    Json::Value
+    toJson() const;
+
+private:
+    void*
+    allocate(std::size_t size, std::size_t alignment);
+
+    Node*
+    makeNode();
+
+    // Copy a string into the arena, adding a terminating null.
+    char const*
+    copyString(char const* data, std::size_t size);
+
+    boost::container::pmr::monotonic_buffer_resource resource_;
+    Node* root_;
+};
+
+/** A value in a Document.
+
+    Nodes are created by, and belong to, their document. The interface
+    follows Json::Value where it can.
+*/
+class Document::Node
+{
+public:
+    /** The longest string which is stored inline. */
+    static constexpr std::size_t smallSize = 15;
+
+    struct Member
+    {
+        std::string_view key;
+        Node* value;
+    };
+
+    using Members = boost::container::pmr::vector<Member>;
+    using Elements = boost::container::pmr::vector<Node*>;
+
+    Node(Node const&) = delete;
+    Node&
+    operator=(Node const&) = delete;
+
+    ValueType
+    type() const
+    {
+        return type_;
+    }
+
+    bool
+    isNull() const
+    {
+        return type_ == nullValue;
+    }
+
+    explicit operator bool() const
+    {
+        return !isNull();
+    }
+
+    /** The number of elements or members, zero for scalars. */
+    std::size_t
+    size() const;
+
+    /** Make this an empty value of the given type. */
+    Node&
+    operator=(ValueType type);
+
+    Node&
+    operator=(std::nullptr_t);
+
+    Node&
+    operator=(bool value);
+
+    Node&
+    operator=(Int value);
+
+    Node&
+    operator=(UInt value);
+
+    Node&
+    operator=(double value);
+
+    /** Assign a string that outlives the document, without copying it. */
+    Node&
+    operator=(StaticString const& value);
+
+    Node&
+    operator=(char const* value);
+
+    Node&
+    operator=(std::string const& value);
+
+    /** Assign a deep copy of a Json::Value. */
+    Node&
+    operator=(Json::Value const& value);
+
+    /** Access an object member, creating it if needed.
+
+        A null value becomes an empty object first.
+    */
+    Node&
+    operator[](StaticString const& key);
+
+    Node&
+    operator[](std::string const& key);
+
+    /** Return the member with the given key, or nullptr. */
+    Node const*
+    find(std::string_view key) const;
+
+    bool
+    isMember(std::string_view key) const
+    {
+        return find(key) != nullptr;
+    }
+
+    /** Append a null element. A null value becomes an empty array first. */
+    Node&
+    append();
+
+    template <class T>
+    Node&
+    append(T const& value)
+    {
+        auto& node = append();
+        node = value;
+        return node;
+    }
+
+    /** Return an array element. */
+    Node const&
+    at(std::size_t index) const
+    {
+        return *(*elements_)[index];
+    }
+
+    /** The string held by a string value. */
+    std::string_view
+    asString() const;
+
+    Int
+    asInt() const
+    {
+        return int_;
+    }
+
+    UInt
+    asUInt() const
+    {
+        return uint_;
+    }
+
+    double
+    asDouble() const
+    {
+        return real_;
+    }
+
+    bool
+    asBool() const
+    {
+        return bool_;
+    }
+
+    /** The members of an object, sorted by key. */
+    Members const&
+    members() const
+    {
+        return *members_;
+    }
+
+    /** The elements of an array. */
+    Elements const&
+    elements() const
+    {
+        return *elements_;
+    }
+
+    /** Convert this value, and everything below it, to a Json::Value. */
+    Json::Value
+    toJson() const;
+
+private:
+    friend class Document;
+
+    explicit Node(Document& document) : document_(document)
+    {
+    }
+
+    Node&
+    member(char const* key, std::size_t size, bool copy);
+
+    void
+    setString(char const* data, std::size_t size);
+
+    Document& document_;
+    ValueType type_ = nullValue;
+    bool small_ = false;
+    std::uint8_t smallLength_ = 0;
+    union
+    {
+        Int int_;
+        UInt uint_;
+        double real_;
+        bool bool_;
+        struct
+        {
+            char const* data;
+            std::size_t size;
+        } string_;
+        char inline_[smallSize + 1];
+        Elements* elements_;
+        Members* members_;
+    };
+};
+
+//------------------------------------------------------------------------------
+
+// Helpers matching those in Object.h, so that code templated on the kind of
+// JSON object (such as LedgerToJson) can also write into a document.
+
+inline Document::Node&
+setArray(Document::Node& json, StaticString const& key)
+{
+    return json[key] = arrayValue;
+}
+
+inline Document::Node&
+addObject(Document::Node& json, StaticString const& key)
+{
+    return json[key] = objectValue;
+}
+
+inline Document::Node&
+appendArray(Document::Node& json)
+{
+    return json.append() = arrayValue;
+}
+
+inline Document::Node&
+appendObject(Document::Node& json)
+{
+    return json.append() = objectValue;
+}
+
+void
+copyFrom(Document::Node& to, Json::Value const& from);
+
+//------------------------------------------------------------------------------
+
+namespace detail {
+
+template <class Write>
+void
+write_node(Write const& write, Document::Node const& node)
+{
+    switch (node.type())
+    {
+        case nullValue:
+            write("null", 4);
+            break;
+
+        case intValue:
+            write_string(write, valueToString(node.asInt()));
+            break;
+
+        case uintValue:
+            write_string(write, valueToString(node.asUInt()));
+            break;
+
+        case realValue:
+            write_string(write, valueToString(node.asDouble()));
+            break;
+
+        case stringValue:
+            // Strings are always stored null terminated.
+            write_string(write, valueToQuotedString(node.asString().data()));
+            break;
+
+        case booleanValue:
+            write_string(write, valueToString(node.asBool()));
+            break;
+
+        case arrayValue: {
+            write("[", 1);
+            bool first = true;
+            for (auto const element : node.elements())
+            {
+                if (!first)
+                    write(",", 1);
+                first = false;
+                write_node(write, *element);
+            }
+            write("]", 1);
+            break;
+        }
+
+        case objectValue: {
+            write("{", 1);
+            bool first = true;
+            for (auto const& member : node.members())
+            {
+                if (!first)
+                    write(",", 1);
+                first = false;
+                write_string(write, valueToQuotedString(member.key.data()));
+                write(":", 1);
+                write_node(write, *member.value);
+            }
+            write("}", 1);
+            break;
+        }
+    }
+}
+
+}  // namespace detail
+
+/** Stream compact JSON, exactly as Json::stream would for the equivalent
+    Json::Value. */
+template <class Write>
+void
+stream(Document const& document, Write const& write)
+{
+    detail::write_node(write, document.root());
+    write("\n", 1);
+}
+
+/** Return compact JSON, exactly as Json::to_string would for the
+    equivalent Json::Value. */
+std::string
+to_string(Document const& document);
+
+}  // namespace Json
+
+#endif
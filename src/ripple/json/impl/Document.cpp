@@ -0,0 +1,363 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/json/Document.h>
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+namespace Json {
+
+Document::Document(std::size_t initialSize)
+    : resource_(initialSize), root_(makeNode())
+{
+}
+
+Json::Value
+Document::toJson() const
+{
+    return root_->toJson();
+}
+
+void*
+Document::allocate(std::size_t size, std::size_t alignment)
+{
+    return resource_.allocate(size, alignment);
+}
+
+Document::Node*
+Document::makeNode()
+{
+    return new (allocate(sizeof(Node), alignof(Node))) Node(*this);
+}
+
+char const*
+Document::copyString(char const* data, std::size_t size)
+{
+    auto const p = static_cast<char*>(allocate(size + 1, 1));
+    if (size != 0)
+        std::memcpy(p, data, size);
+    p[size] = '\0';
+    return p;
+}
+
+//------------------------------------------------------------------------------
+
+std::size_t
+Document::Node::size() const
+{
+    if (type_ == arrayValue)
+        return elements_->size();
+    if (type_ == objectValue)
+        return members_->size();
+    return 0;
+}
+
+Document::Node&
+Document::Node::operator=(ValueType type)
+{
+    type_ = type;
+    small_ = false;
+    switch (type)
+    {
+        case nullValue:
+            break;
+        case intValue:
+            int_ = 0;
+            break;
+        case uintValue:
+            uint_ = 0;
+            break;
+        case realValue:
+            real_ = 0.0;
+            break;
+        case stringValue:
+            small_ = true;
+            smallLength_ = 0;
+            inline_[0] = '\0';
+            break;
+        case booleanValue:
+            bool_ = false;
+            break;
+        case arrayValue:
+            elements_ = new (document_.allocate(
+                sizeof(Elements), alignof(Elements)))
+                Elements(Elements::allocator_type(&document_.resource_));
+            break;
+        case objectValue:
+            members_ = new (document_.allocate(
+                sizeof(Members), alignof(Members)))
+                Members(Members::allocator_type(&document_.resource_));
+            break;
+    }
+    return *this;
+}
+
+Document::Node&
+Document::Node::operator=(std::nullptr_t)
+{
+    return *this = nullValue;
+}
+
+Document::Node&
+Document::Node::operator=(bool value)
+{
+    type_ = booleanValue;
+    bool_ = value;
+    return *this;
+}
+
+Document::Node&
+Document::Node::operator=(Int value)
+{
+    type_ = intValue;
+    int_ = value;
+    return *this;
+}
+
+Document::Node&
+Document::Node::operator=(UInt value)
+{
+    type_ = uintValue;
+    uint_ = value;
+    return *this;
+}
+
+Document::Node&
+Document::Node::operator=(double value)
+{
+    type_ = realValue;
+    real_ = value;
+    return *this;
+}
+
+Document::Node&
+Document::Node::operator=(StaticString const& value)
+{
+    type_ = stringValue;
+    small_ = false;
+    string_.data = value.c_str();
+    string_.size = std::strlen(string_.data);
+    return *this;
+}
+
+Document::Node&
+Document::Node::operator=(char const* value)
+{
+    setString(value, std::strlen(value));
+    return *this;
+}
+
+Document::Node&
+Document::Node::operator=(std::string const& value)
+{
+    setString(value.data(), value.size());
+    return *this;
+}
+
+void
+Document::Node::setString(char const* data, std::size_t size)
+{
+    type_ = stringValue;
+    if (size <= smallSize)
+    {
+        small_ = true;
+        smallLength_ = static_cast<std::uint8_t>(size);
+        if (size != 0)
+            std::memcpy(inline_, data, size);
+        inline_[size] = '\0';
+    }
+    else
+    {
+        small_ = false;
+        string_.data = document_.copyString(data, size);
+        string_.size = size;
+    }
+}
+
+Document::Node&
+Document::Node::operator=(Json::Value const& value)
+{
+    switch (value.type())
+    {
+        case nullValue:
+            return *this = nullValue;
+        case intValue:
+            return *this = value.asInt();
+        case uintValue:
+            return *this = value.asUInt();
+        case realValue:
+            return *this = value.asDouble();
+        case stringValue:
+            return *this = value.asCString();
+        case booleanValue:
+            return *this = value.asBool();
+        case arrayValue:
+            *this = arrayValue;
+            elements_->reserve(value.size());
+            for (auto const& element : value)
+                append() = element;
+            return *this;
+        case objectValue:
+            *this = objectValue;
+            members_->reserve(value.size());
+            for (auto it = value.begin(); it != value.end(); ++it)
+            {
+                // Json::Value iterates in key order, so this only ever
+                // appends.
+                auto const key = it.memberName();
+                member(key, std::strlen(key), true) = *it;
+            }
+            return *this;
+    }
+    return *this;
+}
+
+Document::Node&
+Document::Node::member(char const* key, std::size_t size, bool copy)
+{
+    if (type_ != objectValue)
+        *this = objectValue;
+
+    std::string_view const k(key, size);
+    auto it = std::lower_bound(
+        members_->begin(),
+        members_->end(),
+        k,
+        [](Member const& m, std::string_view k) { return m.key < k; });
+    if (it != members_->end() && it->key == k)
+        return *it->value;
+
+    if (copy)
+        key = document_.copyString(key, size);
+    auto node = document_.makeNode();
+    members_->insert(it, Member{std::string_view(key, size), node});
+    return *node;
+}
+
+Document::Node&
+Document::Node::operator[](StaticString const& key)
+{
+    return member(key.c_str(), std::strlen(key.c_str()), false);
+}
+
+Document::Node&
+Document::Node::operator[](std::string const& key)
+{
+    return member(key.data(), key.size(), true);
+}
+
+Document::Node const*
+Document::Node::find(std::string_view key) const
+{
+    if (type_ != objectValue)
+        return nullptr;
+
+    auto it = std::lower_bound(
+        members_->begin(),
+        members_->end(),
+        key,
+        [](Member const& m, std::string_view k) { return m.key < k; });
+    if (it != members_->end() && it->key == key)
+        return it->value;
+    return nullptr;
+}
+
+Document::Node&
+Document::Node::append()
+{
+    if (type_ != arrayValue)
+        *this = arrayValue;
+
+    auto node = document_.makeNode();
+    elements_->push_back(node);
+    return *node;
+}
+
+std::string_view
+Document::Node::asString() const
+{
+    if (type_ != stringValue)
+        return {};
+    if (small_)
+        return {inline_, smallLength_};
+    return {string_.data, string_.size};
+}
+
+Json::Value
+Document::Node::toJson() const
+{
+    switch (type_)
+    {
+        case nullValue:
+            return Json::Value();
+        case intValue:
+            return int_;
+        case uintValue:
+            return uint_;
+        case realValue:
+            return real_;
+        case stringValue:
+            return asString().data();
+        case booleanValue:
+            return bool_;
+        case arrayValue: {
+            Json::Value result(Json::arrayValue);
+            for (auto const element : *elements_)
+                result.append(element->toJson());
+            return result;
+        }
+        case objectValue: {
+            Json::Value result(Json::objectValue);
+            for (auto const& m : *members_)
+                result[std::string(m.key)] = m.value->toJson();
+            return result;
+        }
+    }
+    return Json::Value();
+}
+
+//------------------------------------------------------------------------------
+
+void
+copyFrom(Document::Node& to, Json::Value const& from)
+{
+    if (!to)  // Short circuit this very common case.
+    {
+        to = from;
+        return;
+    }
+
+    for (auto it = from.begin(); it != from.end(); ++it)
+        to[it.memberName()] = *it;
+}
+
+std::string
+to_string(Document const& document)
+{
+    std::string s;
+    detail::write_node(
+        [&s](void const* data, std::size_t n) {
+            s.append(static_cast<char const*>(data), n);
+        },
+        document.root());
+    return s;
+}
+
+}  // namespace Json
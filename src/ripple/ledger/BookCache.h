@@ -0,0 +1,118 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_LEDGER_BOOKCACHE_H_INCLUDED
+#define RIPPLE_LEDGER_BOOKCACHE_H_INCLUDED
+
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/basics/base_uint.h>
+#include <ripple/protocol/Quality.h>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ripple {
+
+class ReadView;
+
+/** An offer in an order book, as listed by the book's directories. */
+struct BookOffer
+{
+    // The first page of the directory of the offer's quality
+    uint256 root;
+
+    // The page of that directory which lists the offer
+    uint256 dir;
+
+    // The key of the offer
+    uint256 index;
+
+    Quality quality;
+};
+
+/** The offers at the top of an order book, in the order they are taken. */
+using BookOffers = std::vector<BookOffer>;
+
+/** The tops of the order books of an immutable ledger.
+
+    Taking offers from a book means finding each quality directory with
+    succ and then reading the pages of the directory. Every strand which
+    goes through a book, and every pass over the strand, walks the same
+    directories again. This keeps, for each book asked for, the first
+    offers in the order BookTip presents them, read once per ledger.
+    Only the most recently used books are kept, up to a fixed number.
+
+    The ledger must not change while the cache is in use.
+*/
+class BookCache
+{
+public:
+    /** The number of offers kept for each book. */
+    static constexpr std::size_t defaultDepth = 128;
+
+    /** The number of books kept. */
+    static constexpr std::size_t defaultCapacity = 256;
+
+    explicit BookCache(
+        std::size_t depth = defaultDepth,
+        std::size_t capacity = defaultCapacity);
+
+    BookCache(BookCache const&) = delete;
+    BookCache&
+    operator=(BookCache const&) = delete;
+
+    /** Return the top of an order book, reading it if needed.
+
+        @param ledger The ledger whose books this caches.
+        @param book The base key of the book's directories.
+    */
+    std::shared_ptr<BookOffers const>
+    get(ReadView const& ledger, uint256 const& book);
+
+    /** Return the number of books cached. */
+    std::size_t
+    size() const;
+
+private:
+    std::shared_ptr<BookOffers const>
+    fetch(ReadView const& ledger, uint256 const& book) const;
+
+    struct Entry
+    {
+        std::shared_ptr<BookOffers const> offers;
+
+        // Where the book is in lru_
+        std::list<uint256>::iterator position;
+    };
+
+    std::size_t const depth_;
+    std::size_t const capacity_;
+
+    std::mutex mutable mutex_;
+    hash_map<uint256, Entry> books_;
+
+    // The books cached, most recently used first
+    std::list<uint256> lru_;
+};
+
+}  // namespace ripple
+
+#endif
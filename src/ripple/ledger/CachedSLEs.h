@@ -20,12 +20,183 @@
 #ifndef RIPPLE_LEDGER_CACHEDSLES_H_INCLUDED
 #define RIPPLE_LEDGER_CACHEDSLES_H_INCLUDED
 
-#include <ripple/basics/TaggedCache.h>
+#include <ripple/basics/InsertOnlyMap.h>
 #include <ripple/basics/base_uint.h>
 #include <ripple/protocol/STLedgerEntry.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 
 namespace ripple {
-using CachedSLEs = TaggedCache<uint256, SLE const>;
-}
+
+/** Ledger entries shared by the cached views of every ledger.
+
+    Entries are keyed by the digest of their SHAMap leaf, so an entry which
+    did not change is found from any ledger which holds it.
+
+    Lookups take no lock. The entries live in two generations: each sweep
+    discards the older one and starts a new one, and an entry found in the
+    older generation is carried into the current one. Only the entries
+    which were not used since the previous sweep are dropped. A retired
+    generation is freed once every lookup which could see it has finished.
+
+    Hits and misses are counted separately for each kind of caller, taken
+    from the Scope active on the calling coroutine or, outside of one, the
+    calling thread.
+*/
+class CachedSLEs
+{
+public:
+    /** Who a lookup is made for. */
+    enum class Caller : int {
+        other,
+        transaction,
+        rpc,
+        pathfinding,
+    };
+
+    static constexpr std::size_t callers = 4;
+
+    /** Attribute the lookups made by this coroutine, or this thread
+        outside of one, to a caller. */
+    class Scope
+    {
+        Caller const previous_;
+
+    public:
+        explicit Scope(Caller caller);
+
+        ~Scope();
+
+        Scope(Scope const&) = delete;
+        Scope&
+        operator=(Scope const&) = delete;
+    };
+
+    /** Create a cache.
+
+        @param buckets The fewest buckets a generation starts with. A new
+                       generation also starts with at least one bucket
+                       for each entry of the one before it.
+    */
+    explicit CachedSLEs(std::size_t buckets = 4096);
+
+    ~CachedSLEs();
+
+    CachedSLEs(CachedSLEs const&) = delete;
+    CachedSLEs&
+    operator=(CachedSLEs const&) = delete;
+
+    /** Fetch an item from the cache.
+
+        If the digest was not found, Handler will be called with this
+        signature:
+            std::shared_ptr<SLE const>(void)
+    */
+    template <class Handler>
+    std::shared_ptr<SLE const>
+    fetch(uint256 const& digest, Handler const& h)
+    {
+        auto& stats = stats_[static_cast<int>(caller())];
+        if (auto sle = find(digest))
+        {
+            stats.hits.fetch_add(1, std::memory_order_relaxed);
+            return sle;
+        }
+        stats.misses.fetch_add(1, std::memory_order_relaxed);
+
+        std::shared_ptr<SLE const> sle = h();
+        if (!sle)
+            return sle;
+        return insert(digest, std::move(sle));
+    }
+
+    /** Add an entry, as when warming the cache, without counting a miss. */
+    void
+    preload(uint256 const& digest, std::shared_ptr<SLE const> sle);
+
+    /** Call `f(digest, sle)` for every entry, those of the current
+        generation first. An entry may be visited twice. */
+    template <class F>
+    void
+    visit(F&& f) const
+    {
+        Pin const pin(*this);
+        current_.load()->forEach(f);
+        previous_.load()->forEach(f);
+    }
+
+    /** Start a new generation, dropping the entries not used since the
+        previous one was started. */
+    void
+    sweep();
+
+    /** Returns the number of entries in both generations. */
+    std::size_t
+    size() const;
+
+    /** Returns the fraction of lookups which were hits. */
+    double
+    rate() const;
+
+    /** Returns the fraction of lookups made for a caller which were hits. */
+    double
+    rate(Caller caller) const;
+
+    /** The caller active on this coroutine or thread. */
+    static Caller
+    caller();
+
+private:
+    using Generation = InsertOnlyMap<uint256, std::shared_ptr<SLE const>>;
+
+    struct Stats
+    {
+        std::atomic<std::uint64_t> hits{0};
+        std::atomic<std::uint64_t> misses{0};
+    };
+
+    // Marks a thread as reading the generations, which may not be freed
+    // until it is done.
+    class Pin
+    {
+        CachedSLEs const& cache_;
+        int const slot_;
+
+    public:
+        explicit Pin(CachedSLEs const& cache);
+        ~Pin();
+
+        Pin(Pin const&) = delete;
+        Pin&
+        operator=(Pin const&) = delete;
+    };
+
+    std::size_t const buckets_;
+    std::atomic<Generation*> current_;
+    std::atomic<Generation*> previous_;
+
+    // Readers register in the slot of the epoch they started in. A sweep
+    // advances the epoch, then waits for the slot of the old one to drain.
+    std::atomic<std::uint64_t> epoch_{0};
+    mutable std::array<std::atomic<int>, 2> readers_{};
+
+    std::mutex sweepMutex_;
+    std::array<Stats, callers> stats_;
+
+    std::shared_ptr<SLE const>
+    find(uint256 const& digest);
+
+    std::shared_ptr<SLE const>
+    insert(uint256 const& digest, std::shared_ptr<SLE const> sle);
+};
+
+/** Returns the name of a caller, as reported by get_counts. */
+char const*
+to_string(CachedSLEs::Caller caller);
+
+}  // namespace ripple
 
 #endif  // RIPPLE_LEDGER_CACHEDSLES_H_INCLUDED
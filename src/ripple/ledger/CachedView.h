@@ -20,12 +20,10 @@
 #ifndef RIPPLE_LEDGER_CACHEDVIEW_H_INCLUDED
 #define RIPPLE_LEDGER_CACHEDVIEW_H_INCLUDED
 
-#include <ripple/basics/hardened_hash.h>
+#include <ripple/basics/InsertOnlyMap.h>
 #include <ripple/ledger/CachedSLEs.h>
 #include <ripple/ledger/ReadView.h>
-#include <map>
 #include <memory>
-#include <mutex>
 #include <type_traits>
 
 namespace ripple {
@@ -37,11 +35,7 @@ class CachedViewImpl : public DigestAwareReadView
 private:
     DigestAwareReadView const& base_;
     CachedSLEs& cache_;
-    std::mutex mutable mutex_;
-    std::unordered_map<
-        key_type,
-        std::shared_ptr<SLE const>,
-        hardened_hash<>> mutable map_;
+    InsertOnlyMap<key_type, std::shared_ptr<SLE const>> mutable map_;
 
 public:
     CachedViewImpl() = delete;
@@ -96,6 +90,12 @@ public:
         return base_.succ(key, last);
     }
 
+    std::shared_ptr<BookOffers const>
+    bookOffers(uint256 const& book) const override
+    {
+        return base_.bookOffers(book);
+    }
+
     std::unique_ptr<sles_type::iter_base>
     slesBegin() const override
     {
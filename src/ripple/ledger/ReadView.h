@@ -26,12 +26,14 @@
 #include <ripple/basics/chrono.h>
 #include <ripple/beast/hash/uhash.h>
 #include <ripple/beast/utility/Journal.h>
+#include <ripple/ledger/BookCache.h>
 #include <ripple/ledger/detail/ReadViewFwdRange.h>
 #include <ripple/protocol/Indexes.h>
 #include <ripple/protocol/Protocol.h>
 #include <ripple/protocol/Rules.h>
 #include <ripple/protocol/STAmount.h>
 #include <ripple/protocol/STLedgerEntry.h>
+#include <ripple/protocol/STLedgerEntryView.h>
 #include <ripple/protocol/STTx.h>
 #include <cassert>
 #include <cstdint>
@@ -244,6 +246,35 @@ public:
     virtual std::shared_ptr<SLE const>
     read(Keylet const& k) const = 0;
 
+    /** Return a view of the state item associated with a key.
+
+        Unlike read, this does not deserialize the item up front:
+        fields are deserialized as they are read. Readers which only
+        look at a few fields of an item should prefer this.
+
+        The default implementation views the item returned by read.
+
+        @return `std::nullopt` if the key is not present
+                or if the type does not match.
+    */
+    virtual std::optional<SLEView>
+    readLazy(Keylet const& k) const;
+
+    /** Return the cached top of an order book.
+
+        Ledgers which do not change keep the first offers of the books
+        that are asked for. A view built on such a ledger passes them on
+        as long as neither it nor any view in between has changed a
+        directory of the book.
+
+        The default implementation returns `nullptr`.
+
+        @param book The base key of the book's directories.
+        @return `nullptr` if the book must be read from the view.
+    */
+    virtual std::shared_ptr<BookOffers const>
+    bookOffers(uint256 const& book) const;
+
     // Accounts in a payment are not allowed to use assets acquired during that
     // payment. The PaymentSandbox tracks the debits, credits, and owner count
     // changes that accounts make during a payment. `balanceHook` adjusts
@@ -21,14 +21,18 @@
 #define RIPPLE_LEDGER_APPLYSTATETABLE_H_INCLUDED
 
 #include <ripple/basics/XRPAmount.h>
+#include <ripple/basics/hardened_hash.h>
 #include <ripple/beast/utility/Journal.h>
 #include <ripple/ledger/OpenView.h>
 #include <ripple/ledger/RawView.h>
 #include <ripple/ledger/ReadView.h>
 #include <ripple/protocol/TER.h>
 #include <ripple/protocol/TxMeta.h>
+#include <boost/container/flat_set.hpp>
+#include <cstdint>
 #include <memory>
 #include <utility>
+#include <vector>
 
 namespace ripple {
 namespace detail {
@@ -48,9 +52,29 @@ private:
         modify,
     };
 
-    using items_t = std::map<key_type, std::pair<Action, std::shared_ptr<SLE>>>;
+    struct Item
+    {
+        key_type key;
+        Action action;
+        std::shared_ptr<SLE> sle;
+    };
+
+    // The buffered entries, in no particular order, and an open addressing
+    // index over their keys. A slot holds one plus the position of an item
+    // in items_, or zero when it is empty.
+    std::vector<Item> items_;
+    std::vector<std::uint32_t> slots_;
+    hardened_hash<> hasher_;
+
+    // The keys of the items for succ, sorted up to sortedKeys_ and in the
+    // order added after it. The tail is sorted in by the next succ. Keys
+    // of removed items may remain, so succ checks each against the index.
+    mutable std::vector<key_type> keys_;
+    mutable std::size_t sortedKeys_ = 0;
+
+    // The roots of the directories with a changed page
+    boost::container::flat_set<key_type> dirs_;
 
-    items_t items_;
     XRPAmount dropsDestroyed_{0};
 
 public:
@@ -97,6 +121,13 @@ public:
     std::shared_ptr<SLE const>
     read(ReadView const& base, Keylet const& k) const;
 
+    std::optional<SLEView>
+    readLazy(ReadView const& base, Keylet const& k) const;
+
+    /** Returns `true` if a page of a directory of the book changed. */
+    bool
+    changedBook(uint256 const& book) const;
+
     std::shared_ptr<SLE>
     peek(ReadView const& base, Keylet const& k);
 
@@ -138,6 +169,30 @@ public:
     }
 
 private:
+    std::size_t
+    slotOf(key_type const& key) const;
+
+    Item*
+    find(key_type const& key);
+
+    Item const*
+    find(key_type const& key) const;
+
+    Item&
+    emplace(key_type const& key, Action action, std::shared_ptr<SLE> sle);
+
+    void
+    remove(key_type const& key);
+
+    std::vector<Item const*>
+    ordered() const;
+
+    void
+    sortKeys() const;
+
+    void
+    changed(SLE const& sle);
+
     static void
     threadItem(TxMeta& meta, std::shared_ptr<SLE> const& to);
 
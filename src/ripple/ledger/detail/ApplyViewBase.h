@@ -67,6 +67,12 @@ public:
     std::shared_ptr<SLE const>
     read(Keylet const& k) const override;
 
+    std::optional<SLEView>
+    readLazy(Keylet const& k) const override;
+
+    std::shared_ptr<BookOffers const>
+    bookOffers(uint256 const& book) const override;
+
     std::unique_ptr<sles_type::iter_base>
     slesBegin() const override;
 
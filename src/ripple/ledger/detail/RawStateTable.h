@@ -27,6 +27,7 @@
 #include <boost/container/pmr/polymorphic_allocator.hpp>
 
 #include <map>
+#include <set>
 #include <utility>
 
 namespace ripple {
@@ -53,6 +54,7 @@ public:
               boost::container::pmr::monotonic_buffer_resource>(
               initialBufferSize)}
         , items_{rhs.items_, monotonic_resource_.get()}
+        , dirs_{rhs.dirs_}
         , dropsDestroyed_{rhs.dropsDestroyed_} {};
 
     RawStateTable(RawStateTable&&) = default;
@@ -86,6 +88,13 @@ public:
     std::shared_ptr<SLE const>
     read(ReadView const& base, Keylet const& k) const;
 
+    std::optional<SLEView>
+    readLazy(ReadView const& base, Keylet const& k) const;
+
+    /** Returns `true` if a page of a directory of the book changed. */
+    bool
+    changedBook(uint256 const& book) const;
+
     void
     destroyXRP(XRPAmount const& fee);
 
@@ -107,6 +116,9 @@ private:
 
     class sles_iter_impl;
 
+    void
+    changed(SLE const& sle);
+
     struct sleAction
     {
         Action action;
@@ -133,6 +145,9 @@ private:
         monotonic_resource_;
     items_t items_;
 
+    // The roots of the directories with a changed page
+    std::set<key_type> dirs_;
+
     XRPAmount dropsDestroyed_{0};
 };
 
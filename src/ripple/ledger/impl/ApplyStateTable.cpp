@@ -21,20 +21,204 @@
 #include <ripple/json/to_string.h>
 #include <ripple/ledger/detail/ApplyStateTable.h>
 #include <ripple/protocol/Feature.h>
+#include <ripple/protocol/Indexes.h>
 #include <ripple/protocol/st.h>
+#include <algorithm>
 #include <cassert>
 
 namespace ripple {
 namespace detail {
 
+namespace {
+
+// Whether two versions of a ledger entry hold the same data, as
+// STObject::operator== decides it. Both versions of an entry are
+// normally built from the same template, which puts every field at the
+// same position in each, so the fields are compared pairwise instead of
+// searching one object for each field of the other.
+bool
+sameFields(STObject const& cur, STObject const& orig)
+{
+    auto const count = cur.getCount();
+    if (cur.isFree() || orig.isFree() || count != orig.getCount())
+        return cur == orig;
+    for (int i = 0; i < count; ++i)
+    {
+        if (&cur.getFieldSType(i) != &orig.getFieldSType(i))
+            return cur == orig;
+    }
+    for (int i = 0; i < count; ++i)
+    {
+        auto const& field = cur.getFieldSType(i);
+        if (field.isBinary() && !(cur.peekAtIndex(i) == orig.peekAtIndex(i)))
+            return false;
+    }
+    return true;
+}
+
+// The fields of the original version of an entry which are recorded as
+// previous values because the current version no longer matches them.
+STObject
+previousFields(STObject const& orig, STObject& cur)
+{
+    STObject prevs(sfPreviousFields);
+    auto const count = orig.getCount();
+    bool positional =
+        !orig.isFree() && !cur.isFree() && count == cur.getCount();
+    for (int i = 0; positional && i < count; ++i)
+        positional = &orig.getFieldSType(i) == &cur.getFieldSType(i);
+
+    for (int i = 0; i < count; ++i)
+    {
+        auto const& obj = orig.peekAtIndex(i);
+        if (!obj.getFName().shouldMeta(SField::sMD_ChangeOrig))
+            continue;
+        bool const matches = positional ? obj == cur.peekAtIndex(i)
+                                        : cur.hasMatchingEntry(obj);
+        if (!matches)
+            prevs.emplace_back(obj);
+    }
+    return prevs;
+}
+
+}  // namespace
+
+std::size_t
+ApplyStateTable::slotOf(key_type const& key) const
+{
+    assert(!slots_.empty());
+    auto const mask = slots_.size() - 1;
+    auto slot = hasher_(key) & mask;
+    while (slots_[slot] != 0 && items_[slots_[slot] - 1].key != key)
+        slot = (slot + 1) & mask;
+    return slot;
+}
+
+auto
+ApplyStateTable::find(key_type const& key) -> Item*
+{
+    if (slots_.empty())
+        return nullptr;
+    auto const index = slots_[slotOf(key)];
+    return index == 0 ? nullptr : &items_[index - 1];
+}
+
+auto
+ApplyStateTable::find(key_type const& key) const -> Item const*
+{
+    if (slots_.empty())
+        return nullptr;
+    auto const index = slots_[slotOf(key)];
+    return index == 0 ? nullptr : &items_[index - 1];
+}
+
+auto
+ApplyStateTable::emplace(
+    key_type const& key,
+    Action action,
+    std::shared_ptr<SLE> sle) -> Item&
+{
+    assert(!find(key));
+    // Keep the index at most half full so that probes stay short
+    if ((items_.size() + 1) * 2 > slots_.size())
+    {
+        slots_.assign(std::max<std::size_t>(16, slots_.size() * 2), 0);
+        for (std::size_t i = 0; i < items_.size(); ++i)
+            slots_[slotOf(items_[i].key)] = i + 1;
+    }
+    slots_[slotOf(key)] = items_.size() + 1;
+    items_.push_back({key, action, std::move(sle)});
+    keys_.push_back(key);
+    return items_.back();
+}
+
+void
+ApplyStateTable::remove(key_type const& key)
+{
+    auto const mask = slots_.size() - 1;
+    auto hole = slotOf(key);
+    auto const index = slots_[hole] - 1;
+
+    // Shift back any following entries whose probe sequence passes
+    // through the hole, so that every lookup still finds its entry.
+    for (auto slot = (hole + 1) & mask; slots_[slot] != 0;
+         slot = (slot + 1) & mask)
+    {
+        auto const home = hasher_(items_[slots_[slot] - 1].key) & mask;
+        if (((slot - home) & mask) >= ((slot - hole) & mask))
+        {
+            slots_[hole] = slots_[slot];
+            hole = slot;
+        }
+    }
+    slots_[hole] = 0;
+
+    // Fill the gap in the items with the last one
+    if (index + 1 != items_.size())
+    {
+        slots_[slotOf(items_.back().key)] = index + 1;
+        items_[index] = std::move(items_.back());
+    }
+    items_.pop_back();
+}
+
+// The items in key order, which the metadata and any observer of the
+// changes see them in.
+auto
+ApplyStateTable::ordered() const -> std::vector<Item const*>
+{
+    std::vector<Item const*> result;
+    result.reserve(items_.size());
+    for (auto const& item : items_)
+        result.push_back(&item);
+    std::sort(result.begin(), result.end(), [](auto lhs, auto rhs) {
+        return lhs->key < rhs->key;
+    });
+    return result;
+}
+
+void
+ApplyStateTable::sortKeys() const
+{
+    if (sortedKeys_ == keys_.size())
+        return;
+
+    if (keys_.size() > 2 * items_.size())
+    {
+        // Mostly the keys of removed items: start again.
+        keys_.clear();
+        for (auto const& item : items_)
+            keys_.push_back(item.key);
+        std::sort(keys_.begin(), keys_.end());
+    }
+    else
+    {
+        auto const middle = keys_.begin() + sortedKeys_;
+        std::sort(middle, keys_.end());
+        std::inplace_merge(keys_.begin(), middle, keys_.end());
+        keys_.erase(std::unique(keys_.begin(), keys_.end()), keys_.end());
+    }
+    sortedKeys_ = keys_.size();
+}
+
+// Views of an order book stop passing on the cached top of the book once
+// a page of any of its directories changed. Pages other than the first do
+// not have keys within the book, so note the root of every directory.
+void
+ApplyStateTable::changed(SLE const& sle)
+{
+    if (sle.getType() == ltDIR_NODE)
+        dirs_.insert(sle.getFieldH256(sfRootIndex));
+}
+
 void
 ApplyStateTable::apply(RawView& to) const
 {
     to.rawDestroyXRP(dropsDestroyed_);
     for (auto const& item : items_)
     {
-        auto const& sle = item.second.second;
-        switch (item.second.first)
+        auto const& sle = item.sle;
+        switch (item.action)
         {
             case Action::cache:
                 break;
@@ -57,7 +241,7 @@ ApplyStateTable::size() const
     std::size_t ret = 0;
     for (auto& item : items_)
     {
-        switch (item.second.first)
+        switch (item.action)
         {
             case Action::erase:
             case Action::insert:
@@ -79,28 +263,28 @@ ApplyStateTable::visit(
         std::shared_ptr<SLE const> const& before,
         std::shared_ptr<SLE const> const& after)> const& func) const
 {
-    for (auto& item : items_)
+    for (auto const item : ordered())
     {
-        switch (item.second.first)
+        switch (item->action)
         {
             case Action::erase:
                 func(
-                    item.first,
+                    item->key,
                     true,
-                    to.read(keylet::unchecked(item.first)),
-                    item.second.second);
+                    to.read(keylet::unchecked(item->key)),
+                    item->sle);
                 break;
 
             case Action::insert:
-                func(item.first, false, nullptr, item.second.second);
+                func(item->key, false, nullptr, item->sle);
                 break;
 
             case Action::modify:
                 func(
-                    item.first,
+                    item->key,
                     false,
-                    to.read(keylet::unchecked(item.first)),
-                    item.second.second);
+                    to.read(keylet::unchecked(item->key)),
+                    item->sle);
                 break;
 
             default:
@@ -133,10 +317,10 @@ ApplyStateTable::generateTxMeta(
     bool const recordDefaultAmounts = to.rules().enabled(fixXahauV1);
 
     Mods newMod;
-    for (auto& item : items_)
+    for (auto const item : ordered())
     {
         SField const* type;
-        switch (item.second.first)
+        switch (item->action)
         {
             default:
             case Action::cache:
@@ -151,31 +335,23 @@ ApplyStateTable::generateTxMeta(
                 type = &sfModifiedNode;
                 break;
         }
-        auto const origNode = to.read(keylet::unchecked(item.first));
-        auto curNode = item.second.second;
-        if ((type == &sfModifiedNode) && (*curNode == *origNode))
+        auto const origNode = to.read(keylet::unchecked(item->key));
+        auto curNode = item->sle;
+        if ((type == &sfModifiedNode) && sameFields(*curNode, *origNode))
             continue;
         std::uint16_t nodeType = curNode
             ? curNode->getFieldU16(sfLedgerEntryType)
             : origNode->getFieldU16(sfLedgerEntryType);
-        meta.setAffectedNode(item.first, *type, nodeType);
+        meta.setAffectedNode(item->key, *type, nodeType);
         if (type == &sfDeletedNode)
         {
             assert(origNode && curNode);
             threadOwners(to, meta, origNode, newMod, j);
 
-            STObject prevs(sfPreviousFields);
-            for (auto const& obj : *origNode)
-            {
-                // go through the original node for
-                // modified  fields saved on modification
-                if (obj.getFName().shouldMeta(SField::sMD_ChangeOrig) &&
-                    !curNode->hasMatchingEntry(obj))
-                    prevs.emplace_back(obj);
-            }
-
+            // modified fields saved on modification
+            auto prevs = previousFields(*origNode, *curNode);
             if (!prevs.empty())
-                meta.getAffectedNode(item.first).emplace_back(std::move(prevs));
+                meta.getAffectedNode(item->key).emplace_back(std::move(prevs));
 
             STObject finals(sfFinalFields);
             for (auto const& obj : *curNode)
@@ -187,7 +363,7 @@ ApplyStateTable::generateTxMeta(
             }
 
             if (!finals.empty())
-                meta.getAffectedNode(item.first)
+                meta.getAffectedNode(item->key)
                     .emplace_back(std::move(finals));
         }
         else if (type == &sfModifiedNode)
@@ -198,17 +374,10 @@ ApplyStateTable::generateTxMeta(
                                             // item modified
                 threadItem(meta, curNode);
 
-            STObject prevs(sfPreviousFields);
-            for (auto const& obj : *origNode)
-            {
-                // search the original node for values saved on modify
-                if (obj.getFName().shouldMeta(SField::sMD_ChangeOrig) &&
-                    !curNode->hasMatchingEntry(obj))
-                    prevs.emplace_back(obj);
-            }
-
+            // values of the original node saved on modify
+            auto prevs = previousFields(*origNode, *curNode);
             if (!prevs.empty())
-                meta.getAffectedNode(item.first).emplace_back(std::move(prevs));
+                meta.getAffectedNode(item->key).emplace_back(std::move(prevs));
 
             STObject finals(sfFinalFields);
             for (auto const& obj : *curNode)
@@ -220,7 +389,7 @@ ApplyStateTable::generateTxMeta(
             }
 
             if (!finals.empty())
-                meta.getAffectedNode(item.first)
+                meta.getAffectedNode(item->key)
                     .emplace_back(std::move(finals));
         }
         else if (type == &sfCreatedNode)  // if created, thread to owner(s)
@@ -246,7 +415,7 @@ ApplyStateTable::generateTxMeta(
             }
 
             if (!news.empty())
-                meta.getAffectedNode(item.first).emplace_back(std::move(news));
+                meta.getAffectedNode(item->key).emplace_back(std::move(news));
         }
         else
         {
@@ -268,8 +437,8 @@ ApplyStateTable::apply(
     beast::Journal j)
 {
     // Build metadata and insert
-    auto const sTx = std::make_shared<Serializer>();
-    tx.add(*sTx);
+    auto const sTx = std::make_shared<Serializer>(
+        tx.getSerialized().data(), tx.getSerialized().size());
     std::shared_ptr<Serializer> sMeta;
     if (!to.open())
     {
@@ -297,12 +466,10 @@ ApplyStateTable::apply(
 bool
 ApplyStateTable::exists(ReadView const& base, Keylet const& k) const
 {
-    auto const iter = items_.find(k.key);
-    if (iter == items_.end())
+    auto const item = find(k.key);
+    if (!item)
         return base.exists(k);
-    auto const& item = iter->second;
-    auto const& sle = item.second;
-    switch (item.first)
+    switch (item->action)
     {
         case Action::erase:
             return false;
@@ -311,7 +478,7 @@ ApplyStateTable::exists(ReadView const& base, Keylet const& k) const
         case Action::modify:
             break;
     }
-    if (!k.check(*sle))
+    if (!k.check(*item->sle))
         return false;
     return true;
 }
@@ -323,7 +490,7 @@ ApplyStateTable::succ(
     std::optional<key_type> const& last) const -> std::optional<key_type>
 {
     std::optional<key_type> next = key;
-    items_t::const_iterator iter;
+    Item const* item;
     // Find base successor that is
     // not also deleted in our list
     do
@@ -331,16 +498,18 @@ ApplyStateTable::succ(
         next = base.succ(*next, last);
         if (!next)
             break;
-        iter = items_.find(*next);
-    } while (iter != items_.end() && iter->second.first == Action::erase);
-    // Find non-deleted successor in our list
-    for (iter = items_.upper_bound(key); iter != items_.end(); ++iter)
+        item = find(*next);
+    } while (item && item->action == Action::erase);
+    // Find the lowest non-deleted successor in our list.
+    sortKeys();
+    for (auto it = std::upper_bound(keys_.begin(), keys_.end(), key);
+         it != keys_.end() && (!next || *it < *next);
+         ++it)
     {
-        if (iter->second.first != Action::erase)
+        auto const i = find(*it);
+        if (i && i->action != Action::erase)
         {
-            // Found both, return the lower key
-            if (!next || next > iter->first)
-                next = iter->first;
+            next = *it;
             break;
         }
     }
@@ -354,12 +523,10 @@ ApplyStateTable::succ(
 std::shared_ptr<SLE const>
 ApplyStateTable::read(ReadView const& base, Keylet const& k) const
 {
-    auto const iter = items_.find(k.key);
-    if (iter == items_.end())
+    auto const item = find(k.key);
+    if (!item)
         return base.read(k);
-    auto const& item = iter->second;
-    auto const& sle = item.second;
-    switch (item.first)
+    switch (item->action)
     {
         case Action::erase:
             return nullptr;
@@ -368,32 +535,42 @@ ApplyStateTable::read(ReadView const& base, Keylet const& k) const
         case Action::modify:
             break;
     };
-    if (!k.check(*sle))
+    if (!k.check(*item->sle))
         return nullptr;
-    return sle;
+    return item->sle;
+}
+
+std::optional<SLEView>
+ApplyStateTable::readLazy(ReadView const& base, Keylet const& k) const
+{
+    if (!find(k.key))
+        return base.readLazy(k);
+    if (auto sle = read(base, k))
+        return SLEView(std::move(sle));
+    return std::nullopt;
+}
+
+bool
+ApplyStateTable::changedBook(uint256 const& book) const
+{
+    auto const iter = dirs_.lower_bound(book);
+    return iter != dirs_.end() && *iter < getQualityNext(book);
 }
 
 std::shared_ptr<SLE>
 ApplyStateTable::peek(ReadView const& base, Keylet const& k)
 {
-    auto iter = items_.lower_bound(k.key);
-    if (iter == items_.end() || iter->first != k.key)
+    auto const item = find(k.key);
+    if (!item)
     {
         auto const sle = base.read(k);
         if (!sle)
             return nullptr;
         // Make our own copy
-        using namespace std;
-        iter = items_.emplace_hint(
-            iter,
-            piecewise_construct,
-            forward_as_tuple(sle->key()),
-            forward_as_tuple(Action::cache, make_shared<SLE>(*sle)));
-        return iter->second.second;
+        return emplace(sle->key(), Action::cache, std::make_shared<SLE>(*sle))
+            .sle;
     }
-    auto const& item = iter->second;
-    auto const& sle = item.second;
-    switch (item.first)
+    switch (item->action)
     {
         case Action::erase:
             return nullptr;
@@ -402,31 +579,31 @@ ApplyStateTable::peek(ReadView const& base, Keylet const& k)
         case Action::modify:
             break;
     };
-    if (!k.check(*sle))
+    if (!k.check(*item->sle))
         return nullptr;
-    return sle;
+    return item->sle;
 }
 
 void
 ApplyStateTable::erase(ReadView const& base, std::shared_ptr<SLE> const& sle)
 {
-    auto const iter = items_.find(sle->key());
-    if (iter == items_.end())
+    auto const item = find(sle->key());
+    if (!item)
         LogicError("ApplyStateTable::erase: missing key");
-    auto& item = iter->second;
-    if (item.second != sle)
+    if (item->sle != sle)
         LogicError("ApplyStateTable::erase: unknown SLE");
-    switch (item.first)
+    changed(*sle);
+    switch (item->action)
     {
         case Action::erase:
             LogicError("ApplyStateTable::erase: double erase");
             break;
         case Action::insert:
-            items_.erase(iter);
+            remove(item->key);
             break;
         case Action::cache:
         case Action::modify:
-            item.first = Action::erase;
+            item->action = Action::erase;
             break;
     }
 }
@@ -434,26 +611,25 @@ ApplyStateTable::erase(ReadView const& base, std::shared_ptr<SLE> const& sle)
 void
 ApplyStateTable::rawErase(ReadView const& base, std::shared_ptr<SLE> const& sle)
 {
-    using namespace std;
-    auto const result = items_.emplace(
-        piecewise_construct,
-        forward_as_tuple(sle->key()),
-        forward_as_tuple(Action::erase, sle));
-    if (result.second)
+    changed(*sle);
+    auto const item = find(sle->key());
+    if (!item)
+    {
+        emplace(sle->key(), Action::erase, sle);
         return;
-    auto& item = result.first->second;
-    switch (item.first)
+    }
+    switch (item->action)
     {
         case Action::erase:
             LogicError("ApplyStateTable::rawErase: double erase");
             break;
         case Action::insert:
-            items_.erase(result.first);
+            remove(item->key);
             break;
         case Action::cache:
         case Action::modify:
-            item.first = Action::erase;
-            item.second = sle;
+            item->action = Action::erase;
+            item->sle = sle;
             break;
     }
 }
@@ -461,19 +637,14 @@ ApplyStateTable::rawErase(ReadView const& base, std::shared_ptr<SLE> const& sle)
 void
 ApplyStateTable::insert(ReadView const& base, std::shared_ptr<SLE> const& sle)
 {
-    auto const iter = items_.lower_bound(sle->key());
-    if (iter == items_.end() || iter->first != sle->key())
-    {
-        using namespace std;
-        items_.emplace_hint(
-            iter,
-            piecewise_construct,
-            forward_as_tuple(sle->key()),
-            forward_as_tuple(Action::insert, sle));
+    changed(*sle);
+    auto const item = find(sle->key());
+    if (!item)
+    {
+        emplace(sle->key(), Action::insert, sle);
         return;
     }
-    auto& item = iter->second;
-    switch (item.first)
+    switch (item->action)
     {
         case Action::cache:
             LogicError("ApplyStateTable::insert: already cached");
@@ -484,55 +655,50 @@ ApplyStateTable::insert(ReadView const& base, std::shared_ptr<SLE> const& sle)
         case Action::erase:
             break;
     }
-    item.first = Action::modify;
-    item.second = sle;
+    item->action = Action::modify;
+    item->sle = sle;
 }
 
 void
 ApplyStateTable::replace(ReadView const& base, std::shared_ptr<SLE> const& sle)
 {
-    auto const iter = items_.lower_bound(sle->key());
-    if (iter == items_.end() || iter->first != sle->key())
-    {
-        using namespace std;
-        items_.emplace_hint(
-            iter,
-            piecewise_construct,
-            forward_as_tuple(sle->key()),
-            forward_as_tuple(Action::modify, sle));
+    changed(*sle);
+    auto const item = find(sle->key());
+    if (!item)
+    {
+        emplace(sle->key(), Action::modify, sle);
         return;
     }
-    auto& item = iter->second;
-    switch (item.first)
+    switch (item->action)
     {
         case Action::erase:
             LogicError("ApplyStateTable::replace: already erased");
         case Action::cache:
-            item.first = Action::modify;
+            item->action = Action::modify;
             break;
         case Action::insert:
         case Action::modify:
             break;
     }
-    item.second = sle;
+    item->sle = sle;
 }
 
 void
 ApplyStateTable::update(ReadView const& base, std::shared_ptr<SLE> const& sle)
 {
-    auto const iter = items_.find(sle->key());
-    if (iter == items_.end())
+    auto const item = find(sle->key());
+    if (!item)
         LogicError("ApplyStateTable::update: missing key");
-    auto& item = iter->second;
-    if (item.second != sle)
+    if (item->sle != sle)
         LogicError("ApplyStateTable::update: unknown SLE");
-    switch (item.first)
+    changed(*sle);
+    switch (item->action)
     {
         case Action::erase:
             LogicError("ApplyStateTable::update: erased");
             break;
         case Action::cache:
-            item.first = Action::modify;
+            item->action = Action::modify;
             break;
         case Action::insert:
         case Action::modify:
@@ -589,25 +755,21 @@ ApplyStateTable::getForMod(
             return miter->second;
         }
     }
+    if (auto const item = find(key))
     {
-        auto iter = items_.find(key);
-        if (iter != items_.end())
+        if (item->action == Action::erase)
         {
-            auto const& item = iter->second;
-            if (item.first == Action::erase)
-            {
-                // The Destination of an Escrow or a PayChannel may have been
-                // deleted.  In that case the account we're threading to will
-                // not be found and it is appropriate to return a nullptr.
-                JLOG(j.warn()) << "Trying to thread to deleted node";
-                return nullptr;
-            }
-            if (item.first != Action::cache)
-                return item.second;
-
-            // If it's only cached, then the node is being modified only by
-            // metadata; fall through and track it in the mods table.
+            // The Destination of an Escrow or a PayChannel may have been
+            // deleted.  In that case the account we're threading to will
+            // not be found and it is appropriate to return a nullptr.
+            JLOG(j.warn()) << "Trying to thread to deleted node";
+            return nullptr;
         }
+        if (item->action != Action::cache)
+            return item->sle;
+
+        // If it's only cached, then the node is being modified only by
+        // metadata; fall through and track it in the mods table.
     }
     auto c = base.read(keylet::unchecked(key));
     if (!c)
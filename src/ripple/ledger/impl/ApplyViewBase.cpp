@@ -74,6 +74,20 @@ ApplyViewBase::read(Keylet const& k) const
     return items_.read(*base_, k);
 }
 
+std::optional<SLEView>
+ApplyViewBase::readLazy(Keylet const& k) const
+{
+    return items_.readLazy(*base_, k);
+}
+
+std::shared_ptr<BookOffers const>
+ApplyViewBase::bookOffers(uint256 const& book) const
+{
+    if (items_.changedBook(book))
+        return nullptr;
+    return base_->bookOffers(book);
+}
+
 auto
 ApplyViewBase::slesBegin() const -> std::unique_ptr<sles_type::iter_base>
 {
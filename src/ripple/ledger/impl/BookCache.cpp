@@ -0,0 +1,106 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/ledger/BookCache.h>
+#include <ripple/ledger/View.h>
+#include <algorithm>
+
+namespace ripple {
+
+BookCache::BookCache(std::size_t depth, std::size_t capacity)
+    : depth_(depth), capacity_(std::max<std::size_t>(capacity, 1))
+{
+}
+
+std::shared_ptr<BookOffers const>
+BookCache::get(ReadView const& ledger, uint256 const& book)
+{
+    {
+        std::lock_guard lock(mutex_);
+        if (auto const iter = books_.find(book); iter != books_.end())
+        {
+            lru_.splice(lru_.begin(), lru_, iter->second.position);
+            return iter->second.offers;
+        }
+    }
+
+    // Read the book without holding the lock. If another thread read it
+    // first, use theirs.
+    auto offers = fetch(ledger, book);
+
+    std::lock_guard lock(mutex_);
+    if (auto const iter = books_.find(book); iter != books_.end())
+    {
+        lru_.splice(lru_.begin(), lru_, iter->second.position);
+        return iter->second.offers;
+    }
+
+    if (books_.size() >= capacity_)
+    {
+        books_.erase(lru_.back());
+        lru_.pop_back();
+    }
+
+    lru_.push_front(book);
+    books_.emplace(book, Entry{offers, lru_.begin()});
+    return offers;
+}
+
+std::size_t
+BookCache::size() const
+{
+    std::lock_guard lock(mutex_);
+    return books_.size();
+}
+
+// Walks the directories of the book the way BookTip does: each quality
+// directory in turn, and each of its pages in turn.
+std::shared_ptr<BookOffers const>
+BookCache::fetch(ReadView const& ledger, uint256 const& book) const
+{
+    auto offers = std::make_shared<BookOffers>();
+    auto const end = getQualityNext(book);
+    auto key = book;
+
+    while (offers->size() < depth_)
+    {
+        auto const root = ledger.succ(key, end);
+        if (!root)
+            break;
+
+        std::shared_ptr<SLE const> page;
+        unsigned int entry = 0;
+        uint256 index;
+        if (cdirFirst(ledger, *root, page, entry, index))
+        {
+            Quality const quality(getQuality(*root));
+            do
+            {
+                offers->push_back({*root, page->key(), index, quality});
+            } while (offers->size() < depth_ &&
+                     cdirNext(ledger, *root, page, entry, index));
+        }
+
+        key = *root;
+    }
+
+    return offers;
+}
+
+}  // namespace ripple
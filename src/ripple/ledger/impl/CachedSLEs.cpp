@@ -0,0 +1,181 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/LocalValue.h>
+#include <ripple/ledger/CachedSLEs.h>
+#include <algorithm>
+#include <thread>
+
+namespace ripple {
+
+namespace {
+
+// Kept for each coroutine, which may be resumed on another thread
+LocalValue<CachedSLEs::Caller> localCaller(CachedSLEs::Caller::other);
+
+}  // namespace
+
+CachedSLEs::Scope::Scope(Caller caller) : previous_(*localCaller)
+{
+    *localCaller = caller;
+}
+
+CachedSLEs::Scope::~Scope()
+{
+    *localCaller = previous_;
+}
+
+auto
+CachedSLEs::caller() -> Caller
+{
+    return *localCaller;
+}
+
+//------------------------------------------------------------------------------
+
+CachedSLEs::Pin::Pin(CachedSLEs const& cache)
+    : cache_(cache), slot_([&cache]() {
+        for (;;)
+        {
+            auto const epoch = cache.epoch_.load();
+            auto& readers = cache.readers_[epoch & 1];
+            ++readers;
+            // A sweep which advanced the epoch meanwhile may not wait for
+            // this slot; register again in the slot of the new epoch.
+            if (cache.epoch_.load() == epoch)
+                return static_cast<int>(epoch & 1);
+            --readers;
+        }
+    }())
+{
+}
+
+CachedSLEs::Pin::~Pin()
+{
+    --cache_.readers_[slot_];
+}
+
+//------------------------------------------------------------------------------
+
+CachedSLEs::CachedSLEs(std::size_t buckets)
+    : buckets_(buckets)
+    , current_(new Generation(buckets))
+    , previous_(new Generation(buckets))
+{
+}
+
+CachedSLEs::~CachedSLEs()
+{
+    delete current_.load();
+    delete previous_.load();
+}
+
+std::shared_ptr<SLE const>
+CachedSLEs::find(uint256 const& digest)
+{
+    Pin const pin(*this);
+    if (auto const sle = current_.load()->find(digest))
+        return *sle;
+    if (auto const sle = previous_.load()->find(digest))
+        return *current_.load()->insert(digest, *sle).first;
+    return {};
+}
+
+std::shared_ptr<SLE const>
+CachedSLEs::insert(uint256 const& digest, std::shared_ptr<SLE const> sle)
+{
+    Pin const pin(*this);
+    return *current_.load()->insert(digest, std::move(sle)).first;
+}
+
+void
+CachedSLEs::preload(uint256 const& digest, std::shared_ptr<SLE const> sle)
+{
+    insert(digest, std::move(sle));
+}
+
+void
+CachedSLEs::sweep()
+{
+    std::lock_guard lock(sweepMutex_);
+    auto const fresh =
+        new Generation(std::max(buckets_, current_.load()->size()));
+    auto const retired = previous_.exchange(current_.load());
+    current_.store(fresh);
+
+    // Lookups which started before the new generation was published
+    // registered in the slot of the current epoch.
+    auto const epoch = epoch_.fetch_add(1);
+    while (readers_[epoch & 1].load() != 0)
+        std::this_thread::yield();
+    delete retired;
+}
+
+std::size_t
+CachedSLEs::size() const
+{
+    Pin const pin(*this);
+    return current_.load()->size() + previous_.load()->size();
+}
+
+double
+CachedSLEs::rate() const
+{
+    std::uint64_t hits = 0;
+    std::uint64_t total = 0;
+    for (auto const& stats : stats_)
+    {
+        auto const h = stats.hits.load(std::memory_order_relaxed);
+        hits += h;
+        total += h + stats.misses.load(std::memory_order_relaxed);
+    }
+    if (total == 0)
+        return 0;
+    return double(hits) / total;
+}
+
+double
+CachedSLEs::rate(Caller caller) const
+{
+    auto const& stats = stats_[static_cast<int>(caller)];
+    auto const hits = stats.hits.load(std::memory_order_relaxed);
+    auto const total = hits + stats.misses.load(std::memory_order_relaxed);
+    if (total == 0)
+        return 0;
+    return double(hits) / total;
+}
+
+char const*
+to_string(CachedSLEs::Caller caller)
+{
+    switch (caller)
+    {
+        case CachedSLEs::Caller::transaction:
+            return "transaction";
+        case CachedSLEs::Caller::rpc:
+            return "rpc";
+        case CachedSLEs::Caller::pathfinding:
+            return "pathfinding";
+        case CachedSLEs::Caller::other:
+            break;
+    }
+    return "other";
+}
+
+}  // namespace ripple
@@ -33,25 +33,18 @@ CachedViewImpl::exists(Keylet const& k) const
 std::shared_ptr<SLE const>
 CachedViewImpl::read(Keylet const& k) const
 {
+    if (auto const found = map_.find(k.key))
     {
-        std::lock_guard lock(mutex_);
-        auto const iter = map_.find(k.key);
-        if (iter != map_.end())
-        {
-            if (!iter->second || !k.check(*iter->second))
-                return nullptr;
-            return iter->second;
-        }
+        if (!*found || !k.check(**found))
+            return nullptr;
+        return *found;
     }
     auto const digest = base_.digest(k.key);
     if (!digest)
         return nullptr;
     auto sle = cache_.fetch(*digest, [&]() { return base_.read(k); });
-    std::lock_guard lock(mutex_);
-    auto const er = map_.emplace(k.key, sle);
-    auto const& iter = er.first;
-    bool const inserted = er.second;
-    if (iter->second && !k.check(*iter->second))
+    auto const [found, inserted] = map_.insert(k.key, std::move(sle));
+    if (*found && !k.check(**found))
     {
         if (!inserted)
         {
@@ -62,7 +55,7 @@ CachedViewImpl::read(Keylet const& k) const
         }
         return nullptr;
     }
-    return iter->second;
+    return *found;
 }
 
 }  // namespace detail
@@ -173,6 +173,20 @@ OpenView::read(Keylet const& k) const
     return items_.read(*base_, k);
 }
 
+std::optional<SLEView>
+OpenView::readLazy(Keylet const& k) const
+{
+    return items_.readLazy(*base_, k);
+}
+
+std::shared_ptr<BookOffers const>
+OpenView::bookOffers(uint256 const& book) const
+{
+    if (items_.changedBook(book))
+        return nullptr;
+    return base_->bookOffers(book);
+}
+
 auto
 OpenView::slesBegin() const -> std::unique_ptr<sles_type::iter_base>
 {
@@ -19,6 +19,7 @@
 
 #include <ripple/basics/contract.h>
 #include <ripple/ledger/detail/RawStateTable.h>
+#include <ripple/protocol/Indexes.h>
 
 namespace ripple {
 namespace detail {
@@ -233,6 +234,7 @@ RawStateTable::succ(
 void
 RawStateTable::erase(std::shared_ptr<SLE> const& sle)
 {
+    changed(*sle);
     // The base invariant is checked during apply
     auto const result = items_.emplace(
         std::piecewise_construct,
@@ -259,6 +261,7 @@ RawStateTable::erase(std::shared_ptr<SLE> const& sle)
 void
 RawStateTable::insert(std::shared_ptr<SLE> const& sle)
 {
+    changed(*sle);
     auto const result = items_.emplace(
         std::piecewise_construct,
         std::forward_as_tuple(sle->key()),
@@ -284,6 +287,7 @@ RawStateTable::insert(std::shared_ptr<SLE> const& sle)
 void
 RawStateTable::replace(std::shared_ptr<SLE> const& sle)
 {
+    changed(*sle);
     auto const result = items_.emplace(
         std::piecewise_construct,
         std::forward_as_tuple(sle->key()),
@@ -319,6 +323,32 @@ RawStateTable::read(ReadView const& base, Keylet const& k) const
     return sle;
 }
 
+std::optional<SLEView>
+RawStateTable::readLazy(ReadView const& base, Keylet const& k) const
+{
+    if (items_.find(k.key) == items_.end())
+        return base.readLazy(k);
+    if (auto sle = read(base, k))
+        return SLEView(std::move(sle));
+    return std::nullopt;
+}
+
+bool
+RawStateTable::changedBook(uint256 const& book) const
+{
+    auto const iter = dirs_.lower_bound(book);
+    return iter != dirs_.end() && *iter < getQualityNext(book);
+}
+
+// Pages other than the first do not have keys within the book, so note
+// the root of every directory changed.
+void
+RawStateTable::changed(SLE const& sle)
+{
+    if (sle.getType() == ltDIR_NODE)
+        dirs_.insert(sle.getFieldH256(sfRootIndex));
+}
+
 void
 RawStateTable::destroyXRP(XRPAmount const& fee)
 {
@@ -22,6 +22,20 @@
 
 namespace ripple {
 
+std::optional<SLEView>
+ReadView::readLazy(Keylet const& k) const
+{
+    if (auto sle = read(k))
+        return SLEView(std::move(sle));
+    return std::nullopt;
+}
+
+std::shared_ptr<BookOffers const>
+ReadView::bookOffers(uint256 const&) const
+{
+    return nullptr;
+}
+
 ReadView::sles_type::sles_type(ReadView const& view) : ReadViewFwdRange(view)
 {
 }
@@ -189,7 +189,7 @@ isGlobalFrozen(ReadView const& view, AccountID const& issuer)
 {
     if (isXRP(issuer))
         return false;
-    if (auto const sle = view.read(keylet::account(issuer)))
+    if (auto const sle = view.readLazy(keylet::account(issuer)))
         return sle->isFlag(lsfGlobalFreeze);
     return false;
 }
@@ -205,13 +205,12 @@ isFrozen(
 {
     if (isXRP(currency))
         return false;
-    auto sle = view.read(keylet::account(issuer));
-    if (sle && sle->isFlag(lsfGlobalFreeze))
+    if (isGlobalFrozen(view, issuer))
         return true;
     if (issuer != account)
     {
         // Check if the issuer froze the line
-        sle = view.read(keylet::line(account, issuer, currency));
+        auto const sle = view.readLazy(keylet::line(account, issuer, currency));
         if (sle &&
             sle->isFlag((issuer > account) ? lsfHighFreeze : lsfLowFreeze))
             return true;
@@ -235,7 +234,7 @@ accountHolds(
     }
 
     // IOU: Return balance on trust line modulo freeze
-    auto const sle = view.read(keylet::line(account, issuer, currency));
+    auto const sle = view.readLazy(keylet::line(account, issuer, currency));
     if (!sle)
     {
         amount.clear({currency, issuer});
@@ -357,8 +356,8 @@ xrpLiquid(
     std::int32_t ownerCountAdj,
     beast::Journal j)
 {
-    auto const sle = view.read(keylet::account(id));
-    if (sle == nullptr)
+    auto const sle = view.readLazy(keylet::account(id));
+    if (!sle)
         return beast::zero;
 
     // Return balance minus reserve
@@ -401,7 +400,7 @@ forEachItem(
 
     while (true)
     {
-        auto sle = view.read(pos);
+        auto const sle = view.readLazy(pos);
         if (!sle)
             return;
         for (auto const& key : sle->getFieldV256(sfIndexes))
@@ -434,7 +433,7 @@ forEachItemAfter(
     {
         auto const hintIndex = keylet::page(root, hint);
 
-        if (auto hintDir = view.read(hintIndex))
+        if (auto const hintDir = view.readLazy(hintIndex))
         {
             for (auto const& key : hintDir->getFieldV256(sfIndexes))
             {
@@ -450,7 +449,7 @@ forEachItemAfter(
         bool found = false;
         for (;;)
         {
-            auto const ownerDir = view.read(currentIndex);
+            auto const ownerDir = view.readLazy(currentIndex);
             if (!ownerDir)
                 return found;
             for (auto const& key : ownerDir->getFieldV256(sfIndexes))
@@ -476,7 +475,7 @@ forEachItemAfter(
     {
         for (;;)
         {
-            auto const ownerDir = view.read(currentIndex);
+            auto const ownerDir = view.readLazy(currentIndex);
             if (!ownerDir)
                 return true;
             for (auto const& key : ownerDir->getFieldV256(sfIndexes))
@@ -493,7 +492,7 @@ forEachItemAfter(
 Rate
 transferRate(ReadView const& view, AccountID const& issuer)
 {
-    auto const sle = view.read(keylet::account(issuer));
+    auto const sle = view.readLazy(keylet::account(issuer));
 
     if (sle && sle->isFieldPresent(sfTransferRate))
         return Rate{sle->getFieldU32(sfTransferRate)};
@@ -23,9 +23,12 @@
 #include <ripple/app/misc/Manifest.h>
 #include <ripple/basics/CountedObject.h>
 #include <ripple/json/json_value.h>
+#include <ripple/net/StreamMessage.h>
 #include <ripple/protocol/Book.h>
 #include <ripple/protocol/ErrorCodes.h>
 #include <ripple/resource/Consumer.h>
+#include <deque>
+#include <functional>
 #include <mutex>
 
 namespace ripple {
@@ -187,6 +190,12 @@ public:
         addRpcSub(std::string const& strUrl, ref rspEntry) = 0;
         virtual bool
         tryRemoveRpcSub(std::string const& strUrl) = 0;
+
+        /** Forget a subscriber pushed to at a URL, whatever streams it is
+            subscribed to. Its subscriptions end when it is destroyed.
+        */
+        virtual void
+        removeRpcSub(std::string const& strUrl, InfoSub const& sub) = 0;
     };
 
 public:
@@ -201,6 +210,31 @@ public:
     virtual void
     send(Json::Value const& jvObj, bool broadcast) = 0;
 
+    /** Send a message that has already been serialized.
+
+        Publishers that fan the same event out to many subscribers build
+        the message once and hand it to each of them. The default
+        implementation falls back to sending the JSON object; subscribers
+        which can write the serialized text directly should override it.
+    */
+    virtual void
+    send(StreamMessage::pointer const& msg, bool broadcast)
+    {
+        send(msg->json(), broadcast);
+    }
+
+    /** `true` if this subscriber negotiated the binary stream encoding.
+
+        Publishers use this to choose which encoding of an event to hand
+        to the subscriber. Only subscribers returning `true` here are
+        ever sent binary messages.
+    */
+    virtual bool
+    binaryEncoding() const
+    {
+        return false;
+    }
+
     std::uint64_t
     getSeq();
 
@@ -229,6 +263,44 @@ public:
     std::shared_ptr<InfoSubRequest> const&
     getRequest();
 
+    using Delivery = std::function<void(InfoSub&)>;
+
+    /** The result of queueing a delivery. */
+    enum class Queued {
+        overflow,  // The queue was full, the delivery was discarded and
+                   // the subscriber must be disconnected
+        pending,   // The delivery will run on the current drain
+        drain      // The caller must arrange for drainDeliveries() to run
+    };
+
+    /** Queue a delivery to run against this subscriber.
+
+        Deliveries run in the order they were queued, away from the
+        thread that produced them. A subscriber which falls behind by
+        more than `limit` deliveries is disconnected instead of slowing
+        the producer down.
+    */
+    Queued
+    queueDelivery(Delivery&& delivery, std::size_t limit);
+
+    /** Run queued deliveries until the queue is empty. */
+    void
+    drainDeliveries();
+
+    /** The number of deliveries discarded because the queue was full. */
+    std::uint64_t
+    getDroppedDeliveries() const;
+
+    /** Disconnect a subscriber which fell too far behind.
+
+        WebSocket subscribers are closed. Subscribers pushed to over HTTP
+        are removed, which ends their subscriptions.
+    */
+    virtual void
+    disconnect()
+    {
+    }
+
 protected:
     std::mutex mLock;
 
@@ -241,6 +313,11 @@ private:
     std::uint64_t mSeq;
     hash_set<AccountID> accountHistorySubscriptions_;
 
+    mutable std::mutex deliveryLock_;
+    std::deque<Delivery> deliveries_;
+    bool draining_ = false;
+    std::uint64_t droppedDeliveries_ = 0;
+
     static int
     assign_id()
     {
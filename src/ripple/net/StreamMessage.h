@@ -0,0 +1,127 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_NET_STREAMMESSAGE_H_INCLUDED
+#define RIPPLE_NET_STREAMMESSAGE_H_INCLUDED
+
+#include <ripple/basics/CountedObject.h>
+#include <ripple/basics/Slice.h>
+#include <ripple/json/json_value.h>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace ripple {
+
+/** An immutable, pre-serialized subscription stream message.
+
+    A publisher builds one of these per event and hands the same
+    instance, by reference count, to every subscriber. The JSON text
+    is produced exactly once, when the message is constructed, so the
+    cost of serialization no longer scales with the number of
+    subscribers.
+
+    The original JSON tree is retained for subscribers which cannot
+    consume the serialized form directly (for example, RPCSub queues
+    the JSON object for later delivery over HTTP).
+
+    A binary message carries an already encoded envelope instead (see
+    RPC/BinaryEncoding.h) and has no JSON tree. It is only ever handed
+    to subscribers which negotiated the binary encoding.
+*/
+class StreamMessage : public CountedObject<StreamMessage>
+{
+public:
+    using pointer = std::shared_ptr<StreamMessage const>;
+
+    explicit StreamMessage(Json::Value const& jv);
+
+    explicit StreamMessage(Json::Value&& jv);
+
+    /** Construct a binary message from an encoded envelope. */
+    explicit StreamMessage(Slice binary);
+
+    StreamMessage(StreamMessage const&) = delete;
+    StreamMessage&
+    operator=(StreamMessage const&) = delete;
+
+    /** The JSON object this message was built from. */
+    Json::Value const&
+    json() const
+    {
+        return json_;
+    }
+
+    /** The compact serialized form of the JSON object, or the encoded
+        envelope of a binary message. */
+    std::string const&
+    text() const
+    {
+        return text_;
+    }
+
+    /** `true` if this message must be sent as a binary frame. */
+    bool
+    binary() const
+    {
+        return binary_;
+    }
+
+    std::size_t
+    size() const
+    {
+        return text_.size();
+    }
+
+private:
+    Json::Value const json_;
+    std::string const text_;
+    bool const binary_ = false;
+};
+
+/** Produces the encoding of a stream event which a subscriber asked for.
+
+    The argument is `true` for the binary encoding and `false` for JSON.
+    Publishers build each encoding at most once, on first use.
+*/
+using StreamMessageFactory = std::function<StreamMessage::pointer(bool)>;
+
+/** Build a shared stream message from a JSON object. */
+inline StreamMessage::pointer
+makeStreamMessage(Json::Value const& jv)
+{
+    return std::make_shared<StreamMessage const>(jv);
+}
+
+inline StreamMessage::pointer
+makeStreamMessage(Json::Value&& jv)
+{
+    return std::make_shared<StreamMessage const>(std::move(jv));
+}
+
+/** Build a shared binary stream message from an encoded envelope. */
+inline StreamMessage::pointer
+makeStreamMessage(Slice binary)
+{
+    return std::make_shared<StreamMessage const>(binary);
+}
+
+}  // namespace ripple
+
+#endif
@@ -136,4 +136,54 @@ InfoSub::getRequest()
     return request_;
 }
 
+auto
+InfoSub::queueDelivery(Delivery&& delivery, std::size_t limit) -> Queued
+{
+    std::lock_guard sl(deliveryLock_);
+
+    if (deliveries_.size() >= limit)
+    {
+        ++droppedDeliveries_;
+        return Queued::overflow;
+    }
+
+    deliveries_.push_back(std::move(delivery));
+
+    if (draining_)
+        return Queued::pending;
+
+    draining_ = true;
+    return Queued::drain;
+}
+
+void
+InfoSub::drainDeliveries()
+{
+    for (;;)
+    {
+        Delivery delivery;
+        {
+            std::lock_guard sl(deliveryLock_);
+
+            if (deliveries_.empty())
+            {
+                draining_ = false;
+                return;
+            }
+
+            delivery = std::move(deliveries_.front());
+            deliveries_.pop_front();
+        }
+
+        delivery(*this);
+    }
+}
+
+std::uint64_t
+InfoSub::getDroppedDeliveries() const
+{
+    std::lock_guard sl(deliveryLock_);
+    return droppedDeliveries_;
+}
+
 }  // namespace ripple
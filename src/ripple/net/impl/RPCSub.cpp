@@ -28,7 +28,8 @@
 namespace ripple {
 
 // Subscription object for JSON-RPC
-class RPCSubImp : public RPCSub
+class RPCSubImp : public RPCSub,
+                  public std::enable_shared_from_this<RPCSubImp>
 {
 public:
     RPCSubImp(
@@ -40,6 +41,7 @@ public:
         std::string const& strPassword,
         Logs& logs)
         : RPCSub(source)
+        , m_source(source)
         , m_io_service(io_service)
         , m_jobQueue(jobQueue)
         , mUrl(strUrl)
@@ -95,13 +97,22 @@ public:
             // Start a sending thread.
             JLOG(j_.info()) << "RPCCall::fromNetwork start";
 
+            // The job keeps this alive, since it may be removed meanwhile
             mSending = m_jobQueue.addJob(
-                jtCLIENT_SUBSCRIBE, "RPCSub::sendThread", [this]() {
-                    sendThread();
-                });
+                jtCLIENT_SUBSCRIBE,
+                "RPCSub::sendThread",
+                [self = shared_from_this()]() { self->sendThread(); });
         }
     }
 
+    void
+    disconnect() override
+    {
+        JLOG(j_.warn()) << "RPCCall::fromNetwork too slow, unsubscribing "
+                        << mUrl;
+        m_source.removeRpcSub(mUrl, *this);
+    }
+
     void
     setUsername(std::string const& strUsername) override
     {
@@ -184,6 +195,7 @@ private:
 private:
     enum { eventQueueMax = 32 };
 
+    InfoSub::Source& m_source;
     boost::asio::io_service& m_io_service;
     JobQueue& m_jobQueue;
 
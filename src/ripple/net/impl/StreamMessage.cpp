@@ -0,0 +1,51 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/json/json_writer.h>
+#include <ripple/net/StreamMessage.h>
+
+namespace ripple {
+
+static std::string
+serializeStreamMessage(Json::Value const& jv)
+{
+    std::string s;
+    Json::stream(jv, [&s](void const* data, std::size_t n) {
+        s.append(static_cast<char const*>(data), n);
+    });
+    return s;
+}
+
+StreamMessage::StreamMessage(Json::Value const& jv)
+    : json_(jv), text_(serializeStreamMessage(json_))
+{
+}
+
+StreamMessage::StreamMessage(Json::Value&& jv)
+    : json_(std::move(jv)), text_(serializeStreamMessage(json_))
+{
+}
+
+StreamMessage::StreamMessage(Slice binary)
+    : text_(reinterpret_cast<char const*>(binary.data()), binary.size())
+    , binary_(true)
+{
+}
+
+}  // namespace ripple
@@ -3037,10 +3037,8 @@ PeerImp::doTransactions(
             return;
         }
 
-        Serializer s;
         auto tx = reply.add_transactions();
-        auto sttx = txn->getSTransaction();
-        sttx->add(s);
+        auto const s = txn->getSTransaction()->getSerialized();
         tx->set_rawtransaction(s.data(), s.size());
         tx->set_status(
             txn->getStatus() == INCLUDED ? protocol::tsCURRENT
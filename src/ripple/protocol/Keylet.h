@@ -26,6 +26,7 @@
 namespace ripple {
 
 class STLedgerEntry;
+class STLedgerEntryView;
 
 /** A pair of SHAMap key and LedgerEntryType.
 
@@ -47,6 +48,9 @@ struct Keylet
     /** Returns true if the SLE matches the type */
     bool
     check(STLedgerEntry const&) const;
+
+    bool
+    check(STLedgerEntryView const&) const;
 };
 
 }  // namespace ripple
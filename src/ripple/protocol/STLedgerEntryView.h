@@ -0,0 +1,76 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_PROTOCOL_STLEDGERENTRYVIEW_H_INCLUDED
+#define RIPPLE_PROTOCOL_STLEDGERENTRYVIEW_H_INCLUDED
+
+#include <ripple/basics/CountedObject.h>
+#include <ripple/protocol/STLedgerEntry.h>
+#include <ripple/protocol/STObjectView.h>
+
+namespace ripple {
+
+/** A read-only view of a ledger entry which deserializes fields on access.
+
+    Returned by ReadView::readLazy, for readers which only need a few
+    fields of an entry. Entries which a view holds deserialized, because
+    they were modified or cached, are viewed as they are, without a copy.
+
+    @see STObjectView
+*/
+class STLedgerEntryView final : public STObjectView,
+                                public CountedObject<STLedgerEntryView>
+{
+public:
+    /** View a serialized ledger entry, kept alive by the owner. */
+    STLedgerEntryView(
+        Slice data,
+        uint256 const& key,
+        std::shared_ptr<void const> owner);
+
+    /** View a deserialized ledger entry. */
+    explicit STLedgerEntryView(std::shared_ptr<SLE const> sle);
+
+    uint256 const&
+    key() const
+    {
+        return key_;
+    }
+
+    LedgerEntryType
+    getType() const
+    {
+        return type_;
+    }
+
+    /** Deserialize the whole entry, for readers which need all of it. */
+    std::shared_ptr<SLE const>
+    sle() const;
+
+private:
+    uint256 key_;
+    LedgerEntryType type_;
+    std::shared_ptr<SLE const> sle_;
+};
+
+using SLEView = STLedgerEntryView;
+
+}  // namespace ripple
+
+#endif
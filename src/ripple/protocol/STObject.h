@@ -40,7 +40,38 @@
 
 namespace ripple {
 
+class STAccount;
 class STArray;
+class STBlob;
+
+namespace detail {
+
+// The serialized type of each class of field. Typed access to a field
+// compares this with the type of the field found, which is much cheaper
+// than a dynamic_cast to the class.
+template <class T>
+struct STypeOf;
+
+template <SerializedTypeID id>
+using STypeConstant = std::integral_constant<SerializedTypeID, id>;
+
+// clang-format off
+template <> struct STypeOf<STUInt8> : STypeConstant<STI_UINT8> {};
+template <> struct STypeOf<STUInt16> : STypeConstant<STI_UINT16> {};
+template <> struct STypeOf<STUInt32> : STypeConstant<STI_UINT32> {};
+template <> struct STypeOf<STUInt64> : STypeConstant<STI_UINT64> {};
+template <> struct STypeOf<STUInt128> : STypeConstant<STI_UINT128> {};
+template <> struct STypeOf<STUInt160> : STypeConstant<STI_UINT160> {};
+template <> struct STypeOf<STUInt256> : STypeConstant<STI_UINT256> {};
+template <> struct STypeOf<STAmount> : STypeConstant<STI_AMOUNT> {};
+template <> struct STypeOf<STBlob> : STypeConstant<STI_VL> {};
+template <> struct STypeOf<STAccount> : STypeConstant<STI_ACCOUNT> {};
+template <> struct STypeOf<STArray> : STypeConstant<STI_ARRAY> {};
+template <> struct STypeOf<STPathSet> : STypeConstant<STI_PATHSET> {};
+template <> struct STypeOf<STVector256> : STypeConstant<STI_VECTOR256> {};
+// clang-format on
+
+}  // namespace detail
 
 inline void
 throwFieldNotFound(SField const& field)
@@ -685,7 +716,10 @@ template <class T>
 inline T const*
 STObject::Proxy<T>::find() const
 {
-    return dynamic_cast<T const*>(st_->peekAtPField(*f_));
+    auto const field = st_->peekAtPField(*f_);
+    if (!field || field->getSType() != detail::STypeOf<T>::value)
+        return nullptr;
+    return static_cast<T const*>(field);
 }
 
 template <class T>
@@ -940,6 +974,33 @@ STObject::getPIndex(int offset)
     return &v_[offset].get();
 }
 
+inline int
+STObject::getFieldIndex(SField const& field) const
+{
+    if (mType != nullptr)
+        return mType->getIndex(field);
+
+    int i = 0;
+    for (auto const& elem : v_)
+    {
+        if (elem->getFName() == field)
+            return i;
+        ++i;
+    }
+    return -1;
+}
+
+inline const STBase*
+STObject::peekAtPField(SField const& field) const
+{
+    int index = getFieldIndex(field);
+
+    if (index == -1)
+        return nullptr;
+
+    return peekAtPIndex(index);
+}
+
 template <class T>
 typename T::value_type
 STObject::operator[](TypedField<T> const& f) const
@@ -1068,12 +1129,10 @@ STObject::getFieldByValue(SField const& field) const
     if (id == STI_NOTPRESENT)
         return V();  // optional field not present
 
-    const T* cf = dynamic_cast<const T*>(rf);
-
-    if (!cf)
+    if (id != detail::STypeOf<T>::value)
         Throw<std::runtime_error>("Wrong field type");
 
-    return cf->value();
+    return static_cast<const T*>(rf)->value();
 }
 
 // Implementations for getting (most) fields that return by const reference.
@@ -1095,12 +1154,10 @@ STObject::getFieldByConstRef(SField const& field, V const& empty) const
     if (id == STI_NOTPRESENT)
         return empty;  // optional field not present
 
-    const T* cf = dynamic_cast<const T*>(rf);
-
-    if (!cf)
+    if (id != detail::STypeOf<T>::value)
         Throw<std::runtime_error>("Wrong field type");
 
-    return *cf;
+    return *static_cast<const T*>(rf);
 }
 
 // Implementation for setting most fields with a setValue() method.
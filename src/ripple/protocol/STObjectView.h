@@ -0,0 +1,137 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_PROTOCOL_STOBJECTVIEW_H_INCLUDED
+#define RIPPLE_PROTOCOL_STOBJECTVIEW_H_INCLUDED
+
+#include <ripple/basics/Blob.h>
+#include <ripple/basics/Slice.h>
+#include <ripple/protocol/STAmount.h>
+#include <ripple/protocol/STArray.h>
+#include <ripple/protocol/STObject.h>
+#include <ripple/protocol/STPathSet.h>
+#include <ripple/protocol/STVector256.h>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace ripple {
+
+/** A read-only view of a serialized object, such as a ledger entry or a
+    transaction, which deserializes fields only when they are read.
+
+    Building an STObject creates every field, with heap storage for blobs,
+    amounts with issues, arrays and inner objects, even when the reader only
+    wants two or three of them. A view instead makes one pass over the
+    serialized bytes, noting where each field starts, and reads a field from
+    its bytes on every access.
+
+    The getters follow STObject: a field which is not present reads as its
+    default value. Fields which are read often are better read once.
+
+    A view can also be built over an object which was already deserialized,
+    so that readers may take a view whatever the source of the object.
+*/
+class STObjectView
+{
+public:
+    /** View serialized bytes, kept alive by the owner. */
+    STObjectView(Slice data, std::shared_ptr<void const> owner);
+
+    /** View a deserialized object, kept alive by the owner. */
+    STObjectView(STObject const& object, std::shared_ptr<void const> owner);
+
+    STObjectView(STObjectView&&) = default;
+    STObjectView&
+    operator=(STObjectView&&) = default;
+
+    bool
+    isFieldPresent(SField const& field) const;
+
+    std::uint32_t
+    getFlags() const;
+
+    bool
+    isFlag(std::uint32_t flag) const
+    {
+        return (getFlags() & flag) == flag;
+    }
+
+    unsigned char
+    getFieldU8(SField const& field) const;
+    std::uint16_t
+    getFieldU16(SField const& field) const;
+    std::uint32_t
+    getFieldU32(SField const& field) const;
+    std::uint64_t
+    getFieldU64(SField const& field) const;
+    uint128
+    getFieldH128(SField const& field) const;
+    uint160
+    getFieldH160(SField const& field) const;
+    uint256
+    getFieldH256(SField const& field) const;
+    AccountID
+    getAccountID(SField const& field) const;
+    Blob
+    getFieldVL(SField const& field) const;
+    STAmount
+    getFieldAmount(SField const& field) const;
+    STPathSet
+    getFieldPathSet(SField const& field) const;
+    STVector256
+    getFieldV256(SField const& field) const;
+    STArray
+    getFieldArray(SField const& field) const;
+    STObject
+    getFieldObject(SField const& field) const;
+
+protected:
+    // The serialized object, if the view was built over one
+    Slice
+    data() const
+    {
+        return data_;
+    }
+
+private:
+    struct Field
+    {
+        int code;
+        std::uint32_t offset;
+        std::uint32_t size;
+    };
+
+    void
+    index();
+
+    // The bytes of a field of the given type, if it is present
+    std::optional<SerialIter>
+    at(SField const& field, SerializedTypeID type) const;
+
+    std::shared_ptr<void const> owner_;
+    STObject const* object_ = nullptr;
+    Slice data_;
+    std::vector<Field> fields_;
+};
+
+}  // namespace ripple
+
+#endif
@@ -20,6 +20,7 @@
 #ifndef RIPPLE_PROTOCOL_STTX_H_INCLUDED
 #define RIPPLE_PROTOCOL_STTX_H_INCLUDED
 
+#include <ripple/basics/Buffer.h>
 #include <ripple/basics/Expected.h>
 #include <ripple/protocol/Feature.h>
 #include <ripple/protocol/PublicKey.h>
@@ -47,6 +48,9 @@ class STTx final : public STObject, public CountedObject<STTx>
     uint256 tid_;
     TxType tx_type_;
 
+    // The serialized transaction, which tid_ is the hash of
+    Buffer serialized_;
+
 public:
     static std::size_t const minMultiSigners = 1;
 
@@ -106,6 +110,15 @@ public:
     uint256
     getTransactionID() const;
 
+    /** Return the serialized transaction.
+
+        The transaction is serialized once, when its ID is computed, and
+        the result is kept. A transaction changed in any other way than
+        by sign() is not serialized again.
+    */
+    Slice
+    getSerialized() const;
+
     Json::Value
     getJson(JsonOptions options) const override;
     Json::Value
@@ -138,6 +151,10 @@ public:
         std::string const& escapedMetaData) const;
 
 private:
+    // Serialize the transaction and compute its ID from the result.
+    void
+    setSerialized();
+
     Expected<void, std::string>
     checkSingleSign(RequireFullyCanonicalSig requireCanonicalSig) const;
 
@@ -193,6 +210,12 @@ STTx::getTransactionID() const
     return tid_;
 }
 
+inline Slice
+STTx::getSerialized() const
+{
+    return serialized_;
+}
+
 }  // namespace ripple
 
 #endif
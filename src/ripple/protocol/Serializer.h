@@ -305,6 +305,52 @@ Serializer::addVL(Iter begin, Iter end, int len)
 
 //------------------------------------------------------------------------------
 
+/** A Serializer for an object whose serialization is only needed briefly.
+
+    Hashing an object, or copying it into a SHAMap item, serializes it into
+    a buffer which is thrown away right after. Each thread keeps a few of
+    these buffers once they are released, so that most such serializations
+    reuse memory instead of allocating it.
+*/
+class ScratchSerializer
+{
+public:
+    /** How often buffers were reused and allocated, over all threads. */
+    struct Stats
+    {
+        std::uint64_t reused;
+        std::uint64_t allocated;
+    };
+
+    ScratchSerializer();
+
+    ~ScratchSerializer();
+
+    ScratchSerializer(ScratchSerializer const&) = delete;
+    ScratchSerializer&
+    operator=(ScratchSerializer const&) = delete;
+
+    Serializer&
+    operator*() noexcept
+    {
+        return s_;
+    }
+
+    Serializer*
+    operator->() noexcept
+    {
+        return &s_;
+    }
+
+    static Stats
+    stats();
+
+private:
+    Serializer s_;
+};
+
+//------------------------------------------------------------------------------
+
 // DEPRECATED
 // Transitional adapter to new serialization interfaces
 class SerialIter
@@ -19,6 +19,7 @@
 
 #include <ripple/protocol/Keylet.h>
 #include <ripple/protocol/STLedgerEntry.h>
+#include <ripple/protocol/STLedgerEntryView.h>
 
 namespace ripple {
 
@@ -36,4 +37,16 @@ Keylet::check(STLedgerEntry const& sle) const
     return sle.getType() == type;
 }
 
+bool
+Keylet::check(STLedgerEntryView const& sle) const
+{
+    if (type == ltANY)
+        return true;
+
+    if (type == ltCHILD)
+        return sle.getType() != ltDIR_NODE;
+
+    return sle.getType() == type;
+}
+
 }  // namespace ripple
@@ -54,15 +54,4 @@ SOTemplate::SOTemplate(
     }
 }
 
-int
-SOTemplate::getIndex(SField const& sField) const
-{
-    // The mapping table should be large enough for any possible field
-    //
-    if (sField.getNum() <= 0 || sField.getNum() >= indices_.size())
-        Throw<std::runtime_error>("Invalid field index for getIndex().");
-
-    return indices_[sField.getNum()];
-}
-
 }  // namespace ripple
@@ -17,6 +17,7 @@
 */
 //==============================================================================
 
+#include <ripple/basics/DecimalMath.h>
 #include <ripple/basics/Log.h>
 #include <ripple/basics/contract.h>
 #include <ripple/basics/safe_cast.h>
@@ -26,7 +27,6 @@
 #include <ripple/protocol/UintTypes.h>
 #include <ripple/protocol/jss.h>
 #include <boost/algorithm/string.hpp>
-#include <boost/multiprecision/cpp_int.hpp>
 #include <boost/regex.hpp>
 #include <iostream>
 #include <iterator>
@@ -40,6 +40,14 @@ static const std::uint64_t tenTo14 = 100000000000000ull;
 static const std::uint64_t tenTo14m1 = tenTo14 - 1;
 static const std::uint64_t tenTo17 = tenTo14 * 1000;
 
+// Scale the mantissa of a native amount up into the range of the
+// mantissa of an IOU amount
+static void
+toIOURange(std::uint64_t& value, int& offset)
+{
+    decimal::scaleUp(value, offset, 16, std::numeric_limits<int>::min());
+}
+
 //------------------------------------------------------------------------------
 static std::int64_t
 getSNValue(STAmount const& amount)
@@ -736,10 +744,10 @@ STAmount::canonicalize()
         }
         else
         {
-            while (mOffset < 0)
+            if (mOffset < 0)
             {
-                mValue /= 10;
-                ++mOffset;
+                mValue = decimal::shiftDown(mValue, -mOffset);
+                mOffset = 0;
             }
 
             while (mOffset > 0)
@@ -778,19 +786,16 @@ STAmount::canonicalize()
         return;
     }
 
-    while ((mValue < cMinValue) && (mOffset > cMinOffset))
-    {
-        mValue *= 10;
-        --mOffset;
-    }
+    decimal::scaleUp(mValue, mOffset, 16, cMinOffset);
 
-    while (mValue > cMaxValue)
+    if (mValue > cMaxValue)
     {
-        if (mOffset >= cMaxOffset)
+        int const n = decimal::log10Floor(mValue) - 15;
+        if (mOffset + n > cMaxOffset)
             Throw<std::runtime_error>("value overflow");
 
-        mValue /= 10;
-        ++mOffset;
+        mValue = decimal::shiftDown(mValue, n);
+        mOffset += n;
     }
 
     if ((mOffset < cMinOffset) || (mValue < cMinValue))
@@ -1102,10 +1107,7 @@ muldiv(
     std::uint64_t multiplicand,
     std::uint64_t divisor)
 {
-    boost::multiprecision::uint128_t ret;
-
-    boost::multiprecision::multiply(ret, multiplier, multiplicand);
-    ret /= divisor;
+    auto const ret = decimal::uint128_t(multiplier) * multiplicand / divisor;
 
     if (ret > std::numeric_limits<std::uint64_t>::max())
     {
@@ -1124,11 +1126,8 @@ muldiv_round(
     std::uint64_t divisor,
     std::uint64_t rounding)
 {
-    boost::multiprecision::uint128_t ret;
-
-    boost::multiprecision::multiply(ret, multiplier, multiplicand);
-    ret += rounding;
-    ret /= divisor;
+    auto const ret =
+        (decimal::uint128_t(multiplier) * multiplicand + rounding) / divisor;
 
     if (ret > std::numeric_limits<std::uint64_t>::max())
     {
@@ -1157,21 +1156,12 @@ divide(STAmount const& num, STAmount const& den, Issue const& issue)
 
     if (num.native())
     {
-        while (numVal < STAmount::cMinValue)
-        {
-            // Need to bring into range
-            numVal *= 10;
-            --numOffset;
-        }
+        toIOURange(numVal, numOffset);
     }
 
     if (den.native())
     {
-        while (denVal < STAmount::cMinValue)
-        {
-            denVal *= 10;
-            --denOffset;
-        }
+        toIOURange(denVal, denOffset);
     }
 
     // We divide the two mantissas (each is between 10^15
@@ -1218,20 +1208,12 @@ multiply(STAmount const& v1, STAmount const& v2, Issue const& issue)
 
     if (v1.native())
     {
-        while (value1 < STAmount::cMinValue)
-        {
-            value1 *= 10;
-            --offset1;
-        }
+        toIOURange(value1, offset1);
     }
 
     if (v2.native())
     {
-        while (value2 < STAmount::cMinValue)
-        {
-            value2 *= 10;
-            --offset2;
-        }
+        toIOURange(value2, offset2);
     }
 
     // We multiply the two mantissas (each is between 10^15
@@ -1252,14 +1234,9 @@ canonicalizeRound(bool native, std::uint64_t& value, int& offset)
     {
         if (offset < 0)
         {
-            int loops = 0;
-
-            while (offset < -1)
-            {
-                value /= 10;
-                ++offset;
-                ++loops;
-            }
+            int const loops = -offset - 1;
+            value = decimal::shiftDown(value, loops);
+            offset = -1;
 
             value += (loops >= 2) ? 9 : 10;  // add before last divide
             value /= 10;
@@ -1313,20 +1290,12 @@ mulRound(
 
     if (v1.native())
     {
-        while (value1 < STAmount::cMinValue)
-        {
-            value1 *= 10;
-            --offset1;
-        }
+        toIOURange(value1, offset1);
     }
 
     if (v2.native())
     {
-        while (value2 < STAmount::cMinValue)
-        {
-            value2 *= 10;
-            --offset2;
-        }
+        toIOURange(value2, offset2);
     }
 
     bool const resultNegative = v1.negative() != v2.negative();
@@ -1384,20 +1353,12 @@ divRound(
 
     if (num.native())
     {
-        while (numVal < STAmount::cMinValue)
-        {
-            numVal *= 10;
-            --numOffset;
-        }
+        toIOURange(numVal, numOffset);
     }
 
     if (den.native())
     {
-        while (denVal < STAmount::cMinValue)
-        {
-            denVal *= 10;
-            --denOffset;
-        }
+        toIOURange(denVal, denOffset);
     }
 
     bool const resultNegative = (num.negative() != den.negative());
@@ -0,0 +1,58 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/contract.h>
+#include <ripple/basics/safe_cast.h>
+#include <ripple/protocol/STLedgerEntryView.h>
+
+namespace ripple {
+
+STLedgerEntryView::STLedgerEntryView(
+    Slice data,
+    uint256 const& key,
+    std::shared_ptr<void const> owner)
+    : STObjectView(data, std::move(owner)), key_(key)
+{
+    auto const format = LedgerFormats::getInstance().findByType(
+        safe_cast<LedgerEntryType>(getFieldU16(sfLedgerEntryType)));
+
+    if (format == nullptr)
+        Throw<std::runtime_error>("invalid ledger entry type");
+
+    type_ = format->getType();
+}
+
+STLedgerEntryView::STLedgerEntryView(std::shared_ptr<SLE const> sle)
+    : STObjectView(*sle, sle)
+    , key_(sle->key())
+    , type_(sle->getType())
+    , sle_(std::move(sle))
+{
+}
+
+std::shared_ptr<SLE const>
+STLedgerEntryView::sle() const
+{
+    if (sle_)
+        return sle_;
+
+    return std::make_shared<SLE const>(SerialIter{data()}, key_);
+}
+
+}  // namespace ripple
@@ -354,35 +354,19 @@ STObject::isEquivalent(const STBase& t) const
 uint256
 STObject::getHash(HashPrefix prefix) const
 {
-    Serializer s;
-    s.add32(prefix);
-    add(s, withAllFields);
-    return s.getSHA512Half();
+    ScratchSerializer s;
+    s->add32(prefix);
+    add(*s, withAllFields);
+    return s->getSHA512Half();
 }
 
 uint256
 STObject::getSigningHash(HashPrefix prefix) const
 {
-    Serializer s;
-    s.add32(prefix);
-    add(s, omitSigningFields);
-    return s.getSHA512Half();
-}
-
-int
-STObject::getFieldIndex(SField const& field) const
-{
-    if (mType != nullptr)
-        return mType->getIndex(field);
-
-    int i = 0;
-    for (auto const& elem : v_)
-    {
-        if (elem->getFName() == field)
-            return i;
-        ++i;
-    }
-    return -1;
+    ScratchSerializer s;
+    s->add32(prefix);
+    add(*s, omitSigningFields);
+    return s->getSHA512Half();
 }
 
 const STBase&
@@ -413,17 +397,6 @@ STObject::getFieldSType(int index) const
     return v_[index]->getFName();
 }
 
-const STBase*
-STObject::peekAtPField(SField const& field) const
-{
-    int index = getFieldIndex(field);
-
-    if (index == -1)
-        return nullptr;
-
-    return peekAtPIndex(index);
-}
-
 STBase*
 STObject::getPField(SField const& field, bool createOkay)
 {
@@ -0,0 +1,394 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/contract.h>
+#include <ripple/protocol/STAccount.h>
+#include <ripple/protocol/STObjectView.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace ripple {
+
+// Each of these skips the body of one field, whose header has been read.
+
+static void
+skipField(SerialIter& sit, int type, int depth);
+
+static void
+skipObject(SerialIter& sit, int depth)
+{
+    if (depth > 10)
+        Throw<std::runtime_error>("Maximum nesting depth of STObject exceeded");
+
+    while (!sit.empty())
+    {
+        int type;
+        int field;
+        sit.getFieldID(type, field);
+
+        if (type == STI_OBJECT && field == 1)
+            return;
+
+        if (type == 9 && field == 9)
+            continue;
+
+        skipField(sit, type, depth + 1);
+    }
+}
+
+static void
+skipArray(SerialIter& sit, int depth)
+{
+    while (!sit.empty())
+    {
+        int type;
+        int field;
+        sit.getFieldID(type, field);
+
+        if (type == STI_ARRAY && field == 1)
+            return;
+
+        if (type != STI_OBJECT)
+            Throw<std::runtime_error>("Non-object in array");
+
+        skipObject(sit, depth + 1);
+    }
+}
+
+static void
+skipPathSet(SerialIter& sit)
+{
+    for (;;)
+    {
+        int const type = sit.get8();
+
+        if (type == STPathElement::typeNone)
+            return;
+
+        if (type == STPathElement::typeBoundary)
+            continue;
+
+        if (type & ~STPathElement::typeAll)
+            Throw<std::runtime_error>("bad path element");
+
+        if (type & STPathElement::typeAccount)
+            sit.skip(20);
+        if (type & STPathElement::typeCurrency)
+            sit.skip(20);
+        if (type & STPathElement::typeIssuer)
+            sit.skip(20);
+    }
+}
+
+static void
+skipField(SerialIter& sit, int type, int depth)
+{
+    switch (type)
+    {
+        case STI_UINT8:
+            sit.skip(1);
+            break;
+        case STI_UINT16:
+            sit.skip(2);
+            break;
+        case STI_UINT32:
+            sit.skip(4);
+            break;
+        case STI_UINT64:
+            sit.skip(8);
+            break;
+        case STI_UINT96:
+            sit.skip(12);
+            break;
+        case STI_UINT128:
+            sit.skip(16);
+            break;
+        case STI_UINT160:
+            sit.skip(20);
+            break;
+        case STI_UINT192:
+            sit.skip(24);
+            break;
+        case STI_UINT256:
+            sit.skip(32);
+            break;
+        case STI_UINT384:
+            sit.skip(48);
+            break;
+        case STI_UINT512:
+            sit.skip(64);
+            break;
+        case STI_AMOUNT:
+            // A native amount is just the 64 bit value, an issued amount
+            // also has a currency and an issuer
+            if (sit.get64() & STAmount::cNotNative)
+                sit.skip(40);
+            break;
+        case STI_VL:
+        case STI_ACCOUNT:
+        case STI_VECTOR256:
+            sit.skip(sit.getVLDataLength());
+            break;
+        case STI_OBJECT:
+            skipObject(sit, depth);
+            break;
+        case STI_ARRAY:
+            skipArray(sit, depth);
+            break;
+        case STI_PATHSET:
+            skipPathSet(sit);
+            break;
+        default:
+            Throw<std::runtime_error>("Unknown object type");
+    }
+}
+
+//------------------------------------------------------------------------------
+
+STObjectView::STObjectView(Slice data, std::shared_ptr<void const> owner)
+    : owner_(std::move(owner)), data_(data)
+{
+    index();
+}
+
+STObjectView::STObjectView(
+    STObject const& object,
+    std::shared_ptr<void const> owner)
+    : owner_(std::move(owner)), object_(&object)
+{
+}
+
+void
+STObjectView::index()
+{
+    fields_.reserve(16);
+
+    SerialIter sit(data_);
+    while (!sit.empty())
+    {
+        int type;
+        int field;
+        sit.getFieldID(type, field);
+
+        if (type == STI_OBJECT && field == 1)
+            break;
+
+        if (type == 9 && field == 9)
+            continue;
+
+        auto const code = field_code(type, field);
+        auto const offset = data_.size() - sit.getBytesLeft();
+        skipField(sit, type, 0);
+
+        if (std::any_of(fields_.begin(), fields_.end(), [code](auto const& f) {
+                return f.code == code;
+            }))
+            Throw<std::runtime_error>("Duplicate field detected");
+
+        fields_.push_back(
+            {code,
+             static_cast<std::uint32_t>(offset),
+             static_cast<std::uint32_t>(
+                 data_.size() - sit.getBytesLeft() - offset)});
+    }
+}
+
+std::optional<SerialIter>
+STObjectView::at(SField const& field, SerializedTypeID type) const
+{
+    if (field.fieldType != type)
+        Throw<std::runtime_error>("Wrong field type");
+
+    for (auto const& f : fields_)
+    {
+        if (f.code == field.fieldCode)
+            return SerialIter{data_.data() + f.offset, f.size};
+    }
+
+    return std::nullopt;
+}
+
+bool
+STObjectView::isFieldPresent(SField const& field) const
+{
+    if (object_)
+        return object_->isFieldPresent(field);
+
+    return std::any_of(fields_.begin(), fields_.end(), [&](auto const& f) {
+        return f.code == field.fieldCode;
+    });
+}
+
+std::uint32_t
+STObjectView::getFlags() const
+{
+    return getFieldU32(sfFlags);
+}
+
+unsigned char
+STObjectView::getFieldU8(SField const& field) const
+{
+    if (object_)
+        return object_->getFieldU8(field);
+    if (auto sit = at(field, STI_UINT8))
+        return sit->get8();
+    return 0;
+}
+
+std::uint16_t
+STObjectView::getFieldU16(SField const& field) const
+{
+    if (object_)
+        return object_->getFieldU16(field);
+    if (auto sit = at(field, STI_UINT16))
+        return sit->get16();
+    return 0;
+}
+
+std::uint32_t
+STObjectView::getFieldU32(SField const& field) const
+{
+    if (object_)
+        return object_->getFieldU32(field);
+    if (auto sit = at(field, STI_UINT32))
+        return sit->get32();
+    return 0;
+}
+
+std::uint64_t
+STObjectView::getFieldU64(SField const& field) const
+{
+    if (object_)
+        return object_->getFieldU64(field);
+    if (auto sit = at(field, STI_UINT64))
+        return sit->get64();
+    return 0;
+}
+
+uint128
+STObjectView::getFieldH128(SField const& field) const
+{
+    if (object_)
+        return object_->getFieldH128(field);
+    if (auto sit = at(field, STI_UINT128))
+        return sit->get128();
+    return {};
+}
+
+uint160
+STObjectView::getFieldH160(SField const& field) const
+{
+    if (object_)
+        return object_->getFieldH160(field);
+    if (auto sit = at(field, STI_UINT160))
+        return sit->get160();
+    return {};
+}
+
+uint256
+STObjectView::getFieldH256(SField const& field) const
+{
+    if (object_)
+        return object_->getFieldH256(field);
+    if (auto sit = at(field, STI_UINT256))
+        return sit->get256();
+    return {};
+}
+
+AccountID
+STObjectView::getAccountID(SField const& field) const
+{
+    if (object_)
+        return object_->getAccountID(field);
+    if (auto sit = at(field, STI_ACCOUNT))
+        return STAccount(*sit, field).value();
+    return {};
+}
+
+Blob
+STObjectView::getFieldVL(SField const& field) const
+{
+    if (object_)
+        return object_->getFieldVL(field);
+    if (auto sit = at(field, STI_VL))
+        return sit->getVL();
+    return {};
+}
+
+STAmount
+STObjectView::getFieldAmount(SField const& field) const
+{
+    if (object_)
+        return object_->getFieldAmount(field);
+    if (auto sit = at(field, STI_AMOUNT))
+        return STAmount(*sit, field);
+    return STAmount{};
+}
+
+STPathSet
+STObjectView::getFieldPathSet(SField const& field) const
+{
+    if (object_)
+        return object_->getFieldPathSet(field);
+    if (auto sit = at(field, STI_PATHSET))
+        return STPathSet(*sit, field);
+    return {};
+}
+
+STVector256
+STObjectView::getFieldV256(SField const& field) const
+{
+    if (object_)
+        return object_->getFieldV256(field);
+    if (auto sit = at(field, STI_VECTOR256))
+        return STVector256(*sit, field);
+    return {};
+}
+
+STArray
+STObjectView::getFieldArray(SField const& field) const
+{
+    if (object_)
+        return object_->getFieldArray(field);
+    if (auto sit = at(field, STI_ARRAY))
+        return STArray(*sit, field);
+    return {};
+}
+
+STObject
+STObjectView::getFieldObject(SField const& field) const
+{
+    if (object_)
+    {
+        if (auto const inner =
+                dynamic_cast<STObject const*>(object_->peekAtPField(field)))
+            return *inner;
+        return STObject{field};
+    }
+
+    if (auto sit = at(field, STI_OBJECT))
+    {
+        STObject inner(*sit, field);
+        inner.applyTemplateFromSField(field);
+        return inner;
+    }
+    return STObject{field};
+}
+
+}  // namespace ripple
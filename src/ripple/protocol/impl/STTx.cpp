@@ -33,6 +33,7 @@
 #include <ripple/protocol/STTx.h>
 #include <ripple/protocol/Sign.h>
 #include <ripple/protocol/TxFlags.h>
+#include <ripple/protocol/digest.h>
 #include <ripple/protocol/UintTypes.h>
 #include <ripple/protocol/jss.h>
 #include <boost/format.hpp>
@@ -62,7 +63,7 @@ STTx::STTx(STObject&& object) : STObject(std::move(object))
 {
     tx_type_ = safe_cast<TxType>(getFieldU16(sfTransactionType));
     applyTemplate(getTxFormat(tx_type_)->getSOTemplate());  //  may throw
-    tid_ = getHash(HashPrefix::transactionID);
+    setSerialized();
 }
 
 STTx::STTx(SerialIter& sit) : STObject(sfTransaction)
@@ -78,7 +79,7 @@ STTx::STTx(SerialIter& sit) : STObject(sfTransaction)
     tx_type_ = safe_cast<TxType>(getFieldU16(sfTransactionType));
 
     applyTemplate(getTxFormat(tx_type_)->getSOTemplate());  // May throw
-    tid_ = getHash(HashPrefix::transactionID);
+    setSerialized();
 }
 
 STTx::STTx(TxType type, std::function<void(STObject&)> assembler)
@@ -96,7 +97,16 @@ STTx::STTx(TxType type, std::function<void(STObject&)> assembler)
     if (tx_type_ != type)
         LogicError("Transaction type was mutated during assembly");
 
-    tid_ = getHash(HashPrefix::transactionID);
+    setSerialized();
+}
+
+void
+STTx::setSerialized()
+{
+    ScratchSerializer s;
+    add(*s);
+    serialized_ = Buffer(s->data(), s->size());
+    tid_ = sha512Half(HashPrefix::transactionID, Slice(serialized_));
 }
 
 STBase*
@@ -204,7 +214,7 @@ STTx::sign(PublicKey const& publicKey, SecretKey const& secretKey)
     auto const sig = ripple::sign(publicKey, secretKey, makeSlice(data));
 
     setFieldVL(sfTxnSignature, sig);
-    tid_ = getHash(HashPrefix::transactionID);
+    setSerialized();
 }
 
 Expected<void, std::string>
@@ -241,8 +251,7 @@ STTx::getJson(JsonOptions options, bool binary) const
     if (binary)
     {
         Json::Value ret;
-        Serializer s = STObject::getSerializer();
-        ret[jss::tx] = strHex(s.peekData());
+        ret[jss::tx] = strHex(serialized_);
         ret[jss::hash] = to_string(getTransactionID());
         return ret;
     }
@@ -265,8 +274,7 @@ std::string
 STTx::getMetaSQL(std::uint32_t inLedger, std::string const& escapedMetaData)
     const
 {
-    Serializer s;
-    add(s);
+    Serializer s(serialized_.data(), serialized_.size());
     return getMetaSQL(s, inLedger, txnSqlValidated, escapedMetaData);
 }
 
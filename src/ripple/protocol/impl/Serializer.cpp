@@ -21,6 +21,7 @@
 #include <ripple/basics/contract.h>
 #include <ripple/protocol/Serializer.h>
 #include <ripple/protocol/digest.h>
+#include <atomic>
 #include <type_traits>
 
 namespace ripple {
@@ -516,4 +517,54 @@ SerialIter::getVLBuffer()
     return getRawHelper<Buffer>(getVLDataLength());
 }
 
+//------------------------------------------------------------------------------
+
+namespace {
+
+// Released buffers larger than this are freed rather than kept
+std::size_t constexpr maxScratchCapacity = 64 * 1024;
+
+// The number of released buffers each thread keeps
+std::size_t constexpr maxScratchBuffers = 4;
+
+thread_local std::vector<Blob> scratchBuffers;
+
+std::atomic<std::uint64_t> scratchReused{0};
+std::atomic<std::uint64_t> scratchAllocated{0};
+
+}  // namespace
+
+ScratchSerializer::ScratchSerializer() : s_(0)
+{
+    if (scratchBuffers.empty())
+    {
+        scratchAllocated.fetch_add(1, std::memory_order_relaxed);
+        s_.reserve(256);
+        return;
+    }
+
+    scratchReused.fetch_add(1, std::memory_order_relaxed);
+    s_.modData().swap(scratchBuffers.back());
+    scratchBuffers.pop_back();
+}
+
+ScratchSerializer::~ScratchSerializer()
+{
+    auto& data = s_.modData();
+    if (data.capacity() > maxScratchCapacity ||
+        scratchBuffers.size() >= maxScratchBuffers)
+        return;
+
+    data.clear();
+    scratchBuffers.push_back(std::move(data));
+}
+
+auto
+ScratchSerializer::stats() -> Stats
+{
+    return {
+        scratchReused.load(std::memory_order_relaxed),
+        scratchAllocated.load(std::memory_order_relaxed)};
+}
+
 }  // namespace ripple
@@ -119,7 +119,8 @@ JSS(PaymentChannelCreate);     // transaction type.
 JSS(PaymentChannelFund);       // transaction type.
 JSS(Remit);                    // transaction type.
 JSS(RippleState);              // ledger type.
-JSS(SLE_hit_rate);             // out: GetCounts.
+JSS(SLE_hit_rate);             // out: GetCounts, NetworkOPs
+JSS(SLE_hit_rates);            // out: GetCounts.
 JSS(SetFee);                   // transaction type.
 JSS(UNLModify);                // transaction type.
 JSS(UNLReport);                // transaction type.
@@ -179,6 +180,7 @@ JSS(acquiring);           // out: LedgerRequest
 JSS(address);             // out: PeerImp
 JSS(affected);            // out: AcceptedLedgerTx
 JSS(age);                 // out: NetworkOPs, Peers
+JSS(allocated);           // out: GetCounts
 JSS(alternatives);        // out: PathRequest, RipplePathFind
 JSS(amendment_blocked);   // out: NetworkOPs
 JSS(amendments);          // in: AccountObjects, out: NetworkOPs
@@ -186,6 +188,7 @@ JSS(amount);              // out: AccountChannels
 JSS(api_version);         // in: many, out: Version
 JSS(api_version_low);     // out: Version
 JSS(applied);             // out: SubmitTransaction
+JSS(apply_us);            // out: LedgerBulkReplay
 JSS(asks);                // out: Subscribe
 JSS(assets);              // out: GatewayBalances
 JSS(authorized);          // out: AccountLines
@@ -213,8 +216,12 @@ JSS(both_sides);             // in: Subscribe, Unsubscribe
 JSS(broadcast);              // out: SubmitTransaction
 JSS(build_path);             // in: TransactionSign
 JSS(build_version);          // out: NetworkOPs
+JSS(bytes);                  // out: InboundLedger
+JSS(bytes_per_second);       // out: InboundLedger
+JSS(cache_warmup);           // out: NetworkOPs
 JSS(cancel_after);           // out: AccountChannels
 JSS(can_delete);             // out: CanDelete
+JSS(capacity);               // out: GetCounts
 JSS(changes);                // out: BookChanges
 JSS(channel_id);             // out: AccountChannels
 JSS(channels);               // out: AccountChannels
@@ -286,13 +293,16 @@ JSS(dir_root);                // out: DirectoryEntryIterator
 JSS(directory);               // in: LedgerEntry
 JSS(domain);                  // out: ValidatorInfo, Manifest
 JSS(drops);                   // out: TxQ
-JSS(duration_us);             // out: NetworkOPs
+JSS(duration_ms);             // out: CacheSnapshot
+JSS(duration_us);             // out: NetworkOPs, InboundLedger,
+                              //     LedgerBulkReplay
 JSS(effective);               // out: ValidatorList
                               // in: UNL
 JSS(enabled);                 // out: AmendmentTable
 JSS(engine_result);           // out: NetworkOPs, TransactionSign, Submit
 JSS(engine_result_code);      // out: NetworkOPs, TransactionSign, Submit
 JSS(engine_result_message);   // out: NetworkOPs, TransactionSign, Submit
+JSS(entries);                 // out: CacheSnapshot
 JSS(ephemeral_key);           // out: ValidatorInfo
                               // in/out: Manifest
 JSS(error);                   // out: error
@@ -303,6 +313,8 @@ JSS(error_message);         // out: error
 JSS(escrow);                // in: LedgerEntry
 JSS(emitted_txn);           // in: LedgerEntry
 JSS(expand);                // in: handler/Ledger
+JSS(expansion_us);          // out: GetCounts
+JSS(expansions);            // out: GetCounts
 JSS(expected_date);         // out: any (warnings)
 JSS(expected_date_UTC);     // out: any (warnings)
 JSS(expected_ledger_size);  // out: TxQ
@@ -330,8 +342,11 @@ JSS(flags);                 // out: AccountOffers,
 JSS(forward);               // in: AccountTx
 JSS(freeze);                // out: AccountLines
 JSS(freeze_peer);           // out: AccountLines
+JSS(from_snapshot);         // out: CacheSnapshot
 JSS(frozen_balances);       // out: GatewayBalances
 JSS(full);                  // in: LedgerClearer, handlers/Ledger
+                            // out: GetCounts
+JSS(full_below);            // out: CacheSnapshot
 JSS(full_reply);            // out: PathFind
 JSS(fullbelow_size);        // out: GetCounts
 JSS(good);                  // out: RPCVersion
@@ -341,6 +356,7 @@ JSS(hashes);                // in: AccountObjects
 JSS(have_header);           // out: InboundLedger
 JSS(have_state);            // out: InboundLedger
 JSS(have_transactions);     // out: InboundLedger
+JSS(heap);                  // out: GetCounts
 JSS(high);                  // out: BookChanges
 JSS(highest_sequence);      // out: AccountInfo
 JSS(highest_ticket);        // out: AccountInfo
@@ -363,6 +379,7 @@ JSS(index);    // in: LedgerEntry, DownloadShard
                //      LedgerEntry, TxHistory, LedgerData
 JSS(info);     // out: ServerInfo, ConsensusInfo, FetchInfo
 JSS(initial_sync_duration_us);
+JSS(inner_nodes);          // out: InboundLedger
 JSS(internal_command);     // in: Internal
 JSS(invalid_API_version);  // out: Many, when a request has an invalid
                            //      version
@@ -394,6 +411,7 @@ JSS(ledger_current_index);        // out: NetworkOPs, RPCHelpers,
                                   //      LedgerCurrent, LedgerAccept,
                                   //      AccountLines
 JSS(ledger_data);                 // out: LedgerHeader
+JSS(ledger_entries);              // out: CacheSnapshot
 JSS(ledger_hash);                 // in: RPCHelpers, LedgerRequest,
                                   //     RipplePathFind, TransactionEntry,
                                   //     handlers/Ledger
@@ -407,8 +425,11 @@ JSS(ledger_index_min);            // in, out: AccountTx*
 JSS(ledger_max);                  // in, out: AccountTx*
 JSS(ledger_min);                  // in, out: AccountTx*
 JSS(ledger_time);                 // out: NetworkOPs
+JSS(ledgers);                     // out: LedgerBulkReplay
 JSS(LEDGER_ENTRY_TYPES);          // out: RPC server_definitions
 JSS(levels);                      // LogLevels
+JSS(light);                       // out: GetCounts
+JSS(light_bytes);                 // out: GetCounts
 JSS(limit);                       // in/out: AccountTx*, AccountOffers,
                                   //         AccountLines, AccountObjects
                                   // in: LedgerData, BookOffers
@@ -468,6 +489,8 @@ JSS(min_count);                  // in: GetCounts
 JSS(min_ledger);                 // in: LedgerCleaner
 JSS(minimum_fee);                // out: TxQ
 JSS(minimum_level);              // out: TxQ
+JSS(mismatches);                 // out: LedgerBulkReplay
+JSS(missing);                    // out: InboundLedger, CacheSnapshot
 JSS(missingCommand);             // error
 JSS(name);                       // out: AmendmentTableImpl, PeerImp
 JSS(namespace_entries);          // out: AccountNamespace
@@ -500,6 +523,8 @@ JSS(node_written_bytes);         // out: GetCounts
 JSS(node_writes_duration_us);    // out: GetCounts
 JSS(node_write_retries);         // out: GetCounts
 JSS(node_writes_delayed);        // out::GetCounts
+JSS(nodes);                      // out: InboundLedger
+JSS(nodes_per_second);           // out: InboundLedger
 JSS(nth);                        // out: RPC server_definitions
 JSS(obligations);                // out: GatewayBalances
 JSS(offer);                      // in: LedgerEntry
@@ -510,9 +535,11 @@ JSS(open);                       // out: handlers/Ledger
 JSS(open_ledger_cost);           // out: SubmitTransaction
 JSS(open_ledger_fee);            // out: TxQ
 JSS(open_ledger_level);          // out: TxQ
+JSS(outstanding);                // out: InboundLedger
 JSS(owner);                      // in: LedgerEntry, out: NetworkOPs
 JSS(owner_funds);                // in/out: Ledger, NetworkOPs, AcceptedLedgerTx
 JSS(page_index);
+JSS(parallelism);        // in: LedgerData
 JSS(params);             // RPC
 JSS(parent_close_time);  // out: LedgerToJson
 JSS(parent_hash);        // out: LedgerToJson
@@ -526,7 +553,8 @@ JSS(payment_channel);    // in: LedgerEntry
 JSS(pclose);
 JSS(peer);                        // in: AccountLines
 JSS(peer_authorized);             // out: AccountLines
-JSS(peer_id);                     // out: RCLCxPeerPos
+JSS(peer_id);                     // out: RCLCxPeerPos, InboundLedger
+JSS(peer_stats);                  // out: InboundLedger
 JSS(peers);                       // out: InboundLedger, handlers/Peers, Overlay
 JSS(peer_disconnects);            // Severed peer connection counter.
 JSS(peer_disconnects_resources);  // Severed peer connections because of
@@ -558,6 +586,8 @@ JSS(queued);            // out: SubmitTransaction
 JSS(queued_duration_us);
 JSS(random);                // out: Random
 JSS(raw_meta);              // out: AcceptedLedgerTx
+JSS(reads);                 // out: InboundLedger
+JSS(reads_done);            // out: InboundLedger
 JSS(receive_currencies);    // out: AccountCurrencies
 JSS(reference_level);       // out: TxQ
 JSS(refresh_interval);      // in: UNL
@@ -567,6 +597,7 @@ JSS(remaining);             // out: ValidatorList
 JSS(remote);                // out: Logic.h
 JSS(request);               // RPC
 JSS(requested);             // out: Manifest
+JSS(reused);                // out: GetCounts
 JSS(reservations);          // out: Reservations
 JSS(reserve_base);          // out: NetworkOPs
 JSS(reserve_base_xrp);      // out: NetworkOPs
@@ -576,13 +607,18 @@ JSS(reserve_inc_xrp);       // out: NetworkOPs
 JSS(reserve_inc_native);    // out: NetworkOPs
 JSS(response);              // websocket
 JSS(result);                // RPC
+JSS(retained_ledgers);      // out: GetCounts
 JSS(ripple_lines);          // out: NetworkOPs
 JSS(ripple_state);          // in: LedgerEntr
 JSS(ripplerpc);             // ripple RPC version
 JSS(role);                  // out: Ping.cpp
 JSS(rpc);
 JSS(rt_accounts);  // in: Subscribe, Unsubscribe
+JSS(rtt);          // out: InboundLedger
+JSS(running);      // out: InboundLedger
 JSS(running_duration_us);
+JSS(scans);                     // out: InboundLedger
+JSS(scratch_serializers);       // out: GetCounts
 JSS(search_depth);              // in: RipplePathFind
 JSS(searched_all);              // out: Tx
 JSS(secret);                    // in: TransactionSign,
@@ -605,6 +641,7 @@ JSS(server_status);             // out: NetworkOPs
 JSS(server_version);            // out: NetworkOPs
 JSS(settle_delay);              // out: AccountChannels
 JSS(severity);                  // in: LogLevel
+JSS(shamapitem_slabs);          // out: GetCounts
 JSS(shards);                    // in/out: GetCounts, DownloadShard
 JSS(signature);                 // out: NetworkOPs, ChannelAuthorize
 JSS(signature_verified);        // out: ChannelVerify
@@ -613,6 +650,8 @@ JSS(signing_keys);              // out: ValidatorList
 JSS(signing_time);              // out: NetworkOPs
 JSS(signer_list);               // in: AccountObjects
 JSS(signer_lists);              // in/out: AccountInfo
+JSS(size);                      // out: GetCounts
+JSS(slabs);                     // out: GetCounts
 JSS(snapshot);                  // in: Subscribe
 JSS(source_account);            // in: PathRequest, RipplePathFind
 JSS(source_amount);             // in: PathRequest, RipplePathFind
@@ -624,10 +663,13 @@ JSS(started);
 JSS(state);                 // out: Logic.h, ServerState, LedgerData
 JSS(state_accounting);      // out: NetworkOPs
 JSS(state_now);             // in: Subscribe
+JSS(state_scan);            // out: InboundLedger
 JSS(status);                // error
 JSS(stop);                  // in: LedgerCleaner
 JSS(stop_history_tx_only);  // in: Unsubscribe, stop history tx stream
 JSS(storedSeqs);            // out: NodeToShardStatus
+JSS(streamed);              // in: LedgerHandler, LedgerData,
+                            //     AccountObjects, AccountTx
 JSS(streams);               // in: Subscribe, Unsubscribe
 JSS(strict);                // in: AccountCurrencies, AccountInfo
 JSS(sub_index);             // in: LedgerEntry
@@ -658,10 +700,13 @@ JSS(transTreeHash);           // out: ledger/Ledger.cpp
 JSS(transaction);             // in: Tx
                               // out: NetworkOPs, AcceptedLedgerTx,
 JSS(transaction_hash);        // out: RCLCxPeerPos, LedgerToJson
+JSS(transaction_scan);        // out: InboundLedger
 JSS(transactions);            // out: LedgerToJson,
                               // in: AccountTx*, Unsubscribe
 JSS(transitions);             // out: NetworkOPs
+JSS(tree_nodes);              // out: CacheSnapshot
 JSS(treenode_cache_size);     // out: GetCounts
+JSS(treenode_hit_rate);       // out: NetworkOPs
 JSS(treenode_track_size);     // out: GetCounts
 JSS(trusted);                 // out: UnlList
 JSS(trusted_validator_keys);  // out: ValidatorList
@@ -709,6 +754,7 @@ JSS(url);                        // in/out: Subscribe, Unsubscribe
 JSS(url_password);               // in: Subscribe
 JSS(url_username);               // in: Subscribe
 JSS(urlgravatar);                //
+JSS(used);                       // out: GetCounts
 JSS(username);                   // in: Subscribe
 JSS(validated);                  // out: NetworkOPs, RPCHelpers, AccountTx*
                                  //      Tx
@@ -733,8 +779,10 @@ JSS(vetoed);           // out: AmendmentTableImpl
 JSS(volume_a);         // out: BookChanges
 JSS(volume_b);         // out: BookChanges
 JSS(vote);             // in: Feature
+JSS(wait_us);          // out: LedgerBulkReplay
 JSS(warning);          // rpc:
 JSS(warnings);         // out: server_info, server_state
+JSS(window);           // out: InboundLedger
 JSS(workers);
 JSS(write_load);   // out: GetCounts
 JSS(NegativeUNL);  // out: ValidatorList; ledger type
@@ -0,0 +1,144 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2019 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_RPC_BINARYENCODING_H_INCLUDED
+#define RIPPLE_RPC_BINARYENCODING_H_INCLUDED
+
+#include <ripple/basics/Slice.h>
+#include <ripple/protocol/Serializer.h>
+#include <ripple/protocol/TER.h>
+#include <cstdint>
+#include <string>
+
+namespace Json {
+class Value;
+}
+
+namespace ripple {
+
+class ReadView;
+class STTx;
+
+namespace RPC {
+
+/** The binary encoding of WebSocket messages.
+
+    Sessions which negotiate the binary subprotocol (see WSSession.h)
+    receive stream messages, and the responses of the commands which
+    support it, as binary frames. The payloads are the canonical
+    serialized forms of the ledger objects involved, so nothing has to
+    be rendered to, or parsed back from, JSON at either end.
+
+    Every message starts with a two byte header:
+
+        uint8    binaryEncodingVersion
+        uint8    BinaryMessage
+
+    followed by the fields of the message type. Integers are big endian.
+    A blob is a uint32 byte count followed by the bytes; unlike the VL
+    prefix used inside serialized objects it is not limited in size.
+
+    ledgerClosed (the `ledger` stream):
+
+        uint32   ledger_index
+        hash256  ledger_hash
+        uint32   ledger_time
+        uint64   fee_base, in drops
+        uint64   reserve_base, in drops
+        uint64   reserve_inc, in drops
+        uint32   txn_count
+        blob     validated_ledgers, empty when not reported
+
+    transaction (the `transactions`, `transactions_proposed`, `accounts`,
+    `accounts_proposed` and book streams):
+
+        uint8    validated
+        uint32   ledger_index, or the current ledger if not validated
+        hash256  ledger_hash, zero if not validated
+        uint32   close time of the ledger, zero if not validated
+        int32    engine_result_code
+        blob     serialized transaction
+        blob     serialized metadata, empty if not validated
+
+    The JSON only fields derived from these (`ctid`, `delivered_amount`,
+    `owner_funds` and the textual engine result) are not sent.
+
+    response:
+
+        uint8    flags, see BinaryResponseFlags
+        blob     the request `id`, as compact JSON, empty if none
+        blob     the command name
+        ...      the command specific payload, see the command handlers
+
+    Errors, and commands without a binary form, are always answered with
+    JSON text frames. The streams not listed above are also always JSON.
+*/
+inline constexpr std::uint8_t binaryEncodingVersion = 1;
+
+enum class BinaryMessage : std::uint8_t {
+    response = 1,
+    ledgerClosed = 2,
+    transaction = 3,
+};
+
+/** The flags of a binary response. */
+enum BinaryResponseFlags : std::uint8_t {
+    // The server is under load, as `"warning": "load"` says in JSON
+    binaryLoadWarning = 0x01,
+};
+
+/** Append the header of a binary message. */
+void
+addBinaryHeader(Serializer& s, BinaryMessage type);
+
+/** Append a size prefixed blob. */
+void
+addBinaryBlob(Serializer& s, Slice data);
+
+/** Append the header and the common fields of a binary response, with
+    no flags set. */
+void
+addBinaryResponseHeader(Serializer& s, Json::Value const& request);
+
+/** Set flags of a response begun by addBinaryResponseHeader. */
+void
+setBinaryResponseFlags(Serializer& s, std::uint8_t flags);
+
+/** Append a complete `ledgerClosed` stream message. */
+void
+addBinaryLedgerClosed(
+    Serializer& s,
+    ReadView const& ledger,
+    std::uint32_t txnCount,
+    std::string const& validatedLedgers);
+
+/** Append a complete `transaction` stream message. */
+void
+addBinaryTransaction(
+    Serializer& s,
+    ReadView const& ledger,
+    STTx const& tx,
+    TER result,
+    bool validated,
+    Slice meta);
+
+}  // namespace RPC
+}  // namespace ripple
+
+#endif
@@ -33,12 +33,28 @@ class STTx;
 
 namespace RPC {
 
+/** Compute the volume and rates of every order book a ledger changed.
+
+    This is the message published on the `book_changes` stream, and the
+    result of the `book_changes` command. The books are tallied under the
+    issues of their two sides. The text names of the issues, which decide
+    which side of a book is reported first and the order of the books,
+    are built once per issue rather than once per affected offer.
+*/
 template <class L>
 Json::Value
 computeBookChanges(std::shared_ptr<L const> const& lpAccepted)
 {
+    std::map<Issue, std::string> names;
+    auto const name = [&names](Issue const& issue) -> std::string const& {
+        auto it = names.find(issue);
+        if (it == names.end())
+            it = names.emplace(issue, to_string(issue)).first;
+        return it->second;
+    };
+
     std::map<
-        std::string,
+        std::pair<Issue, Issue>,
         std::tuple<
             STAmount,  // side A volume
             STAmount,  // side B volume
@@ -112,11 +128,11 @@ computeBookChanges(std::shared_ptr<L const> const& lpAccepted)
             STAmount deltaPays = finalFields.getFieldAmount(sfTakerPays) -
                 previousFields.getFieldAmount(sfTakerPays);
 
-            std::string g{to_string(deltaGets.issue())};
-            std::string p{to_string(deltaPays.issue())};
-
-            bool const noswap =
-                isXRP(deltaGets) ? true : (isXRP(deltaPays) ? false : (g < p));
+            bool const noswap = isXRP(deltaGets)
+                ? true
+                : (isXRP(deltaPays)
+                       ? false
+                       : (name(deltaGets.issue()) < name(deltaPays.issue())));
 
             STAmount first = noswap ? deltaGets : deltaPays;
             STAmount second = noswap ? deltaPays : deltaGets;
@@ -133,27 +149,20 @@ computeBookChanges(std::shared_ptr<L const> const& lpAccepted)
             if (second < beast::zero)
                 second = -second;
 
-            std::stringstream ss;
-            if (noswap)
-                ss << g << "|" << p;
-            else
-                ss << p << "|" << g;
-
-            std::string key{ss.str()};
-
-            if (tally.find(key) == tally.end())
-                tally[key] = {
-                    first,   // side A vol
-                    second,  // side B vol
-                    rate,    // high
-                    rate,    // low
-                    rate,    // open
-                    rate     // close
-                };
-            else
+            auto [it, inserted] = tally.try_emplace(
+                std::make_pair(first.issue(), second.issue()),
+                first,   // side A vol
+                second,  // side B vol
+                rate,    // high
+                rate,    // low
+                rate,    // open
+                rate     // close
+            );
+
+            if (!inserted)
             {
                 // increment volume
-                auto& entry = tally[key];
+                auto& entry = it->second;
 
                 std::get<0>(entry) += first;   // side A vol
                 std::get<1>(entry) += second;  // side B vol
@@ -169,6 +178,17 @@ computeBookChanges(std::shared_ptr<L const> const& lpAccepted)
         }
     }
 
+    // Report the books in the order of their names.
+    std::vector<std::pair<std::string, decltype(tally)::const_iterator>> books;
+    books.reserve(tally.size());
+    for (auto it = tally.cbegin(); it != tally.cend(); ++it)
+        books.emplace_back(
+            name(it->first.first) + "|" + name(it->first.second), it);
+    std::sort(
+        books.begin(), books.end(), [](auto const& lhs, auto const& rhs) {
+            return lhs.first < rhs.first;
+        });
+
     Json::Value jvObj(Json::objectValue);
     jvObj[jss::type] = "bookChanges";
     jvObj[jss::ledger_index] = lpAccepted->info().seq;
@@ -178,17 +198,18 @@ computeBookChanges(std::shared_ptr<L const> const& lpAccepted)
 
     jvObj[jss::changes] = Json::arrayValue;
 
-    for (auto const& entry : tally)
+    for (auto const& book : books)
     {
+        auto const& entry = *book.second;
         Json::Value& inner = jvObj[jss::changes].append(Json::objectValue);
 
         STAmount volA = std::get<0>(entry.second);
         STAmount volB = std::get<1>(entry.second);
 
         inner[jss::currency_a] =
-            (isXRP(volA) ? "XRP_drops" : to_string(volA.issue()));
+            (isXRP(volA) ? "XRP_drops" : name(volA.issue()));
         inner[jss::currency_b] =
-            (isXRP(volB) ? "XRP_drops" : to_string(volB.issue()));
+            (isXRP(volB) ? "XRP_drops" : name(volB.issue()));
 
         inner[jss::volume_a] =
             (isXRP(volA) ? to_string(volA.xrp()) : to_string(volA.iou()));
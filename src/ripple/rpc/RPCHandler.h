@@ -22,8 +22,14 @@
 
 #include <ripple/core/Config.h>
 #include <ripple/net/InfoSub.h>
+#include <ripple/protocol/Serializer.h>
 #include <ripple/rpc/Context.h>
 #include <ripple/rpc/Status.h>
+#include <functional>
+
+namespace Json {
+class Object;
+}
 
 namespace ripple {
 namespace RPC {
@@ -34,6 +40,35 @@ struct JsonContext;
 Status
 doCommand(RPC::JsonContext&, Json::Value&);
 
+/** Execute an RPC command, answering in binary form if it can.
+
+    If the command has a binary encoding and succeeds, its payload is
+    appended to `binary` and `true` is returned. Otherwise `result` holds
+    the JSON response, exactly as doCommand would have produced it.
+*/
+bool
+doCommandBinary(RPC::JsonContext&, Json::Value& result, Serializer& binary);
+
+/** Execute an RPC command, writing its result as it is sent if it can.
+
+    Only requests with `"streamed": true` are streamed, since the fields
+    of a streamed object are in the order written rather than sorted.
+
+    If the command can be streamed and the request is valid, `begin` is
+    called to start the response, and the result is written to the
+    object it returns; `true` is returned. If writing the result then
+    fails part way, `result` holds the error, which can no longer be
+    sent in place of the response.
+
+    Otherwise `false` is returned, and `result` holds the JSON response
+    exactly as doCommand would have produced it.
+*/
+bool
+doCommandStreamed(
+    RPC::JsonContext&,
+    Json::Value& result,
+    std::function<Json::Object&()> const& begin);
+
 Role
 roleRequired(unsigned int version, bool betaEnabled, std::string const& method);
 
@@ -0,0 +1,178 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2019 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_RPC_RESPONSESTREAM_H_INCLUDED
+#define RIPPLE_RPC_RESPONSESTREAM_H_INCLUDED
+
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/core/JobQueue.h>
+#include <ripple/json/Output.h>
+#include <ripple/server/Session.h>
+#include <ripple/server/WSSession.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace ripple {
+namespace RPC {
+
+/** Carries a response to a client connection while it is being produced.
+
+    Building a large response as a Json::Value, serializing it, and only
+    then handing it to the connection holds several copies of it in
+    memory at once, and the client sees nothing until all of it is ready.
+    Instead, the RPC coroutine writes the JSON text of the response into
+    a stream (usually through a Json::Writer), which passes it to the
+    connection in chunks of about chunkSize bytes as they fill.
+
+    Once more than highWater bytes are waiting to be sent, the producer
+    is suspended until the connection has caught up to lowWater. The
+    coroutine yields its thread while it waits; a producer without a
+    coroutine blocks. This bounds the memory held by a response however
+    large it is and however slowly the client reads it.
+
+    If the connection goes away, anything written afterwards is discarded
+    and a suspended producer is released.
+*/
+class ResponseStream
+{
+public:
+    static constexpr std::size_t chunkSize = 64 * 1024;
+    static constexpr std::size_t highWater = 1024 * 1024;
+    static constexpr std::size_t lowWater = 256 * 1024;
+
+    /** What the connection should do after calling next(). */
+    enum class Next {
+        chunk,    // Send the chunk, then call next() again
+        last,     // Send the chunk, which completes the response
+        wait,     // Nothing to send yet, `resume` will be called
+        done,     // The response is complete
+        aborted,  // The response failed, close the connection
+    };
+
+    explicit ResponseStream(std::shared_ptr<JobQueue::Coro> coro = {});
+
+    ResponseStream(ResponseStream const&) = delete;
+    ResponseStream&
+    operator=(ResponseStream const&) = delete;
+
+    //
+    // Producer
+    //
+
+    /** Append text to the response. */
+    void
+    write(boost::beast::string_view data);
+
+    /** Return an Output which appends to the response.
+
+        The stream must outlive the Output.
+    */
+    Json::Output
+    output();
+
+    /** Complete the response. Nothing may be written afterwards. */
+    void
+    finish();
+
+    /** End the response early, because producing it failed.
+
+        The connection is closed without completing the response, so the
+        client can tell that it is incomplete.
+    */
+    void
+    abort();
+
+    /** The number of bytes written so far. */
+    std::size_t
+    size() const
+    {
+        return size_;
+    }
+
+    //
+    // Connection
+    //
+
+    /** Take the next chunk to send.
+
+        If none is ready yet `resume` is kept, and called once there is
+        one or the response is complete.
+    */
+    Next
+    next(std::string& chunk, std::function<void(void)> const& resume);
+
+    /** Report that a chunk of `bytes` bytes has been sent. */
+    void
+    sent(std::size_t bytes);
+
+    /** Report that nothing more can be sent. */
+    void
+    abandon();
+
+private:
+    // Queue the pending text, suspending if too much is queued.
+    void
+    flush();
+
+    void
+    resumeProducer();
+
+    std::shared_ptr<JobQueue::Coro> const coro_;
+
+    // Only used by the producer.
+    std::string pending_;
+    std::size_t size_ = 0;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::string> chunks_;
+    std::size_t queued_ = 0;
+    bool finished_ = false;
+    bool aborted_ = false;
+    bool abandoned_ = false;
+    bool suspended_ = false;
+    std::function<void(void)> resume_;
+};
+
+/** Start a response on an HTTP session, using chunked transfer encoding.
+
+    The status line and headers are sent at once. After the response is
+    complete the session reads the next request if `keepAlive` is set,
+    and is closed otherwise.
+*/
+std::shared_ptr<ResponseStream>
+makeHTTPResponseStream(
+    Session& session,
+    int status,
+    bool keepAlive,
+    std::shared_ptr<JobQueue::Coro> coro,
+    beast::Journal j);
+
+/** Start a response on a WebSocket session, as a single text message. */
+std::shared_ptr<ResponseStream>
+makeWSResponseStream(WSSession& session, std::shared_ptr<JobQueue::Coro> coro);
+
+}  // namespace RPC
+}  // namespace ripple
+
+#endif
@@ -19,6 +19,7 @@
 
 #include <ripple/app/main/Application.h>
 #include <ripple/app/tx/impl/details/NFTokenUtils.h>
+#include <ripple/json/Object.h>
 #include <ripple/json/json_writer.h>
 #include <ripple/ledger/ReadView.h>
 #include <ripple/net/RPCErr.h>
@@ -29,6 +30,7 @@
 #include <ripple/protocol/nftPageMask.h>
 #include <ripple/resource/Fees.h>
 #include <ripple/rpc/Context.h>
+#include <ripple/rpc/impl/Handler.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
 #include <ripple/rpc/impl/Tuning.h>
 
@@ -165,22 +167,38 @@ doAccountNFTs(RPC::JsonContext& context)
     return result;
 }
 
+namespace {
+
+struct AccountObjectsRequest
+{
+    std::shared_ptr<ReadView const> ledger;
+
+    // The fields of the result which precede the objects.
+    Json::Value head;
+
+    AccountID accountID;
+    std::optional<std::vector<LedgerEntryType>> typeFilter;
+    unsigned int limit = 0;
+    uint256 dirIndex;
+    uint256 entryIndex;
+};
+
+// Returns a null value if the request is valid, and the error otherwise.
 Json::Value
-doAccountObjects(RPC::JsonContext& context)
+checkAccountObjects(RPC::JsonContext& context, AccountObjectsRequest& request)
 {
     auto const& params = context.params;
     if (!params.isMember(jss::account))
         return RPC::missing_field_error(jss::account);
 
-    std::shared_ptr<ReadView const> ledger;
+    auto& ledger = request.ledger;
     auto result = RPC::lookupLedger(ledger, context);
     if (ledger == nullptr)
         return result;
 
-    AccountID accountID;
     {
         auto const strIdent = params[jss::account].asString();
-        if (auto jv = RPC::accountFromString(accountID, strIdent))
+        if (auto jv = RPC::accountFromString(request.accountID, strIdent))
         {
             for (auto it = jv.begin(); it != jv.end(); ++it)
                 result[it.memberName()] = *it;
@@ -189,10 +207,10 @@ doAccountObjects(RPC::JsonContext& context)
         }
     }
 
-    if (!ledger->exists(keylet::account(accountID)))
+    if (!ledger->exists(keylet::account(request.accountID)))
         return rpcError(rpcACT_NOT_FOUND);
 
-    std::optional<std::vector<LedgerEntryType>> typeFilter;
+    auto& typeFilter = request.typeFilter;
 
     if (params.isMember(jss::deletion_blockers_only) &&
         params[jss::deletion_blockers_only].asBool())
@@ -239,12 +257,10 @@ doAccountObjects(RPC::JsonContext& context)
         }
     }
 
-    unsigned int limit;
-    if (auto err = readLimitField(limit, RPC::Tuning::accountObjects, context))
+    if (auto err = readLimitField(
+            request.limit, RPC::Tuning::accountObjects, context))
         return *err;
 
-    uint256 dirIndex;
-    uint256 entryIndex;
     if (params.isMember(jss::marker))
     {
         auto const& marker = params[jss::marker];
@@ -256,31 +272,81 @@ doAccountObjects(RPC::JsonContext& context)
         if (!std::getline(ss, s, ','))
             return RPC::invalid_field_error(jss::marker);
 
-        if (!dirIndex.parseHex(s))
+        if (!request.dirIndex.parseHex(s))
             return RPC::invalid_field_error(jss::marker);
 
         if (!std::getline(ss, s, ','))
             return RPC::invalid_field_error(jss::marker);
 
-        if (!entryIndex.parseHex(s))
+        if (!request.entryIndex.parseHex(s))
             return RPC::invalid_field_error(jss::marker);
     }
 
-    if (!RPC::getAccountObjects(
-            *ledger,
-            accountID,
-            typeFilter,
-            dirIndex,
-            entryIndex,
-            limit,
-            result))
+    request.head = std::move(result);
+    context.loadType = Resource::feeMediumBurdenRPC;
+    return Json::Value();
+}
+
+template <class Object>
+void
+writeAccountObjects(Object& result, AccountObjectsRequest const& request)
+{
+    Json::copyFrom(result, request.head);
+
+    // If the marker does not identify an entry nothing is visited, and
+    // the array is left empty.
+    std::optional<std::string> marker;
+    {
+        auto&& objects = Json::setArray(result, jss::account_objects);
+        RPC::forEachAccountObject(
+            *request.ledger,
+            request.accountID,
+            request.typeFilter,
+            request.dirIndex,
+            request.entryIndex,
+            request.limit,
+            [&objects](std::shared_ptr<SLE const> const& sle) {
+                objects.append(sle->getJson(JsonOptions::none));
+            },
+            marker);
+    }
+
+    if (marker)
     {
-        result[jss::account_objects] = Json::arrayValue;
+        result[jss::limit] = request.limit;
+        result[jss::marker] = *marker;
     }
 
-    result[jss::account] = toBase58(accountID);
-    context.loadType = Resource::feeMediumBurdenRPC;
+    result[jss::account] = toBase58(request.accountID);
+}
+
+}  // namespace
+
+Json::Value
+doAccountObjects(RPC::JsonContext& context)
+{
+    AccountObjectsRequest request;
+    if (auto error = checkAccountObjects(context, request))
+        return error;
+
+    Json::Value result;
+    writeAccountObjects(result, request);
     return result;
 }
 
+Json::Value
+doAccountObjectsStream(
+    RPC::JsonContext& context,
+    RPC::Handler::ResultWriter& write)
+{
+    auto request = std::make_shared<AccountObjectsRequest>();
+    if (auto error = checkAccountObjects(context, *request))
+        return error;
+
+    write = [request](Json::Object& result) {
+        writeAccountObjects(result, *request);
+    };
+    return Json::Value();
+}
+
 }  // namespace ripple
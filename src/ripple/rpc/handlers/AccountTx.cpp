@@ -24,6 +24,7 @@
 #include <ripple/app/rdb/backend/PostgresDatabase.h>
 #include <ripple/app/rdb/backend/SQLiteDatabase.h>
 #include <ripple/core/Pg.h>
+#include <ripple/json/Object.h>
 #include <ripple/json/json_reader.h>
 #include <ripple/json/json_value.h>
 #include <ripple/ledger/ReadView.h>
@@ -32,9 +33,11 @@
 #include <ripple/protocol/UintTypes.h>
 #include <ripple/protocol/jss.h>
 #include <ripple/resource/Fees.h>
+#include <ripple/rpc/BinaryEncoding.h>
 #include <ripple/rpc/Context.h>
 #include <ripple/rpc/DeliveredAmount.h>
 #include <ripple/rpc/Role.h>
+#include <ripple/rpc/impl/Handler.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
 
 #include <grpcpp/grpcpp.h>
@@ -267,28 +270,22 @@ doAccountTxHelp(RPC::Context& context, AccountTxArgs const& args)
     return {result, rpcSUCCESS};
 }
 
-Json::Value
-populateJsonResponse(
-    std::pair<AccountTxResult, RPC::Status> const& res,
+template <class Object>
+void
+writeAccountTx(
+    Object& response,
+    AccountTxResult const& result,
     AccountTxArgs const& args,
     RPC::JsonContext const& context)
 {
-    Json::Value response;
-    RPC::Status const& error = res.second;
-    if (error.toErrorCode() != rpcSUCCESS)
-    {
-        error.inject(response);
-    }
-    else
-    {
-        AccountTxResult const& result = res.first;
-        response[jss::validated] = true;
-        response[jss::limit] = result.limit;
-        response[jss::account] = context.params[jss::account].asString();
-        response[jss::ledger_index_min] = result.ledgerRange.min;
-        response[jss::ledger_index_max] = result.ledgerRange.max;
+    response[jss::validated] = true;
+    response[jss::limit] = result.limit;
+    response[jss::account] = context.params[jss::account].asString();
+    response[jss::ledger_index_min] = result.ledgerRange.min;
+    response[jss::ledger_index_max] = result.ledgerRange.max;
 
-        Json::Value& jvTxns = (response[jss::transactions] = Json::arrayValue);
+    {
+        auto&& jvTxns = Json::setArray(response, jss::transactions);
 
         if (auto txnsData = std::get_if<TxnsData>(&result.transactions))
         {
@@ -297,16 +294,15 @@ populateJsonResponse(
             {
                 if (txn)
                 {
-                    Json::Value& jvObj = jvTxns.append(Json::objectValue);
+                    auto&& jvObj = Json::appendObject(jvTxns);
 
                     jvObj[jss::tx] = txn->getJson(JsonOptions::include_date);
                     if (txnMeta)
                     {
-                        jvObj[jss::meta] =
-                            txnMeta->getJson(JsonOptions::include_date);
+                        auto meta = txnMeta->getJson(JsonOptions::include_date);
+                        insertDeliveredAmount(meta, context, txn, *txnMeta);
+                        jvObj[jss::meta] = meta;
                         jvObj[jss::validated] = true;
-                        insertDeliveredAmount(
-                            jvObj[jss::meta], context, txn, *txnMeta);
                     }
                 }
             }
@@ -318,7 +314,7 @@ populateJsonResponse(
             for (auto const& binaryData :
                  std::get<TxnsDataBinary>(result.transactions))
             {
-                Json::Value& jvObj = jvTxns.append(Json::objectValue);
+                auto&& jvObj = Json::appendObject(jvTxns);
 
                 jvObj[jss::tx_blob] = strHex(std::get<0>(binaryData));
                 jvObj[jss::meta] = strHex(std::get<1>(binaryData));
@@ -326,16 +322,30 @@ populateJsonResponse(
                 jvObj[jss::validated] = true;
             }
         }
+    }
 
-        if (result.marker)
-        {
-            response[jss::marker] = Json::objectValue;
-            response[jss::marker][jss::ledger] = result.marker->ledgerSeq;
-            response[jss::marker][jss::seq] = result.marker->txnSeq;
-        }
-        if (context.app.config().reporting())
-            response["used_postgres"] = true;
+    if (result.marker)
+    {
+        auto&& marker = Json::addObject(response, jss::marker);
+        marker[jss::ledger] = result.marker->ledgerSeq;
+        marker[jss::seq] = result.marker->txnSeq;
     }
+    if (context.app.config().reporting())
+        response["used_postgres"] = true;
+}
+
+Json::Value
+populateJsonResponse(
+    std::pair<AccountTxResult, RPC::Status> const& res,
+    AccountTxArgs const& args,
+    RPC::JsonContext const& context)
+{
+    Json::Value response;
+    RPC::Status const& error = res.second;
+    if (error.toErrorCode() != rpcSUCCESS)
+        error.inject(response);
+    else
+        writeAccountTx(response, res.first, args, context);
 
     JLOG(context.j.debug()) << __func__ << " : finished";
     return response;
@@ -351,12 +361,9 @@ populateJsonResponse(
 //   marker: object {ledger: ledger_index, seq: txn_sequence} // optional,
 //   resume previous query
 // }
-Json::Value
-doAccountTxJson(RPC::JsonContext& context)
+static std::variant<AccountTxArgs, Json::Value>
+parseAccountTxArgs(RPC::JsonContext& context)
 {
-    if (!context.app.config().useTxTables())
-        return rpcError(rpcNOT_ENABLED);
-
     auto& params = context.params;
     AccountTxArgs args;
     Json::Value response;
@@ -403,9 +410,129 @@ doAccountTxJson(RPC::JsonContext& context)
         args.marker = {token[jss::ledger].asUInt(), token[jss::seq].asUInt()};
     }
 
+    return args;
+}
+
+Json::Value
+doAccountTxJson(RPC::JsonContext& context)
+{
+    if (!context.app.config().useTxTables())
+        return rpcError(rpcNOT_ENABLED);
+
+    auto parsed = parseAccountTxArgs(context);
+    if (auto jv = std::get_if<Json::Value>(&parsed))
+        return *jv;
+    auto const& args = std::get<AccountTxArgs>(parsed);
+
     auto res = doAccountTxHelp(context, args);
     JLOG(context.j.debug()) << __func__ << " populating response";
     return populateJsonResponse(res, args, context);
 }
 
+Json::Value
+doAccountTxStream(
+    RPC::JsonContext& context,
+    RPC::Handler::ResultWriter& write)
+{
+    if (!context.app.config().useTxTables())
+        return rpcError(rpcNOT_ENABLED);
+
+    auto parsed = parseAccountTxArgs(context);
+    if (auto jv = std::get_if<Json::Value>(&parsed))
+        return *jv;
+    auto const& args = std::get<AccountTxArgs>(parsed);
+
+    // The page is still read from the database in full, only writing the
+    // response is streamed.
+    auto res = doAccountTxHelp(context, args);
+    if (res.second.toErrorCode() != rpcSUCCESS)
+        return populateJsonResponse(res, args, context);
+
+    auto result = std::make_shared<AccountTxResult>(std::move(res.first));
+    write = [result, args, &context](Json::Object& response) {
+        writeAccountTx(response, *result, args, context);
+    };
+    return Json::Value();
+}
+
+// Binary payload:
+//   uint160  account
+//   uint32   ledger_index_min
+//   uint32   ledger_index_max
+//   uint32   limit
+//   uint8    1 if a marker follows, else 0
+//   uint32   marker ledger, only if present
+//   uint32   marker seq, only if present
+//   uint32   the number of transactions, each of which is:
+//     uint32   ledger_index
+//     blob     serialized transaction
+//     blob     serialized metadata
+Json::Value
+doAccountTxBinary(RPC::JsonContext& context, Serializer& s)
+{
+    if (!context.app.config().useTxTables())
+        return rpcError(rpcNOT_ENABLED);
+
+    auto parsed = parseAccountTxArgs(context);
+    if (auto jv = std::get_if<Json::Value>(&parsed))
+        return *jv;
+    auto& args = std::get<AccountTxArgs>(parsed);
+    args.binary = true;
+
+    auto res = doAccountTxHelp(context, args);
+    if (res.second.toErrorCode() != rpcSUCCESS)
+        return populateJsonResponse(res, args, context);
+
+    AccountTxResult const& result = res.first;
+    s.addBitString(args.account);
+    s.add32(result.ledgerRange.min);
+    s.add32(result.ledgerRange.max);
+    s.add32(result.limit);
+    s.add8(result.marker ? 1 : 0);
+    if (result.marker)
+    {
+        s.add32(result.marker->ledgerSeq);
+        s.add32(result.marker->txnSeq);
+    }
+
+    if (auto txnsData = std::get_if<TxnsData>(&result.transactions))
+    {
+        std::uint32_t count = 0;
+        for (auto const& [txn, txnMeta] : *txnsData)
+        {
+            if (txn && txnMeta)
+                ++count;
+        }
+        s.add32(count);
+
+        for (auto const& [txn, txnMeta] : *txnsData)
+        {
+            if (!txn || !txnMeta)
+                continue;
+            s.add32(txn->getLedger());
+            Serializer txnBlob;
+            txn->getSTransaction()->add(txnBlob);
+            RPC::addBinaryBlob(s, txnBlob.slice());
+            RPC::addBinaryBlob(
+                s, txnMeta->getAsObject().getSerializer().slice());
+        }
+    }
+    else
+    {
+        auto const& txnsDataBinary =
+            std::get<TxnsDataBinary>(result.transactions);
+        s.add32(static_cast<std::uint32_t>(txnsDataBinary.size()));
+
+        for (auto const& [txnBlob, metaBlob, ledgerIndex] : txnsDataBinary)
+        {
+            s.add32(ledgerIndex);
+            RPC::addBinaryBlob(s, makeSlice(txnBlob));
+            RPC::addBinaryBlob(s, makeSlice(metaBlob));
+        }
+    }
+
+    JLOG(context.j.debug()) << __func__ << " : finished";
+    return Json::Value();
+}
+
 }  // namespace ripple
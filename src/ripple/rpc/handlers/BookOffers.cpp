@@ -17,6 +17,7 @@
 */
 //==============================================================================
 
+#include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/misc/NetworkOPs.h>
 #include <ripple/basics/Log.h>
@@ -26,7 +27,6 @@
 #include <ripple/protocol/UintTypes.h>
 #include <ripple/protocol/jss.h>
 #include <ripple/resource/Fees.h>
-#include <ripple/rpc/BookChanges.h>
 #include <ripple/rpc/Context.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
 
@@ -209,7 +209,7 @@ doBookChanges(RPC::JsonContext& context)
     if (std::holds_alternative<Json::Value>(res))
         return std::get<Json::Value>(res);
 
-    return RPC::computeBookChanges(
+    return *context.ledgerMaster.getBookChanges(
         std::get<std::shared_ptr<Ledger const>>(res));
 }
 
@@ -30,8 +30,10 @@
 #include <ripple/nodestore/Database.h>
 #include <ripple/nodestore/DatabaseShard.h>
 #include <ripple/protocol/ErrorCodes.h>
+#include <ripple/protocol/Serializer.h>
 #include <ripple/protocol/jss.h>
 #include <ripple/rpc/Context.h>
+#include <ripple/shamap/SHAMapItem.h>
 #include <ripple/shamap/ShardFamily.h>
 
 namespace ripple {
@@ -108,7 +110,35 @@ getCountsJson(Application& app, int minObjectCount)
     ret[jss::historical_perminute] =
         static_cast<int>(app.getInboundLedgers().fetchRate());
     ret[jss::SLE_hit_rate] = app.cachedSLEs().rate();
+    {
+        Json::Value& rates = ret[jss::SLE_hit_rates] = Json::objectValue;
+        for (std::size_t i = 0; i < CachedSLEs::callers; ++i)
+        {
+            auto const caller = static_cast<CachedSLEs::Caller>(i);
+            rates[to_string(caller)] = app.cachedSLEs().rate(caller);
+        }
+    }
+    {
+        auto const stats = ScratchSerializer::stats();
+        Json::Value& jv = ret[jss::scratch_serializers] = Json::objectValue;
+        jv[jss::reused] = std::to_string(stats.reused);
+        jv[jss::allocated] = std::to_string(stats.allocated);
+    }
+    {
+        Json::Value& jv = ret[jss::shamapitem_slabs] = Json::objectValue;
+        Json::Value& slabs = jv[jss::slabs] = Json::arrayValue;
+        for (auto const& stats : detail::slabber.stats())
+        {
+            Json::Value& slab = slabs.append(Json::objectValue);
+            slab[jss::size] = Json::UInt(stats.size);
+            slab[jss::slabs] = Json::UInt(stats.slabs);
+            slab[jss::capacity] = std::to_string(stats.capacity);
+            slab[jss::used] = std::to_string(stats.used);
+        }
+        jv[jss::heap] = std::to_string(detail::shamapItemsOnHeap.load());
+    }
     ret[jss::ledger_hit_rate] = app.getLedgerMaster().getCacheHitRate();
+    ret[jss::retained_ledgers] = app.getLedgerMaster().getRetainedLedgersJson();
     ret[jss::AL_size] = Json::UInt(app.getAcceptedLedgerCache().size());
     ret[jss::AL_hit_rate] = app.getAcceptedLedgerCache().getHitRate();
 
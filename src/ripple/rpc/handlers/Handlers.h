@@ -20,6 +20,7 @@
 #ifndef RIPPLE_RPC_HANDLERS_HANDLERS_H_INCLUDED
 #define RIPPLE_RPC_HANDLERS_HANDLERS_H_INCLUDED
 
+#include <ripple/protocol/Serializer.h>
 #include <ripple/rpc/handlers/LedgerHandler.h>
 
 namespace ripple {
@@ -37,12 +38,18 @@ doAccountNFTs(RPC::JsonContext&);
 Json::Value
 doAccountObjects(RPC::JsonContext&);
 Json::Value
+doAccountObjectsStream(RPC::JsonContext&, RPC::Handler::ResultWriter&);
+Json::Value
 doAccountOffers(RPC::JsonContext&);
 Json::Value
 doAccountNamespace(RPC::JsonContext&);
 Json::Value
 doAccountTxJson(RPC::JsonContext&);
 Json::Value
+doAccountTxBinary(RPC::JsonContext&, Serializer&);
+Json::Value
+doAccountTxStream(RPC::JsonContext&, RPC::Handler::ResultWriter&);
+Json::Value
 doBookOffers(RPC::JsonContext&);
 Json::Value
 doBookChanges(RPC::JsonContext&);
@@ -83,8 +90,12 @@ doLedgerCurrent(RPC::JsonContext&);
 Json::Value
 doLedgerData(RPC::JsonContext&);
 Json::Value
+doLedgerDataStream(RPC::JsonContext&, RPC::Handler::ResultWriter&);
+Json::Value
 doLedgerEntry(RPC::JsonContext&);
 Json::Value
+doLedgerEntryBinary(RPC::JsonContext&, Serializer&);
+Json::Value
 doLedgerHeader(RPC::JsonContext&);
 Json::Value
 doLedgerRequest(RPC::JsonContext&);
@@ -153,6 +164,8 @@ doTransactionEntry(RPC::JsonContext&);
 Json::Value
 doTxJson(RPC::JsonContext&);
 Json::Value
+doTxBinary(RPC::JsonContext&, Serializer&);
+Json::Value
 doTxHistory(RPC::JsonContext&);
 Json::Value
 doTxReduceRelay(RPC::JsonContext&);
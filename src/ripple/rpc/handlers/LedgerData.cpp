@@ -17,7 +17,9 @@
 */
 //==============================================================================
 
+#include <ripple/app/ledger/Ledger.h>
 #include <ripple/app/ledger/LedgerToJson.h>
+#include <ripple/json/Object.h>
 #include <ripple/ledger/ReadView.h>
 #include <ripple/protocol/ErrorCodes.h>
 #include <ripple/protocol/LedgerFormats.h>
@@ -25,112 +27,247 @@
 #include <ripple/rpc/Context.h>
 #include <ripple/rpc/GRPCHandlers.h>
 #include <ripple/rpc/Role.h>
+#include <ripple/rpc/impl/Handler.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
 #include <ripple/rpc/impl/Tuning.h>
+#include <algorithm>
+#include <optional>
 
 namespace ripple {
 
-// Get state nodes from a ledger
-//   Inputs:
-//     limit:        integer, maximum number of entries
-//     marker:       opaque, resume point
-//     binary:       boolean, format
-//     type:         string // optional, defaults to all ledger node types
-//   Outputs:
-//     ledger_hash:  chosen ledger's hash
-//     ledger_index: chosen ledger's index
-//     state:        array of state nodes
-//     marker:       resume point, if any
+namespace {
+
+struct LedgerDataRequest
+{
+    std::shared_ptr<ReadView const> ledger;
+
+    // The fields of the result which precede the state nodes.
+    Json::Value head;
+
+    ReadView::key_type key;
+    bool isBinary = false;
+    int limit = -1;
+    LedgerEntryType type = ltANY;
+
+    // The number of threads to walk the state map with.
+    std::size_t parallelism = 1;
+};
+
+// Returns a null value if the request is valid, and the error otherwise.
 Json::Value
-doLedgerData(RPC::JsonContext& context)
+checkLedgerData(RPC::JsonContext& context, LedgerDataRequest& request)
 {
-    std::shared_ptr<ReadView const> lpLedger;
     auto const& params = context.params;
 
-    auto jvResult = RPC::lookupLedger(lpLedger, context);
-    if (!lpLedger)
-        return jvResult;
+    request.head = RPC::lookupLedger(request.ledger, context);
+    if (!request.ledger)
+        return request.head;
 
     bool const isMarker = params.isMember(jss::marker);
-    ReadView::key_type key = ReadView::key_type();
     if (isMarker)
     {
         Json::Value const& jMarker = params[jss::marker];
-        if (!(jMarker.isString() && key.parseHex(jMarker.asString())))
+        if (!(jMarker.isString() && request.key.parseHex(jMarker.asString())))
             return RPC::expected_field_error(jss::marker, "valid");
     }
 
-    bool const isBinary = params[jss::binary].asBool();
+    request.isBinary = params[jss::binary].asBool();
 
-    int limit = -1;
     if (params.isMember(jss::limit))
     {
         Json::Value const& jLimit = params[jss::limit];
         if (!jLimit.isIntegral())
             return RPC::expected_field_error(jss::limit, "integer");
 
-        limit = jLimit.asInt();
+        request.limit = jLimit.asInt();
     }
 
-    auto maxLimit = RPC::Tuning::pageLength(isBinary);
-    if ((limit < 0) || ((limit > maxLimit) && (!isUnlimited(context.role))))
-        limit = maxLimit;
-
-    jvResult[jss::ledger_hash] = to_string(lpLedger->info().hash);
-    jvResult[jss::ledger_index] = lpLedger->info().seq;
-
-    if (!isMarker)
-    {
-        // Return base ledger data on first query
-        jvResult[jss::ledger] = getJson(LedgerFill(
-            *lpLedger, &context, isBinary ? LedgerFill::Options::binary : 0));
-    }
+    auto maxLimit = RPC::Tuning::pageLength(request.isBinary);
+    if ((request.limit < 0) ||
+        ((request.limit > maxLimit) && (!isUnlimited(context.role))))
+        request.limit = maxLimit;
 
     auto [rpcStatus, type] = RPC::chooseLedgerEntryType(params);
     if (rpcStatus)
     {
-        jvResult.clear();
+        Json::Value jvResult;
         rpcStatus.inject(jvResult);
         return jvResult;
     }
-    Json::Value& nodes = jvResult[jss::state];
-    if (nodes.type() == Json::nullValue)
+    request.type = type;
+
+    // Walking the state map on several threads is only offered to admins,
+    // whose full-ledger dumps are what it speeds up.
+    if (params.isMember(jss::parallelism) && context.role == Role::ADMIN)
     {
-        nodes = Json::Value(Json::arrayValue);
+        Json::Value const& jParallelism = params[jss::parallelism];
+        if (!jParallelism.isIntegral())
+            return RPC::expected_field_error(jss::parallelism, "integer");
+
+        request.parallelism = std::clamp(
+            jParallelism.asInt(), 1, RPC::Tuning::maxLedgerDataParallelism);
     }
 
-    auto e = lpLedger->sles.end();
-    for (auto i = lpLedger->sles.upper_bound(key); i != e; ++i)
+    auto& head = request.head;
+    auto const& ledger = *request.ledger;
+    head[jss::ledger_hash] = to_string(ledger.info().hash);
+    head[jss::ledger_index] = ledger.info().seq;
+
+    if (!isMarker)
+    {
+        // Return base ledger data on first query
+        head[jss::ledger] = getJson(LedgerFill(
+            ledger,
+            &context,
+            request.isBinary ? LedgerFill::Options::binary : 0));
+    }
+
+    return Json::Value();
+}
+
+template <class Object>
+void
+writeLedgerData(Object& result, LedgerDataRequest const& request)
+{
+    auto const& ledger = *request.ledger;
+    auto limit = request.limit;
+
+    Json::copyFrom(result, request.head);
+
+    std::optional<ReadView::key_type> marker;
     {
-        auto sle = lpLedger->read(keylet::unchecked((*i)->key()));
-        if (limit-- <= 0)
+        auto&& nodes = Json::setArray(result, jss::state);
+
+        auto const fullLedger = request.parallelism > 1
+            ? dynamic_cast<Ledger const*>(&ledger)
+            : nullptr;
+        if (fullLedger)
         {
-            // Stop processing before the current key.
-            auto k = sle->key();
-            jvResult[jss::marker] = to_string(--k);
-            break;
-        }
+            // Build the entries on the walking threads, and append them
+            // here in key order.
+            auto prepare = [&request](SHAMapItem const& item) {
+                Json::Value entry;
+
+                // Binary entries are only decoded to filter them by type
+                if (request.isBinary && request.type == ltANY)
+                {
+                    entry[jss::data] = strHex(item.slice());
+                }
+                else
+                {
+                    SLE const sle{SerialIter{item.slice()}, item.key()};
+                    if (request.type != ltANY && sle.getType() != request.type)
+                        return entry;
+
+                    if (request.isBinary)
+                        entry[jss::data] = strHex(item.slice());
+                    else
+                        entry = sle.getJson(JsonOptions::none);
+                }
+                entry[jss::index] = to_string(item.key());
+                return entry;
+            };
+
+            auto visit = [&](SHAMapItem const& item, Json::Value&& entry) {
+                if (limit-- <= 0)
+                {
+                    // Stop processing before the current key.
+                    auto k = item.key();
+                    marker = --k;
+                    return false;
+                }
 
-        if (type == ltANY || sle->getType() == type)
+                if (!entry.isNull())
+                    nodes.append(std::move(entry));
+                return true;
+            };
+
+            // One entry past the limit is walked, to place the marker.
+            fullLedger->stateMap().visitLeavesParallel(
+                request.key,
+                static_cast<std::size_t>(limit) + 1,
+                request.parallelism,
+                prepare,
+                visit);
+        }
+        else
         {
-            if (isBinary)
-            {
-                Json::Value& entry = nodes.append(Json::objectValue);
-                entry[jss::data] = serializeHex(*sle);
-                entry[jss::index] = to_string(sle->key());
-            }
-            else
+            auto e = ledger.sles.end();
+            for (auto i = ledger.sles.upper_bound(request.key); i != e; ++i)
             {
-                Json::Value& entry =
-                    nodes.append(sle->getJson(JsonOptions::none));
-                entry[jss::index] = to_string(sle->key());
+                auto sle = ledger.read(keylet::unchecked((*i)->key()));
+                if (limit-- <= 0)
+                {
+                    // Stop processing before the current key.
+                    auto k = sle->key();
+                    marker = --k;
+                    break;
+                }
+
+                if (request.type == ltANY || sle->getType() == request.type)
+                {
+                    if (request.isBinary)
+                    {
+                        auto&& entry = Json::appendObject(nodes);
+                        entry[jss::data] = serializeHex(*sle);
+                        entry[jss::index] = to_string(sle->key());
+                    }
+                    else
+                    {
+                        auto entry = sle->getJson(JsonOptions::none);
+                        entry[jss::index] = to_string(sle->key());
+                        nodes.append(std::move(entry));
+                    }
+                }
             }
         }
     }
 
+    if (marker)
+        result[jss::marker] = to_string(*marker);
+}
+
+}  // namespace
+
+// Get state nodes from a ledger
+//   Inputs:
+//     limit:        integer, maximum number of entries
+//     marker:       opaque, resume point
+//     binary:       boolean, format
+//     type:         string // optional, defaults to all ledger node types
+//     parallelism:  integer // optional, admin only, threads to walk with
+//   Outputs:
+//     ledger_hash:  chosen ledger's hash
+//     ledger_index: chosen ledger's index
+//     state:        array of state nodes
+//     marker:       resume point, if any
+Json::Value
+doLedgerData(RPC::JsonContext& context)
+{
+    LedgerDataRequest request;
+    if (auto error = checkLedgerData(context, request))
+        return error;
+
+    Json::Value jvResult;
+    writeLedgerData(jvResult, request);
     return jvResult;
 }
 
+Json::Value
+doLedgerDataStream(
+    RPC::JsonContext& context,
+    RPC::Handler::ResultWriter& write)
+{
+    auto request = std::make_shared<LedgerDataRequest>();
+    if (auto error = checkLedgerData(context, *request))
+        return error;
+
+    write = [request](Json::Object& result) {
+        writeLedgerData(result, *request);
+    };
+    return Json::Value();
+}
+
 std::pair<org::xrpl::rpc::v1::GetLedgerDataResponse, grpc::Status>
 doLedgerDataGrpc(
     RPC::GRPCContext<org::xrpl::rpc::v1::GetLedgerDataRequest>& context)
@@ -26,30 +26,28 @@
 #include <ripple/protocol/Indexes.h>
 #include <ripple/protocol/PublicKey.h>
 #include <ripple/protocol/jss.h>
+#include <ripple/rpc/BinaryEncoding.h>
 #include <ripple/rpc/Context.h>
 #include <ripple/rpc/GRPCHandlers.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
 
 namespace ripple {
 
-// {
-//   ledger_hash : <ledger>
-//   ledger_index : <ledger_index>
-//   ...
-// }
-Json::Value
-doLedgerEntry(RPC::JsonContext& context)
+// Look up the ledger and work out the key of the requested entry. If the
+// ledger can not be found, or the request is malformed, the returned value
+// holds the error.
+static Json::Value
+parseLedgerEntryRequest(
+    RPC::JsonContext& context,
+    std::shared_ptr<ReadView const>& lpLedger,
+    uint256& uNodeIndex,
+    LedgerEntryType& expectedType)
 {
-    std::shared_ptr<ReadView const> lpLedger;
     auto jvResult = RPC::lookupLedger(lpLedger, context);
 
     if (!lpLedger)
         return jvResult;
 
-    uint256 uNodeIndex;
-    bool bNodeBinary = false;
-    LedgerEntryType expectedType = ltANY;
-
     if (context.params.isMember(jss::index))
     {
         if (!uNodeIndex.parseHex(context.params[jss::index].asString()))
@@ -523,6 +521,28 @@ doLedgerEntry(RPC::JsonContext& context)
             jvResult[jss::error] = "unknownOption";
     }
 
+    return jvResult;
+}
+
+// {
+//   ledger_hash : <ledger>
+//   ledger_index : <ledger_index>
+//   ...
+// }
+Json::Value
+doLedgerEntry(RPC::JsonContext& context)
+{
+    std::shared_ptr<ReadView const> lpLedger;
+    uint256 uNodeIndex;
+    bool bNodeBinary = false;
+    LedgerEntryType expectedType = ltANY;
+
+    auto jvResult =
+        parseLedgerEntryRequest(context, lpLedger, uNodeIndex, expectedType);
+
+    if (!lpLedger)
+        return jvResult;
+
     if (uNodeIndex.isNonZero())
     {
         auto const sleNode = lpLedger->read(keylet::unchecked(uNodeIndex));
@@ -558,6 +578,51 @@ doLedgerEntry(RPC::JsonContext& context)
     return jvResult;
 }
 
+// Binary payload:
+//   uint32   ledger_index
+//   hash256  ledger_hash
+//   uint8    validated
+//   hash256  index
+//   blob     serialized ledger entry
+Json::Value
+doLedgerEntryBinary(RPC::JsonContext& context, Serializer& s)
+{
+    std::shared_ptr<ReadView const> lpLedger;
+    uint256 uNodeIndex;
+    LedgerEntryType expectedType = ltANY;
+
+    auto jvResult =
+        parseLedgerEntryRequest(context, lpLedger, uNodeIndex, expectedType);
+
+    // Requests which do not name an entry are answered as doLedgerEntry
+    // answers them.
+    if (!lpLedger || jvResult.isMember(jss::error) || uNodeIndex.isZero())
+        return jvResult;
+
+    auto const sleNode = lpLedger->read(keylet::unchecked(uNodeIndex));
+    if (!sleNode)
+    {
+        jvResult[jss::error] = "entryNotFound";
+        return jvResult;
+    }
+    if ((expectedType != ltANY) && (expectedType != sleNode->getType()))
+    {
+        jvResult[jss::error] = "unexpectedLedgerType";
+        return jvResult;
+    }
+
+    s.add32(lpLedger->info().seq);
+    s.addBitString(lpLedger->info().hash);
+    s.add8(jvResult[jss::validated].asBool() ? 1 : 0);
+    s.addBitString(uNodeIndex);
+
+    Serializer node;
+    sleNode->add(node);
+    RPC::addBinaryBlob(s, node.slice());
+
+    return Json::Value();
+}
+
 std::pair<org::xrpl::rpc::v1::GetLedgerEntryResponse, grpc::Status>
 doLedgerEntryGrpc(
     RPC::GRPCContext<org::xrpl::rpc::v1::GetLedgerEntryRequest>& context)
@@ -188,7 +188,7 @@ doSubmit(RPC::JsonContext& context)
     {
         jvResult[jss::tx_json] = tpTrans->getJson(JsonOptions::none);
         jvResult[jss::tx_blob] =
-            strHex(tpTrans->getSTransaction()->getSerializer().peekData());
+            strHex(tpTrans->getSTransaction()->getSerialized());
 
         if (temUNCERTAIN != tpTrans->getResult())
         {
@@ -25,6 +25,7 @@
 #include <ripple/net/RPCErr.h>
 #include <ripple/protocol/ErrorCodes.h>
 #include <ripple/protocol/jss.h>
+#include <ripple/rpc/BinaryEncoding.h>
 #include <ripple/rpc/CTID.h>
 #include <ripple/rpc/Context.h>
 #include <ripple/rpc/DeliveredAmount.h>
@@ -340,14 +341,10 @@ populateJsonResponse(
     return response;
 }
 
-Json::Value
-doTxJson(RPC::JsonContext& context)
+// Deserialize and validate JSON arguments
+static std::variant<TxArgs, Json::Value>
+parseTxArgs(RPC::JsonContext& context)
 {
-    if (!context.app.config().useTxTables())
-        return rpcError(rpcNOT_ENABLED);
-
-    // Deserialize and validate JSON arguments
-
     TxArgs args;
 
     if (context.params.isMember(jss::transaction) &&
@@ -401,8 +398,78 @@ doTxJson(RPC::JsonContext& context)
         }
     }
 
+    return args;
+}
+
+Json::Value
+doTxJson(RPC::JsonContext& context)
+{
+    if (!context.app.config().useTxTables())
+        return rpcError(rpcNOT_ENABLED);
+
+    auto parsed = parseTxArgs(context);
+    if (auto jv = std::get_if<Json::Value>(&parsed))
+        return *jv;
+    auto const& args = std::get<TxArgs>(parsed);
+
     std::pair<TxResult, RPC::Status> res = doTxHelp(context, args);
     return populateJsonResponse(res, args, context);
 }
 
+// Binary payload:
+//   uint8   validated
+//   uint32  ledger_index, zero if not in a ledger yet
+//   uint32  close time of the ledger, zero if unknown
+//   blob    serialized transaction
+//   blob    serialized metadata, empty if unavailable
+Json::Value
+doTxBinary(RPC::JsonContext& context, Serializer& s)
+{
+    if (!context.app.config().useTxTables())
+        return rpcError(rpcNOT_ENABLED);
+
+    auto parsed = parseTxArgs(context);
+    if (auto jv = std::get_if<Json::Value>(&parsed))
+        return *jv;
+    auto& args = std::get<TxArgs>(parsed);
+    args.binary = true;
+
+    std::pair<TxResult, RPC::Status> res = doTxHelp(context, args);
+    TxResult const& result = res.first;
+    if (res.second.toErrorCode() != rpcSUCCESS || !result.txn)
+        return populateJsonResponse(res, args, context);
+
+    auto const ledgerIndex = result.txn->getLedger();
+    std::uint32_t closeTime = 0;
+    if (ledgerIndex != 0)
+    {
+        auto const ct = context.ledgerMaster.getCloseTimeBySeq(ledgerIndex);
+        if (ct)
+            closeTime = ct->time_since_epoch().count();
+    }
+
+    s.add8(result.validated ? 1 : 0);
+    s.add32(ledgerIndex);
+    s.add32(closeTime);
+
+    Serializer txn;
+    result.txn->getSTransaction()->add(txn);
+    RPC::addBinaryBlob(s, txn.slice());
+
+    if (auto blob = std::get_if<Blob>(&result.meta))
+    {
+        RPC::addBinaryBlob(s, makeSlice(*blob));
+    }
+    else if (auto const& m = std::get<std::shared_ptr<TxMeta>>(result.meta))
+    {
+        RPC::addBinaryBlob(s, m->getAsObject().getSerializer().slice());
+    }
+    else
+    {
+        RPC::addBinaryBlob(s, Slice{});
+    }
+
+    return Json::Value();
+}
+
 }  // namespace ripple
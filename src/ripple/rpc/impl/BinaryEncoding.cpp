@@ -0,0 +1,118 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2019 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/json/json_value.h>
+#include <ripple/json/to_string.h>
+#include <ripple/ledger/ReadView.h>
+#include <ripple/protocol/STTx.h>
+#include <ripple/protocol/jss.h>
+#include <ripple/rpc/BinaryEncoding.h>
+#include <cassert>
+
+namespace ripple {
+namespace RPC {
+
+void
+addBinaryHeader(Serializer& s, BinaryMessage type)
+{
+    s.add8(binaryEncodingVersion);
+    s.add8(static_cast<std::uint8_t>(type));
+}
+
+void
+addBinaryBlob(Serializer& s, Slice data)
+{
+    s.add32(static_cast<std::uint32_t>(data.size()));
+    s.addRaw(data);
+}
+
+void
+addBinaryResponseHeader(Serializer& s, Json::Value const& request)
+{
+    addBinaryHeader(s, BinaryMessage::response);
+    s.add8(0);
+
+    std::string id;
+    if (request.isMember(jss::id))
+        id = to_string(request[jss::id]);
+    addBinaryBlob(s, makeSlice(id));
+
+    addBinaryBlob(
+        s,
+        makeSlice(
+            request.isMember(jss::command)
+                ? request[jss::command].asString()
+                : request[jss::method].asString()));
+}
+
+void
+setBinaryResponseFlags(Serializer& s, std::uint8_t flags)
+{
+    // The flags follow the two byte header
+    assert(s.getDataLength() > 2);
+    s.modData()[2] |= flags;
+}
+
+void
+addBinaryLedgerClosed(
+    Serializer& s,
+    ReadView const& ledger,
+    std::uint32_t txnCount,
+    std::string const& validatedLedgers)
+{
+    auto const& info = ledger.info();
+    auto const& fees = ledger.fees();
+
+    addBinaryHeader(s, BinaryMessage::ledgerClosed);
+    s.add32(info.seq);
+    s.addBitString(info.hash);
+    s.add32(info.closeTime.time_since_epoch().count());
+    s.add64(fees.base.drops());
+    s.add64(fees.accountReserve(0).drops());
+    s.add64(fees.increment.drops());
+    s.add32(txnCount);
+    addBinaryBlob(s, makeSlice(validatedLedgers));
+}
+
+void
+addBinaryTransaction(
+    Serializer& s,
+    ReadView const& ledger,
+    STTx const& tx,
+    TER result,
+    bool validated,
+    Slice meta)
+{
+    auto const& info = ledger.info();
+
+    addBinaryHeader(s, BinaryMessage::transaction);
+    s.add8(validated ? 1 : 0);
+    s.add32(info.seq);
+    s.addBitString(validated ? info.hash : uint256{});
+    s.add32(validated ? info.closeTime.time_since_epoch().count() : 0);
+    s.add32(static_cast<std::uint32_t>(TERtoInt(result)));
+
+    Serializer txn;
+    tx.add(txn);
+    addBinaryBlob(s, txn.slice());
+    addBinaryBlob(s, meta);
+}
+
+}  // namespace RPC
+}  // namespace ripple
@@ -57,6 +57,23 @@ handle(JsonContext& context, Object& object)
     return status;
 };
 
+template <class HandlerImpl>
+Json::Value
+stream(JsonContext& context, Handler::ResultWriter& write)
+{
+    auto handler = std::make_shared<HandlerImpl>(context);
+
+    if (auto status = handler->check())
+    {
+        Json::Value error;
+        status.inject(error);
+        return error;
+    }
+
+    write = [handler](Json::Object& object) { handler->writeResult(object); };
+    return Json::Value();
+}
+
 Handler const handlerArray[]{
     // Some handlers not specified here are added to the table via addHandler()
     // Request-response methods
@@ -69,9 +86,19 @@ Handler const handlerArray[]{
     {"account_namespace", byRef(&doAccountNamespace), Role::USER, NO_CONDITION},
     {"account_channels", byRef(&doAccountChannels), Role::USER, NO_CONDITION},
     {"account_nfts", byRef(&doAccountNFTs), Role::USER, NO_CONDITION},
-    {"account_objects", byRef(&doAccountObjects), Role::USER, NO_CONDITION},
+    {"account_objects",
+     byRef(&doAccountObjects),
+     Role::USER,
+     NO_CONDITION,
+     {},
+     &doAccountObjectsStream},
     {"account_offers", byRef(&doAccountOffers), Role::USER, NO_CONDITION},
-    {"account_tx", byRef(&doAccountTxJson), Role::USER, NO_CONDITION},
+    {"account_tx",
+     byRef(&doAccountTxJson),
+     Role::USER,
+     NO_CONDITION,
+     &doAccountTxBinary,
+     &doAccountTxStream},
     {"blacklist", byRef(&doBlackList), Role::ADMIN, NO_CONDITION},
     {"book_changes", byRef(&doBookChanges), Role::USER, NO_CONDITION},
     {"book_offers", byRef(&doBookOffers), Role::USER, NO_CONDITION},
@@ -107,8 +134,17 @@ Handler const handlerArray[]{
      byRef(&doLedgerCurrent),
      Role::USER,
      NEEDS_CURRENT_LEDGER},
-    {"ledger_data", byRef(&doLedgerData), Role::USER, NO_CONDITION},
-    {"ledger_entry", byRef(&doLedgerEntry), Role::USER, NO_CONDITION},
+    {"ledger_data",
+     byRef(&doLedgerData),
+     Role::USER,
+     NO_CONDITION,
+     {},
+     &doLedgerDataStream},
+    {"ledger_entry",
+     byRef(&doLedgerEntry),
+     Role::USER,
+     NO_CONDITION,
+     &doLedgerEntryBinary},
     {"ledger_header", byRef(&doLedgerHeader), Role::USER, NO_CONDITION},
     {"ledger_request", byRef(&doLedgerRequest), Role::ADMIN, NO_CONDITION},
     {"log_level", byRef(&doLogLevel), Role::ADMIN, NO_CONDITION},
@@ -156,7 +192,11 @@ Handler const handlerArray[]{
     {"crawl_shards", byRef(&doCrawlShards), Role::ADMIN, NO_CONDITION},
     {"stop", byRef(&doStop), Role::ADMIN, NO_CONDITION},
     {"transaction_entry", byRef(&doTransactionEntry), Role::USER, NO_CONDITION},
-    {"tx", byRef(&doTxJson), Role::USER, NEEDS_NETWORK_CONNECTION},
+    {"tx",
+     byRef(&doTxJson),
+     Role::USER,
+     NEEDS_NETWORK_CONNECTION,
+     &doTxBinary},
     {"tx_history", byRef(&doTxHistory), Role::USER, NO_CONDITION},
     {"tx_reduce_relay", byRef(&doTxReduceRelay), Role::USER, NO_CONDITION},
     {"unl_list", byRef(&doUnlList), Role::ADMIN, NO_CONDITION},
@@ -192,6 +232,9 @@ private:
         // This is where the new-style handlers are added.
         addHandler<LedgerHandler>();
         addHandler<VersionHandler>();
+
+        // A full or expanded ledger can be very large.
+        table_[LedgerHandler::name()].streamMethod_ = &stream<LedgerHandler>;
     }
 
 public:
@@ -23,6 +23,7 @@
 #include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/misc/NetworkOPs.h>
 #include <ripple/core/Config.h>
+#include <ripple/protocol/Serializer.h>
 #include <ripple/rpc/RPCHandler.h>
 #include <ripple/rpc/Status.h>
 #include <ripple/rpc/impl/Tuning.h>
@@ -48,10 +49,33 @@ struct Handler
     template <class JsonValue>
     using Method = std::function<Status(JsonContext&, JsonValue&)>;
 
+    /** Appends the binary payload of a response (see BinaryEncoding.h).
+
+        Returns a null value on success, or the JSON error to send
+        instead, in which case anything appended is discarded.
+    */
+    using BinaryMethod = std::function<Json::Value(JsonContext&, Serializer&)>;
+
+    /** Writes the result of a request to a streaming Json::Object. */
+    using ResultWriter = std::function<void(Json::Object&)>;
+
+    /** Prepares a response which is written as it is sent (see
+        ResponseStream.h).
+
+        Validates the request and, on success, sets the ResultWriter and
+        returns a null value. Otherwise returns the JSON error to send
+        instead. Nothing is sent to the client before the writer is
+        called, so errors found here are reported as usual.
+    */
+    using StreamMethod =
+        std::function<Json::Value(JsonContext&, ResultWriter&)>;
+
     const char* name_;
     Method<Json::Value> valueMethod_;
     Role role_;
     RPC::Condition condition_;
+    BinaryMethod binaryMethod_ = {};
+    StreamMethod streamMethod_ = {};
 };
 
 Handler const*
@@ -30,6 +30,7 @@
 #include <ripple/core/JobQueue.h>
 #include <ripple/json/Object.h>
 #include <ripple/json/to_string.h>
+#include <ripple/ledger/CachedSLEs.h>
 #include <ripple/net/InfoSub.h>
 #include <ripple/net/RPCErr.h>
 #include <ripple/protocol/ErrorCodes.h>
@@ -190,6 +191,7 @@ callMethod(
     static std::atomic<std::uint64_t> requestId{0};
     auto& perfLog = context.app.getPerfLog();
     std::uint64_t const curId = ++requestId;
+    CachedSLEs::Scope const scope(CachedSLEs::Caller::rpc);
     try
     {
         perfLog.rpcStart(name, curId);
@@ -293,6 +295,69 @@ doCommand(RPC::JsonContext& context, Json::Value& result)
     return rpcUNKNOWN_COMMAND;
 }
 
+bool
+doCommandBinary(
+    RPC::JsonContext& context,
+    Json::Value& result,
+    Serializer& binary)
+{
+    Handler const* handler = nullptr;
+    if (shouldForwardToP2p(context) || fillHandler(context, handler) ||
+        !handler->binaryMethod_)
+    {
+        doCommand(context, result);
+        return false;
+    }
+
+    auto const method = [&binary, handler](
+                            JsonContext& context, Json::Value& result) {
+        result = handler->binaryMethod_(context, binary);
+        return Status();
+    };
+    callMethod(context, method, handler->name_, result);
+
+    // Errors, and requests proxied to a p2p server, are answered in JSON.
+    return result.isNull();
+}
+
+bool
+doCommandStreamed(
+    RPC::JsonContext& context,
+    Json::Value& result,
+    std::function<Json::Object&()> const& begin)
+{
+    // Streamed replies order the fields of an object as they are written,
+    // not by name, so only clients that ask for them get them.
+    bool const wanted = context.params.isMember(jss::streamed) &&
+        context.params[jss::streamed].isBool() &&
+        context.params[jss::streamed].asBool();
+
+    Handler const* handler = nullptr;
+    if (!wanted || context.app.config().reporting() ||
+        shouldForwardToP2p(context) || fillHandler(context, handler) ||
+        !handler->streamMethod_)
+    {
+        doCommand(context, result);
+        return false;
+    }
+
+    bool streamed = false;
+    auto const method = [&begin, &streamed, handler](
+                            JsonContext& context, Json::Value& result) {
+        Handler::ResultWriter write;
+        result = handler->streamMethod_(context, write);
+        if (write)
+        {
+            streamed = true;
+            write(begin());
+        }
+        return Status();
+    };
+    callMethod(context, method, handler->name_, result);
+
+    return streamed;
+}
+
 Role
 roleRequired(unsigned int version, bool betaEnabled, std::string const& method)
 {
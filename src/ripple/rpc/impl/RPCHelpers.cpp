@@ -151,14 +151,15 @@ isRelatedToAccount(
 }
 
 bool
-getAccountObjects(
+forEachAccountObject(
     ReadView const& ledger,
     AccountID const& account,
     std::optional<std::vector<LedgerEntryType>> const& typeFilter,
     uint256 dirIndex,
     uint256 entryIndex,
     std::uint32_t const limit,
-    Json::Value& jvResult)
+    std::function<void(std::shared_ptr<SLE const> const&)> const& visit,
+    std::optional<std::string>& marker)
 {
     auto typeMatchesFilter = [](std::vector<LedgerEntryType> const& typeFilter,
                                 LedgerEntryType ledgerType) {
@@ -185,8 +186,6 @@ getAccountObjects(
             iterateNFTPages = false;
     }
 
-    auto& jvObjects = (jvResult[jss::account_objects] = Json::arrayValue);
-
     // this is a mutable version of limit, used to seemlessly switch
     // to iterating directory entries when nftokenpages are exhausted
     uint32_t mlimit = limit;
@@ -208,7 +207,7 @@ getAccountObjects(
 
         while (cp)
         {
-            jvObjects.append(cp->getJson(JsonOptions::none));
+            visit(cp);
             auto const npm = (*cp)[~sfNextPageMin];
             if (npm)
                 cp = ledger.read(Keylet(ltNFTOKEN_PAGE, *npm));
@@ -219,8 +218,7 @@ getAccountObjects(
             {
                 if (cp)
                 {
-                    jvResult[jss::limit] = limit;
-                    jvResult[jss::marker] = std::string("0,") + to_string(ck);
+                    marker = std::string("0,") + to_string(ck);
                     return true;
                 }
             }
@@ -274,9 +272,7 @@ getAccountObjects(
         // response.  Check for that condition.
         if (i == mlimit && mlimit < limit)
         {
-            jvResult[jss::limit] = limit;
-            jvResult[jss::marker] =
-                to_string(dirIndex) + ',' + to_string(*iter);
+            marker = to_string(dirIndex) + ',' + to_string(*iter);
             return true;
         }
 
@@ -287,16 +283,14 @@ getAccountObjects(
             if (!typeFilter.has_value() ||
                 typeMatchesFilter(typeFilter.value(), sleNode->getType()))
             {
-                jvObjects.append(sleNode->getJson(JsonOptions::none));
+                visit(sleNode);
             }
 
             if (++i == mlimit)
             {
                 if (++iter != entries.end())
                 {
-                    jvResult[jss::limit] = limit;
-                    jvResult[jss::marker] =
-                        to_string(dirIndex) + ',' + to_string(*iter);
+                    marker = to_string(dirIndex) + ',' + to_string(*iter);
                     return true;
                 }
 
@@ -318,9 +312,7 @@ getAccountObjects(
             auto const& e = dir->getFieldV256(sfIndexes);
             if (!e.empty())
             {
-                jvResult[jss::limit] = limit;
-                jvResult[jss::marker] =
-                    to_string(dirIndex) + ',' + to_string(*e.begin());
+                marker = to_string(dirIndex) + ',' + to_string(*e.begin());
             }
 
             return true;
@@ -328,6 +320,39 @@ getAccountObjects(
     }
 }
 
+bool
+getAccountObjects(
+    ReadView const& ledger,
+    AccountID const& account,
+    std::optional<std::vector<LedgerEntryType>> const& typeFilter,
+    uint256 dirIndex,
+    uint256 entryIndex,
+    std::uint32_t const limit,
+    Json::Value& jvResult)
+{
+    auto& jvObjects = (jvResult[jss::account_objects] = Json::arrayValue);
+
+    std::optional<std::string> marker;
+    auto const found = forEachAccountObject(
+        ledger,
+        account,
+        typeFilter,
+        dirIndex,
+        entryIndex,
+        limit,
+        [&jvObjects](std::shared_ptr<SLE const> const& sle) {
+            jvObjects.append(sle->getJson(JsonOptions::none));
+        },
+        marker);
+
+    if (marker)
+    {
+        jvResult[jss::limit] = limit;
+        jvResult[jss::marker] = std::move(*marker);
+    }
+    return found;
+}
+
 bool
 getAccountNamespace(
     ReadView const& ledger,
@@ -29,6 +29,7 @@
 #include <ripple/rpc/Context.h>
 #include <ripple/rpc/Status.h>
 #include <ripple/rpc/impl/Tuning.h>
+#include <functional>
 #include <optional>
 #include <org/xrpl/rpc/v1/xrp_ledger.pb.h>
 #include <variant>
@@ -91,6 +92,27 @@ isRelatedToAccount(
     std::shared_ptr<SLE const> const& sle,
     AccountID const& accountID);
 
+/** Visits the objects owned by an account in a ledger.
+
+    Objects are visited in the order getAccountObjects returns them, and
+    the parameters have the same meaning.
+
+    @param visit Called with each object that passes the type filter.
+    @param marker Set to the point to resume from if the limit was reached
+                  before every object was visited.
+    @return `false` if the starting entry could not be found.
+*/
+bool
+forEachAccountObject(
+    ReadView const& ledger,
+    AccountID const& account,
+    std::optional<std::vector<LedgerEntryType>> const& typeFilter,
+    uint256 dirIndex,
+    uint256 entryIndex,
+    std::uint32_t const limit,
+    std::function<void(std::shared_ptr<SLE const> const&)> const& visit,
+    std::optional<std::string>& marker);
+
 /** Gathers all objects for an account in a ledger.
     @param ledger Ledger to search account objects.
     @param account AccountID to find objects for.
@@ -0,0 +1,398 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2019 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/rpc/ResponseStream.h>
+#include <ripple/server/Writer.h>
+#include <ripple/server/impl/JSONRPCUtil.h>
+#include <boost/asio/buffer.hpp>
+#include <boost/logic/tribool.hpp>
+#include <array>
+#include <charconv>
+
+namespace ripple {
+namespace RPC {
+
+ResponseStream::ResponseStream(std::shared_ptr<JobQueue::Coro> coro)
+    : coro_(std::move(coro))
+{
+}
+
+void
+ResponseStream::write(boost::beast::string_view data)
+{
+    pending_.append(data.data(), data.size());
+    size_ += data.size();
+    if (pending_.size() >= chunkSize)
+        flush();
+}
+
+Json::Output
+ResponseStream::output()
+{
+    return [this](boost::beast::string_view const& data) { write(data); };
+}
+
+void
+ResponseStream::flush()
+{
+    std::function<void(void)> resume;
+    bool suspend = false;
+    {
+        std::lock_guard lock(mutex_);
+        if (abandoned_ || finished_)
+        {
+            pending_.clear();
+            return;
+        }
+        queued_ += pending_.size();
+        chunks_.push_back(std::move(pending_));
+        pending_.clear();
+        resume = std::move(resume_);
+        resume_ = nullptr;
+        suspend = suspended_ = queued_ > highWater;
+    }
+
+    if (resume)
+        resume();
+
+    if (!suspend)
+        return;
+
+    if (coro_)
+    {
+        // resumeProducer() may already have posted the coroutine; the
+        // job waits for it to yield.
+        coro_->yield();
+        return;
+    }
+
+    std::unique_lock lock(mutex_);
+    cv_.wait(lock, [this] { return !suspended_; });
+}
+
+void
+ResponseStream::finish()
+{
+    std::function<void(void)> resume;
+    {
+        std::lock_guard lock(mutex_);
+        if (!abandoned_ && !finished_ && !pending_.empty())
+        {
+            queued_ += pending_.size();
+            chunks_.push_back(std::move(pending_));
+        }
+        pending_.clear();
+        finished_ = true;
+        resume = std::move(resume_);
+        resume_ = nullptr;
+    }
+
+    if (resume)
+        resume();
+}
+
+void
+ResponseStream::abort()
+{
+    std::function<void(void)> resume;
+    {
+        std::lock_guard lock(mutex_);
+        pending_.clear();
+        chunks_.clear();
+        queued_ = 0;
+        finished_ = true;
+        aborted_ = true;
+        resume = std::move(resume_);
+        resume_ = nullptr;
+    }
+
+    if (resume)
+        resume();
+}
+
+ResponseStream::Next
+ResponseStream::next(
+    std::string& chunk,
+    std::function<void(void)> const& resume)
+{
+    std::lock_guard lock(mutex_);
+    if (aborted_)
+        return Next::aborted;
+    if (chunks_.empty())
+    {
+        if (finished_)
+            return Next::done;
+        resume_ = resume;
+        return Next::wait;
+    }
+    chunk = std::move(chunks_.front());
+    chunks_.pop_front();
+    return finished_ && chunks_.empty() ? Next::last : Next::chunk;
+}
+
+void
+ResponseStream::sent(std::size_t bytes)
+{
+    bool wake = false;
+    {
+        std::lock_guard lock(mutex_);
+        queued_ -= std::min(bytes, queued_);
+        if (suspended_ && queued_ <= lowWater)
+        {
+            suspended_ = false;
+            wake = true;
+        }
+    }
+
+    if (wake)
+        resumeProducer();
+}
+
+void
+ResponseStream::abandon()
+{
+    // Destroyed outside the lock, it may own the connection.
+    std::function<void(void)> resume;
+    bool wake = false;
+    {
+        std::lock_guard lock(mutex_);
+        abandoned_ = true;
+        chunks_.clear();
+        queued_ = 0;
+        resume = std::move(resume_);
+        resume_ = nullptr;
+        wake = suspended_;
+        suspended_ = false;
+    }
+
+    if (wake)
+        resumeProducer();
+}
+
+void
+ResponseStream::resumeProducer()
+{
+    if (!coro_)
+    {
+        cv_.notify_all();
+        return;
+    }
+
+    // If the JobQueue is stopping and refuses the job, finish the
+    // coroutine on this thread. Otherwise the application would hang
+    // on shutdown waiting for it.
+    if (!coro_->post())
+        coro_->resume();
+}
+
+//------------------------------------------------------------------------------
+
+namespace {
+
+// Pulls a streamed response into an HTTP session, framing each chunk
+// for chunked transfer encoding.
+class ResponseWriter : public Writer
+{
+public:
+    ResponseWriter(std::shared_ptr<ResponseStream> stream, std::string header)
+        : stream_(std::move(stream)), buffer_(std::move(header))
+    {
+    }
+
+    ~ResponseWriter() override
+    {
+        stream_->abandon();
+    }
+
+    bool
+    complete() override
+    {
+        return done_ && offset_ == buffer_.size();
+    }
+
+    void
+    consume(std::size_t bytes) override
+    {
+        offset_ += bytes;
+        if (offset_ == buffer_.size() && chunkSize_ != 0)
+        {
+            stream_->sent(chunkSize_);
+            chunkSize_ = 0;
+        }
+    }
+
+    bool
+    prepare(std::size_t, std::function<void(void)> resume) override
+    {
+        if (offset_ != buffer_.size())
+            return true;
+
+        static constexpr char const* terminator = "0\r\n\r\n";
+
+        std::string chunk;
+        auto const next = stream_->next(chunk, resume);
+        switch (next)
+        {
+            case ResponseStream::Next::wait:
+                return false;
+
+            case ResponseStream::Next::aborted:
+                // Leave the response incomplete. Releasing the writer
+                // releases the connection, which is then closed.
+                return false;
+
+            case ResponseStream::Next::done:
+                buffer_ = terminator;
+                done_ = true;
+                break;
+
+            case ResponseStream::Next::chunk:
+            case ResponseStream::Next::last: {
+                std::array<char, 16> size;
+                auto const end = std::to_chars(
+                    size.data(), size.data() + size.size(), chunk.size(), 16);
+                buffer_.assign(size.data(), end.ptr);
+                buffer_ += "\r\n";
+                buffer_ += chunk;
+                buffer_ += "\r\n";
+                chunkSize_ = chunk.size();
+                if (next == ResponseStream::Next::last)
+                {
+                    buffer_ += terminator;
+                    done_ = true;
+                }
+                break;
+            }
+        }
+
+        offset_ = 0;
+        return true;
+    }
+
+    std::vector<boost::asio::const_buffer>
+    data() override
+    {
+        return {boost::asio::buffer(
+            buffer_.data() + offset_, buffer_.size() - offset_)};
+    }
+
+private:
+    std::shared_ptr<ResponseStream> const stream_;
+
+    // The bytes being sent: the headers, or a framed chunk.
+    std::string buffer_;
+    std::size_t offset_ = 0;
+
+    // The size of the chunk in buffer_, reported once it is sent.
+    std::size_t chunkSize_ = 0;
+
+    // buffer_ holds the end of the response.
+    bool done_ = false;
+};
+
+// Sends a streamed response as the frames of a WebSocket text message.
+class ResponseWSMsg : public WSMsg
+{
+public:
+    explicit ResponseWSMsg(std::shared_ptr<ResponseStream> stream)
+        : stream_(std::move(stream))
+    {
+    }
+
+    ~ResponseWSMsg() override
+    {
+        stream_->abandon();
+    }
+
+    std::pair<boost::tribool, std::vector<boost::asio::const_buffer>>
+    prepare(std::size_t, std::function<void(void)> resume) override
+    {
+        // The previous chunk has been sent.
+        if (!chunk_.empty())
+        {
+            stream_->sent(chunk_.size());
+            chunk_.clear();
+        }
+
+        switch (stream_->next(chunk_, resume))
+        {
+            case ResponseStream::Next::wait:
+                return {boost::indeterminate, {}};
+            case ResponseStream::Next::chunk:
+                return {false, {boost::asio::buffer(chunk_)}};
+            case ResponseStream::Next::last:
+                return {true, {boost::asio::buffer(chunk_)}};
+            case ResponseStream::Next::done:
+                break;
+            case ResponseStream::Next::aborted:
+                // The message cannot be finished, so the connection is
+                // failed rather than ending the message early.
+                failed_ = true;
+                return {boost::indeterminate, {}};
+        }
+        return {true, {}};
+    }
+
+    void
+    cancel() override
+    {
+        stream_->abandon();
+    }
+
+    bool
+    failed() const override
+    {
+        return failed_;
+    }
+
+private:
+    std::shared_ptr<ResponseStream> const stream_;
+    std::string chunk_;
+    bool failed_ = false;
+};
+
+}  // namespace
+
+std::shared_ptr<ResponseStream>
+makeHTTPResponseStream(
+    Session& session,
+    int status,
+    bool keepAlive,
+    std::shared_ptr<JobQueue::Coro> coro,
+    beast::Journal j)
+{
+    auto stream = std::make_shared<ResponseStream>(std::move(coro));
+    std::string header;
+    HTTPChunkedReplyHeader(status, keepAlive, Json::stringOutput(header), j);
+    session.write(
+        std::make_shared<ResponseWriter>(stream, std::move(header)),
+        keepAlive);
+    return stream;
+}
+
+std::shared_ptr<ResponseStream>
+makeWSResponseStream(WSSession& session, std::shared_ptr<JobQueue::Coro> coro)
+{
+    auto stream = std::make_shared<ResponseStream>(std::move(coro));
+    session.send(std::make_shared<ResponseWSMsg>(stream));
+    return stream;
+}
+
+}  // namespace RPC
+}  // namespace ripple
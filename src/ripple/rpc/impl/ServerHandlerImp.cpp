@@ -26,6 +26,8 @@
 #include <ripple/beast/net/IPAddressConversion.h>
 #include <ripple/beast/rfc2616.h>
 #include <ripple/core/JobQueue.h>
+#include <ripple/json/Object.h>
+#include <ripple/json/Writer.h>
 #include <ripple/json/json_reader.h>
 #include <ripple/json/to_string.h>
 #include <ripple/net/RPCErr.h>
@@ -33,7 +35,9 @@
 #include <ripple/protocol/ErrorCodes.h>
 #include <ripple/resource/Fees.h>
 #include <ripple/resource/ResourceManager.h>
+#include <ripple/rpc/BinaryEncoding.h>
 #include <ripple/rpc/RPCHandler.h>
+#include <ripple/rpc/ResponseStream.h>
 #include <ripple/rpc/Role.h>
 #include <ripple/rpc/ServerHandler.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
@@ -49,6 +53,7 @@
 #include <boost/type_traits.hpp>
 #include <algorithm>
 #include <mutex>
+#include <optional>
 #include <stdexcept>
 
 namespace ripple {
@@ -271,6 +276,88 @@ buffers_to_string(ConstBufferSequence const& bs)
     return s;
 }
 
+namespace {
+
+// A response whose result is written to a ResponseStream while the
+// command runs, instead of being built as a Json::Value and sent after.
+class StreamedResponse
+{
+public:
+    explicit StreamedResponse(std::shared_ptr<RPC::ResponseStream> stream)
+        : stream_(std::move(stream)), writer_(stream_->output())
+    {
+        root_.emplace(writer_);
+    }
+
+    StreamedResponse(StreamedResponse const&) = delete;
+    StreamedResponse&
+    operator=(StreamedResponse const&) = delete;
+
+    ~StreamedResponse()
+    {
+        if (root_)
+            abort();
+    }
+
+    /** The top level object of the response. */
+    Json::Object&
+    root()
+    {
+        return *root_;
+    }
+
+    /** The "result" member of the response, opened on first use. */
+    Json::Object&
+    result()
+    {
+        if (!result_)
+            result_.emplace(Json::addObject(*root_, jss::result));
+        return *result_;
+    }
+
+    /** Close the "result" member, so that root() can be written to. */
+    void
+    closeResult()
+    {
+        result_.reset();
+    }
+
+    /** Complete the response, following it with `trailer`. */
+    void
+    finish(boost::beast::string_view trailer = {})
+    {
+        result_.reset();
+        root_.reset();
+        if (!trailer.empty())
+            stream_->write(trailer);
+        stream_->finish();
+    }
+
+    /** Fail the response, leaving the JSON incomplete. */
+    void
+    abort()
+    {
+        // Abort first, so that closing the open objects is not sent.
+        stream_->abort();
+        result_.reset();
+        root_.reset();
+    }
+
+    std::size_t
+    size() const
+    {
+        return stream_->size();
+    }
+
+private:
+    std::shared_ptr<RPC::ResponseStream> const stream_;
+    Json::Writer writer_;
+    std::optional<Json::Object::Root> root_;
+    std::optional<Json::Object> result_;
+};
+
+}  // namespace
+
 void
 ServerHandlerImp::onRequest(Session& session)
 {
@@ -344,7 +431,17 @@ ServerHandlerImp::onWSMessage(
         "WS-Client",
         [this, session, jv = std::move(jv)](
             std::shared_ptr<JobQueue::Coro> const& coro) {
-            auto const jr = this->processSession(session, coro, jv);
+            Serializer binary;
+            auto const jr = this->processSession(session, coro, jv, binary);
+            if (jr.isNull())
+            {
+                // A streamed response has already been sent.
+                if (binary.getDataLength() != 0)
+                    session->send(std::make_shared<StreamWSMsg>(
+                        makeStreamMessage(binary.slice())));
+                session->complete();
+                return;
+            }
             auto const s = to_string(jr);
             auto const n = s.length();
             boost::beast::multi_buffer sb(n);
@@ -401,7 +498,8 @@ Json::Value
 ServerHandlerImp::processSession(
     std::shared_ptr<WSSession> const& session,
     std::shared_ptr<JobQueue::Coro> const& coro,
-    Json::Value const& jv)
+    Json::Value const& jv,
+    Serializer& binary)
 {
     auto is = std::static_pointer_cast<WSInfoSub>(session->appDefined);
     if (is->getConsumer().disconnect(m_journal))
@@ -416,6 +514,8 @@ ServerHandlerImp::processSession(
     // Requests without "command" are invalid.
     Json::Value jr(Json::objectValue);
     Resource::Charge loadType = Resource::feeReferenceRPC;
+    bool answeredBinary = false;
+    std::optional<StreamedResponse> streamed;
     try
     {
         auto apiVersion =
@@ -479,7 +579,29 @@ ServerHandlerImp::processSession(
                 {is->user(), is->forwarded_for()}};
 
             auto start = std::chrono::system_clock::now();
-            RPC::doCommand(context, jr[jss::result]);
+            if (is->binaryEncoding())
+            {
+                RPC::addBinaryResponseHeader(binary, jv);
+                answeredBinary =
+                    RPC::doCommandBinary(context, jr[jss::result], binary);
+            }
+            else
+            {
+                auto const begin = [&]() -> Json::Object& {
+                    streamed.emplace(RPC::makeWSResponseStream(*session, coro));
+                    auto& root = streamed->root();
+                    if (jv.isMember(jss::id))
+                        root[jss::id] = jv[jss::id];
+                    if (jv.isMember(jss::jsonrpc))
+                        root[jss::jsonrpc] = jv[jss::jsonrpc];
+                    if (jv.isMember(jss::ripplerpc))
+                        root[jss::ripplerpc] = jv[jss::ripplerpc];
+                    if (jv.isMember(jss::api_version))
+                        root[jss::api_version] = jv[jss::api_version];
+                    return streamed->result();
+                };
+                RPC::doCommandStreamed(context, jr[jss::result], begin);
+            }
             auto end = std::chrono::system_clock::now();
             logDuration(jv, end - start, m_journal);
         }
@@ -493,6 +615,35 @@ ServerHandlerImp::processSession(
     }
 
     is->getConsumer().charge(loadType);
+    if (answeredBinary)
+    {
+        if (is->getConsumer().warn())
+            RPC::setBinaryResponseFlags(binary, RPC::binaryLoadWarning);
+        return Json::Value();
+    }
+
+    if (streamed)
+    {
+        // Part of the response has been sent, so an error can no longer
+        // replace it. Closing the connection tells the client it failed.
+        if (!jr[jss::result].isNull())
+        {
+            streamed->abort();
+            session->close({boost::beast::websocket::internal_error,
+                            "Response failed"});
+            return Json::Value();
+        }
+
+        streamed->closeResult();
+        auto& root = streamed->root();
+        if (is->getConsumer().warn())
+            root[jss::warning] = jss::load.c_str();
+        root[jss::status] = jss::success.c_str();
+        root[jss::type] = jss::response.c_str();
+        streamed->finish();
+        return Json::Value();
+    }
+
     if (is->getConsumer().warn())
         jr[jss::warning] = jss::load;
 
@@ -549,6 +700,22 @@ ServerHandlerImp::processSession(
     std::shared_ptr<Session> const& session,
     std::shared_ptr<JobQueue::Coro> coro)
 {
+    bool const keepAlive = beast::rfc2616::is_keep_alive(session->request());
+
+    // Once a streamed response is complete the session reads the next
+    // request, so the current one must not be used after that.
+    bool streamed = false;
+    std::function<std::shared_ptr<RPC::ResponseStream>()> startStream;
+    // Chunked transfer encoding needs HTTP/1.1.
+    if (session->request().version() >= 11)
+    {
+        startStream = [&]() {
+            streamed = true;
+            return RPC::makeHTTPResponseStream(
+                *session, 200, keepAlive, coro, app_.journal("RPC"));
+        };
+    }
+
     processRequest(
         session->port(),
         buffers_to_string(session->request().body().data()),
@@ -561,9 +728,13 @@ ServerHandlerImp::processSession(
             if (iter != session->request().end())
                 return iter->value();
             return boost::beast::string_view{};
-        }());
+        }(),
+        startStream);
+
+    if (streamed)
+        return;
 
-    if (beast::rfc2616::is_keep_alive(session->request()))
+    if (keepAlive)
         session->complete();
     else
         session->close(true);
@@ -593,7 +764,8 @@ ServerHandlerImp::processRequest(
     Output&& output,
     std::shared_ptr<JobQueue::Coro> coro,
     boost::string_view forwardedFor,
-    boost::string_view user)
+    boost::string_view user,
+    std::function<std::shared_ptr<RPC::ResponseStream>()> const& startStream)
 {
     auto rpcJ = app_.journal("RPC");
 
@@ -875,11 +1047,33 @@ ServerHandlerImp::processRequest(
             {user, forwardedFor}};
         Json::Value result;
 
+        // Only a single request answered in the original format is
+        // streamed; the others rearrange the result after it is built.
+        std::optional<StreamedResponse> streamed;
+
         auto start = std::chrono::system_clock::now();
 
         try
         {
-            RPC::doCommand(context, result);
+            if (startStream && !batch && ripplerpc < "2.0")
+            {
+                auto const begin = [&]() -> Json::Object& {
+                    streamed.emplace(startStream());
+                    auto& root = streamed->root();
+                    if (params.isMember(jss::jsonrpc))
+                        root[jss::jsonrpc] = params[jss::jsonrpc];
+                    if (params.isMember(jss::ripplerpc))
+                        root[jss::ripplerpc] = params[jss::ripplerpc];
+                    if (params.isMember(jss::id))
+                        root[jss::id] = params[jss::id];
+                    return streamed->result();
+                };
+                RPC::doCommandStreamed(context, result, begin);
+            }
+            else
+            {
+                RPC::doCommand(context, result);
+            }
         }
         catch (std::exception const& ex)
         {
@@ -894,6 +1088,34 @@ ServerHandlerImp::processRequest(
         logDuration(params, end - start, m_journal);
 
         usage.charge(loadType);
+
+        if (streamed)
+        {
+            if (result.isNull())
+            {
+                auto& object = streamed->result();
+                if (usage.warn())
+                    object[jss::warning] = jss::load.c_str();
+                object[jss::status] = jss::success.c_str();
+                streamed->finish("\n");
+            }
+            else
+            {
+                // The client sees the response end without completing.
+                JLOG(m_journal.warn()) << "Failed to stream the response to "
+                                       << strMethod << ": " << result;
+                streamed->abort();
+            }
+
+            rpc_time_.notify(
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::system_clock::now() - start));
+            ++rpc_requests_;
+            rpc_size_.notify(
+                beast::insight::Event::value_type{streamed->size()});
+            return;
+        }
+
         if (usage.warn())
             result[jss::warning] = jss::load;
 
@@ -32,12 +32,17 @@
 #include <boost/beast/ssl/ssl_stream.hpp>
 #include <boost/utility/string_view.hpp>
 #include <condition_variable>
+#include <functional>
 #include <map>
 #include <mutex>
 #include <vector>
 
 namespace ripple {
 
+namespace RPC {
+class ResponseStream;
+}
+
 inline bool
 operator<(Port const& lhs, Port const& rhs)
 {
@@ -171,17 +176,31 @@ public:
     onStopped(Server&);
 
 private:
+    /** Process a WebSocket request.
+
+        If the session negotiated the binary encoding and the command
+        answered in binary form, the encoded response is left in `binary`
+        and a null value is returned. A null value is also returned if the
+        response was streamed to the session as it was produced.
+    */
     Json::Value
     processSession(
         std::shared_ptr<WSSession> const& session,
         std::shared_ptr<JobQueue::Coro> const& coro,
-        Json::Value const& jv);
+        Json::Value const& jv,
+        Serializer& binary);
 
     void
     processSession(
         std::shared_ptr<Session> const&,
         std::shared_ptr<JobQueue::Coro> coro);
 
+    /** Process a JSON-RPC request.
+
+        If `startStream` is set and the response to the request can be
+        streamed, it is called to start the response, which is then
+        written to the stream it returns instead of to `output`.
+    */
     void
     processRequest(
         Port const& port,
@@ -190,7 +209,9 @@ private:
         Output&&,
         std::shared_ptr<JobQueue::Coro> coro,
         boost::string_view forwardedFor,
-        boost::string_view user);
+        boost::string_view user,
+        std::function<std::shared_ptr<RPC::ResponseStream>()> const&
+            startStream = {});
 
     Handoff
     statusResponse(http_request_type const& request) const;
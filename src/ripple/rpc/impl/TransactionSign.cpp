@@ -636,7 +636,7 @@ transactionFormatResultImpl(Transaction::pointer tpTrans)
     {
         jvResult[jss::tx_json] = tpTrans->getJson(JsonOptions::none);
         jvResult[jss::tx_blob] =
-            strHex(tpTrans->getSTransaction()->getSerializer().peekData());
+            strHex(tpTrans->getSTransaction()->getSerialized());
 
         if (temUNCERTAIN != tpTrans->getResult())
         {
@@ -77,6 +77,9 @@ inline int constexpr pageLength(bool isBinary)
     return isBinary ? binaryPageLength : jsonPageLength;
 }
 
+/** Maximum number of threads an admin LedgerData request may walk with. */
+static int constexpr maxLedgerDataParallelism = 16;
+
 /** Maximum number of source currencies allowed in a path find request. */
 static int constexpr max_src_cur = 18;
 
@@ -20,26 +20,66 @@
 #ifndef RIPPLE_RPC_WSINFOSUB_H
 #define RIPPLE_RPC_WSINFOSUB_H
 
+#include <ripple/basics/safe_cast.h>
 #include <ripple/beast/net/IPAddressConversion.h>
 #include <ripple/json/json_writer.h>
 #include <ripple/net/InfoSub.h>
 #include <ripple/rpc/Role.h>
 #include <ripple/server/WSSession.h>
 #include <boost/utility/string_view.hpp>
+#include <algorithm>
 #include <memory>
 #include <string>
 
 namespace ripple {
 
+/** A WebSocket message backed by a shared, pre-serialized stream message.
+
+    Every session receiving the same published event holds a reference
+    to the same buffer; nothing is copied or re-serialized per session.
+*/
+class StreamWSMsg : public WSMsg
+{
+    StreamMessage::pointer msg_;
+    std::size_t pos_ = 0;
+    std::size_t n_ = 0;
+
+public:
+    explicit StreamWSMsg(StreamMessage::pointer msg) : msg_(std::move(msg))
+    {
+    }
+
+    std::pair<boost::tribool, std::vector<boost::asio::const_buffer>>
+    prepare(std::size_t bytes, std::function<void(void)>) override
+    {
+        auto const& text = msg_->text();
+        pos_ += n_;
+        if (pos_ >= text.size())
+            return {true, {}};
+        n_ = std::min(bytes, text.size() - pos_);
+        boost::tribool const done = (pos_ + n_ == text.size());
+        return {done, {boost::asio::const_buffer(text.data() + pos_, n_)}};
+    }
+
+    bool
+    binary() const override
+    {
+        return msg_->binary();
+    }
+};
+
 class WSInfoSub : public InfoSub
 {
     std::weak_ptr<WSSession> ws_;
     std::string user_;
     std::string fwdfor_;
+    bool const binary_;
 
 public:
     WSInfoSub(Source& source, std::shared_ptr<WSSession> const& ws)
-        : InfoSub(source), ws_(ws)
+        : InfoSub(source)
+        , ws_(ws)
+        , binary_(requestsBinaryEncoding(ws->request()))
     {
         auto const& h = ws->request();
         if (ipAllowed(
@@ -81,6 +121,34 @@ public:
         auto m = std::make_shared<StreambufWSMsg<decltype(sb)>>(std::move(sb));
         sp->send(m);
     }
+
+    void
+    send(StreamMessage::pointer const& msg, bool) override
+    {
+        auto sp = ws_.lock();
+        if (!sp)
+            return;
+        sp->send(std::make_shared<StreamWSMsg>(msg));
+    }
+
+    void
+    disconnect() override
+    {
+        auto sp = ws_.lock();
+        if (!sp)
+            return;
+        boost::beast::websocket::close_reason cr;
+        cr.code = safe_cast<decltype(cr.code)>(
+            boost::beast::websocket::close_code::policy_error);
+        cr.reason = "Policy error: client is too slow.";
+        sp->close(cr);
+    }
+
+    bool
+    binaryEncoding() const override
+    {
+        return binary_;
+    }
 };
 
 }  // namespace ripple
@@ -27,6 +27,7 @@
 #include <boost/asio/buffer.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/beast/core/buffers_prefix.hpp>
+#include <boost/beast/http/rfc7230.hpp>
 #include <boost/beast/websocket/rfc6455.hpp>
 #include <boost/logic/tribool.hpp>
 
@@ -38,6 +39,31 @@
 
 namespace ripple {
 
+/** The WebSocket subprotocol which selects the binary encoding.
+
+    A client offering this protocol in `Sec-WebSocket-Protocol` during the
+    handshake receives stream messages, and the responses of commands that
+    support it, as binary frames. Everything else is still sent as JSON
+    text frames.
+*/
+inline constexpr char const* binaryWSProtocol = "xrpl-binary-v1";
+
+/** Return `true` if the upgrade request offers the binary subprotocol. */
+inline bool
+requestsBinaryEncoding(http_request_type const& request)
+{
+    auto const it =
+        request.find(boost::beast::http::field::sec_websocket_protocol);
+    if (it == request.end())
+        return false;
+    for (auto const& protocol : boost::beast::http::token_list{it->value()})
+    {
+        if (protocol == binaryWSProtocol)
+            return true;
+    }
+    return false;
+}
+
 class WSMsg
 {
 public:
@@ -66,6 +92,34 @@ public:
     */
     virtual std::pair<boost::tribool, std::vector<boost::asio::const_buffer>>
     prepare(std::size_t bytes, std::function<void(void)> resume) = 0;
+
+    /** Return `true` if the message must be sent as a binary frame. */
+    virtual bool
+    binary() const
+    {
+        return false;
+    }
+
+    /** Called if the connection fails before the message is sent.
+
+        A message whose data is still being produced uses this to tell
+        the producer to stop.
+    */
+    virtual void
+    cancel()
+    {
+    }
+
+    /** Return `true` if the message could not be completed.
+
+        Checked after prepare. The connection is then failed, so that
+        what was already sent is not taken for a whole message.
+    */
+    virtual bool
+    failed() const
+    {
+        return false;
+    }
 };
 
 template <class Streambuf>
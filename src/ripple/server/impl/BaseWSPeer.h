@@ -198,11 +198,15 @@ BaseWSPeer<Handler, Impl>::run()
     impl().ws_.control_callback(control_callback_);
     start_timer();
     close_on_timer_ = true;
-    impl().ws_.set_option(
-        boost::beast::websocket::stream_base::decorator([](auto& res) {
+    impl().ws_.set_option(boost::beast::websocket::stream_base::decorator(
+        [binary = requestsBinaryEncoding(request_)](auto& res) {
             res.set(
                 boost::beast::http::field::server,
                 BuildInfo::getFullVersionString());
+            if (binary)
+                res.set(
+                    boost::beast::http::field::sec_websocket_protocol,
+                    binaryWSProtocol);
         }));
     impl().ws_.async_accept(
         request_,
@@ -317,9 +321,13 @@ BaseWSPeer<Handler, Impl>::on_write(error_code const& ec)
     auto& w = *wq_.front();
     auto const result = w.prepare(
         65536, std::bind(&BaseWSPeer::do_write, impl().shared_from_this()));
+    if (w.failed())
+        return fail(boost::asio::error::connection_aborted, "write");
     if (boost::indeterminate(result.first))
         return;
     start_timer();
+    // The opcode is only applied at the start of each message.
+    impl().ws_.binary(w.binary());
     if (!result.first)
         impl().ws_.async_write_some(
             static_cast<bool>(result.first),
@@ -510,6 +518,8 @@ BaseWSPeer<Handler, Impl>::fail(error_code ec, String const& what)
         ec_ = ec;
         JLOG(this->j_.trace()) << what << ": " << ec.message();
         ripple::get_lowest_layer(impl().ws_).socket().close(ec);
+        for (auto const& w : wq_)
+            w->cancel();
     }
 }
 
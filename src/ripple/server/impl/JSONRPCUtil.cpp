@@ -52,6 +52,47 @@ getHTTPHeaderTimestamp()
     return std::string(buffer);
 }
 
+static void
+outputStatusLine(int nStatus, Json::Output const& output)
+{
+    switch (nStatus)
+    {
+        case 200:
+            output("HTTP/1.1 200 OK\r\n");
+            break;
+        case 202:
+            output("HTTP/1.1 202 Accepted\r\n");
+            break;
+        case 400:
+            output("HTTP/1.1 400 Bad Request\r\n");
+            break;
+        case 401:
+            output("HTTP/1.1 401 Authorization Required\r\n");
+            break;
+        case 403:
+            output("HTTP/1.1 403 Forbidden\r\n");
+            break;
+        case 404:
+            output("HTTP/1.1 404 Not Found\r\n");
+            break;
+        case 405:
+            output("HTTP/1.1 405 Method Not Allowed\r\n");
+            break;
+        case 429:
+            output("HTTP/1.1 429 Too Many Requests\r\n");
+            break;
+        case 500:
+            output("HTTP/1.1 500 Internal Server Error\r\n");
+            break;
+        case 501:
+            output("HTTP/1.1 501 Not Implemented\r\n");
+            break;
+        case 503:
+            output("HTTP/1.1 503 Server is overloaded\r\n");
+            break;
+    }
+}
+
 void
 HTTPReply(
     int nStatus,
@@ -95,43 +136,7 @@ HTTPReply(
         return;
     }
 
-    switch (nStatus)
-    {
-        case 200:
-            output("HTTP/1.1 200 OK\r\n");
-            break;
-        case 202:
-            output("HTTP/1.1 202 Accepted\r\n");
-            break;
-        case 400:
-            output("HTTP/1.1 400 Bad Request\r\n");
-            break;
-        case 401:
-            output("HTTP/1.1 401 Authorization Required\r\n");
-            break;
-        case 403:
-            output("HTTP/1.1 403 Forbidden\r\n");
-            break;
-        case 404:
-            output("HTTP/1.1 404 Not Found\r\n");
-            break;
-        case 405:
-            output("HTTP/1.1 405 Method Not Allowed\r\n");
-            break;
-        case 429:
-            output("HTTP/1.1 429 Too Many Requests\r\n");
-            break;
-        case 500:
-            output("HTTP/1.1 500 Internal Server Error\r\n");
-            break;
-        case 501:
-            output("HTTP/1.1 501 Not Implemented\r\n");
-            break;
-        case 503:
-            output("HTTP/1.1 503 Server is overloaded\r\n");
-            break;
-    }
-
+    outputStatusLine(nStatus, output);
     output(getHTTPHeaderTimestamp());
 
     output(
@@ -156,4 +161,27 @@ HTTPReply(
     output("\r\n");
 }
 
+void
+HTTPChunkedReplyHeader(
+    int nStatus,
+    bool keepAlive,
+    Json::Output const& output,
+    beast::Journal j)
+{
+    JLOG(j.trace()) << "HTTP Reply " << nStatus << " (chunked)";
+
+    outputStatusLine(nStatus, output);
+    output(getHTTPHeaderTimestamp());
+    output(
+        keepAlive ? "Connection: Keep-Alive\r\n" : "Connection: close\r\n");
+    output(
+        "Transfer-Encoding: chunked\r\n"
+        "Content-Type: application/json; charset=UTF-8\r\n");
+    output("Server: " + systemName() + "-json-rpc/");
+    output(BuildInfo::getFullVersionString());
+    output(
+        "\r\n"
+        "\r\n");
+}
+
 }  // namespace ripple
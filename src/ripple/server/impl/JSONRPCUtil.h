@@ -32,6 +32,15 @@ HTTPReply(
     Json::Output const&,
     beast::Journal j);
 
+/** Write the status line and headers of a response whose body follows
+    using chunked transfer encoding. */
+void
+HTTPChunkedReplyHeader(
+    int nStatus,
+    bool keepAlive,
+    Json::Output const&,
+    beast::Journal j);
+
 }  // namespace ripple
 
 #endif
@@ -26,6 +26,7 @@
 #include <ripple/shamap/FullBelowCache.h>
 #include <ripple/shamap/TreeNodeCache.h>
 #include <cstdint>
+#include <functional>
 
 namespace ripple {
 
@@ -95,6 +96,14 @@ public:
 
     virtual void
     reset() = 0;
+
+    /** Run `work` on another thread, to share a walk of a map.
+
+        @return `false` if it could not be started, in which case the
+                caller does the work itself.
+    */
+    virtual bool
+    post(std::function<void()> work) = 0;
 };
 
 }  // namespace ripple
@@ -27,6 +27,7 @@
 #include <ripple/beast/utility/Journal.h>
 #include <atomic>
 #include <string>
+#include <vector>
 
 namespace ripple {
 
@@ -117,6 +118,16 @@ public:
         m_cache.insert(key);
     }
 
+    /** Return the keys in the cache.
+        Thread safety:
+            Safe to call from any thread.
+    */
+    std::vector<key_type>
+    getKeys() const
+    {
+        return m_cache.getKeys();
+    }
+
     /** generation determines whether cached entry is valid */
     std::uint32_t
     getGeneration(void) const
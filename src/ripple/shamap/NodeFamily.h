@@ -82,6 +82,9 @@ public:
     void
     reset() override;
 
+    bool
+    post(std::function<void()> work) override;
+
     void
     missingNodeAcquireBySeq(std::uint32_t seq, uint256 const& hash) override;
 
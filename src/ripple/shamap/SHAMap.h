@@ -20,6 +20,7 @@
 #ifndef RIPPLE_SHAMAP_SHAMAP_H_INCLUDED
 #define RIPPLE_SHAMAP_SHAMAP_H_INCLUDED
 
+#include <ripple/basics/ParallelFor.h>
 #include <ripple/basics/UnorderedContainers.h>
 #include <ripple/beast/utility/Journal.h>
 #include <ripple/nodestore/Database.h>
@@ -33,8 +34,14 @@
 #include <ripple/shamap/SHAMapMissingNode.h>
 #include <ripple/shamap/SHAMapTreeNode.h>
 #include <ripple/shamap/TreeNodeCache.h>
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
 #include <stack>
+#include <type_traits>
 #include <vector>
 
 namespace ripple {
@@ -120,8 +127,8 @@ public:
     static inline constexpr unsigned int leafDepth = 64;
 
     using DeltaItem = std::pair<
-        std::shared_ptr<SHAMapItem const>,
-        std::shared_ptr<SHAMapItem const>>;
+        boost::intrusive_ptr<SHAMapItem const>,
+        boost::intrusive_ptr<SHAMapItem const>>;
     using Delta = std::map<uint256, DeltaItem>;
 
     SHAMap(SHAMap const&) = delete;
@@ -190,23 +197,25 @@ public:
     delItem(uint256 const& id);
 
     bool
-    addItem(SHAMapNodeType type, SHAMapItem&& i);
+    addItem(SHAMapNodeType type, boost::intrusive_ptr<SHAMapItem const> item);
 
     SHAMapHash
     getHash() const;
 
     // save a copy if you have a temporary anyway
     bool
-    updateGiveItem(SHAMapNodeType type, std::shared_ptr<SHAMapItem const>);
+    updateGiveItem(SHAMapNodeType type, boost::intrusive_ptr<SHAMapItem const>);
 
     bool
-    addGiveItem(SHAMapNodeType type, std::shared_ptr<SHAMapItem const> item);
+    addGiveItem(
+        SHAMapNodeType type,
+        boost::intrusive_ptr<SHAMapItem const> item);
 
     // Save a copy if you need to extend the life
     // of the SHAMapItem beyond this SHAMap
-    std::shared_ptr<SHAMapItem const> const&
+    boost::intrusive_ptr<SHAMapItem const> const&
     peekItem(uint256 const& id) const;
-    std::shared_ptr<SHAMapItem const> const&
+    boost::intrusive_ptr<SHAMapItem const> const&
     peekItem(uint256 const& id, SHAMapHash& hash) const;
 
     // traverse functions
@@ -253,23 +262,90 @@ public:
     */
     void
     visitLeaves(
-        std::function<void(std::shared_ptr<SHAMapItem const> const&)> const&)
-        const;
+        std::function<
+            void(boost::intrusive_ptr<SHAMapItem const> const&)> const&) const;
+
+    /** Visit the leaves after a key in key order, walking the map and
+        preparing the leaves on several threads.
+
+        The key space is split into 256 ranges by the first byte of the
+        key. A few ranges at a time are walked, each on its own thread, so
+        that the nodes they need are fetched concurrently; the number
+        walked at once follows from how many leaves the rest of the limit
+        looks to need. Of the leaves found, those within `limit` are
+        prepared in chunks on the same threads, then passed to `visit` in
+        key order on the calling thread. The threads are the calling one
+        and those started through Family::post. No range collects more
+        leaves than are left to visit, which bounds the memory used.
+
+        The map must not be modified during the walk.
+
+        @param start Only leaves with keys greater than this are visited.
+        @param limit The most leaves to visit.
+        @param threads The number of threads to walk and prepare on,
+                       including the calling thread.
+        @param prepare Called with each leaf, on any of the threads.
+        @param visit Called with each leaf and its prepared value, in key
+                     order. If it returns false the walk stops.
+    */
+    template <class Prepare, class Visit>
+    void
+    visitLeavesParallel(
+        uint256 const& start,
+        std::size_t limit,
+        std::size_t threads,
+        Prepare&& prepare,
+        Visit&& visit) const;
 
     // comparison/sync functions
 
+    /** Counters which getMissingNodes updates as it goes.
+
+        Another thread may read them while a search is under way.
+    */
+    struct ScanProgress
+    {
+        // Searches started, and those still under way
+        std::atomic<std::uint64_t> scans = 0;
+        std::atomic<std::uint32_t> running = 0;
+
+        // Inner nodes whose children have all been checked
+        std::atomic<std::uint64_t> innerNodes = 0;
+
+        // Asynchronous reads issued, and those which have completed
+        std::atomic<std::uint64_t> reads = 0;
+        std::atomic<std::uint64_t> readsDone = 0;
+
+        // Nodes found to be missing
+        std::atomic<std::uint64_t> missing = 0;
+
+        // Time spent searching, in microseconds
+        std::atomic<std::uint64_t> duration = 0;
+    };
+
     /** Check for nodes in the SHAMap not available
 
         Traverse the SHAMap efficiently, maximizing I/O
         concurrency, to discover nodes referenced in the
         SHAMap but not available locally.
 
+        With more than one thread, the subtrees under the children of the
+        root are searched at the same time, on the calling thread and on
+        threads started through Family::post, each keeping its own
+        asynchronous reads in flight.
+
         @param maxNodes The maximum number of found nodes to return
         @param filter The filter to use when retrieving nodes
+        @param threads The greatest number of threads to search with
+        @param progress If not null, counters to update while searching
         @param return The nodes known to be missing
     */
     std::vector<std::pair<SHAMapNodeID, uint256>>
-    getMissingNodes(int maxNodes, SHAMapSyncFilter* filter);
+    getMissingNodes(
+        int maxNodes,
+        SHAMapSyncFilter* filter,
+        std::size_t threads = 1,
+        ScanProgress* progress = nullptr);
 
     bool
     getNodeFat(
@@ -315,6 +391,28 @@ public:
         Slice const& rawNode,
         SHAMapSyncFilter* filter);
 
+    /** Add a batch of nodes received from a peer.
+
+        The nodes are grouped by the branch of the root they lie under and
+        the groups are added on up to `threads` threads: the calling thread
+        and threads started through Family::post. Within a group the
+        nodes are added in the order given, so a node may follow its parent
+        in the same batch. Adding a group stops at its first invalid node.
+
+        The root must already have been added with addRootNode; a root
+        node in the batch is counted as a duplicate.
+
+        @param nodes The identifier and wire form of each node
+        @param filter The filter to use when retrieving nodes
+        @param threads The greatest number of threads to use
+        @return The combined result of adding every node
+    */
+    SHAMapAddNode
+    addKnownNodes(
+        std::vector<std::pair<SHAMapNodeID, Slice>> const& nodes,
+        SHAMapSyncFilter* filter,
+        std::size_t threads);
+
     // status functions
     void
     setImmutable();
@@ -361,8 +459,8 @@ private:
     using SharedPtrNodeStack =
         std::stack<std::pair<std::shared_ptr<SHAMapTreeNode>, SHAMapNodeID>>;
     using DeltaRef = std::pair<
-        std::shared_ptr<SHAMapItem const> const&,
-        std::shared_ptr<SHAMapItem const> const&>;
+        boost::intrusive_ptr<SHAMapItem const> const&,
+        boost::intrusive_ptr<SHAMapItem const> const&>;
 
     // tree node cache operations
     std::shared_ptr<SHAMapTreeNode>
@@ -475,7 +573,7 @@ private:
     descendNoStore(std::shared_ptr<SHAMapInnerNode> const&, int branch) const;
 
     /** If there is only one leaf below this node, get its contents */
-    std::shared_ptr<SHAMapItem const> const&
+    boost::intrusive_ptr<SHAMapItem const> const&
     onlyBelow(SHAMapTreeNode*) const;
 
     bool
@@ -490,7 +588,7 @@ private:
     bool
     walkBranch(
         SHAMapTreeNode* node,
-        std::shared_ptr<SHAMapItem const> const& otherMapItem,
+        boost::intrusive_ptr<SHAMapItem const> const& otherMapItem,
         bool isFirstMap,
         Delta& differences,
         int& maxCount) const;
@@ -506,11 +604,13 @@ private:
         MissingNodes&
         operator=(const MissingNodes&) = delete;
 
-        // basic parameters
-        int max_;
+        // basic parameters; the number of nodes still wanted is shared by
+        // all the searches of one call to getMissingNodes
+        std::atomic<int>& max_;
         SHAMapSyncFilter* filter_;
         int const maxDefer_;
         std::uint32_t generation_;
+        ScanProgress* progress_;
 
         // nodes we have discovered to be missing
         std::vector<std::pair<SHAMapNodeID, uint256>> missingNodes_;
@@ -548,23 +648,34 @@ private:
         std::map<SHAMapInnerNode*, SHAMapNodeID> resumes_;
 
         MissingNodes(
-            int max,
+            std::atomic<int>& max,
             SHAMapSyncFilter* filter,
             int maxDefer,
-            std::uint32_t generation)
+            std::uint32_t generation,
+            ScanProgress* progress)
             : max_(max)
             , filter_(filter)
             , maxDefer_(maxDefer)
             , generation_(generation)
+            , progress_(progress)
             , deferred_(0)
         {
             missingNodes_.reserve(max);
             finishedReads_.reserve(maxDefer);
         }
+
+        void
+        count(std::atomic<std::uint64_t> ScanProgress::*counter)
+        {
+            if (progress_)
+                (progress_->*counter).fetch_add(1, std::memory_order_relaxed);
+        }
     };
 
     // getMissingNodes helper functions
     void
+    gmn_Walk(MissingNodes&, MissingNodes::StackEntry pos);
+    void
     gmn_ProcessNodes(MissingNodes&, MissingNodes::StackEntry& node);
     void
     gmn_ProcessDeferredReads(MissingNodes&);
@@ -746,6 +857,117 @@ SHAMap::end() const
     return const_iterator(this, nullptr);
 }
 
+template <class Prepare, class Visit>
+void
+SHAMap::visitLeavesParallel(
+    uint256 const& start,
+    std::size_t limit,
+    std::size_t threads,
+    Prepare&& prepare,
+    Visit&& visit) const
+{
+    using value_type = std::invoke_result_t<Prepare&, SHAMapItem const&>;
+
+    static constexpr std::size_t chunkSize = 256;
+
+    if (threads <= 1)
+    {
+        std::size_t walked = 0;
+        for (auto it = upper_bound(start); it != end() && walked < limit;
+             ++it, ++walked)
+        {
+            if (!visit(*it, prepare(*it)))
+                return;
+        }
+        return;
+    }
+
+    auto const post = [this](std::function<void()> work) {
+        return f_.post(std::move(work));
+    };
+
+    // The key space is split into ranges by the first byte of the key,
+    // which hold about as many leaves each, and several ranges are walked
+    // at once so that the nodes they need are fetched concurrently.
+    static constexpr std::size_t ranges = 256;
+
+    std::size_t const first = start.data()[0];
+    std::size_t range = first;
+    std::size_t window = 1;
+    std::size_t walked = 0;
+
+    std::vector<std::vector<SHAMapItem const*>> found;
+    std::vector<SHAMapItem const*> items;
+    std::vector<value_type> prepared;
+
+    while (range < ranges && walked < limit)
+    {
+        auto const count = std::min(window, ranges - range);
+        auto const wanted = limit - walked;
+
+        found.clear();
+        found.resize(count);
+        parallelFor(count, threads - 1, post, [&](std::size_t i) {
+            auto const r = range + i;
+            uint256 from = start;
+            if (r != first)
+            {
+                // The last key of the range before
+                from = ~uint256();
+                from.data()[0] = static_cast<std::uint8_t>(r - 1);
+            }
+
+            auto& leaves = found[i];
+            for (auto it = upper_bound(from); it != end() &&
+                 it->key().data()[0] == r && leaves.size() < wanted;
+                 ++it)
+                leaves.push_back(&*it);
+        });
+        range += count;
+
+        // Only the leaves within the limit are prepared.
+        std::size_t total = 0;
+        items.clear();
+        for (auto const& leaves : found)
+        {
+            total += leaves.size();
+            for (auto const item : leaves)
+            {
+                if (items.size() == wanted)
+                    break;
+                items.push_back(item);
+            }
+        }
+
+        prepared.clear();
+        prepared.resize(items.size());
+        parallelFor(
+            (items.size() + chunkSize - 1) / chunkSize,
+            threads - 1,
+            post,
+            [&](std::size_t chunk) {
+                auto const last =
+                    std::min(items.size(), (chunk + 1) * chunkSize);
+                for (auto i = chunk * chunkSize; i < last; ++i)
+                    prepared[i] = prepare(*items[i]);
+            });
+
+        for (std::size_t i = 0; i < items.size(); ++i)
+        {
+            if (!visit(*items[i], std::move(prepared[i])))
+                return;
+        }
+        walked += items.size();
+
+        // Walk as many ranges next as the rest of the limit looks to need,
+        // judging by the ranges just walked, within a few for each thread.
+        auto const needed = total == 0
+            ? 2 * count
+            : ((limit - walked) * count + total - 1) / total;
+        window = std::clamp<std::size_t>(needed, 1, 2 * threads);
+    }
+}
+
 }  // namespace ripple
 
 #endif
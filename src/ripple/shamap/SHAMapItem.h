@@ -20,52 +20,197 @@
 #ifndef RIPPLE_SHAMAP_SHAMAPITEM_H_INCLUDED
 #define RIPPLE_SHAMAP_SHAMAPITEM_H_INCLUDED
 
-#include <ripple/basics/Buffer.h>
+#include <ripple/basics/ByteUtilities.h>
 #include <ripple/basics/CountedObject.h>
+#include <ripple/basics/SlabAllocator.h>
 #include <ripple/basics/Slice.h>
 #include <ripple/basics/base_uint.h>
+#include <ripple/basics/contract.h>
+#include <boost/smart_ptr/intrusive_ptr.hpp>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <type_traits>
 
 namespace ripple {
 
-// an item stored in a SHAMap
+/** An item stored in a SHAMap.
+
+    The key, the size and the reference count are followed, in the same
+    allocation, by the payload. Items are created by make_shamapitem and
+    are held through a boost::intrusive_ptr; most of them are carved out
+    of size class slabs instead of coming from the general allocator.
+*/
 class SHAMapItem : public CountedObject<SHAMapItem>
 {
+    // These are used to support boost::intrusive_ptr reference counting
+    // These functions are used internally by boost::intrusive_ptr to handle
+    // lifetime management.
+    friend void
+    intrusive_ptr_add_ref(SHAMapItem const* x);
+
+    friend void
+    intrusive_ptr_release(SHAMapItem const* x);
+
+    // This is the interface for creating new instances of this class.
+    friend boost::intrusive_ptr<SHAMapItem>
+    make_shamapitem(uint256 const& tag, Slice data);
+
 private:
-    uint256 tag_;
-    Buffer data_;
+    uint256 const tag_;
 
-public:
-    SHAMapItem() = delete;
+    // We use std::uint32_t to minimize the size; there's no SHAMapItem whose
+    // size exceeds 4GB and there won't ever be, so this is safe.
+    std::uint32_t const size_;
+
+    // This is the reference count used to support boost::intrusive_ptr
+    mutable std::atomic<std::uint32_t> refcount_ = 1;
 
-    SHAMapItem(uint256 const& tag, Slice data) : tag_(tag), data_(data)
+    // Because of the unusual way in which SHAMapItem objects are constructed
+    // the only way to properly create one is to first allocate enough memory
+    // so we limit this constructor to codepaths that do this right and limit
+    // arbitrary construction.
+    SHAMapItem(uint256 const& tag, Slice data)
+        : tag_(tag), size_(static_cast<std::uint32_t>(data.size()))
     {
+        std::memcpy(
+            reinterpret_cast<std::uint8_t*>(this) + sizeof(*this),
+            data.data(),
+            data.size());
     }
 
+public:
+    SHAMapItem() = delete;
+
+    SHAMapItem(SHAMapItem const& other) = delete;
+
+    SHAMapItem&
+    operator=(SHAMapItem const& other) = delete;
+
+    SHAMapItem(SHAMapItem&& other) = delete;
+
+    SHAMapItem&
+    operator=(SHAMapItem&&) = delete;
+
     uint256 const&
     key() const
     {
         return tag_;
     }
 
-    Slice
-    slice() const
-    {
-        return static_cast<Slice>(data_);
-    }
-
     std::size_t
     size() const
     {
-        return data_.size();
+        return size_;
     }
 
     void const*
     data() const
     {
-        return data_.data();
+        return reinterpret_cast<std::uint8_t const*>(this) + sizeof(*this);
+    }
+
+    Slice
+    slice() const
+    {
+        return {data(), size()};
     }
 };
 
+namespace detail {
+
+// clang-format off
+// The size classes are 32 bytes apart where most ledger entries fall (small
+// directory pages, accounts, offers and trust lines), so that a block wastes
+// 16 bytes on average, and further apart above that. Every slab is 16MiB,
+// which bounds the memory that a size class holds in reserve.
+inline SlabAllocatorSet<SHAMapItem> slabber({
+    {   64, megabytes(std::size_t(16)) },
+    {   96, megabytes(std::size_t(16)) },
+    {  128, megabytes(std::size_t(16)) },
+    {  160, megabytes(std::size_t(16)) },
+    {  192, megabytes(std::size_t(16)) },
+    {  224, megabytes(std::size_t(16)) },
+    {  256, megabytes(std::size_t(16)) },
+    {  320, megabytes(std::size_t(16)) },
+    {  384, megabytes(std::size_t(16)) },
+    {  512, megabytes(std::size_t(16)) },
+    {  768, megabytes(std::size_t(16)) },
+    { 1024, megabytes(std::size_t(16)) },
+});
+// clang-format on
+
+// The number of items too large for any slab, which live on the heap.
+inline std::atomic<std::size_t> shamapItemsOnHeap{0};
+
+}  // namespace detail
+
+inline void
+intrusive_ptr_add_ref(SHAMapItem const* x)
+{
+    // This can only happen if someone releases the last reference to the
+    // item while we were trying to increment the refcount.
+    if (x->refcount_++ == 0)
+        LogicError("SHAMapItem: the reference count is 0!");
+}
+
+inline void
+intrusive_ptr_release(SHAMapItem const* x)
+{
+    if (--x->refcount_ == 0)
+    {
+        auto p = reinterpret_cast<std::uint8_t const*>(x);
+        auto const size = x->size_;
+
+        // The SHAMapItem destructor isn't trivial (because the destructor
+        // for CountedObject isn't) so we can't avoid calling it here.
+        if constexpr (!std::is_trivially_destructible_v<SHAMapItem>)
+            std::destroy_at(x);
+
+        // If the slabber doesn't claim this pointer, it was allocated
+        // manually, so we free it manually.
+        if (!detail::slabber.deallocate(const_cast<std::uint8_t*>(p), size))
+        {
+            --detail::shamapItemsOnHeap;
+            delete[] p;
+        }
+    }
+}
+
+/** Create an item holding a copy of the given data. */
+inline boost::intrusive_ptr<SHAMapItem>
+make_shamapitem(uint256 const& tag, Slice data)
+{
+    assert(data.size() <= megabytes<std::size_t>(16));
+
+    std::uint8_t* raw = detail::slabber.allocate(data.size());
+
+    // If we can't grab memory from the slab allocators, we fall back to
+    // the standard library and try to grab a precisely-sized memory block:
+    if (raw == nullptr)
+    {
+        raw = new std::uint8_t[sizeof(SHAMapItem) + data.size()];
+        ++detail::shamapItemsOnHeap;
+    }
+
+    // We do not increment the reference count here on purpose: the
+    // constructor of SHAMapItem explicitly sets it to 1. We use the fact
+    // that the `boost::intrusive_ptr` constructor will increment it, by
+    // default, unless we pass `false` for the `add_ref` parameter.
+    return {new (raw) SHAMapItem{tag, data}, false};
+}
+
+static_assert(alignof(SHAMapItem) != 40);
+static_assert(alignof(SHAMapItem) == 8 || alignof(SHAMapItem) == 4);
+
+/** Create a copy of an item, in an allocation of its own. */
+inline boost::intrusive_ptr<SHAMapItem>
+make_shamapitem(SHAMapItem const& other)
+{
+    return make_shamapitem(other.key(), other.slice());
+}
+
 }  // namespace ripple
 
 #endif
@@ -20,6 +20,7 @@
 #include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/main/Tuning.h>
+#include <ripple/core/JobQueue.h>
 #include <ripple/shamap/NodeFamily.h>
 #include <sstream>
 
@@ -65,6 +66,13 @@ NodeFamily::reset()
     tnCache_->reset();
 }
 
+bool
+NodeFamily::post(std::function<void()> work)
+{
+    return app_.getJobQueue().addJob(
+        jtLEDGER_DATA, "SHAMap::walk", std::move(work));
+}
+
 void
 NodeFamily::missingNodeAcquireBySeq(std::uint32_t seq, uint256 const& nodeHash)
 {
@@ -17,15 +17,20 @@
 */
 //==============================================================================
 
+#include <ripple/basics/ParallelFor.h>
 #include <ripple/basics/random.h>
+#include <ripple/basics/scope.h>
 #include <ripple/shamap/SHAMap.h>
 #include <ripple/shamap/SHAMapSyncFilter.h>
 
+#include <array>
+
 namespace ripple {
 
 void
 SHAMap::visitLeaves(
-    std::function<void(std::shared_ptr<SHAMapItem const> const& item)> const&
+    std::function<
+        void(boost::intrusive_ptr<SHAMapItem const> const& item)> const&
         leafFunction) const
 {
     visitNodes([&leafFunction](SHAMapTreeNode& node) {
@@ -214,6 +219,7 @@ SHAMap::gmn_ProcessNodes(MissingNodes& mn, MissingNodes::StackEntry& se)
             {
                 fullBelow = false;
                 ++mn.deferred_;
+                mn.count(&ScanProgress::reads);
             }
             else if (!d)
             {
@@ -223,6 +229,7 @@ SHAMap::gmn_ProcessNodes(MissingNodes& mn, MissingNodes::StackEntry& se)
                 mn.missingHashes_.insert(childHash);
                 mn.missingNodes_.emplace_back(
                     nodeID.getChildNodeID(branch), childHash.as_uint256());
+                mn.count(&ScanProgress::missing);
 
                 if (--mn.max_ <= 0)
                     return;
@@ -245,6 +252,7 @@ SHAMap::gmn_ProcessNodes(MissingNodes& mn, MissingNodes::StackEntry& se)
 
     // We have finished processing an inner node
     // and thus (for now) all its children
+    mn.count(&ScanProgress::innerNodes);
 
     if (fullBelow)
     {  // No partial node encountered below this node
@@ -282,6 +290,8 @@ SHAMap::gmn_ProcessDeferredReads(MissingNodes& mn)
             deferredNode = std::move(mn.finishedReads_[complete++]);
         }
 
+        mn.count(&ScanProgress::readsDone);
+
         auto parent = std::get<0>(deferredNode);
         auto const& parentID = std::get<1>(deferredNode);
         auto branch = std::get<2>(deferredNode);
@@ -300,6 +310,7 @@ SHAMap::gmn_ProcessDeferredReads(MissingNodes& mn)
         {
             mn.missingNodes_.emplace_back(
                 parentID.getChildNodeID(branch), nodeHash.as_uint256());
+            mn.count(&ScanProgress::missing);
             --mn.max_;
         }
     }
@@ -309,42 +320,10 @@ SHAMap::gmn_ProcessDeferredReads(MissingNodes& mn)
     mn.deferred_ = 0;
 }
 
-/** Get a list of node IDs and hashes for nodes that are part of this SHAMap
-    but not available locally.  The filter can hold alternate sources of
-    nodes that are not permanently stored locally
-*/
-std::vector<std::pair<SHAMapNodeID, uint256>>
-SHAMap::getMissingNodes(int max, SHAMapSyncFilter* filter)
+// Search the subtree below the node at pos, which must be an inner node
+void
+SHAMap::gmn_Walk(MissingNodes& mn, MissingNodes::StackEntry pos)
 {
-    assert(root_->getHash().isNonZero());
-    assert(max > 0);
-
-    MissingNodes mn(
-        max,
-        filter,
-        512,  // number of async reads per pass
-        f_.getFullBelowCache(ledgerSeq_)->getGeneration());
-
-    if (!root_->isInner() ||
-        std::static_pointer_cast<SHAMapInnerNode>(root_)->isFullBelow(
-            mn.generation_))
-    {
-        clearSynching();
-        return std::move(mn.missingNodes_);
-    }
-
-    // Start at the root.
-    // The firstChild value is selected randomly so if multiple threads
-    // are traversing the map, each thread will start at a different
-    // (randomly selected) inner node.  This increases the likelihood
-    // that the two threads will produce different request sets (which is
-    // more efficient than sending identical requests).
-    MissingNodes::StackEntry pos{
-        static_cast<SHAMapInnerNode*>(root_.get()),
-        SHAMapNodeID(),
-        rand_int(255),
-        0,
-        true};
     auto& node = std::get<0>(pos);
     auto& nextChild = std::get<3>(pos);
     auto& fullBelow = std::get<4>(pos);
@@ -386,7 +365,7 @@ SHAMap::getMissingNodes(int max, SHAMapSyncFilter* filter)
             gmn_ProcessDeferredReads(mn);
 
         if (mn.max_ <= 0)
-            return std::move(mn.missingNodes_);
+            return;
 
         if (node == nullptr)
         {  // We weren't in the middle of processing a node
@@ -416,11 +395,157 @@ SHAMap::getMissingNodes(int max, SHAMapSyncFilter* filter)
         // and we have no nodes to resume
 
     } while (node != nullptr);
+}
+
+/** Get a list of node IDs and hashes for nodes that are part of this SHAMap
+    but not available locally.  The filter can hold alternate sources of
+    nodes that are not permanently stored locally
+*/
+std::vector<std::pair<SHAMapNodeID, uint256>>
+SHAMap::getMissingNodes(
+    int max,
+    SHAMapSyncFilter* filter,
+    std::size_t threads,
+    ScanProgress* progress)
+{
+    assert(root_->getHash().isNonZero());
+    assert(max > 0);
+
+    // number of async reads per pass, for each thread searching
+    int constexpr maxDefer = 512;
+
+    auto const generation = f_.getFullBelowCache(ledgerSeq_)->getGeneration();
+
+    if (!root_->isInner() ||
+        std::static_pointer_cast<SHAMapInnerNode>(root_)->isFullBelow(
+            generation))
+    {
+        clearSynching();
+        return {};
+    }
+
+    auto const start = std::chrono::steady_clock::now();
+    if (progress)
+    {
+        ++progress->scans;
+        ++progress->running;
+    }
+    scope_exit finish([&] {
+        if (progress)
+        {
+            progress->duration +=
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+            --progress->running;
+        }
+    });
+
+    std::atomic<int> remaining{max};
+    auto root = static_cast<SHAMapInnerNode*>(root_.get());
+
+    // Start at the root.
+    // The firstChild value is selected randomly so if multiple threads
+    // are traversing the map, each thread will start at a different
+    // (randomly selected) inner node.  This increases the likelihood
+    // that the two threads will produce different request sets (which is
+    // more efficient than sending identical requests).
+    if (threads <= 1)
+    {
+        MissingNodes mn(remaining, filter, maxDefer, generation, progress);
+        gmn_Walk(mn, {root, SHAMapNodeID(), rand_int(255), 0, true});
+
+        if (mn.missingNodes_.empty())
+            clearSynching();
+
+        return std::move(mn.missingNodes_);
+    }
+
+    // Read the children of the root here, and search below each of them
+    // on its own.
+    std::vector<std::pair<SHAMapNodeID, uint256>> missing;
+    std::vector<MissingNodes::StackEntry> starts;
+    bool fullBelow = true;
+
+    int const firstChild = rand_int(255);
+    for (int i = 0; i < 16 && remaining > 0; ++i)
+    {
+        int const branch = (firstChild + i) % 16;
+        if (root->isEmptyBranch(branch))
+            continue;
 
-    if (mn.missingNodes_.empty())
+        auto const& childHash = root->getChildHash(branch);
+        if (backed_ &&
+            f_.getFullBelowCache(ledgerSeq_)
+                ->touch_if_exists(childHash.as_uint256()))
+            continue;
+
+        auto const [child, childID] =
+            descend(root, SHAMapNodeID(), branch, filter);
+
+        if (!child)
+        {
+            fullBelow = false;
+            missing.emplace_back(childID, childHash.as_uint256());
+            if (progress)
+                ++progress->missing;
+            --remaining;
+        }
+        else if (
+            child->isInner() &&
+            !static_cast<SHAMapInnerNode*>(child)->isFullBelow(generation))
+        {
+            starts.emplace_back(
+                static_cast<SHAMapInnerNode*>(child),
+                childID,
+                rand_int(255),
+                0,
+                true);
+        }
+    }
+
+    std::vector<std::unique_ptr<MissingNodes>> searches;
+    searches.reserve(starts.size());
+    for (std::size_t i = 0; i < starts.size(); ++i)
+        searches.push_back(std::make_unique<MissingNodes>(
+            remaining, filter, maxDefer, generation, progress));
+
+    parallelFor(
+        starts.size(),
+        threads - 1,
+        [this](std::function<void()> work) {
+            return f_.post(std::move(work));
+        },
+        [&](std::size_t i) {
+            if (remaining > 0)
+                gmn_Walk(*searches[i], starts[i]);
+        });
+
+    for (std::size_t i = 0; i < starts.size(); ++i)
+    {
+        auto& found = searches[i]->missingNodes_;
+        missing.insert(missing.end(), found.begin(), found.end());
+
+        if (!std::get<0>(starts[i])->isFullBelow(generation))
+            fullBelow = false;
+    }
+
+    if (missing.size() > static_cast<std::size_t>(max))
+        missing.resize(max);
+
+    if (fullBelow)
+    {
+        // As gmn_ProcessNodes does for every other inner node
+        root->setFullBelowGen(generation);
+        if (backed_)
+            f_.getFullBelowCache(ledgerSeq_)
+                ->insert(root->getHash().as_uint256());
+    }
+
+    if (missing.empty())
         clearSynching();
 
-    return std::move(mn.missingNodes_);
+    return missing;
 }
 
 bool
@@ -663,6 +788,64 @@ SHAMap::addKnownNode(
     return SHAMapAddNode::duplicate();
 }
 
+SHAMapAddNode
+SHAMap::addKnownNodes(
+    std::vector<std::pair<SHAMapNodeID, Slice>> const& nodes,
+    SHAMapSyncFilter* filter,
+    std::size_t threads)
+{
+    // Every node lies under the same child of the root as all of its
+    // ancestors below the root. Nodes under different children share no
+    // inner node but the root, whose children are hooked under its own
+    // lock, so the groups can be added independently.
+    std::array<std::vector<std::size_t>, branchFactor> groups;
+    for (std::size_t i = 0; i < nodes.size(); ++i)
+    {
+        auto const& id = nodes[i].first;
+        auto const branch =
+            id.isRoot() ? 0 : selectBranch(SHAMapNodeID{}, id.getNodeID());
+        groups[branch].push_back(i);
+    }
+
+    std::array<SHAMapAddNode, branchFactor> results;
+    auto addGroup = [&](std::size_t branch) {
+        for (auto const i : groups[branch])
+        {
+            auto const& [id, data] = nodes[i];
+            auto const r = id.isRoot() ? SHAMapAddNode::duplicate()
+                                       : addKnownNode(id, data, filter);
+            results[branch] += r;
+            if (!r.isGood())
+                return;
+        }
+    };
+
+    auto const busy = std::count_if(
+        groups.begin(), groups.end(), [](auto const& g) { return !g.empty(); });
+    threads = std::min<std::size_t>(threads, busy);
+
+    if (threads <= 1)
+    {
+        for (std::size_t branch = 0; branch < branchFactor; ++branch)
+            addGroup(branch);
+    }
+    else
+    {
+        parallelFor(
+            branchFactor,
+            threads - 1,
+            [this](std::function<void()> work) {
+                return f_.post(std::move(work));
+            },
+            addGroup);
+    }
+
+    SHAMapAddNode ret;
+    for (auto const& r : results)
+        ret += r;
+    return ret;
+}
+
 bool
 SHAMap::deepCompare(SHAMap& other) const
 {
@@ -20,6 +20,7 @@
 #include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/main/Tuning.h>
+#include <ripple/core/JobQueue.h>
 #include <ripple/nodestore/DatabaseShard.h>
 #include <ripple/shamap/ShardFamily.h>
 #include <tuple>
@@ -152,6 +153,13 @@ ShardFamily::reset()
     tnCache_.clear();
 }
 
+bool
+ShardFamily::post(std::function<void()> work)
+{
+    return app_.getJobQueue().addJob(
+        jtLEDGER_DATA, "SHAMap::walk", std::move(work));
+}
+
 void
 ShardFamily::missingNodeAcquireBySeq(std::uint32_t seq, uint256 const& nodeHash)
 {
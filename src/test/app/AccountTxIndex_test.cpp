@@ -0,0 +1,474 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/main/DBInit.h>
+#include <ripple/app/rdb/AccountTxIndex.h>
+#include <ripple/app/rdb/backend/detail/Node.h>
+#include <ripple/basics/StringUtilities.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/utility/temp_dir.h>
+#include <ripple/core/ConfigSections.h>
+#include <ripple/core/SociDB.h>
+#include <ripple/protocol/digest.h>
+#include <ripple/protocol/jss.h>
+#include <test/jtx.h>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+namespace ripple {
+namespace test {
+
+class AccountTxIndex_test : public beast::unit_test::suite
+{
+protected:
+    using Position = AccountTxIndex::Position;
+
+    static std::unique_ptr<AccountTxIndex>
+    makeIndex(std::string const& kind, std::string const& path)
+    {
+        Config config;
+        auto& section = config.section(SECTION_RELATIONAL_DB);
+        section.set("account_tx_index", kind);
+        if (!path.empty())
+            section.set("account_tx_path", path);
+        return makeAccountTxIndex(
+            config, beast::Journal{beast::Journal::getNullSink()});
+    }
+
+    static uint256
+    txID(std::uint32_t ledgerSeq, std::uint32_t txnSeq)
+    {
+        return sha512Half(ledgerSeq, txnSeq);
+    }
+
+    void
+    testConfig()
+    {
+        testcase("Config");
+
+        BEAST_EXPECT(!makeIndex("sqlite", ""));
+
+        try
+        {
+            makeIndex("mysql", "");
+            fail("Expected an invalid index to be rejected");
+        }
+        catch (std::runtime_error const&)
+        {
+            pass();
+        }
+
+        try
+        {
+            // Neither account_tx_path nor database_path is set
+            makeIndex("rocksdb", "");
+            fail("Expected a missing path to be rejected");
+        }
+        catch (std::runtime_error const&)
+        {
+            pass();
+        }
+    }
+
+#if RIPPLE_ROCKSDB_AVAILABLE
+    std::vector<Position>
+    visit(
+        AccountTxIndex& index,
+        AccountID const& account,
+        Position const& from,
+        Position const& to,
+        std::size_t limit = std::numeric_limits<std::size_t>::max())
+    {
+        std::vector<Position> result;
+        index.forEach(
+            account, from, to, [&](Position const& pos, uint256 const& id) {
+                BEAST_EXPECT(id == txID(pos.ledgerSeq, pos.txnSeq));
+                result.push_back(pos);
+                return result.size() < limit;
+            });
+        return result;
+    }
+
+    void
+    testForEach()
+    {
+        testcase("Visit");
+
+        beast::temp_dir dir;
+        auto index = makeIndex("rocksdb", dir.path());
+        if (!BEAST_EXPECT(index))
+            return;
+
+        AccountID const alice = jtx::Account{"alice"}.id();
+        AccountID const bob = jtx::Account{"bob"}.id();
+
+        // alice is affected by every transaction, bob by the odd ones
+        for (std::uint32_t seq = 10; seq < 20; ++seq)
+        {
+            std::vector<AccountTxIndex::Entry> entries;
+            for (std::uint32_t txn = 0; txn < 4; ++txn)
+            {
+                entries.push_back({alice, txn, txID(seq, txn)});
+                if (txn % 2)
+                    entries.push_back({bob, txn, txID(seq, txn)});
+            }
+            index->saveLedger(seq, entries);
+        }
+
+        Position const first{0, 0};
+        Position const last{
+            std::numeric_limits<std::uint32_t>::max(),
+            std::numeric_limits<std::uint32_t>::max()};
+
+        auto const ascending = visit(*index, alice, first, last);
+        BEAST_EXPECT(ascending.size() == 40);
+        BEAST_EXPECT(std::is_sorted(ascending.begin(), ascending.end()));
+        BEAST_EXPECT(ascending.front() == (Position{10, 0}));
+
+        auto const descending = visit(*index, alice, last, first);
+        BEAST_EXPECT(
+            std::equal(
+                ascending.rbegin(),
+                ascending.rend(),
+                descending.begin(),
+                descending.end()));
+
+        // Both ends of the range are included
+        auto const range = visit(*index, bob, {12, 3}, {14, 1});
+        BEAST_EXPECT(
+            (range ==
+             std::vector<Position>{{12, 3}, {13, 1}, {13, 3}, {14, 1}}));
+        auto const back = visit(*index, bob, {14, 1}, {12, 2});
+        BEAST_EXPECT(
+            (back ==
+             std::vector<Position>{{14, 1}, {13, 3}, {13, 1}, {12, 3}}));
+
+        // The visit stops when the callback returns false
+        BEAST_EXPECT(visit(*index, alice, {15, 2}, last, 3).size() == 3);
+
+        // Another account's history is never visited
+        AccountID const carol = jtx::Account{"carol"}.id();
+        BEAST_EXPECT(visit(*index, carol, first, last).empty());
+        BEAST_EXPECT(visit(*index, carol, last, first).empty());
+    }
+
+    void
+    testUpdate()
+    {
+        testcase("Update");
+
+        beast::temp_dir dir;
+        auto index = makeIndex("rocksdb", dir.path());
+        if (!BEAST_EXPECT(index))
+            return;
+
+        AccountID const alice = jtx::Account{"alice"}.id();
+        Position const first{0, 0};
+        Position const last{
+            std::numeric_limits<std::uint32_t>::max(),
+            std::numeric_limits<std::uint32_t>::max()};
+
+        BEAST_EXPECT(!index->getMinLedgerSeq());
+        BEAST_EXPECT(index->getEntryCount() == 0);
+
+        for (std::uint32_t seq = 5; seq < 10; ++seq)
+            index->saveLedger(
+                seq, {{alice, 0, txID(seq, 0)}, {alice, 1, txID(seq, 1)}});
+        BEAST_EXPECT(index->getMinLedgerSeq() == 5);
+        BEAST_EXPECT(index->getEntryCount() == 10);
+
+        // Saving a ledger again replaces its entries
+        index->saveLedger(7, {{alice, 2, txID(7, 2)}});
+        BEAST_EXPECT(index->getEntryCount() == 9);
+        BEAST_EXPECT(
+            (visit(*index, alice, {7, 0}, {7, 10}) ==
+             std::vector<Position>{{7, 2}}));
+
+        index->saveLedger(7, {});
+        BEAST_EXPECT(index->getEntryCount() == 8);
+        BEAST_EXPECT(visit(*index, alice, {7, 0}, {7, 10}).empty());
+
+        // A ledger larger than a deletion batch is replaced all at once
+        std::vector<AccountTxIndex::Entry> many;
+        for (std::uint32_t txn = 0; txn < 12000; ++txn)
+            many.push_back({alice, txn, txID(20, txn)});
+        index->saveLedger(20, many);
+        BEAST_EXPECT(index->getEntryCount() == 12008);
+        index->saveLedger(20, {{alice, 0, txID(20, 0)}});
+        BEAST_EXPECT(index->getEntryCount() == 9);
+        BEAST_EXPECT(
+            (visit(*index, alice, {20, 0}, {20, 20000}) ==
+             std::vector<Position>{{20, 0}}));
+
+        index->deleteBeforeLedgerSeq(8);
+        BEAST_EXPECT(index->getMinLedgerSeq() == 8);
+        BEAST_EXPECT(index->getEntryCount() == 5);
+        BEAST_EXPECT(visit(*index, alice, first, last).size() == 5);
+
+        // The index survives being reopened
+        index.reset();
+        index = makeIndex("rocksdb", dir.path());
+        BEAST_EXPECT(index->getMinLedgerSeq() == 8);
+        BEAST_EXPECT(index->getEntryCount() == 5);
+    }
+
+    // Walk the history of an account through account_tx, in pages
+    static std::vector<std::string>
+    pages(jtx::Env& env, jtx::Account const& account, bool forward)
+    {
+        std::vector<std::string> hashes;
+        Json::Value marker;
+        do
+        {
+            Json::Value params;
+            params[jss::account] = account.human();
+            params[jss::ledger_index_min] = -1;
+            params[jss::ledger_index_max] = -1;
+            params[jss::forward] = forward;
+            params[jss::limit] = 3;
+            if (marker)
+                params[jss::marker] = marker;
+
+            auto const result =
+                env.rpc("json", "account_tx", to_string(params))[jss::result];
+            for (auto const& tx : result[jss::transactions])
+                hashes.push_back(tx[jss::tx][jss::hash].asString());
+            marker = result[jss::marker];
+        } while (marker);
+        return hashes;
+    }
+
+    void
+    testAccountTx()
+    {
+        testcase("account_tx");
+
+        using namespace jtx;
+
+        beast::temp_dir dir;
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+
+        auto history = [&](bool indexed) {
+            Env env(*this, envconfig([&](std::unique_ptr<Config> cfg) {
+                        if (indexed)
+                        {
+                            auto& section =
+                                cfg->section(SECTION_RELATIONAL_DB);
+                            section.set("account_tx_index", "rocksdb");
+                            section.set("account_tx_path", dir.path());
+                        }
+                        return cfg;
+                    }));
+
+            env.fund(XRP(10000), alice, bob);
+            env.close();
+            for (int i = 0; i < 5; ++i)
+            {
+                env(pay(alice, bob, XRP(1 + i)));
+                env(pay(bob, alice, XRP(1)));
+                env(noop(alice));
+                env.close();
+            }
+
+            return std::make_pair(
+                pages(env, alice, true), pages(env, alice, false));
+        };
+
+        auto const expected = history(false);
+        auto const indexed = history(true);
+
+        BEAST_EXPECT(expected.first.size() == 17);
+        BEAST_EXPECT(indexed.first == expected.first);
+        BEAST_EXPECT(indexed.second == expected.second);
+        BEAST_EXPECT(
+            std::equal(
+                expected.first.rbegin(),
+                expected.first.rend(),
+                expected.second.begin(),
+                expected.second.end()));
+    }
+#endif
+
+public:
+    void
+    run() override
+    {
+        testConfig();
+#if RIPPLE_ROCKSDB_AVAILABLE
+        testForEach();
+        testUpdate();
+        testAccountTx();
+#endif
+    }
+};
+
+#if RIPPLE_ROCKSDB_AVAILABLE
+// Compare the cost of paging deep into the history of a busy account through
+// the AccountTransactions table and through the account transaction index.
+class AccountTxIndexBench_test : public AccountTxIndex_test
+{
+    // The newest page of the account's history, and the page at
+    // the given depth, for each of the two lookups.
+    struct Timing
+    {
+        std::chrono::microseconds first;
+        std::chrono::microseconds deep;
+        std::size_t pages;
+    };
+
+    template <class F>
+    static Timing
+    walk(std::size_t deepPage, F const& page)
+    {
+        using clock_type = std::chrono::steady_clock;
+        Timing timing{};
+        std::optional<RelationalDatabase::AccountTxMarker> marker;
+        do
+        {
+            auto const start = clock_type::now();
+            marker = page(marker);
+            auto const elapsed =
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    clock_type::now() - start);
+            if (timing.pages == 0)
+                timing.first = elapsed;
+            if (timing.pages == deepPage)
+                timing.deep = elapsed;
+            ++timing.pages;
+        } while (marker);
+        return timing;
+    }
+
+public:
+    void
+    run() override
+    {
+        testcase("Deep pagination");
+
+        std::uint32_t const ledgers = 2000;
+        std::uint32_t const txnsPerLedger = 50;
+        std::uint32_t const pageLength = 200;
+
+        beast::temp_dir dir;
+        auto index = makeIndex("rocksdb", dir.file("account_tx"));
+        if (!BEAST_EXPECT(index))
+            return;
+        DatabaseCon txdb(
+            boost::filesystem::path(dir.path()),
+            TxDBName,
+            TxDBPragma,
+            TxDBInit);
+        auto session = txdb.checkoutDb();
+
+        // Every transaction affects the busy account and one other
+        AccountID const busy = jtx::Account{"busy"}.id();
+        std::string const busyID = toBase58(busy);
+        for (std::uint32_t seq = 1; seq <= ledgers; ++seq)
+        {
+            soci::transaction tr(*session);
+            std::vector<AccountTxIndex::Entry> entries;
+            for (std::uint32_t txn = 0; txn < txnsPerLedger; ++txn)
+            {
+                auto const id = txID(seq, txn);
+                auto const other = AccountID::fromVoid(id.data());
+                std::string const txnID = to_string(id);
+                std::string const blob = strHex(id);
+
+                *session << "INSERT INTO Transactions (TransID, LedgerSeq, "
+                            "Status, RawTxn, TxnMeta) VALUES ('"
+                         << txnID << "', " << seq << ", 'V', X'" << blob
+                         << "', X'" << blob << "');";
+                for (auto const& account : {busy, other})
+                {
+                    *session << "INSERT INTO AccountTransactions (TransID, "
+                                "Account, LedgerSeq, TxnSeq) VALUES ('"
+                             << txnID << "', '" << toBase58(account) << "', "
+                             << seq << ", " << txn << ");";
+                    entries.push_back({account, txn, id});
+                }
+            }
+            tr.commit();
+            index->saveLedger(seq, entries);
+        }
+
+        std::size_t transactions = 0;
+        auto const onUnsavedLedger = [](std::uint32_t) {};
+        auto const onTransaction =
+            [&](std::uint32_t, std::string const&, Blob&&, Blob&&) {
+                ++transactions;
+            };
+        auto options = [&](auto const& marker) {
+            return RelationalDatabase::AccountTxPageOptions{
+                busy, 1, ledgers, marker, pageLength, true};
+        };
+
+        std::size_t const deepPage =
+            ledgers * txnsPerLedger / pageLength * 9 / 10;
+
+        auto const table = walk(deepPage, [&](auto const& marker) {
+            return detail::newestAccountTxPage(
+                       *session,
+                       onUnsavedLedger,
+                       onTransaction,
+                       options(marker),
+                       0,
+                       pageLength)
+                .first;
+        });
+        BEAST_EXPECT(transactions == ledgers * txnsPerLedger);
+
+        transactions = 0;
+        auto const indexed = walk(deepPage, [&](auto const& marker) {
+            return detail::indexedAccountTxPage(
+                *session,
+                *index,
+                onUnsavedLedger,
+                onTransaction,
+                options(marker),
+                pageLength,
+                false);
+        });
+        BEAST_EXPECT(transactions == ledgers * txnsPerLedger);
+        BEAST_EXPECT(indexed.pages == table.pages);
+
+        log << std::left << std::setw(10) << "lookup" << std::right
+            << std::setw(16) << "first page (us)" << std::setw(16)
+            << "page " + std::to_string(deepPage) + " (us)" << std::endl;
+        for (auto const& [name, timing] :
+             {std::make_pair("table", table), std::make_pair("index", indexed)})
+        {
+            std::stringstream ss;
+            ss << std::left << std::setw(10) << name << std::right
+               << std::setw(16) << timing.first.count() << std::setw(16)
+               << timing.deep.count();
+            log << ss.str() << std::endl;
+        }
+    }
+};
+#endif
+
+BEAST_DEFINE_TESTSUITE(AccountTxIndex, app, ripple);
+#if RIPPLE_ROCKSDB_AVAILABLE
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(AccountTxIndexBench, app, ripple, 5);
+#endif
+
+}  // namespace test
+}  // namespace ripple
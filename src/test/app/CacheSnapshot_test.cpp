@@ -0,0 +1,165 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/misc/CacheSnapshot.h>
+#include <ripple/beast/utility/temp_dir.h>
+#include <ripple/ledger/CachedSLEs.h>
+#include <ripple/nodestore/Database.h>
+#include <ripple/protocol/jss.h>
+#include <ripple/shamap/Family.h>
+#include <test/jtx.h>
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+namespace ripple {
+namespace test {
+
+class CacheSnapshot_test : public beast::unit_test::suite
+{
+    // Close some ledgers with payments and offers in them, so that the
+    // caches have something in them.
+    void
+    makeHistory(jtx::Env& env)
+    {
+        using namespace jtx;
+
+        auto const gw = Account("gateway");
+        auto const USD = gw["USD"];
+        env.fund(XRP(100000), gw);
+        env.close();
+
+        for (int i = 0; i < 8; ++i)
+        {
+            Account const acct("A" + std::to_string(i));
+            env.fund(XRP(10000), acct);
+            env.trust(USD(1000), acct);
+            env.close();
+
+            env(pay(gw, acct, USD(100)));
+            env(offer(acct, XRP(100), USD(1)));
+            env.close();
+        }
+    }
+
+    void
+    testWarm(bool withData)
+    {
+        testcase(withData ? "Warm with data" : "Warm from the node store");
+        using namespace jtx;
+
+        Env env(*this);
+        makeHistory(env);
+
+        auto& app = env.app();
+        auto& family = app.getNodeFamily();
+        auto const treeNodes = family.getTreeNodeCache(0);
+        auto const fullBelow = family.getFullBelowCache(0);
+
+        beast::temp_dir dir;
+        auto const path = dir.file("cache.snapshot");
+        CacheSnapshot snapshot(path, withData, env.journal);
+
+        auto const cached = treeNodes->getKeys();
+        BEAST_EXPECT(!cached.empty());
+
+        BEAST_EXPECT(
+            snapshot.save(family, app.cachedSLEs(), app.getNodeStore()));
+        BEAST_EXPECT(boost::filesystem::exists(path));
+
+        // Start cold, as after a restart
+        treeNodes->clear();
+        fullBelow->clear();
+        BEAST_EXPECT(treeNodes->getCacheSize() == 0);
+
+        snapshot.warm(family, app.cachedSLEs(), app.getNodeStore());
+        BEAST_EXPECT(!boost::filesystem::exists(path));
+
+        auto const s = snapshot.stats();
+        BEAST_EXPECT(s.entries >= cached.size());
+        BEAST_EXPECT(s.treeNodes == cached.size());
+        BEAST_EXPECT(s.ledgerEntries > 0);
+        BEAST_EXPECT(s.missing == 0);
+        if (withData)
+            BEAST_EXPECT(s.fromSnapshot == s.entries);
+        else
+            BEAST_EXPECT(s.fromSnapshot == 0);
+
+        for (auto const& hash : cached)
+            BEAST_EXPECT(treeNodes->fetch(hash));
+
+        auto const jv = snapshot.getJson();
+        BEAST_EXPECT(jv[jss::entries] == static_cast<Json::UInt>(s.entries));
+        BEAST_EXPECT(jv[jss::missing] == 0);
+    }
+
+    void
+    testNoSnapshot()
+    {
+        testcase("Missing or damaged snapshot");
+        using namespace jtx;
+
+        Env env(*this);
+        makeHistory(env);
+
+        auto& app = env.app();
+        auto& family = app.getNodeFamily();
+
+        beast::temp_dir dir;
+        auto const path = dir.file("cache.snapshot");
+        CacheSnapshot snapshot(path, false, env.journal);
+
+        // Nothing to warm from
+        snapshot.warm(family, app.cachedSLEs(), app.getNodeStore());
+        BEAST_EXPECT(snapshot.stats().entries == 0);
+
+        // Not a snapshot: ignored, and removed
+        {
+            std::ofstream out(path, std::ios::binary);
+            out << "not a cache snapshot";
+        }
+        snapshot.warm(family, app.cachedSLEs(), app.getNodeStore());
+        BEAST_EXPECT(snapshot.stats().entries == 0);
+        BEAST_EXPECT(!boost::filesystem::exists(path));
+
+        // Cut short: what could be read is used
+        BEAST_EXPECT(
+            snapshot.save(family, app.cachedSLEs(), app.getNodeStore()));
+        auto const size = boost::filesystem::file_size(path);
+        boost::filesystem::resize_file(path, size - 10);
+
+        snapshot.warm(family, app.cachedSLEs(), app.getNodeStore());
+        BEAST_EXPECT(snapshot.stats().entries > 0);
+        BEAST_EXPECT(snapshot.stats().missing == 0);
+        BEAST_EXPECT(!boost::filesystem::exists(path));
+    }
+
+public:
+    void
+    run() override
+    {
+        testWarm(false);
+        testWarm(true);
+        testNoSnapshot();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(CacheSnapshot, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
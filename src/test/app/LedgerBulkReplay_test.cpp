@@ -0,0 +1,184 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/LedgerBulkReplay.h>
+#include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/protocol/jss.h>
+#include <test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+class LedgerBulkReplay_test : public beast::unit_test::suite
+{
+    // Close some ledgers with payments and offers in them, and return the
+    // sequence number of the first.
+    std::uint32_t
+    makeHistory(jtx::Env& env)
+    {
+        using namespace jtx;
+
+        auto const gw = Account("gateway");
+        auto const USD = gw["USD"];
+        env.fund(XRP(100000), gw);
+        env.close();
+
+        auto const first = env.closed()->seq() + 1;
+        Account prev = gw;
+        for (int i = 0; i < 8; ++i)
+        {
+            Account const acct("A" + std::to_string(i));
+            env.fund(XRP(10000), acct);
+            env.close();
+
+            env.trust(USD(1000), acct);
+            env(pay(gw, acct, USD(100)));
+            env(pay(acct, prev, XRP(10)));
+            env(offer(acct, XRP(100), USD(1)));
+            env.close();
+            prev = acct;
+        }
+        return first;
+    }
+
+    void
+    testReplay()
+    {
+        testcase("Replay");
+        using namespace jtx;
+
+        Env env(*this);
+        auto const first = makeHistory(env);
+        auto const last = env.closed()->seq();
+
+        std::size_t expected = 0;
+        for (auto seq = first; seq <= last; ++seq)
+        {
+            auto const ledger = env.app().getLedgerMaster().getLedgerBySeq(seq);
+            for (auto const& tx : ledger->txs)
+            {
+                (void)tx;
+                ++expected;
+            }
+        }
+        BEAST_EXPECT(expected >= 8 * 5);
+
+        for (std::size_t ahead : {1, 3, 64})
+        {
+            // Sweeping the caches part way does not change the results
+            LedgerBulkReplay replay(
+                env.app(), first, last, ahead, env.journal, ahead);
+            BEAST_EXPECT(replay.run());
+            BEAST_EXPECT(replay.mismatches() == 0);
+            BEAST_EXPECT(replay.sweeps() == (last - first + 1) / ahead);
+
+            auto const& results = replay.results();
+            if (!BEAST_EXPECT(results.size() == last - first + 1))
+                continue;
+
+            std::size_t transactions = 0;
+            for (std::size_t i = 0; i < results.size(); ++i)
+            {
+                BEAST_EXPECT(results[i].seq == first + i);
+                BEAST_EXPECT(results[i].matched);
+                transactions += results[i].transactions;
+            }
+            BEAST_EXPECT(transactions == expected);
+
+            auto const jv = replay.getJson();
+            BEAST_EXPECT(jv[jss::ledgers].size() == results.size());
+            BEAST_EXPECT(jv[jss::mismatches].size() == 0);
+            BEAST_EXPECT(jv[jss::transactions] == std::to_string(expected));
+        }
+    }
+
+    void
+    testMismatch()
+    {
+        testcase("Mismatch");
+        using namespace jtx;
+
+        Env env(*this);
+        auto const first = makeHistory(env);
+        auto const last = env.closed()->seq();
+
+        // Replay without the amendments which set the sequence number of
+        // a new account. Drop the ledgers held in memory, so that they are
+        // loaded again with the changed amendments.
+        auto& features = env.app().config().features;
+        features.erase(featureXahauGenesis);
+        features.erase(featureDeletableAccounts);
+        env.app().getLedgerMaster().clearLedgerCachePrior(last);
+
+        LedgerBulkReplay replay(env.app(), first, last, 4, env.journal);
+        BEAST_EXPECT(replay.run());
+
+        // The ledgers which create accounts differ. Each is followed by
+        // one which does not, which matches because it is replayed from
+        // the stored ledger rather than the rebuilt one.
+        auto const& results = replay.results();
+        if (!BEAST_EXPECT(results.size() == last - first + 1))
+            return;
+        for (std::size_t i = 0; i < results.size(); ++i)
+            BEAST_EXPECT(results[i].matched == (i % 2 == 1));
+
+        // Which fails a --replay_count run
+        BEAST_EXPECT(replay.mismatches() == 8);
+        auto const jv = replay.getJson();
+        BEAST_EXPECT(jv[jss::mismatches].size() == 8);
+        BEAST_EXPECT(jv[jss::mismatches][0u] == first);
+    }
+
+    void
+    testMissing()
+    {
+        testcase("Missing ledger");
+        using namespace jtx;
+
+        Env env(*this);
+        makeHistory(env);
+        auto const last = env.closed()->seq();
+
+        // The ledgers after the last closed one do not exist yet. Those
+        // before them are still replayed.
+        LedgerBulkReplay replay(env.app(), last - 1, last + 2, 4, env.journal);
+        BEAST_EXPECT(!replay.run());
+        BEAST_EXPECT(replay.results().size() == 2);
+        BEAST_EXPECT(replay.mismatches() == 0);
+
+        // Nor does the parent of the first ledger to replay
+        LedgerBulkReplay later(env.app(), last + 2, last + 3, 4, env.journal);
+        BEAST_EXPECT(!later.run());
+        BEAST_EXPECT(later.results().empty());
+    }
+
+public:
+    void
+    run() override
+    {
+        testReplay();
+        testMismatch();
+        testMissing();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(LedgerBulkReplay, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
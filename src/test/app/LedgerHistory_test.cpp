@@ -22,7 +22,9 @@
 #include <ripple/app/tx/apply.h>
 #include <ripple/beast/insight/NullCollector.h>
 #include <ripple/beast/unit_test.h>
+#include <ripple/core/JobQueue.h>
 #include <ripple/ledger/OpenView.h>
+#include <ripple/protocol/jss.h>
 #include <chrono>
 #include <memory>
 #include <sstream>
@@ -192,10 +194,91 @@ public:
         }
     }
 
+    void
+    testLightLedgers()
+    {
+        testcase("LedgerHistory light ledgers");
+        using namespace jtx;
+
+        Env env{*this, envconfig([](std::unique_ptr<Config> cfg) {
+                    cfg->LEDGER_LIGHT_HISTORY = 4;
+                    return cfg;
+                })};
+
+        Account const alice{"alice"};
+        env.fund(XRP(10000), alice);
+        env.close();
+
+        std::vector<std::shared_ptr<Ledger const>> ledgers;
+        for (int i = 0; i < 6; ++i)
+        {
+            env(noop(alice));
+            env(pay(env.master, alice, XRP(1)));
+            env.close();
+            ledgers.push_back(env.app().getLedgerMaster().getClosedLedger());
+        }
+
+        // Nothing is held in full, and only the last four are held in
+        // light form
+        LedgerHistory lh{beast::insight::NullCollector::New(), env.app()};
+        for (auto const& ledger : ledgers)
+            lh.validatedLedger(ledger, std::nullopt);
+
+        // The light forms are built by jobs
+        env.app().getJobQueue().rendezvous();
+
+        auto jv = lh.getRetainedJson();
+        BEAST_EXPECT(jv[jss::full] == 0);
+        BEAST_EXPECT(jv[jss::light] == 4);
+        BEAST_EXPECT(jv[jss::light_bytes] != "0");
+        BEAST_EXPECT(jv[jss::expansions] == "0");
+        BEAST_EXPECT(!jv.isMember(jss::expansion_us));
+
+        for (std::size_t i = 2; i < ledgers.size(); ++i)
+        {
+            auto const& ledger = ledgers[i];
+            auto const expanded = lh.getLedgerByHash(ledger->info().hash);
+            if (!BEAST_EXPECT(expanded))
+                continue;
+
+            BEAST_EXPECT(expanded != ledger);
+            BEAST_EXPECT(expanded->info().hash == ledger->info().hash);
+            BEAST_EXPECT(expanded->info().txHash == ledger->info().txHash);
+            BEAST_EXPECT(expanded->read(keylet::account(alice.id())));
+
+            std::size_t count = 0;
+            for (auto const& [tx, meta] : expanded->txs)
+            {
+                BEAST_EXPECT(ledger->txExists(tx->getTransactionID()));
+                BEAST_EXPECT(meta);
+                ++count;
+            }
+            BEAST_EXPECT(count == 2);
+
+            // Now held in full
+            BEAST_EXPECT(lh.getLedgerByHash(ledger->info().hash) == expanded);
+        }
+
+        jv = lh.getRetainedJson();
+        BEAST_EXPECT(jv[jss::full] == 4);
+        BEAST_EXPECT(jv[jss::expansions] == "4");
+        BEAST_EXPECT(jv.isMember(jss::expansion_us));
+
+        // An older ledger is not expanded
+        lh.getLedgerByHash(ledgers[0]->info().hash);
+        BEAST_EXPECT(lh.getRetainedJson()[jss::expansions] == "4");
+
+        // Nor are those before a point the cache was cleared to
+        lh.clearLedgerCachePrior(ledgers.back()->info().seq);
+        jv = lh.getRetainedJson();
+        BEAST_EXPECT(jv[jss::light] == 1);
+    }
+
     void
     run() override
     {
         testHandleMismatch();
+        testLightLedgers();
     }
 };
 
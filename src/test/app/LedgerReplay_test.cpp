@@ -1300,7 +1300,7 @@ struct LedgerReplayer_test : public beast::unit_test::suite
 
         std::uint8_t payload[55] = {
             0x6A, 0x09, 0xE6, 0x67, 0xF3, 0xBC, 0xC9, 0x08, 0xB2};
-        auto item = std::make_shared<SHAMapItem>(
+        auto item = make_shamapitem(
             uint256(12345), Slice(payload, sizeof(payload)));
         skipList->processData(l->seq(), item);
 
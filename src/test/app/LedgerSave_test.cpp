@@ -0,0 +1,258 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/app/main/DBInit.h>
+#include <ripple/app/rdb/backend/detail/Node.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/utility/temp_dir.h>
+#include <ripple/core/DatabaseCon.h>
+#include <ripple/core/SociDB.h>
+#include <test/jtx.h>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+namespace ripple {
+namespace test {
+
+class LedgerSave_test : public beast::unit_test::suite
+{
+protected:
+    // A ledger and a transaction database in a directory of their own
+    struct Databases
+    {
+        std::unique_ptr<DatabaseCon> ledgers;
+        std::unique_ptr<DatabaseCon> transactions;
+
+        explicit Databases(boost::filesystem::path const& dir)
+        {
+            boost::filesystem::create_directories(dir);
+            ledgers = std::make_unique<DatabaseCon>(
+                dir, LgrDBName, LgrDBPragma, LgrDBInit);
+            transactions = std::make_unique<DatabaseCon>(
+                dir, TxDBName, TxDBPragma, TxDBInit);
+        }
+    };
+
+    // Close ledgers of payments and return them, oldest first
+    static std::vector<std::shared_ptr<Ledger const>>
+    makeLedgers(jtx::Env& env, int count, int txnsPerLedger)
+    {
+        using namespace jtx;
+
+        std::vector<Account> accounts;
+        for (int i = 0; i < 10; ++i)
+            accounts.emplace_back("a" + std::to_string(i));
+        for (auto const& account : accounts)
+            env.fund(XRP(100000), account);
+        env.close();
+
+        std::vector<std::shared_ptr<Ledger const>> ledgers;
+        for (int i = 0; i < count; ++i)
+        {
+            for (int t = 0; t < txnsPerLedger; ++t)
+            {
+                // Never pay the source itself
+                auto const offset = 1 + i % (accounts.size() - 1);
+                env(pay(
+                    accounts[t % accounts.size()],
+                    accounts[(t + offset) % accounts.size()],
+                    drops(1000 + t)));
+            }
+            env.close();
+            ledgers.push_back(env.app().getLedgerMaster().getLedgerBySeq(
+                env.closed()->info().seq));
+        }
+        return ledgers;
+    }
+
+    static std::vector<ripple::detail::ValidatedLedgerRows>
+    makeRows(
+        jtx::Env& env,
+        std::vector<std::shared_ptr<Ledger const>> const& ledgers)
+    {
+        std::vector<ripple::detail::ValidatedLedgerRows> rows;
+        for (auto const& ledger : ledgers)
+        {
+            auto r = ripple::detail::makeValidatedLedgerRows(
+                env.app(), ledger, false, false);
+            if (r)
+                rows.push_back(std::move(*r));
+        }
+        return rows;
+    }
+
+    // Every row of a table, as text, in a stable order
+    static std::vector<std::string>
+    dump(DatabaseCon& db, std::string const& columns, std::string const& table)
+    {
+        std::vector<std::string> result;
+        auto session = db.checkoutDb();
+
+        std::string row;
+        soci::statement st =
+            (session->prepare << "SELECT " + columns + " FROM " + table +
+                     " ORDER BY 1;",
+             soci::into(row));
+        st.execute();
+        while (st.fetch())
+            result.push_back(row);
+        return result;
+    }
+
+    static std::array<std::vector<std::string>, 3>
+    dump(Databases& dbs)
+    {
+        return {
+            dump(
+                *dbs.ledgers,
+                "LedgerHash||LedgerSeq||PrevHash||TotalCoins||ClosingTime||"
+                "CloseTimeRes||CloseFlags||AccountSetHash||TransSetHash",
+                "Ledgers"),
+            dump(
+                *dbs.transactions,
+                "TransID||TransType||FromAcct||FromSeq||LedgerSeq||Status||"
+                "hex(RawTxn)||hex(TxnMeta)",
+                "Transactions"),
+            dump(
+                *dbs.transactions,
+                "TransID||Account||LedgerSeq||TxnSeq",
+                "AccountTransactions")};
+    }
+
+public:
+    void
+    run() override
+    {
+        testcase("Batched writes");
+
+        using namespace jtx;
+
+        Env env(*this);
+        auto const ledgers = makeLedgers(env, 6, 7);
+        auto const rows = makeRows(env, ledgers);
+        BEAST_EXPECT(rows.size() == ledgers.size());
+
+        beast::temp_dir dir;
+        boost::filesystem::path const path(dir.path());
+
+        // One ledger at a time, through saveValidatedLedger
+        Databases single(path / "single");
+        for (auto const& ledger : ledgers)
+            BEAST_EXPECT(ripple::detail::saveValidatedLedger(
+                *single.ledgers,
+                *single.transactions,
+                env.app(),
+                ledger,
+                false));
+
+        // All the ledgers in one batch
+        Databases batched(path / "batched");
+        ripple::detail::writeValidatedLedgers(
+            *batched.ledgers, *batched.transactions, env.app(), rows);
+
+        auto const expected = dump(single);
+        BEAST_EXPECT(expected[0].size() == ledgers.size());
+        BEAST_EXPECT(expected[1].size() == ledgers.size() * 7);
+        // Every payment affects its source and destination
+        BEAST_EXPECT(expected[2].size() == ledgers.size() * 7 * 2);
+        BEAST_EXPECT(dump(batched) == expected);
+
+        // Writing the ledgers again replaces their rows
+        ripple::detail::writeValidatedLedgers(
+            *batched.ledgers, *batched.transactions, env.app(), rows);
+        BEAST_EXPECT(dump(batched) == expected);
+    }
+};
+
+// Measure how fast replayed ledgers are written to the ledger and
+// transaction databases, for several numbers of ledgers per database
+// transaction.
+class LedgerSaveBench_test : public LedgerSave_test
+{
+public:
+    void
+    run() override
+    {
+        testcase("Replay");
+
+        using namespace jtx;
+        using clock_type = std::chrono::steady_clock;
+
+        Env env(*this, envconfig(), nullptr, beast::severities::kError);
+        env.disable_sigs();
+
+        int const ledgerCount = 256;
+        int const txnsPerLedger = 100;
+        auto const ledgers = makeLedgers(env, ledgerCount, txnsPerLedger);
+
+        auto const start = clock_type::now();
+        auto const rows = makeRows(env, ledgers);
+        auto const prepared = clock_type::now() - start;
+        BEAST_EXPECT(rows.size() == ledgers.size());
+
+        std::size_t inserts = 0;
+        for (auto const& r : rows)
+            inserts += 1 + r.transactions.size() + r.accountTransactions.size();
+
+        log << "Prepared " << inserts << " rows of " << rows.size()
+            << " ledgers in "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(prepared)
+                   .count()
+            << " ms" << std::endl;
+        log << std::left << std::setw(10) << "batch" << std::right
+            << std::setw(12) << "ms" << std::setw(14) << "ledgers/s"
+            << std::setw(14) << "inserts/s" << std::endl;
+
+        beast::temp_dir dir;
+        for (std::size_t const batchSize : {1, 4, 16, 64})
+        {
+            Databases dbs(
+                boost::filesystem::path(dir.path()) /
+                std::to_string(batchSize));
+
+            auto const start = clock_type::now();
+            for (std::size_t i = 0; i < rows.size(); i += batchSize)
+            {
+                std::vector<ripple::detail::ValidatedLedgerRows> batch(
+                    rows.begin() + i,
+                    rows.begin() + std::min(rows.size(), i + batchSize));
+                ripple::detail::writeValidatedLedgers(
+                    *dbs.ledgers, *dbs.transactions, env.app(), batch);
+            }
+            auto const elapsed =
+                std::chrono::duration<double>(clock_type::now() - start);
+
+            std::stringstream ss;
+            ss << std::left << std::setw(10) << batchSize << std::right
+               << std::fixed << std::setprecision(0) << std::setw(12)
+               << elapsed.count() * 1000 << std::setw(14)
+               << rows.size() / elapsed.count() << std::setw(14)
+               << inserts / elapsed.count();
+            log << ss.str() << std::endl;
+        }
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(LedgerSave, app, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(LedgerSaveBench, app, ripple, 5);
+
+}  // namespace test
+}  // namespace ripple
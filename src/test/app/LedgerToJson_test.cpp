@@ -0,0 +1,178 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/LedgerToJson.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/json/Document.h>
+#include <ripple/json/to_string.h>
+#include <test/jtx.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+
+namespace ripple {
+namespace test {
+
+// Check that LedgerToJson writes identical output into a Json::Value and
+// into a Json::Document.
+class LedgerToJson_test : public beast::unit_test::suite
+{
+protected:
+    struct Mode
+    {
+        char const* name;
+        int options;
+    };
+
+    static constexpr Mode modes[] = {
+        {"hashes", LedgerFill::dumpTxrp},
+        {"expand", LedgerFill::dumpTxrp | LedgerFill::expand},
+        {"binary",
+         LedgerFill::dumpTxrp | LedgerFill::expand | LedgerFill::binary},
+        {"full", LedgerFill::full | LedgerFill::expand},
+    };
+
+    // Close a ledger holding `txns` payments.
+    static std::shared_ptr<ReadView const>
+    makeLedger(jtx::Env& env, std::size_t txns)
+    {
+        using namespace jtx;
+        Account const alice("alice");
+        Account const bob("bob");
+        env.fund(XRP(1000000), alice, bob);
+        env.close();
+        for (std::size_t i = 0; i < txns; ++i)
+            env(pay(alice, bob, XRP(1)));
+        env.close();
+        return env.closed();
+    }
+
+    static std::unique_ptr<Config>
+    makeConfig()
+    {
+        // Let every payment into the open ledger instead of the queue.
+        return jtx::envconfig([](std::unique_ptr<Config> cfg) {
+            cfg->section("transaction_queue")
+                .set("minimum_txn_in_ledger_standalone", "5000");
+            return cfg;
+        });
+    }
+
+    static std::string
+    valueText(ReadView const& ledger, int options)
+    {
+        Json::Value json;
+        addJson(json, {ledger, nullptr, options});
+        return to_string(json);
+    }
+
+    static std::string
+    documentText(ReadView const& ledger, int options)
+    {
+        Json::Document document;
+        addJson(document.root(), {ledger, nullptr, options});
+        return to_string(document);
+    }
+
+public:
+    void
+    run() override
+    {
+        testcase("Document output");
+
+        jtx::Env env(*this, makeConfig());
+        auto const ledger = makeLedger(env, 20);
+        BEAST_EXPECT(
+            std::distance(ledger->txs.begin(), ledger->txs.end()) == 20);
+
+        for (auto const& mode : modes)
+        {
+            auto const expected = valueText(*ledger, mode.options);
+            BEAST_EXPECTS(
+                documentText(*ledger, mode.options) == expected, mode.name);
+        }
+    }
+};
+
+// Compare the cost of producing the text of a 1,000 transaction ledger
+// through a Json::Value and through a Json::Document.
+class LedgerToJsonBench_test : public LedgerToJson_test
+{
+    template <class F>
+    static std::chrono::microseconds
+    time(std::size_t iterations, F const& f)
+    {
+        using clock_type = std::chrono::steady_clock;
+        std::size_t bytes = 0;
+        auto const start = clock_type::now();
+        for (std::size_t i = 0; i < iterations; ++i)
+            bytes += f().size();
+        auto const elapsed = clock_type::now() - start;
+        // Keep the work from being optimized away.
+        if (bytes == 0)
+            return std::chrono::microseconds::zero();
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            elapsed / iterations);
+    }
+
+public:
+    void
+    run() override
+    {
+        testcase("Ledger to JSON");
+
+        jtx::Env env(*this, makeConfig(), nullptr, beast::severities::kError);
+        env.disable_sigs();
+        auto const ledger = makeLedger(env, 1000);
+        BEAST_EXPECT(
+            std::distance(ledger->txs.begin(), ledger->txs.end()) == 1000);
+
+        std::size_t const iterations = 20;
+
+        log << std::left << std::setw(10) << "mode" << std::right
+            << std::setw(14) << "value (us)" << std::setw(16)
+            << "document (us)" << std::setw(12) << "bytes" << std::endl;
+
+        for (auto const& mode : modes)
+        {
+            auto const expected = valueText(*ledger, mode.options);
+            BEAST_EXPECT(documentText(*ledger, mode.options) == expected);
+
+            auto const value = time(
+                iterations, [&] { return valueText(*ledger, mode.options); });
+            auto const document = time(iterations, [&] {
+                return documentText(*ledger, mode.options);
+            });
+
+            std::stringstream ss;
+            ss << std::left << std::setw(10) << mode.name << std::right
+               << std::setw(14) << value.count() << std::setw(16)
+               << document.count() << std::setw(12) << expected.size();
+            log << ss.str() << std::endl;
+        }
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(LedgerToJson, app, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(LedgerToJsonBench, app, ripple, 5);
+
+}  // namespace test
+}  // namespace ripple
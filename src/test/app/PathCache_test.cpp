@@ -0,0 +1,223 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/paths/PathCache.h>
+#include <ripple/app/paths/RippleLineCache.h>
+#include <ripple/beast/unit_test.h>
+#include <test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+class PathCache_test : public beast::unit_test::suite
+{
+    static constexpr int searchLevel = 3;
+    static constexpr int maxPaths = 4;
+
+    // Search for paths on the last closed ledger, using the cache if it
+    // has them. Returns whether the cache had them, and the best paths.
+    std::pair<bool, STPathSet>
+    find(
+        jtx::Env& env,
+        std::shared_ptr<PathCache> const& cache,
+        jtx::Account const& src,
+        jtx::Account const& dst,
+        Currency const& srcCurrency,
+        STAmount const& dstAmount)
+    {
+        Pathfinder pf(
+            std::make_shared<RippleLineCache>(
+                env.closed(), env.app().journal("RippleLineCache"), cache),
+            src,
+            dst,
+            srcCurrency,
+            std::nullopt,
+            dstAmount,
+            std::nullopt,
+            env.app());
+
+        bool const cached = pf.findCachedPaths(searchLevel, maxPaths);
+        if (!cached)
+        {
+            if (!pf.findPaths(searchLevel))
+                return {false, {}};
+            pf.computePathRanks(maxPaths);
+            pf.cachePaths(searchLevel, maxPaths);
+        }
+
+        STPath full;
+        return {cached, pf.getBestPaths(maxPaths, full, {}, noAccount())};
+    }
+
+    void
+    testKey()
+    {
+        testcase("key");
+        using namespace jtx;
+
+        Account const alice("alice");
+        Account const bob("bob");
+        auto const USD = bob["USD"];
+
+        auto key = [&](STAmount const& dstAmount, int level = searchLevel) {
+            return PathCache::makeKey(
+                alice,
+                bob,
+                USD.currency,
+                std::nullopt,
+                STAmount(USD.issue(), std::uint64_t(1), 0, true),
+                dstAmount,
+                level,
+                maxPaths);
+        };
+
+        // Amounts of the same order of magnitude share a result
+        BEAST_EXPECT(key(USD(5)) == key(USD(9)));
+        BEAST_EXPECT(key(USD(10)) == key(USD(99)));
+        BEAST_EXPECT(key(XRP(10)) == key(XRP(50)));
+
+        BEAST_EXPECT(key(USD(5)) != key(USD(50)));
+        BEAST_EXPECT(key(USD(5)) != key(bob["EUR"](5)));
+        BEAST_EXPECT(key(USD(5)) != key(USD(5), searchLevel + 1));
+    }
+
+    void
+    testReuse()
+    {
+        testcase("reuse");
+        using namespace jtx;
+
+        Env env(*this);
+        Account const alice("alice");
+        Account const bob("bob");
+        Account const carol("carol");
+        Account const dan("dan");
+        Account const erin("erin");
+        env.fund(XRP(10000), alice, bob, carol, dan, erin);
+        env.trust(alice["USD"](1000), bob);
+        env.trust(bob["USD"](1000), carol);
+        env.close();
+
+        auto const cache = std::make_shared<PathCache>(env.journal);
+        auto const USD = alice["USD"].currency;
+        auto const amount = carol["USD"](5);
+
+        auto [cached, paths] = find(env, cache, alice, carol, USD, amount);
+        BEAST_EXPECT(!cached);
+        BEAST_EXPECT(paths.size() == 1);
+        BEAST_EXPECT(cache->size() == 1);
+
+        // The same search, and one for a similar amount, are answered
+        // from the cache
+        auto const again = find(env, cache, alice, carol, USD, amount);
+        BEAST_EXPECT(again.first);
+        BEAST_EXPECT(again.second == paths);
+        auto const similar = carol["USD"](7);
+        BEAST_EXPECT(find(env, cache, alice, carol, USD, similar).first);
+        BEAST_EXPECT(cache->getHits() == 2);
+
+        // A search on the open ledger is never cached
+        {
+            Pathfinder pf(
+                std::make_shared<RippleLineCache>(
+                    env.current(),
+                    env.app().journal("RippleLineCache"),
+                    cache),
+                alice,
+                carol,
+                USD,
+                std::nullopt,
+                amount,
+                std::nullopt,
+                env.app());
+            BEAST_EXPECT(!pf.findCachedPaths(searchLevel, maxPaths));
+        }
+
+        // A ledger which does not touch the path carries the result
+        env(pay(dan, erin, XRP(10)));
+        env.close();
+        cache->advance(*env.closed());
+        auto const carried = find(env, cache, alice, carol, USD, amount);
+        BEAST_EXPECT(carried.first);
+        BEAST_EXPECT(carried.second == paths);
+
+        // A ledger which changes an account on the path drops it
+        env(fset(bob, asfDefaultRipple));
+        env.close();
+        cache->advance(*env.closed());
+        BEAST_EXPECT(cache->size() == 0);
+        BEAST_EXPECT(!find(env, cache, alice, carol, USD, amount).first);
+        BEAST_EXPECT(cache->size() == 1);
+
+        // A ledger which was not seen drops it too
+        env.close();
+        env.close();
+        cache->advance(*env.closed());
+        BEAST_EXPECT(cache->size() == 0);
+    }
+
+    void
+    testBooks()
+    {
+        testcase("books");
+        using namespace jtx;
+
+        Env env(*this);
+        Account const gw("gateway");
+        Account const alice("alice");
+        Account const bob("bob");
+        Account const carol("carol");
+        Account const dan("dan");
+        auto const AUD = gw["AUD"];
+        env.fund(XRP(10000), alice, bob, carol, dan, gw);
+        env.trust(AUD(100), bob, carol);
+        env(pay(gw, carol, AUD(50)));
+        env(offer(carol, XRP(50), AUD(50)));
+        env.close();
+
+        auto const cache = std::make_shared<PathCache>(env.journal);
+        auto cached = [&]() {
+            return find(env, cache, alice, bob, xrpCurrency(), AUD(10)).first;
+        };
+
+        BEAST_EXPECT(!cached());
+        BEAST_EXPECT(cached());
+
+        // An offer in a book the search read drops the result, even though
+        // its owner is not on any path
+        env(offer(dan, XRP(10), dan["EUR"](10)));
+        env.close();
+        cache->advance(*env.closed());
+        BEAST_EXPECT(!cached());
+    }
+
+public:
+    void
+    run() override
+    {
+        testKey();
+        testReuse();
+        testBooks();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(PathCache, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
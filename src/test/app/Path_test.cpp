@@ -173,16 +173,17 @@ IPE(Issue const& iss)
 class Path_test : public beast::unit_test::suite
 {
     jtx::Env
-    pathTestEnv()
+    pathTestEnv(std::size_t threads = 1)
     {
         // These tests were originally written with search parameters that are
         // different from the current defaults. This function creates an env
         // with the search parameters that the tests were written for.
         using namespace jtx;
-        return Env(*this, envconfig([](std::unique_ptr<Config> cfg) {
+        return Env(*this, envconfig([threads](std::unique_ptr<Config> cfg) {
             cfg->PATH_SEARCH_OLD = 7;
             cfg->PATH_SEARCH = 7;
             cfg->PATH_SEARCH_MAX = 10;
+            cfg->PATH_SEARCH_THREADS = threads;
             return cfg;
         }));
     }
@@ -635,11 +636,14 @@ public:
     }
 
     void
-    alternative_paths_limit_returned_paths_to_best_quality()
+    alternative_paths_limit_returned_paths_to_best_quality(
+        std::size_t threads = 1)
     {
-        testcase("alternative paths - limit returned paths to best quality");
+        testcase(
+            "alternative paths - limit returned paths to best quality, " +
+            std::to_string(threads) + " threads");
         using namespace jtx;
-        Env env = pathTestEnv();
+        Env env = pathTestEnv(threads);
         auto const gw = Account("gateway");
         auto const USD = gw["USD"];
         auto const gw2 = Account("gateway2");
@@ -1454,6 +1458,7 @@ public:
         alternative_paths_consume_best_transfer();
         alternative_paths_consume_best_transfer_first();
         alternative_paths_limit_returned_paths_to_best_quality();
+        alternative_paths_limit_returned_paths_to_best_quality(4);
         issues_path_negative_issue();
         issues_path_negative_ripple_client_issue_23_smaller();
         issues_path_negative_ripple_client_issue_23_larger();
@@ -0,0 +1,180 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/impl/PeerRequestWindow.h>
+#include <ripple/beast/unit_test.h>
+
+#include <algorithm>
+#include <queue>
+#include <vector>
+
+namespace ripple {
+namespace test {
+
+class PeerRequestWindow_test : public beast::unit_test::suite
+{
+    using time_point = PeerRequestWindow::time_point;
+    using microseconds = std::chrono::microseconds;
+
+    // A peer which serves one request at a time, taking `service` for each,
+    // with a network round trip of `latency`. Requests are sent whenever
+    // the window has room, and the window is returned after `replies`.
+    std::size_t
+    simulate(
+        PeerRequestWindow& w,
+        microseconds latency,
+        microseconds service,
+        int replies)
+    {
+        std::priority_queue<
+            time_point,
+            std::vector<time_point>,
+            std::greater<time_point>>
+            arrivals;
+        time_point busy{};
+
+        auto send = [&](time_point now) {
+            for (auto n = w.available(); n != 0; --n)
+            {
+                w.onRequest(now);
+                busy = std::max(busy, now + latency / 2) + service;
+                arrivals.push(busy + latency / 2);
+            }
+        };
+
+        send(time_point{});
+        for (int i = 0; i < replies && !arrivals.empty(); ++i)
+        {
+            auto const now = arrivals.top();
+            arrivals.pop();
+            w.onReply(now, 1000, 10);
+            if (w.window() > PeerRequestWindow::maxWindow)
+                fail("window exceeded", __FILE__, __LINE__);
+            send(now);
+        }
+        return w.window();
+    }
+
+    void
+    testGrowth()
+    {
+        testcase("growth");
+
+        using namespace std::chrono_literals;
+
+        PeerRequestWindow w;
+        BEAST_EXPECT(w.window() == PeerRequestWindow::minWindow);
+        BEAST_EXPECT(w.available() == 1);
+
+        // Eleven requests cover a round trip of 110ms at 10ms each.
+        auto const window = simulate(w, 100ms, 10ms, 500);
+        BEAST_EXPECT(window >= 11 && window <= 13);
+        BEAST_EXPECT(w.rtt() && *w.rtt() >= 110ms);
+
+        // A peer slower than the network is kept to a few requests.
+        PeerRequestWindow slow;
+        BEAST_EXPECT(simulate(slow, 10ms, 100ms, 100) <= 3);
+
+        // A fast, distant peer is limited by the largest window.
+        PeerRequestWindow fast;
+        BEAST_EXPECT(
+            simulate(fast, 200ms, 1ms, 1000) == PeerRequestWindow::maxWindow);
+    }
+
+    void
+    testExpire()
+    {
+        testcase("expire");
+
+        using namespace std::chrono_literals;
+
+        PeerRequestWindow w;
+        auto const window = simulate(w, 100ms, 10ms, 500);
+        BEAST_EXPECT(w.outstanding() == window);
+
+        time_point const later{10s};
+        BEAST_EXPECT(w.expire(later, 3s) == window);
+        BEAST_EXPECT(w.outstanding() == 0);
+        BEAST_EXPECT(w.window() == window / 2);
+        BEAST_EXPECT(w.available() == window / 2);
+
+        // Nothing left to expire leaves the window alone
+        BEAST_EXPECT(w.expire(later, 3s) == 0);
+        BEAST_EXPECT(w.window() == window / 2);
+
+        // Recent requests are kept
+        w.onRequest(later);
+        BEAST_EXPECT(w.expire(later + 1s, 3s) == 0);
+        BEAST_EXPECT(w.outstanding() == 1);
+
+        // The window never drops below the smallest
+        PeerRequestWindow one;
+        one.onRequest(time_point{});
+        BEAST_EXPECT(one.expire(later, 3s) == 1);
+        BEAST_EXPECT(one.window() == PeerRequestWindow::minWindow);
+    }
+
+    void
+    testRates()
+    {
+        testcase("rates");
+
+        using namespace std::chrono_literals;
+
+        PeerRequestWindow w;
+        BEAST_EXPECT(!w.rtt());
+        BEAST_EXPECT(w.bytesPerSecond() == 0);
+        BEAST_EXPECT(w.nodesPerSecond() == 0);
+
+        // A reply nobody asked for is counted, but not timed
+        w.onReply(time_point{1s}, 300, 3);
+        BEAST_EXPECT(w.bytes() == 300);
+        BEAST_EXPECT(w.nodes() == 3);
+        BEAST_EXPECT(!w.rtt());
+        BEAST_EXPECT(w.window() == PeerRequestWindow::minWindow);
+        BEAST_EXPECT(w.bytesPerSecond() == 0);
+
+        w.onRequest(time_point{2s});
+        BEAST_EXPECT(w.available() == 0);
+        w.onReply(time_point{4s}, 1700, 17);
+        BEAST_EXPECT(w.outstanding() == 0);
+        BEAST_EXPECT(w.rtt() && *w.rtt() == 2000ms);
+        BEAST_EXPECT(w.bytes() == 2000);
+        BEAST_EXPECT(w.nodes() == 20);
+        BEAST_EXPECT(w.bytesPerSecond() == 1000);
+        BEAST_EXPECT(w.nodesPerSecond() == 10);
+
+        // One reply per round trip means the pipe has room for another
+        BEAST_EXPECT(w.window() == 2);
+    }
+
+public:
+    void
+    run() override
+    {
+        testGrowth();
+        testExpire();
+        testRates();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(PeerRequestWindow, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
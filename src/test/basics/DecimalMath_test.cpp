@@ -0,0 +1,879 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/DecimalMath.h>
+#include <ripple/basics/IOUAmount.h>
+#include <ripple/basics/Number.h>
+#include <ripple/basics/random.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/STAmount.h>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <functional>
+#include <string>
+
+namespace ripple {
+namespace test {
+
+/*  Copies of the routines that Number, IOUAmount and STAmount used before
+    they were rewritten in terms of DecimalMath.h. These scale a mantissa
+    one digit at a time, and are kept here only to check that the rewritten
+    routines give the very same results.
+*/
+namespace reference {
+
+using uint128_t = boost::multiprecision::uint128_t;
+
+class Guard
+{
+    std::uint64_t digits_ = 0;
+    bool xbit_ = false;
+    bool sbit_ = false;
+
+public:
+    void
+    set_negative()
+    {
+        sbit_ = true;
+    }
+
+    void
+    push(unsigned d)
+    {
+        xbit_ = xbit_ || (digits_ & 0x0000'0000'0000'000F) != 0;
+        digits_ >>= 4;
+        digits_ |= (d & 0x0000'0000'0000'000FULL) << 60;
+    }
+
+    int
+    round() const
+    {
+        auto const mode = Number::getround();
+
+        if (mode == Number::towards_zero)
+            return -1;
+
+        if (mode == Number::downward)
+            return (sbit_ && (digits_ > 0 || xbit_)) ? 1 : -1;
+
+        if (mode == Number::upward)
+            return (!sbit_ && (digits_ > 0 || xbit_)) ? 1 : -1;
+
+        if (digits_ > 0x5000'0000'0000'0000)
+            return 1;
+        if (digits_ < 0x5000'0000'0000'0000)
+            return -1;
+        return xbit_ ? 1 : 0;
+    }
+};
+
+std::int64_t constexpr minMantissa = 1'000'000'000'000'000LL;
+std::int64_t constexpr maxMantissa = 9'999'999'999'999'999LL;
+int constexpr numberMinExponent = -32768;
+int constexpr numberMaxExponent = 32768;
+int constexpr iouMinExponent = -96;
+int constexpr iouMaxExponent = 80;
+
+Number
+normalize(std::int64_t mantissa, int exponent)
+{
+    if (mantissa == 0)
+        return Number{};
+    bool const negative = (mantissa < 0);
+    auto m = static_cast<std::uint64_t>(mantissa);
+    if (negative)
+        m = -m;
+    while ((m < minMantissa) && (exponent > numberMinExponent))
+    {
+        m *= 10;
+        --exponent;
+    }
+    Guard g;
+    if (negative)
+        g.set_negative();
+    while (m > maxMantissa)
+    {
+        if (exponent >= numberMaxExponent)
+            throw std::overflow_error("Number::normalize 1");
+        g.push(m % 10);
+        m /= 10;
+        ++exponent;
+    }
+    std::int64_t result = m;
+    if ((exponent < numberMinExponent) || (result < minMantissa))
+        return Number{};
+
+    auto r = g.round();
+    if (r == 1 || (r == 0 && (result & 1) == 1))
+    {
+        ++result;
+        if (result > maxMantissa)
+        {
+            result /= 10;
+            ++exponent;
+        }
+    }
+    if (exponent > numberMaxExponent)
+        throw std::overflow_error("Number::normalize 2");
+
+    if (negative)
+        result = -result;
+    return Number{result, exponent, Number::unchecked{}};
+}
+
+Number
+multiply(Number const& x, Number const& y)
+{
+    if (x == Number{} || y == Number{})
+        return Number{};
+    auto xm = x.mantissa();
+    auto xe = x.exponent();
+    int xn = 1;
+    if (xm < 0)
+    {
+        xm = -xm;
+        xn = -1;
+    }
+    auto ym = y.mantissa();
+    auto ye = y.exponent();
+    int yn = 1;
+    if (ym < 0)
+    {
+        ym = -ym;
+        yn = -1;
+    }
+    auto zm = uint128_t(xm) * uint128_t(ym);
+    auto ze = xe + ye;
+    auto zn = xn * yn;
+    Guard g;
+    if (zn == -1)
+        g.set_negative();
+    while (zm > maxMantissa)
+    {
+        g.push(static_cast<unsigned>(zm % 10));
+        zm /= 10;
+        ++ze;
+    }
+    xm = static_cast<std::int64_t>(zm);
+    xe = ze;
+    auto r = g.round();
+    if (r == 1 || (r == 0 && (xm & 1) == 1))
+    {
+        ++xm;
+        if (xm > maxMantissa)
+        {
+            xm /= 10;
+            ++xe;
+        }
+    }
+    if (xe < numberMinExponent)
+        return Number{};
+    if (xe > numberMaxExponent)
+        throw std::overflow_error(
+            "Number::multiplication overflow : exponent is " +
+            std::to_string(xe));
+    return Number{xm * zn, xe, Number::unchecked{}};
+}
+
+std::int64_t
+toRep(Number const& x)
+{
+    std::int64_t drops = x.mantissa();
+    int offset = x.exponent();
+    Guard g;
+    if (drops != 0)
+    {
+        bool const negative = drops < 0;
+        if (negative)
+        {
+            g.set_negative();
+            drops = -drops;
+        }
+        for (; offset < 0; ++offset)
+        {
+            g.push(drops % 10);
+            drops /= 10;
+        }
+        for (; offset > 0; --offset)
+        {
+            if (drops > std::numeric_limits<decltype(drops)>::max() / 10)
+                throw std::overflow_error("Number::operator rep() overflow");
+            drops *= 10;
+        }
+        auto r = g.round();
+        if (r == 1 || (r == 0 && (drops & 1) == 1))
+            ++drops;
+        if (negative)
+            drops = -drops;
+    }
+    return drops;
+}
+
+// IOUAmount::normalize, before the switch over to Number
+std::pair<std::int64_t, int>
+normalizeIOU(std::int64_t mantissa, int exponent)
+{
+    if (mantissa == 0)
+        return {0, -100};
+
+    bool const negative = (mantissa < 0);
+    if (negative)
+        mantissa = -mantissa;
+
+    while ((mantissa < minMantissa) && (exponent > iouMinExponent))
+    {
+        mantissa *= 10;
+        --exponent;
+    }
+
+    while (mantissa > maxMantissa)
+    {
+        if (exponent >= iouMaxExponent)
+            throw std::overflow_error("IOUAmount::normalize");
+        mantissa /= 10;
+        ++exponent;
+    }
+
+    if ((exponent < iouMinExponent) || (mantissa < minMantissa))
+        return {0, -100};
+
+    if (exponent > iouMaxExponent)
+        throw std::overflow_error("value overflow");
+
+    return {negative ? -mantissa : mantissa, exponent};
+}
+
+IOUAmount
+mulRatio(
+    IOUAmount const& amt,
+    std::uint32_t num,
+    std::uint32_t den,
+    bool roundUp)
+{
+    if (!den)
+        throw std::runtime_error("division by zero");
+
+    auto const powerTable = [] {
+        std::vector<uint128_t> result;
+        uint128_t cur(1);
+        for (int i = 0; i < 30; ++i)
+        {
+            result.push_back(cur);
+            cur *= 10;
+        };
+        return result;
+    }();
+
+    auto log10Ceil = [&](uint128_t const& v) {
+        auto const l =
+            std::lower_bound(powerTable.begin(), powerTable.end(), v);
+        return int(std::distance(powerTable.begin(), l));
+    };
+
+    int const fl64 = 18;
+
+    bool const neg = amt.mantissa() < 0;
+    uint128_t const den128(den);
+    uint128_t const mul =
+        uint128_t(neg ? -amt.mantissa() : amt.mantissa()) * uint128_t(num);
+
+    auto low = mul / den128;
+    uint128_t rem(mul - low * den128);
+
+    int exponent = amt.exponent();
+
+    if (rem)
+    {
+        auto const roomToGrow = fl64 - log10Ceil(low);
+        if (roomToGrow > 0)
+        {
+            exponent -= roomToGrow;
+            low *= powerTable[roomToGrow];
+            rem *= powerTable[roomToGrow];
+        }
+        auto const addRem = rem / den128;
+        low += addRem;
+        rem = rem - addRem * den128;
+    }
+
+    bool hasRem = bool(rem);
+    auto const mustShrink = log10Ceil(low) - fl64;
+    if (mustShrink > 0)
+    {
+        uint128_t const sav(low);
+        exponent += mustShrink;
+        low /= powerTable[mustShrink];
+        if (!hasRem)
+            hasRem = bool(sav - low * powerTable[mustShrink]);
+    }
+
+    std::int64_t mantissa = low.convert_to<std::int64_t>();
+
+    if (neg)
+        mantissa *= -1;
+
+    IOUAmount result(mantissa, exponent);
+
+    if (hasRem)
+    {
+        if (roundUp && !neg)
+        {
+            if (!result)
+                return IOUAmount::minPositiveAmount();
+            return IOUAmount(result.mantissa() + 1, result.exponent());
+        }
+
+        if (!roundUp && neg)
+        {
+            if (!result)
+                return IOUAmount(-minMantissa, iouMinExponent);
+            return IOUAmount(result.mantissa() - 1, result.exponent());
+        }
+    }
+
+    return result;
+}
+
+// The mantissa and offset STAmount::canonicalize leaves, before the switch
+// over to Number
+std::pair<std::uint64_t, int>
+canonicalize(bool native, std::uint64_t value, int offset)
+{
+    if (native)
+    {
+        if (value == 0 || offset <= -20)
+            return {0, 0};
+        while (offset < 0)
+        {
+            value /= 10;
+            ++offset;
+        }
+        while (offset > 0)
+        {
+            if (value > STAmount::cMaxNativeN)
+                throw std::runtime_error(
+                    "Native currency amount out of range");
+            value *= 10;
+            --offset;
+        }
+        if (value > STAmount::cMaxNativeN)
+            throw std::runtime_error("Native currency amount out of range");
+        return {value, 0};
+    }
+
+    if (value == 0)
+        return {0, -100};
+
+    while ((value < STAmount::cMinValue) && (offset > STAmount::cMinOffset))
+    {
+        value *= 10;
+        --offset;
+    }
+
+    while (value > STAmount::cMaxValue)
+    {
+        if (offset >= STAmount::cMaxOffset)
+            throw std::runtime_error("value overflow");
+        value /= 10;
+        ++offset;
+    }
+
+    if ((offset < STAmount::cMinOffset) || (value < STAmount::cMinValue))
+        return {0, -100};
+
+    if (offset > STAmount::cMaxOffset)
+        throw std::runtime_error("value overflow");
+
+    return {value, offset};
+}
+
+void
+toIOURange(STAmount const& amount, std::uint64_t& value, int& offset)
+{
+    value = amount.mantissa();
+    offset = amount.exponent();
+    if (amount.native())
+    {
+        while (value < STAmount::cMinValue)
+        {
+            value *= 10;
+            --offset;
+        }
+    }
+}
+
+std::uint64_t
+muldiv_round(
+    std::uint64_t multiplier,
+    std::uint64_t multiplicand,
+    std::uint64_t divisor,
+    std::uint64_t rounding)
+{
+    uint128_t ret;
+    boost::multiprecision::multiply(ret, multiplier, multiplicand);
+    ret += rounding;
+    ret /= divisor;
+    if (ret > std::numeric_limits<std::uint64_t>::max())
+        throw std::overflow_error("overflow");
+    return static_cast<std::uint64_t>(ret);
+}
+
+void
+canonicalizeRound(bool native, std::uint64_t& value, int& offset)
+{
+    if (native)
+    {
+        if (offset < 0)
+        {
+            int loops = 0;
+            while (offset < -1)
+            {
+                value /= 10;
+                ++offset;
+                ++loops;
+            }
+            value += (loops >= 2) ? 9 : 10;
+            value /= 10;
+            ++offset;
+        }
+    }
+    else if (value > STAmount::cMaxValue)
+    {
+        while (value > (10 * STAmount::cMaxValue))
+        {
+            value /= 10;
+            ++offset;
+        }
+        value += 9;
+        value /= 10;
+        ++offset;
+    }
+}
+
+// The rounded products and quotients of amounts which are not both native
+STAmount
+roundResult(
+    Issue const& issue,
+    std::uint64_t amount,
+    int offset,
+    bool resultNegative,
+    bool roundUp)
+{
+    if (resultNegative != roundUp)
+        canonicalizeRound(isXRP(issue), amount, offset);
+    STAmount result(issue, amount, offset, resultNegative);
+    if (roundUp && !resultNegative && !result)
+    {
+        if (isXRP(issue))
+            return STAmount(issue, std::uint64_t{1}, 0, resultNegative);
+        return STAmount(
+            issue, STAmount::cMinValue, STAmount::cMinOffset, resultNegative);
+    }
+    return result;
+}
+
+STAmount
+mulRound(
+    STAmount const& v1,
+    STAmount const& v2,
+    Issue const& issue,
+    bool roundUp)
+{
+    std::uint64_t value1, value2;
+    int offset1, offset2;
+    toIOURange(v1, value1, offset1);
+    toIOURange(v2, value2, offset2);
+    bool const resultNegative = v1.negative() != v2.negative();
+    std::uint64_t const amount = muldiv_round(
+        value1,
+        value2,
+        100'000'000'000'000ull,
+        (resultNegative != roundUp) ? 99'999'999'999'999ull : 0);
+    return roundResult(
+        issue, amount, offset1 + offset2 + 14, resultNegative, roundUp);
+}
+
+STAmount
+divRound(
+    STAmount const& num,
+    STAmount const& den,
+    Issue const& issue,
+    bool roundUp)
+{
+    std::uint64_t numVal, denVal;
+    int numOffset, denOffset;
+    toIOURange(num, numVal, numOffset);
+    toIOURange(den, denVal, denOffset);
+    bool const resultNegative = num.negative() != den.negative();
+    std::uint64_t const amount = muldiv_round(
+        numVal,
+        100'000'000'000'000'000ull,
+        denVal,
+        (resultNegative != roundUp) ? denVal - 1 : 0);
+    return roundResult(
+        issue, amount, numOffset - denOffset - 17, resultNegative, roundUp);
+}
+
+}  // namespace reference
+
+class DecimalMath_test : public beast::unit_test::suite
+{
+    beast::xor_shift_engine engine_{20230307};
+
+    static int constexpr iterations = 50000;
+
+    static constexpr Number::rounding_mode modes[] = {
+        Number::to_nearest,
+        Number::towards_zero,
+        Number::downward,
+        Number::upward};
+
+    // Returns a random value of n digits, often with
+    // trailing digits which round exactly, or exactly half way
+    std::uint64_t
+    digits(int n)
+    {
+        auto const lo = decimal::powersOfTen[n - 1];
+        auto v = rand_int(engine_, lo, decimal::powersOfTen[n] - 1);
+        if (n > 2 && rand_int(engine_, 3) == 0)
+        {
+            auto const p = decimal::powersOfTen[rand_int(engine_, 1, n - 1)];
+            std::uint64_t const tails[] = {0, p / 2, p / 2 + 1, p / 2 - 1};
+            v = v - v % p + tails[rand_int(engine_, 3)];
+        }
+        return v;
+    }
+
+    std::int64_t
+    signedDigits(int maxDigits)
+    {
+        auto const v = static_cast<std::int64_t>(
+            digits(rand_int(engine_, 1, maxDigits)));
+        return rand_int(engine_, 1) ? v : -v;
+    }
+
+    int
+    exponentNear(int limit, int spread)
+    {
+        return rand_int(engine_, limit - spread, limit + spread);
+    }
+
+    // Mostly small, but sometimes close to the limits of Number
+    int
+    numberExponent()
+    {
+        switch (rand_int(engine_, 3))
+        {
+            case 0:
+                return exponentNear(Number::min().exponent(), 20);
+            case 1:
+                return exponentNear(Number::max().exponent(), 20);
+        }
+        return rand_int(engine_, -40, 40);
+    }
+
+    static std::string
+    show(Number const& x)
+    {
+        return std::to_string(x.mantissa()) + "e" +
+            std::to_string(x.exponent());
+    }
+
+    static std::string
+    show(IOUAmount const& x)
+    {
+        return std::to_string(x.mantissa()) + "e" +
+            std::to_string(x.exponent());
+    }
+
+    static std::string
+    show(std::pair<std::int64_t, int> const& x)
+    {
+        return std::to_string(x.first) + "e" + std::to_string(x.second);
+    }
+
+    static std::string
+    show(std::pair<std::uint64_t, int> const& x)
+    {
+        return std::to_string(x.first) + "e" + std::to_string(x.second);
+    }
+
+    static std::string
+    show(std::int64_t x)
+    {
+        return std::to_string(x);
+    }
+
+    static std::string
+    show(STAmount const& x)
+    {
+        return std::string(x.native() ? "native " : "") +
+            (x.negative() ? "-" : "") + std::to_string(x.mantissa()) + "e" +
+            std::to_string(x.exponent());
+    }
+
+    // Runs f, describing its result or the exception it throws
+    template <class F>
+    static std::string
+    outcome(F&& f)
+    {
+        try
+        {
+            return show(f());
+        }
+        catch (std::exception const& e)
+        {
+            return std::string("throws ") + e.what();
+        }
+    }
+
+    // Counts the inputs for which actual and expected differ, and reports
+    // the first of them
+    class Differences
+    {
+        DecimalMath_test& suite_;
+        std::size_t count_ = 0;
+
+    public:
+        explicit Differences(DecimalMath_test& suite) : suite_(suite)
+        {
+        }
+
+        ~Differences()
+        {
+            suite_.expect(
+                count_ == 0,
+                std::to_string(count_) + " differences",
+                __FILE__,
+                __LINE__);
+        }
+
+        template <class F, class G>
+        void
+        operator()(std::string const& input, F&& actual, G&& expected)
+        {
+            auto const a = outcome(actual);
+            auto const e = outcome(expected);
+            if (a != e && count_++ == 0)
+                suite_.log << input << ": got " << a << ", expected " << e
+                           << std::endl;
+        }
+    };
+
+    void
+    testDigitCounts()
+    {
+        testcase("digit counts");
+
+        for (int n = 0; n < 20; ++n)
+        {
+            auto const p = decimal::powersOfTen[n];
+            BEAST_EXPECT(decimal::log10Floor(p) == n);
+            if (n > 0)
+            {
+                BEAST_EXPECT(decimal::log10Floor(p - 1) == n - 1);
+                BEAST_EXPECT(decimal::log10Ceil(p - 1) == n);
+            }
+            BEAST_EXPECT(decimal::log10Ceil(p) == n);
+            BEAST_EXPECT(decimal::log10Ceil(p + 1) == n + 1);
+        }
+
+        for (int n = 19; n <= 38; ++n)
+        {
+            auto const p = decimal::pow10(n);
+            BEAST_EXPECT(decimal::log10Floor(p) == n);
+            BEAST_EXPECT(decimal::log10Floor(p - 1) == n - 1);
+            BEAST_EXPECT(decimal::log10Ceil(p) == n);
+            BEAST_EXPECT(decimal::log10Ceil(p + 1) == n + 1);
+            auto const [q, r] = decimal::divPow10(p + 7, n - 1);
+            BEAST_EXPECT(q == 10 && r == 7);
+        }
+
+        // Every bit width
+        for (int b = 0; b < 64; ++b)
+        {
+            auto const v = std::uint64_t{1} << b;
+            int n = 0;
+            for (auto u = v; u >= 10; u /= 10)
+                ++n;
+            BEAST_EXPECT(decimal::log10Floor(v) == n);
+        }
+    }
+
+    void
+    testNumber()
+    {
+        testcase("Number");
+
+        Differences normalize(*this);
+        Differences multiply(*this);
+        Differences toRep(*this);
+
+        for (auto const mode : modes)
+        {
+            saveNumberRoundMode save{Number::setround(mode)};
+            for (int i = 0; i < iterations; ++i)
+            {
+                auto const m = signedDigits(19);
+                int const e = numberExponent();
+                auto const input =
+                    std::to_string(m) + "e" + std::to_string(e);
+                normalize(
+                    input,
+                    [&] { return Number{m, e}; },
+                    [&] { return reference::normalize(m, e); });
+
+                Number const x{signedDigits(16), rand_int(engine_, -30, 10)};
+                toRep(
+                    show(x),
+                    [&] { return static_cast<std::int64_t>(x); },
+                    [&] { return reference::toRep(x); });
+
+                Number const y{signedDigits(19), e / 2};
+                Number const z{signedDigits(19), e - e / 2};
+                multiply(
+                    show(y) + " * " + show(z),
+                    [&] { return y * z; },
+                    [&] { return reference::multiply(y, z); });
+            }
+        }
+    }
+
+    void
+    testIOUAmount()
+    {
+        testcase("IOUAmount");
+
+        Differences normalize(*this);
+        Differences ratio(*this);
+
+        for (bool const sw : {false, true})
+        {
+            NumberSO stNumberSO{sw};
+            for (int i = 0; i < iterations; ++i)
+            {
+                auto const m = signedDigits(18);
+                int const e = rand_int(engine_, -120, 100);
+                auto const input =
+                    std::to_string(m) + "e" + std::to_string(e);
+                if (!sw)
+                    normalize(
+                        input,
+                        [&] { return IOUAmount{m, e}; },
+                        [&] { return reference::normalizeIOU(m, e); });
+
+                IOUAmount const amt{
+                    signedDigits(16), rand_int(engine_, -96, 80)};
+                auto const num = static_cast<std::uint32_t>(
+                    rand_int(engine_, 1) ? digits(rand_int(engine_, 1, 9))
+                                         : rand_int(engine_, 1, 100));
+                auto const den = static_cast<std::uint32_t>(
+                    digits(rand_int(engine_, 1, 9)));
+                bool const roundUp = rand_int(engine_, 1);
+                ratio(
+                    show(amt) + " * " + std::to_string(num) + "/" +
+                        std::to_string(den),
+                    [&] { return mulRatio(amt, num, den, roundUp); },
+                    [&] {
+                        return reference::mulRatio(amt, num, den, roundUp);
+                    });
+            }
+        }
+    }
+
+    STAmount
+    randomAmount(bool native)
+    {
+        bool const negative = rand_int(engine_, 1);
+        if (native)
+            return STAmount(digits(rand_int(engine_, 1, 17)), negative);
+        return STAmount(
+            noIssue(),
+            digits(16),
+            rand_int(engine_, -96, 80),
+            negative);
+    }
+
+    void
+    testSTAmount()
+    {
+        testcase("STAmount");
+
+        Differences canonicalize(*this);
+        Differences rounded(*this);
+
+        for (bool const sw : {false, true})
+        {
+            NumberSO stNumberSO{sw};
+            STAmountSO stAmountSO{sw};
+            for (int i = 0; i < iterations; ++i)
+            {
+                bool const native = rand_int(engine_, 1);
+                auto const v = digits(rand_int(engine_, 1, 19));
+                int const e = native ? rand_int(engine_, -25, 3)
+                                     : rand_int(engine_, -120, 100);
+                auto const input =
+                    std::to_string(v) + "e" + std::to_string(e);
+                if (!sw)
+                    canonicalize(
+                        input,
+                        [&] {
+                            STAmount const a(
+                                native ? xrpIssue() : noIssue(), v, e);
+                            return std::pair(a.mantissa(), a.exponent());
+                        },
+                        [&] { return reference::canonicalize(native, v, e); });
+
+                auto const x = randomAmount(rand_int(engine_, 1));
+                auto const y = randomAmount(rand_int(engine_, 1));
+                auto const& issue =
+                    rand_int(engine_, 1) ? xrpIssue() : noIssue();
+                bool const roundUp = rand_int(engine_, 1);
+                // The product of two drop amounts is computed exactly
+                if (!(x.native() && y.native() && isXRP(issue)))
+                    rounded(
+                        show(x) + " * " + show(y),
+                        [&] { return mulRound(x, y, issue, roundUp); },
+                        [&] {
+                            return reference::mulRound(x, y, issue, roundUp);
+                        });
+                rounded(
+                    show(x) + " / " + show(y),
+                    [&] { return divRound(x, y, issue, roundUp); },
+                    [&] {
+                        return reference::divRound(x, y, issue, roundUp);
+                    });
+            }
+        }
+    }
+
+public:
+    void
+    run() override
+    {
+        testDigitCounts();
+        testNumber();
+        testIOUAmount();
+        testSTAmount();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(DecimalMath, basics, ripple);
+
+}  // namespace test
+}  // namespace ripple
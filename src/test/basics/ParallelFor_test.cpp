@@ -0,0 +1,125 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/ParallelFor.h>
+#include <ripple/beast/unit_test.h>
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace ripple {
+namespace test {
+
+class ParallelFor_test : public beast::unit_test::suite
+{
+    static bool
+    onThread(std::function<void()> work)
+    {
+        std::thread(std::move(work)).detach();
+        return true;
+    }
+
+    void
+    testAll()
+    {
+        testcase("all items");
+
+        for (std::size_t helpers : {0, 1, 3, 16})
+        {
+            std::vector<std::atomic<int>> calls(1000);
+            parallelFor(calls.size(), helpers, onThread, [&](std::size_t i) {
+                ++calls[i];
+            });
+            BEAST_EXPECT(std::all_of(calls.begin(), calls.end(), [](auto& n) {
+                return n == 1;
+            }));
+        }
+
+        // Nothing to do.
+        parallelFor(0, 4, onThread, [this](std::size_t) { fail(); });
+    }
+
+    void
+    testNoHelpers()
+    {
+        testcase("no helpers");
+
+        // The caller does everything if no helper can be started.
+        std::size_t posted = 0;
+        std::size_t count = 0;
+        auto const caller = std::this_thread::get_id();
+        parallelFor(
+            100,
+            4,
+            [&posted](std::function<void()>) {
+                ++posted;
+                return false;
+            },
+            [&](std::size_t) {
+                BEAST_EXPECT(std::this_thread::get_id() == caller);
+                ++count;
+            });
+        BEAST_EXPECT(posted == 1);
+        BEAST_EXPECT(count == 100);
+    }
+
+    void
+    testException()
+    {
+        testcase("exception");
+
+        for (std::size_t helpers : {0, 3})
+        {
+            std::atomic<std::size_t> count = 0;
+            try
+            {
+                parallelFor(1000, helpers, onThread, [&](std::size_t i) {
+                    if (i == 10)
+                        throw std::runtime_error("work");
+                    ++count;
+                });
+                fail();
+            }
+            catch (std::runtime_error const& e)
+            {
+                BEAST_EXPECT(e.what() == std::string("work"));
+            }
+
+            // Alone, the caller stops at the item that threw.
+            if (helpers == 0)
+                BEAST_EXPECT(count == 10);
+        }
+    }
+
+public:
+    void
+    run() override
+    {
+        testAll();
+        testNoHelpers();
+        testException();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(ParallelFor, basics, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -0,0 +1,235 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/json/Document.h>
+#include <ripple/json/json_reader.h>
+#include <ripple/json/to_string.h>
+#include <ripple/protocol/jss.h>
+
+namespace ripple {
+
+class Document_test : public beast::unit_test::suite
+{
+    // Parse `text`, copy it into a document and check that both
+    // serialize, and convert back, identically.
+    void
+    expectRoundTrip(std::string const& text)
+    {
+        Json::Value value;
+        BEAST_EXPECT(Json::Reader().parse(text, value));
+
+        Json::Document document;
+        document.root() = value;
+        BEAST_EXPECT(to_string(document) == to_string(value));
+        BEAST_EXPECT(document.toJson() == value);
+
+        std::string streamed;
+        stream(document, [&streamed](void const* data, std::size_t size) {
+            streamed.append(static_cast<char const*>(data), size);
+        });
+        std::string expected;
+        stream(value, [&expected](void const* data, std::size_t size) {
+            expected.append(static_cast<char const*>(data), size);
+        });
+        BEAST_EXPECT(streamed == expected);
+    }
+
+    void
+    testConversion()
+    {
+        testcase("conversion");
+
+        expectRoundTrip("null");
+        expectRoundTrip("{}");
+        expectRoundTrip("[]");
+        expectRoundTrip("[23,-4,4.25,true,false,null,\"string\"]");
+        expectRoundTrip("{\"hello\":\"world\"}");
+        expectRoundTrip("[{}]");
+        expectRoundTrip("[[]]");
+        expectRoundTrip(
+            "{\"array\":[{\"12\":23},{},null,false,0.5],"
+            "\"quote\":\"a \\\"quoted\\\"\\n string\","
+            "\"b\":{\"z\":1,\"a\":2,\"m\":[1,2,3]}}");
+        expectRoundTrip("{\"max\":4294967295,\"min\":-2147483648}");
+    }
+
+    void
+    testStrings()
+    {
+        testcase("strings");
+
+        Json::Document document;
+        auto& root = document.root();
+
+        std::string const small(Json::Document::Node::smallSize, 's');
+        std::string const large(Json::Document::Node::smallSize + 1, 'l');
+
+        root[jss::account] = small;
+        root[jss::amount] = large;
+        root[jss::status] = jss::success;
+        root[jss::value] = "";
+        BEAST_EXPECT(root.find("account")->asString() == small);
+        BEAST_EXPECT(root.find("amount")->asString() == large);
+        BEAST_EXPECT(root.find("status")->asString() == "success");
+        BEAST_EXPECT(root.find("value")->asString().empty());
+
+        // A copied string must not alias its source.
+        std::string source = "temporary";
+        root[jss::hash] = source;
+        source[0] = 'T';
+        BEAST_EXPECT(root.find("hash")->asString() == "temporary");
+
+        // Keys given as std::string are copied.
+        {
+            std::string key = "dynamic";
+            root[key] = 1;
+        }
+        BEAST_EXPECT(root.isMember("dynamic"));
+
+        // Overwriting a string with a shorter or longer one.
+        root[jss::account] = large;
+        BEAST_EXPECT(root.find("account")->asString() == large);
+        root[jss::account] = "x";
+        BEAST_EXPECT(root.find("account")->asString() == "x");
+
+        Json::Value expected;
+        expected[jss::account] = "x";
+        expected[jss::amount] = large;
+        expected[jss::status] = jss::success;
+        expected[jss::value] = "";
+        expected[jss::hash] = "temporary";
+        expected["dynamic"] = 1;
+        BEAST_EXPECT(to_string(document) == to_string(expected));
+    }
+
+    void
+    testObjects()
+    {
+        testcase("objects");
+
+        Json::Document document;
+        auto& root = document.root();
+        BEAST_EXPECT(root.isNull());
+
+        // Members are added out of order but serialize sorted.
+        root[jss::validated] = true;
+        root[jss::account] = "a";
+        root[jss::ledger_index] = 7u;
+        root[jss::fee] = -3;
+        BEAST_EXPECT(root.type() == Json::objectValue);
+        BEAST_EXPECT(root.size() == 4);
+        BEAST_EXPECT(
+            to_string(document) ==
+            "{\"account\":\"a\",\"fee\":-3,\"ledger_index\":7,"
+            "\"validated\":true}");
+
+        // Accessing an existing member does not add another.
+        root[jss::account] = "b";
+        BEAST_EXPECT(root.size() == 4);
+        BEAST_EXPECT(!root.isMember("missing"));
+        BEAST_EXPECT(root.find("missing") == nullptr);
+
+        // References remain valid as the object grows.
+        auto& first = root[jss::result];
+        first = "kept";
+        for (int i = 0; i < 100; ++i)
+            root[std::to_string(i)] = i;
+        BEAST_EXPECT(first.asString() == "kept");
+        BEAST_EXPECT(root.find("result") == &first);
+        BEAST_EXPECT(root.toJson().size() == 105);
+    }
+
+    void
+    testArrays()
+    {
+        testcase("arrays");
+
+        Json::Document document;
+        auto& root = document.root();
+
+        auto& array = setArray(root, jss::transactions);
+        auto& first = appendObject(array);
+        first[jss::hash] = "h";
+        for (int i = 0; i < 1000; ++i)
+            array.append(i);
+        BEAST_EXPECT(array.size() == 1001);
+        BEAST_EXPECT(array.at(0).find("hash") == first.find("hash"));
+        BEAST_EXPECT(array.at(1000).asInt() == 999);
+
+        auto& nested = appendArray(array);
+        nested.append(std::string("one"));
+        nested.append(Json::Value(2.5));
+
+        auto& object = addObject(root, jss::ledger);
+        object[jss::closed] = true;
+
+        Json::Value expected;
+        auto& jvArray = expected[jss::transactions] = Json::arrayValue;
+        jvArray.append(Json::objectValue)[jss::hash] = "h";
+        for (int i = 0; i < 1000; ++i)
+            jvArray.append(i);
+        auto& jvNested = jvArray.append(Json::arrayValue);
+        jvNested.append("one");
+        jvNested.append(2.5);
+        expected[jss::ledger][jss::closed] = true;
+
+        BEAST_EXPECT(to_string(document) == to_string(expected));
+        BEAST_EXPECT(document.toJson() == expected);
+    }
+
+    void
+    testCopyFrom()
+    {
+        testcase("copyFrom");
+
+        Json::Value from;
+        from[jss::account] = "alice";
+        from[jss::Fee] = "10";
+
+        Json::Document document;
+        auto& root = document.root();
+        root[jss::hash] = "h";
+        copyFrom(root, from);
+        BEAST_EXPECT(root.size() == 3);
+        BEAST_EXPECT(root.find("account")->asString() == "alice");
+        BEAST_EXPECT(root.find("hash")->asString() == "h");
+
+        // Copying into a null value copies the whole value.
+        Json::Document other;
+        copyFrom(other.root(), Json::Value(5));
+        BEAST_EXPECT(other.root().type() == Json::intValue);
+        BEAST_EXPECT(to_string(other) == "5");
+    }
+
+public:
+    void
+    run() override
+    {
+        testConversion();
+        testStrings();
+        testObjects();
+        testArrays();
+        testCopyFrom();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(Document, json, ripple);
+
+}  // namespace ripple
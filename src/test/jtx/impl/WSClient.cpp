@@ -17,6 +17,7 @@
 */
 //==============================================================================
 
+#include <ripple/basics/strHex.h>
 #include <ripple/json/json_reader.h>
 #include <ripple/json/to_string.h>
 #include <ripple/protocol/jss.h>
@@ -271,8 +272,22 @@ private:
         }
 
         Json::Value jv;
-        Json::Reader jr;
-        jr.parse(buffer_string(rb_.data()), jv);
+        if (ws_.got_binary())
+        {
+            // Binary messages (see BinaryEncoding.h) are handed over as
+            // hex. Responses are marked as such so that invoke finds them.
+            auto const data = buffer_string(rb_.data());
+            if (data.size() > 1 && data[1] == 1)
+                jv[jss::type] = jss::response;
+            else
+                jv[jss::type] = jss::binary;
+            jv[jss::binary] = strHex(data);
+        }
+        else
+        {
+            Json::Reader jr;
+            jr.parse(buffer_string(rb_.data()), jv);
+        }
         rb_.consume(rb_.size());
         auto m = std::make_shared<msg>(std::move(jv));
         {
@@ -0,0 +1,173 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <test/jtx.h>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+namespace ripple {
+namespace test {
+
+// Times transactions which buffer many ledger entries in their
+// ApplyStateTable, both when they are applied to the open ledger and
+// when the ledger is closed and their metadata is built.
+class ApplyStateTableBench_test : public beast::unit_test::suite
+{
+    using clock_type = std::chrono::steady_clock;
+
+    template <class F>
+    static double
+    seconds(F&& f)
+    {
+        auto const start = clock_type::now();
+        f();
+        return std::chrono::duration<double>(clock_type::now() - start)
+            .count();
+    }
+
+    void
+    header()
+    {
+        log << std::left << std::setw(20) << "workload" << std::right
+            << std::setw(10) << "txns" << std::setw(14) << "apply us/tx"
+            << std::setw(14) << "close us/tx" << std::endl;
+    }
+
+    void
+    report(std::string const& name, int txns, double apply, double close)
+    {
+        std::stringstream ss;
+        ss << std::left << std::setw(20) << name << std::right << std::setw(10)
+           << txns << std::fixed << std::setprecision(1) << std::setw(14)
+           << apply * 1e6 / txns << std::setw(14) << close * 1e6 / txns;
+        log << ss.str() << std::endl;
+    }
+
+    // One taker crossing every offer of many makers at once, so that a
+    // single transaction consumes and deletes all of them.
+    void
+    testOfferCrossing()
+    {
+        testcase("Offer crossing");
+
+        using namespace jtx;
+        Env env(*this, envconfig(), nullptr, beast::severities::kError);
+        env.disable_sigs();
+
+        auto const gw = Account("gw");
+        auto const USD = gw["USD"];
+        auto const taker = Account("taker");
+        std::vector<Account> makers;
+        for (int i = 0; i < 20; ++i)
+            makers.emplace_back("maker" + std::to_string(i));
+
+        env.fund(XRP(1000000), gw, taker);
+        for (auto const& maker : makers)
+            env.fund(XRP(100000), maker);
+        env.close();
+        env.trust(USD(1000000), taker);
+        for (auto const& maker : makers)
+        {
+            env.trust(USD(1000000), maker);
+            env(pay(gw, maker, USD(100000)));
+        }
+        env.close();
+
+        int const rounds = 50;
+        int const offersPerMaker = 5;
+        int const offers = makers.size() * offersPerMaker;
+        double apply = 0;
+        double close = 0;
+        for (int round = 0; round < rounds; ++round)
+        {
+            for (int i = 0; i < offersPerMaker; ++i)
+            {
+                for (auto const& maker : makers)
+                    env(offer(maker, XRP(10 + i), USD(10)));
+            }
+            env.close();
+
+            apply += seconds(
+                [&] { env(offer(taker, USD(10 * offers), XRP(20 * offers))); });
+            close += seconds([&] { env.close(); });
+            BEAST_EXPECT(env.current()->read(keylet::account(taker)));
+        }
+        BEAST_EXPECT(env.balance(taker, USD) == USD(10 * offers * rounds));
+        report("offer crossing", rounds, apply, close);
+    }
+
+    // Remits of as many currencies as a Remit allows, each of which
+    // creates its destination account and one trust line per currency.
+    void
+    testRemit()
+    {
+        testcase("Remit");
+
+        using namespace jtx;
+        Env env(*this, envconfig(), nullptr, beast::severities::kError);
+        env.disable_sigs();
+
+        auto const gw = Account("gw");
+        auto const sender = Account("sender");
+        env.fund(XRP(10000000), gw, sender);
+        env.close();
+
+        std::vector<STAmount> amounts{XRP(1)};
+        for (int i = 0; i < 31; ++i)
+        {
+            std::string code = "U";
+            code += static_cast<char>('A' + i / 26);
+            code += static_cast<char>('A' + i % 26);
+            auto const iou = gw[code];
+            env.trust(iou(1000000), sender);
+            env(pay(gw, sender, iou(100000)));
+            amounts.push_back(iou(1));
+        }
+        env.close();
+
+        int const rounds = 200;
+        double apply = 0;
+        double close = 0;
+        for (int round = 0; round < rounds; ++round)
+        {
+            auto const dest = Account("dest" + std::to_string(round));
+            apply += seconds(
+                [&] { env(remit::remit(sender, dest), remit::amts(amounts)); });
+            close += seconds([&] { env.close(); });
+            BEAST_EXPECT(env.current()->read(keylet::account(dest)));
+        }
+        report("remit", rounds, apply, close);
+    }
+
+public:
+    void
+    run() override
+    {
+        header();
+        testOfferCrossing();
+        testRemit();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(ApplyStateTableBench, ledger, ripple, 5);
+
+}  // namespace test
+}  // namespace ripple
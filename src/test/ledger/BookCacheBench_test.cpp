@@ -0,0 +1,156 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/tx/impl/BookTip.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/ledger/OpenView.h>
+#include <ripple/ledger/Sandbox.h>
+#include <test/jtx.h>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+namespace ripple {
+namespace test {
+
+// Times BookTip over a deep order book of a closed ledger, reading the
+// top of the book from the ledger's cache and from the book's directories.
+class BookCacheBench_test : public beast::unit_test::suite
+{
+    using clock_type = std::chrono::steady_clock;
+
+    template <class F>
+    static double
+    seconds(F&& f)
+    {
+        auto const start = clock_type::now();
+        f();
+        return std::chrono::duration<double>(clock_type::now() - start)
+            .count();
+    }
+
+    void
+    header()
+    {
+        log << std::left << std::setw(20) << "workload" << std::right
+            << std::setw(10) << "passes" << std::setw(16) << "cached us/pass"
+            << std::setw(18) << "uncached us/pass" << std::endl;
+    }
+
+    void
+    report(
+        std::string const& name,
+        std::size_t passes,
+        double cached,
+        double uncached)
+    {
+        std::stringstream ss;
+        ss << std::left << std::setw(20) << name << std::right << std::setw(10)
+           << passes << std::fixed << std::setprecision(2) << std::setw(16)
+           << cached * 1e6 / passes << std::setw(18)
+           << uncached * 1e6 / passes;
+        log << ss.str() << std::endl;
+    }
+
+    // Takes up to `count` offers from the book, the way a strand does on
+    // each pass, in a sandbox which is then thrown away.
+    static std::size_t
+    take(
+        OpenView const& view,
+        Book const& book,
+        std::size_t count,
+        beast::Journal j)
+    {
+        Sandbox sb(&view, tapNONE);
+        BookTip tip(sb, book);
+        std::size_t taken = 0;
+        while (taken < count && tip.step(j))
+            ++taken;
+        return taken;
+    }
+
+public:
+    void
+    run() override
+    {
+        using namespace jtx;
+        Env env(*this, envconfig(), nullptr, beast::severities::kError);
+        env.disable_sigs();
+
+        // Like the books of CrossingLimits: many makers, each with offers
+        // at many qualities.
+        auto const gw = Account("gw");
+        auto const USD = gw["USD"];
+        std::vector<Account> makers;
+        for (int i = 0; i < 10; ++i)
+            makers.emplace_back("maker" + std::to_string(i));
+        env.fund(XRP(100000000), gw);
+        for (auto const& maker : makers)
+            env.fund(XRP(10000000), maker);
+        env.close();
+        for (int quality = 0; quality < 50; ++quality)
+        {
+            for (auto const& maker : makers)
+            {
+                for (int i = 0; i < 4; ++i)
+                    env(offer(maker, USD(100), XRP(1000 - 10 * quality)));
+            }
+        }
+        env.close();
+
+        Book const book(USD.issue(), xrpIssue());
+        auto const closed = env.closed();
+
+        // Writing back the first page of the best directory unchanged
+        // makes the view read the book from its directories.
+        OpenView cached(closed.get());
+        OpenView uncached(closed.get());
+        {
+            auto const base = getBookBase(book);
+            auto const root = closed->succ(base, getQualityNext(base));
+            uncached.rawReplace(
+                std::make_shared<SLE>(*closed->read(keylet::page(*root))));
+        }
+        BEAST_EXPECT(cached.bookOffers(getBookBase(book)));
+        BEAST_EXPECT(!uncached.bookOffers(getBookBase(book)));
+
+        header();
+        for (std::size_t const count : {1, 10, 100})
+        {
+            std::size_t const passes = 20000 / count;
+            std::size_t taken[2] = {0, 0};
+            auto const time = [&](OpenView const& view, std::size_t& total) {
+                return seconds([&] {
+                    for (std::size_t i = 0; i < passes; ++i)
+                        total += take(view, book, count, env.journal);
+                });
+            };
+            auto const c = time(cached, taken[0]);
+            auto const u = time(uncached, taken[1]);
+            BEAST_EXPECT(taken[0] == taken[1]);
+            BEAST_EXPECT(taken[0] == passes * count);
+            report("take " + std::to_string(count), passes, c, u);
+        }
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(BookCacheBench, ledger, ripple, 5);
+
+}  // namespace test
+}  // namespace ripple
@@ -0,0 +1,271 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/app/tx/impl/BookTip.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/ledger/BookCache.h>
+#include <ripple/ledger/BookDirs.h>
+#include <ripple/ledger/OpenView.h>
+#include <ripple/ledger/Sandbox.h>
+#include <test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+class BookCache_test : public beast::unit_test::suite
+{
+    // Three qualities of 80 offers each, so that every quality directory
+    // has several pages.
+    static void
+    fillBook(jtx::Env& env, jtx::Account const& alice, jtx::IOU const& AUD)
+    {
+        using namespace jtx;
+        for (auto i = 1, j = 3; i <= 3; ++i, --j)
+            for (auto k = 0; k < 80; ++k)
+                env(offer(alice, AUD(i), XRP(j)));
+        env.close();
+    }
+
+    // Make the view read the book from the ledger instead of its cache by
+    // writing back the first page of the book's best directory unchanged.
+    static void
+    touchBook(OpenView& view, Book const& book)
+    {
+        auto const base = getBookBase(book);
+        auto const root = view.succ(base, getQualityNext(base));
+        view.rawReplace(std::make_shared<SLE>(*view.read(keylet::page(*root))));
+    }
+
+    static std::vector<uint256>
+    take(ApplyView& view, Book const& book, beast::Journal j)
+    {
+        std::vector<uint256> taken;
+        BookTip tip(view, book);
+        while (tip.step(j))
+            taken.push_back(tip.index());
+        return taken;
+    }
+
+    void
+    testOrder()
+    {
+        testcase("Order");
+
+        using namespace jtx;
+        Env env(*this);
+        auto const gw = Account("gw");
+        auto const alice = Account("alice");
+        auto const AUD = gw["AUD"];
+        env.fund(XRP(1000000), gw, alice);
+        env.close();
+        fillBook(env, alice, AUD);
+
+        Book const book(AUD.issue(), xrpIssue());
+        auto const base = getBookBase(book);
+        auto const closed = env.closed();
+
+        auto const offers = closed->bookOffers(base);
+        if (!BEAST_EXPECT(offers))
+            return;
+        BEAST_EXPECT(offers->size() == BookCache::defaultDepth);
+        BEAST_EXPECT(closed->bookOffers(base) == offers);
+
+        std::size_t n = 0;
+        for (auto const& sle : BookDirs(*closed, book))
+        {
+            if (n == offers->size())
+                break;
+            auto const& offer = (*offers)[n++];
+            BEAST_EXPECT(offer.index == sle->key());
+            BEAST_EXPECT(offer.root == sle->getFieldH256(sfBookDirectory));
+            BEAST_EXPECT(
+                offer.dir ==
+                keylet::page(offer.root, sle->getFieldU64(sfBookNode)).key);
+            BEAST_EXPECT(offer.quality == Quality(getQuality(offer.root)));
+        }
+        BEAST_EXPECT(n == offers->size());
+
+        {
+            BookCache cache(5);
+            auto const top = cache.get(*closed, base);
+            BEAST_EXPECT(top->size() == 5);
+            BEAST_EXPECT(std::equal(
+                top->begin(),
+                top->end(),
+                offers->begin(),
+                [](BookOffer const& a, BookOffer const& b) {
+                    return a.index == b.index;
+                }));
+            BEAST_EXPECT(cache.size() == 1);
+
+            // An empty book is cached as such
+            auto const none = cache.get(*closed, getBookBase(reversed(book)));
+            BEAST_EXPECT(none && none->empty());
+            BEAST_EXPECT(cache.size() == 2);
+        }
+
+        {
+            // The least recently used book is dropped past the capacity
+            BookCache cache(5, 2);
+            auto const other = getBookBase(reversed(book));
+            auto const third = getBookBase(Book(gw["USD"].issue(), xrpIssue()));
+            auto const top = cache.get(*closed, base);
+            auto const none = cache.get(*closed, other);
+            BEAST_EXPECT(cache.get(*closed, base) == top);
+            cache.get(*closed, third);
+            BEAST_EXPECT(cache.size() == 2);
+            BEAST_EXPECT(cache.get(*closed, base) == top);
+            BEAST_EXPECT(cache.get(*closed, other) != none);
+            BEAST_EXPECT(cache.size() == 2);
+        }
+
+        // Taking the whole book gives the same offers in the same order,
+        // cached or not, including past the end of the cached offers.
+        OpenView cached(closed.get());
+        OpenView uncached(closed.get());
+        touchBook(uncached, book);
+        BEAST_EXPECT(cached.bookOffers(base) == offers);
+        BEAST_EXPECT(!uncached.bookOffers(base));
+
+        Sandbox sb1(&cached, tapNONE);
+        Sandbox sb2(&uncached, tapNONE);
+        BEAST_EXPECT(sb1.bookOffers(base) == offers);
+        auto const taken = take(sb1, book, env.journal);
+        BEAST_EXPECT(taken.size() == 240);
+        BEAST_EXPECT(taken == take(sb2, book, env.journal));
+        BEAST_EXPECT(BookDirs(sb1, book).begin() == BookDirs(sb1, book).end());
+    }
+
+    void
+    testInvalidation()
+    {
+        testcase("Invalidation");
+
+        using namespace jtx;
+        Env env(*this);
+        auto const gw = Account("gw");
+        auto const alice = Account("alice");
+        auto const AUD = gw["AUD"];
+        auto const CNY = gw["CNY"];
+        env.fund(XRP(1000000), gw, alice);
+        env.close();
+        env(offer(alice, CNY(10), XRP(10)));
+        fillBook(env, alice, AUD);
+
+        Book const book(AUD.issue(), xrpIssue());
+        Book const other(CNY.issue(), xrpIssue());
+        auto const base = getBookBase(book);
+        auto const root = *env.closed()->succ(base, getQualityNext(base));
+
+        // A ledger which can still change does not cache
+        {
+            auto const next = std::make_shared<Ledger>(
+                *env.app().getLedgerMaster().getClosedLedger(), env.now());
+            BEAST_EXPECT(!next->bookOffers(base));
+        }
+
+        // Changing an offer leaves the book alone
+        {
+            OpenView view(env.closed().get());
+            Sandbox sb(&view, tapNONE);
+            auto const offer = (*view.bookOffers(base))[0];
+            auto const sle = sb.peek(keylet::offer(offer.index));
+            sb.update(sle);
+            BEAST_EXPECT(sb.bookOffers(base));
+        }
+
+        // Changing a page other than the first of a directory
+        {
+            OpenView view(env.closed().get());
+            Sandbox sb(&view, tapNONE);
+            auto const page = sb.peek(keylet::page(root, 1));
+            if (BEAST_EXPECT(page))
+                sb.update(page);
+            BEAST_EXPECT(!sb.bookOffers(base));
+            BEAST_EXPECT(sb.bookOffers(getBookBase(other)));
+            BEAST_EXPECT(view.bookOffers(base));
+
+            Sandbox nested(&sb);
+            BEAST_EXPECT(!nested.bookOffers(base));
+
+            sb.apply(view);
+            BEAST_EXPECT(!view.bookOffers(base));
+            BEAST_EXPECT(view.bookOffers(getBookBase(other)));
+
+            OpenView copy(view);
+            BEAST_EXPECT(!copy.bookOffers(base));
+        }
+
+        // Taking an offer
+        {
+            OpenView view(env.closed().get());
+            Sandbox sb(&view, tapNONE);
+            auto const offer = (*view.bookOffers(base))[100];
+            auto const sle = sb.peek(keylet::offer(offer.index));
+            BEAST_EXPECT(offerDelete(sb, sle, env.journal) == tesSUCCESS);
+            BEAST_EXPECT(!sb.bookOffers(base));
+            BEAST_EXPECT(sb.bookOffers(getBookBase(other)));
+        }
+    }
+
+    void
+    testCrossing()
+    {
+        testcase("Crossing");
+
+        using namespace jtx;
+        Env env(*this);
+        auto const gw = Account("gw");
+        auto const alice = Account("alice");
+        auto const bob = Account("bob");
+        auto const AUD = gw["AUD"];
+        env.fund(XRP(1000000), gw, alice, bob);
+        env.close();
+        env.trust(AUD(10000), alice, bob);
+        env(pay(gw, bob, AUD(1000)));
+        env.close();
+        fillBook(env, alice, AUD);
+
+        // Takes the first two qualities, more offers than are cached
+        env(offer(bob, XRP(240), AUD(240)), txflags(tfSell));
+        env.close();
+
+        BEAST_EXPECT(env.balance(bob, AUD) == AUD(760));
+        BEAST_EXPECT(env.balance(alice, AUD) == AUD(240));
+        auto const d = BookDirs(*env.closed(), Book(AUD.issue(), xrpIssue()));
+        BEAST_EXPECT(std::distance(d.begin(), d.end()) == 80);
+        for (auto const& sle : d)
+            BEAST_EXPECT(sle->getFieldAmount(sfTakerPays) == AUD(3));
+    }
+
+public:
+    void
+    run() override
+    {
+        testOrder();
+        testInvalidation();
+        testCrossing();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(BookCache, ledger, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -0,0 +1,300 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/InsertOnlyMap.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/core/JobQueue.h>
+#include <ripple/ledger/CachedSLEs.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <test/jtx.h>
+#include <thread>
+#include <vector>
+
+namespace ripple {
+namespace test {
+
+class CachedSLEs_test : public beast::unit_test::suite
+{
+    static std::shared_ptr<SLE const>
+    sle(std::uint64_t id)
+    {
+        return std::make_shared<SLE const>(
+            Keylet{ltACCOUNT_ROOT, uint256(id)});
+    }
+
+    void
+    testFetch()
+    {
+        testcase("Fetch");
+
+        CachedSLEs cache(16);
+        int calls = 0;
+        auto const load = [&calls](std::uint64_t id) {
+            return [&calls, id]() {
+                ++calls;
+                return sle(id);
+            };
+        };
+
+        BEAST_EXPECT(cache.rate() == 0);
+        auto const first = cache.fetch(uint256(1), load(1));
+        BEAST_EXPECT(first && first->key() == uint256(1));
+        BEAST_EXPECT(calls == 1);
+        BEAST_EXPECT(cache.fetch(uint256(1), load(1)) == first);
+        BEAST_EXPECT(calls == 1);
+        BEAST_EXPECT(cache.rate() == 0.5);
+        BEAST_EXPECT(cache.size() == 1);
+
+        // Nothing is cached when the entry is missing
+        BEAST_EXPECT(!cache.fetch(uint256(2), [] {
+            return std::shared_ptr<SLE const>{};
+        }));
+        BEAST_EXPECT(cache.size() == 1);
+    }
+
+    void
+    testCallers()
+    {
+        testcase("Callers");
+
+        using Caller = CachedSLEs::Caller;
+        CachedSLEs cache(16);
+        auto const load = [] { return sle(1); };
+
+        BEAST_EXPECT(CachedSLEs::caller() == Caller::other);
+        cache.fetch(uint256(1), load);
+        {
+            CachedSLEs::Scope const rpc(Caller::rpc);
+            BEAST_EXPECT(CachedSLEs::caller() == Caller::rpc);
+            cache.fetch(uint256(1), load);
+            {
+                CachedSLEs::Scope const tx(Caller::transaction);
+                cache.fetch(uint256(1), load);
+                cache.fetch(uint256(2), [] { return sle(2); });
+            }
+            BEAST_EXPECT(CachedSLEs::caller() == Caller::rpc);
+        }
+        BEAST_EXPECT(CachedSLEs::caller() == Caller::other);
+
+        BEAST_EXPECT(cache.rate(Caller::other) == 0);
+        BEAST_EXPECT(cache.rate(Caller::rpc) == 1);
+        BEAST_EXPECT(cache.rate(Caller::transaction) == 0.5);
+        BEAST_EXPECT(cache.rate(Caller::pathfinding) == 0);
+        BEAST_EXPECT(cache.rate() == 0.5);
+        BEAST_EXPECT(std::string(to_string(Caller::rpc)) == "rpc");
+    }
+
+    void
+    testCoroutine()
+    {
+        using namespace std::chrono_literals;
+        testcase("Coroutine");
+
+        using Caller = CachedSLEs::Caller;
+        jtx::Env env(*this, jtx::envconfig([](std::unique_ptr<Config> cfg) {
+            cfg->FORCE_MULTI_THREAD = true;
+            return cfg;
+        }));
+        auto& jq = env.app().getJobQueue();
+
+        std::mutex m;
+        std::condition_variable cv;
+        int step = 0;
+        auto const reach = [&](int s) {
+            std::lock_guard lock(m);
+            step = s;
+            cv.notify_all();
+        };
+        auto const reached = [&](int s) {
+            std::unique_lock lock(m);
+            return cv.wait_for(lock, 5s, [&] { return step >= s; });
+        };
+
+        std::shared_ptr<JobQueue::Coro> coro;
+        Caller resumed = Caller::other;
+        Caller after = Caller::rpc;
+        jq.postCoro(jtCLIENT, "CachedSLEs-Test", [&](auto const& c) {
+            coro = c;
+            {
+                CachedSLEs::Scope const rpc(Caller::rpc);
+                reach(1);
+                c->yield();
+                resumed = CachedSLEs::caller();
+            }
+            after = CachedSLEs::caller();
+            reach(2);
+        });
+        if (!BEAST_EXPECT(reached(1)))
+            return;
+        coro->join();
+
+        // The threads the coroutine ran on are not left with its caller
+        std::atomic<int> marked{0};
+        for (int i = 0; i < 32; ++i)
+        {
+            jq.addJob(jtCLIENT, "CachedSLEs-Test", [&] {
+                if (CachedSLEs::caller() != Caller::other)
+                    ++marked;
+            });
+        }
+        jq.rendezvous();
+        BEAST_EXPECT(marked == 0);
+
+        // The coroutine keeps it wherever it is resumed
+        coro->post();
+        BEAST_EXPECT(reached(2));
+        BEAST_EXPECT(resumed == Caller::rpc);
+        BEAST_EXPECT(after == Caller::other);
+    }
+
+    void
+    testSweep()
+    {
+        testcase("Sweep");
+
+        CachedSLEs cache(16);
+        int calls = 0;
+        auto const load = [&calls](std::uint64_t id) {
+            return [&calls, id]() {
+                ++calls;
+                return sle(id);
+            };
+        };
+
+        cache.fetch(uint256(1), load(1));
+        cache.fetch(uint256(2), load(2));
+        cache.sweep();
+
+        // Entry 1 is used, and carried into the new generation
+        cache.fetch(uint256(1), load(1));
+        BEAST_EXPECT(calls == 2);
+        cache.sweep();
+
+        cache.fetch(uint256(1), load(1));
+        BEAST_EXPECT(calls == 2);
+        cache.fetch(uint256(2), load(2));
+        BEAST_EXPECT(calls == 3);
+    }
+
+    void
+    testConcurrent()
+    {
+        testcase("Concurrent");
+
+        CachedSLEs cache(64);
+        std::atomic<bool> stop{false};
+        std::atomic<int> wrong{0};
+
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 4; ++t)
+        {
+            readers.emplace_back([&, t] {
+                for (int i = 0; i < 20000; ++i)
+                {
+                    std::uint64_t const id = (i * 7 + t) % 500;
+                    auto const found =
+                        cache.fetch(uint256(id), [id] { return sle(id); });
+                    if (!found || found->key() != uint256(id))
+                        ++wrong;
+                }
+            });
+        }
+        std::thread sweeper([&] {
+            while (!stop)
+            {
+                cache.sweep();
+                std::this_thread::yield();
+            }
+        });
+
+        for (auto& reader : readers)
+            reader.join();
+        stop = true;
+        sweeper.join();
+        BEAST_EXPECT(wrong == 0);
+    }
+
+    void
+    testGrowth()
+    {
+        testcase("Growth");
+
+        // Far more entries than the map starts with buckets for, added
+        // and searched for from several threads
+        InsertOnlyMap<std::uint64_t, std::uint64_t> map(1);
+        std::atomic<int> wrong{0};
+
+        std::vector<std::thread> writers;
+        for (std::uint64_t t = 0; t < 4; ++t)
+        {
+            writers.emplace_back([&, t] {
+                for (std::uint64_t i = 0; i < 20000; ++i)
+                {
+                    std::uint64_t const key = (i * 4 + t) % 50000;
+                    auto const [value, inserted] = map.insert(key, key * 3);
+                    if (*value != key * 3)
+                        ++wrong;
+                    auto const found = map.find(key);
+                    if (!found || *found != key * 3)
+                        ++wrong;
+                }
+            });
+        }
+        for (auto& writer : writers)
+            writer.join();
+
+        BEAST_EXPECT(wrong == 0);
+        BEAST_EXPECT(map.size() == 50000);
+        BEAST_EXPECT(!map.find(50000));
+
+        std::size_t count = 0;
+        std::uint64_t sum = 0;
+        map.forEach([&](std::uint64_t key, std::uint64_t value) {
+            ++count;
+            sum += value - key * 3;
+        });
+        BEAST_EXPECT(count == 50000);
+        BEAST_EXPECT(sum == 0);
+
+        // Nothing is replaced
+        std::size_t inserted = 0;
+        for (std::uint64_t key = 0; key < 50000; ++key)
+            inserted += map.insert(key, 0).second;
+        BEAST_EXPECT(inserted == 0);
+    }
+
+public:
+    void
+    run() override
+    {
+        testFetch();
+        testCallers();
+        testCoroutine();
+        testSweep();
+        testConcurrent();
+        testGrowth();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(CachedSLEs, ledger, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -0,0 +1,186 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/tx/impl/InvariantCheck.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/Indexes.h>
+#include <test/jtx.h>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+namespace ripple {
+namespace test {
+
+// Times the invariant checks of a few kinds of transactions, over the
+// entries each of them changed, with every check shown every entry and with
+// each entry passed only to the checks which look at entries of its type.
+class InvariantsBench_test : public beast::unit_test::suite
+{
+    using clock_type = std::chrono::steady_clock;
+
+    struct Entry
+    {
+        bool isDelete;
+        std::shared_ptr<SLE const> before;
+        std::shared_ptr<SLE const> after;
+    };
+
+    struct Sample
+    {
+        std::string name;
+        std::shared_ptr<STTx const> tx;
+        std::shared_ptr<ReadView const> view;
+        std::vector<Entry> entries;
+    };
+
+    // Apply a transaction and collect the entries it changed, as they were
+    // before and after it.
+    template <class... FN>
+    static Sample
+    record(
+        jtx::Env& env,
+        std::string name,
+        Json::Value const& jv,
+        FN const&... fN)
+    {
+        auto const prior = env.closed();
+        env(jv, fN...);
+        auto const meta = env.meta();
+        auto const post = env.closed();
+
+        Sample sample{std::move(name), env.tx(), post, {}};
+        for (auto const& node : meta->getFieldArray(sfAffectedNodes))
+        {
+            auto const k = keylet::unchecked(node.getFieldH256(sfLedgerIndex));
+            bool const isDelete = node.getFName() == sfDeletedNode;
+            auto const before = prior->read(k);
+            sample.entries.push_back(
+                {isDelete, before, isDelete ? before : post->read(k)});
+        }
+        return sample;
+    }
+
+    template <class Visit>
+    static bool
+    check(Sample const& sample, beast::Journal j, Visit&& visit)
+    {
+        auto checks = getInvariantChecks();
+        for (auto const& e : sample.entries)
+            visit(checks, e);
+
+        auto const fee = sample.tx->getFieldAmount(sfFee).xrp();
+        return std::apply(
+            [&](auto&... c) {
+                return (
+                    ... &
+                    c.finalize(*sample.tx, tesSUCCESS, fee, *sample.view, j));
+            },
+            checks);
+    }
+
+    template <class Visit>
+    static double
+    seconds(Sample const& sample, beast::Journal j, int rounds, Visit&& visit)
+    {
+        auto const start = clock_type::now();
+        for (int i = 0; i < rounds; ++i)
+            check(sample, j, visit);
+        return std::chrono::duration<double>(clock_type::now() - start)
+                   .count() /
+            rounds;
+    }
+
+public:
+    void
+    run() override
+    {
+        using namespace jtx;
+        using namespace std::chrono_literals;
+        Env env(*this, envconfig(), nullptr, beast::severities::kError);
+
+        auto const gw = Account("gw");
+        auto const alice = Account("alice");
+        auto const bob = Account("bob");
+        auto const carol = Account("carol");
+        auto const USD = gw["USD"];
+        env.fund(XRP(100000), gw, alice, bob);
+        env.close();
+
+        std::vector<Sample> samples;
+        samples.push_back(
+            record(env, "AccountSet", fset(alice, asfDefaultRipple)));
+        samples.push_back(
+            record(env, "Payment XRP", pay(alice, bob, XRP(10))));
+        samples.push_back(
+            record(env, "Payment new account", pay(alice, carol, XRP(1000))));
+        samples.push_back(record(env, "TrustSet", trust(alice, USD(100000))));
+        env.trust(USD(100000), bob);
+        env.close();
+        samples.push_back(
+            record(env, "Payment IOU issue", pay(gw, alice, USD(1000))));
+        samples.push_back(
+            record(env, "Payment IOU", pay(alice, bob, USD(10))));
+        samples.push_back(
+            record(env, "OfferCreate", offer(alice, XRP(100), USD(10))));
+        samples.push_back(record(
+            env, "OfferCreate crossing", offer(bob, USD(10), XRP(100))));
+        samples.push_back(record(
+            env,
+            "EscrowCreate",
+            escrow::create(alice, bob, XRP(100)),
+            escrow::finish_time(env.now() + 1s)));
+        samples.push_back(record(env, "NFTokenMint", token::mint(alice)));
+
+        int const rounds = 20000;
+        for (auto const& sample : samples)
+        {
+            auto const all = [](auto& checks, Entry const& e) {
+                std::apply(
+                    [&](auto&... c) {
+                        (..., c.visitEntry(e.isDelete, e.before, e.after));
+                    },
+                    checks);
+            };
+            auto const dispatched = [](auto& checks, Entry const& e) {
+                visitInvariantEntry(checks, e.isDelete, e.before, e.after);
+            };
+
+            BEAST_EXPECT(
+                check(sample, env.journal, all) ==
+                check(sample, env.journal, dispatched));
+
+            auto const t1 = seconds(sample, env.journal, rounds, all);
+            auto const t2 = seconds(sample, env.journal, rounds, dispatched);
+
+            std::stringstream ss;
+            ss << std::left << std::setw(22) << sample.name << std::right
+               << std::setw(3) << sample.entries.size() << " entries: "
+               << std::fixed << std::setprecision(0) << t1 * 1e9
+               << " ns/tx with every check, " << t2 * 1e9
+               << " ns/tx dispatched by type";
+            log << ss.str() << std::endl;
+        }
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(InvariantsBench, ledger, ripple, 5);
+
+}  // namespace test
+}  // namespace ripple
@@ -19,6 +19,7 @@
 
 #include <ripple/app/tx/apply.h>
 #include <ripple/app/tx/impl/ApplyContext.h>
+#include <ripple/app/tx/impl/InvariantCheck.h>
 #include <ripple/app/tx/impl/Transactor.h>
 #include <ripple/beast/utility/Journal.h>
 #include <ripple/protocol/STLedgerEntry.h>
@@ -28,6 +29,11 @@
 
 namespace ripple {
 
+static_assert(detail::visitsType<XRPNotCreated>(ltPAYCHAN));
+static_assert(!detail::visitsType<XRPNotCreated>(ltOFFER));
+static_assert(!detail::visitsType<TransactionFeeCheck>(ltESCROW));
+static_assert(detail::visitsType<LedgerEntryTypesMatch>(ltTICKET));
+
 class Invariants_test : public beast::unit_test::suite
 {
     // this is common setup/method for running a failing invariant check. The
@@ -446,6 +452,72 @@ class Invariants_test : public beast::unit_test::suite
             STTx{ttPAYMENT, [](STObject& tx) {}});
     }
 
+    // Checks which count the entries they are shown
+    struct Counter
+    {
+        int visits = 0;
+
+        void
+        visitEntry(
+            bool,
+            std::shared_ptr<SLE const> const&,
+            std::shared_ptr<SLE const> const&)
+        {
+            ++visits;
+        }
+    };
+
+    struct AccountCounter : Counter
+    {
+        static constexpr std::array visitedTypes{ltACCOUNT_ROOT};
+    };
+
+    struct OfferCounter : Counter
+    {
+        static constexpr std::array visitedTypes{ltOFFER, ltRIPPLE_STATE};
+    };
+
+    struct NoCounter : Counter
+    {
+        static constexpr std::array<LedgerEntryType, 0> visitedTypes{};
+    };
+
+    struct AnyCounter : Counter
+    {
+    };
+
+    void
+    testVisitDispatch()
+    {
+        using namespace test::jtx;
+        testcase << "visit dispatch";
+
+        Account const A1{"A1"};
+        auto const account = std::make_shared<SLE const>(keylet::account(A1));
+        auto const offer =
+            std::make_shared<SLE const>(keylet::offer(A1.id(), 5u));
+        auto const ticket =
+            std::make_shared<SLE const>(keylet::ticket(A1.id(), 6u));
+
+        auto const visits = [](std::shared_ptr<SLE const> const& before,
+                               std::shared_ptr<SLE const> const& after) {
+            std::tuple<AccountCounter, OfferCounter, NoCounter, AnyCounter>
+                checks;
+            visitInvariantEntry(checks, !after, before, after);
+            return std::array{
+                std::get<0>(checks).visits,
+                std::get<1>(checks).visits,
+                std::get<2>(checks).visits,
+                std::get<3>(checks).visits};
+        };
+
+        BEAST_EXPECT((visits(nullptr, account) == std::array{1, 0, 0, 1}));
+        BEAST_EXPECT((visits(account, account) == std::array{1, 0, 0, 1}));
+        BEAST_EXPECT((visits(offer, nullptr) == std::array{0, 1, 0, 1}));
+        BEAST_EXPECT((visits(account, offer) == std::array{1, 1, 0, 1}));
+        BEAST_EXPECT((visits(ticket, ticket) == std::array{0, 0, 0, 1}));
+    }
+
 public:
     void
     run() override
@@ -459,6 +531,7 @@ public:
         testNoBadOffers();
         testNoZeroEscrow();
         testValidNewAccountRoot();
+        testVisitDispatch();
     }
 };
 
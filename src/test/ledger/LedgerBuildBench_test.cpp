@@ -0,0 +1,107 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/Serializer.h>
+#include <test/jtx.h>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+namespace ripple {
+namespace test {
+
+// Times building ledgers out of many small transactions, which serializes
+// every transaction, its metadata and the entries it changes, and counts
+// the serialization buffers that were reused rather than allocated.
+class LedgerBuildBench_test : public beast::unit_test::suite
+{
+    using clock_type = std::chrono::steady_clock;
+
+    template <class F>
+    static double
+    seconds(F&& f)
+    {
+        auto const start = clock_type::now();
+        f();
+        return std::chrono::duration<double>(clock_type::now() - start)
+            .count();
+    }
+
+public:
+    void
+    run() override
+    {
+        using namespace jtx;
+        Env env(*this, envconfig(), nullptr, beast::severities::kError);
+        env.disable_sigs();
+
+        auto const gw = Account("gw");
+        auto const USD = gw["USD"];
+        std::vector<Account> accounts;
+        for (int i = 0; i < 100; ++i)
+            accounts.emplace_back("account" + std::to_string(i));
+
+        env.fund(XRP(1000000), gw);
+        for (auto const& account : accounts)
+            env.fund(XRP(100000), account);
+        env.close();
+        for (auto const& account : accounts)
+        {
+            env.trust(USD(1000000), account);
+            env(pay(gw, account, USD(100000)));
+        }
+        env.close();
+
+        int const rounds = 50;
+        int txns = 0;
+        double apply = 0;
+        double close = 0;
+        auto const before = ScratchSerializer::stats();
+        for (int round = 0; round < rounds; ++round)
+        {
+            apply += seconds([&] {
+                auto const n = accounts.size();
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    auto const& to = accounts[(i + round + 1) % n];
+                    env(pay(accounts[i], to, XRP(1)));
+                    env(pay(accounts[i], to, USD(1)));
+                    txns += 2;
+                }
+            });
+            close += seconds([&] { env.close(); });
+        }
+        auto const after = ScratchSerializer::stats();
+        BEAST_EXPECT(env.balance(accounts[0], USD) == USD(100000));
+
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(1) << txns << " txns, "
+           << apply * 1e6 / txns << " us/tx to apply, " << close * 1e6 / txns
+           << " us/tx to close; scratch buffers reused "
+           << after.reused - before.reused << ", allocated "
+           << after.allocated - before.allocated;
+        log << ss.str() << std::endl;
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(LedgerBuildBench, ledger, ripple, 5);
+
+}  // namespace test
+}  // namespace ripple
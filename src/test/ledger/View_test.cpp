@@ -263,6 +263,71 @@ class View_test : public beast::unit_test::suite
         succ(v0, 7, std::nullopt);
     }
 
+    // Exercise a view holding many entries
+    void
+    testMetaMany()
+    {
+        testcase("Meta many");
+
+        using namespace jtx;
+        Env env(*this);
+        wipe(env.app().openLedger());
+        OpenView open(&*env.current());
+        ApplyViewImpl v(&open, tapNONE);
+        for (std::uint32_t i = 1; i <= 300; ++i)
+            v.insert(sle(i, i));
+        BEAST_EXPECT(v.size() == 300);
+
+        // Entries which were inserted and then erased are forgotten,
+        // the others are modified in place.
+        for (std::uint32_t i = 3; i <= 300; i += 3)
+            v.erase(v.peek(k(i)));
+        for (std::uint32_t i = 1; i <= 300; i += 3)
+        {
+            auto const s = v.peek(k(i));
+            seq(s, i + 1000);
+            v.update(s);
+        }
+        BEAST_EXPECT(v.size() == 200);
+
+        for (std::uint32_t i = 1; i <= 300; ++i)
+        {
+            if (i % 3 == 0)
+            {
+                BEAST_EXPECT(!v.exists(k(i)));
+                BEAST_EXPECT(!v.read(k(i)));
+                succ(v, i, i + 1 <= 300 ? std::optional(i + 1) : std::nullopt);
+                continue;
+            }
+            auto const expected = i % 3 == 1 ? i + 1000 : i;
+            BEAST_EXPECT(seq(v.read(k(i))) == expected);
+            auto const next = i % 3 == 1 ? i + 1 : i + 2;
+            succ(v, i, next <= 300 ? std::optional(next) : std::nullopt);
+        }
+
+        std::uint64_t last = 0;
+        bool ordered = true;
+        v.visit(
+            open,
+            [&](uint256 const& key,
+                bool isDelete,
+                std::shared_ptr<SLE const> const& before,
+                std::shared_ptr<SLE const> const& after) {
+                ordered = ordered && !isDelete && !before &&
+                    key > uint256(last);
+                last = seq(after) > 1000 ? seq(after) - 1000 : seq(after);
+            });
+        BEAST_EXPECT(ordered);
+        BEAST_EXPECT(last == 299);
+
+        // Entries added between lookups are found by the next one.
+        v.insert(sle(3, 3));
+        succ(v, 2, 3);
+        v.insert(sle(301, 301));
+        succ(v, 299, 301);
+        succ(v, 300, 301);
+    }
+
     void
     testStacked()
     {
@@ -1101,6 +1166,7 @@ class View_test : public beast::unit_test::suite
         testLedger();
         testMeta();
         testMetaSucc();
+        testMetaMany();
         testStacked();
         testContext();
         testSles();
@@ -0,0 +1,125 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/STLedgerEntryView.h>
+#include <ripple/protocol/st.h>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+namespace ripple {
+
+// Measure the cost of the common ways of reading fields of an STObject:
+// the getters, the typed proxies and presence checks, on objects with and
+// without a template, and through a view of the serialized object.
+class STObjectBench_test : public beast::unit_test::suite
+{
+    using clock_type = std::chrono::steady_clock;
+
+    static constexpr std::size_t iterations = 10'000'000;
+
+    std::uint64_t sink_ = 0;
+
+    template <class F>
+    void
+    measure(std::string const& name, F&& f)
+    {
+        auto const start = clock_type::now();
+        for (std::size_t i = 0; i < iterations; ++i)
+            sink_ += f();
+        auto const elapsed =
+            std::chrono::duration<double>(clock_type::now() - start);
+
+        std::stringstream ss;
+        ss << std::left << std::setw(36) << name << std::right << std::fixed
+           << std::setprecision(1) << std::setw(10)
+           << elapsed.count() * 1e9 / iterations;
+        log << ss.str() << std::endl;
+    }
+
+public:
+    void
+    run() override
+    {
+        testcase("Field access");
+
+        AccountID const alice{1};
+        auto const sle = std::make_shared<SLE>(keylet::account(alice));
+        sle->setAccountID(sfAccount, alice);
+        sle->setFieldAmount(sfBalance, STAmount(XRPAmount(12345678)));
+        sle->setFieldU32(sfSequence, 7);
+        sle->setFieldU32(sfOwnerCount, 3);
+        sle->setFieldU32(sfFlags, lsfDefaultRipple);
+        sle->setFieldVL(sfDomain, Blob{'a', 'b', 'c'});
+
+        Serializer s;
+        sle->add(s);
+
+        // The same fields, without a template
+        STObject const freeForm(SerialIter{s.slice()}, sfGeneric);
+
+        SLEView const view(s.slice(), sle->key(), nullptr);
+
+        log << std::left << std::setw(36) << "access" << std::right
+            << std::setw(10) << "ns" << std::endl;
+
+        measure("getFieldU32 (template)", [&]() {
+            return sle->getFieldU32(sfOwnerCount);
+        });
+        measure("getFieldAmount (template)", [&]() {
+            return sle->getFieldAmount(sfBalance).mantissa();
+        });
+        measure("operator[] (template)", [&]() {
+            return (*sle)[sfOwnerCount];
+        });
+        measure("optional operator[] (template)", [&]() {
+            return (*sle)[~sfTransferRate].value_or(1);
+        });
+        measure("isFieldPresent (template)", [&]() {
+            return sle->isFieldPresent(sfDomain);
+        });
+        measure("isFlag (template)", [&]() {
+            return sle->isFlag(lsfDefaultRipple);
+        });
+
+        measure("getFieldU32 (free form)", [&]() {
+            return freeForm.getFieldU32(sfOwnerCount);
+        });
+        measure("getFieldAmount (free form)", [&]() {
+            return freeForm.getFieldAmount(sfBalance).mantissa();
+        });
+        measure("isFieldPresent (free form)", [&]() {
+            return freeForm.isFieldPresent(sfDomain);
+        });
+
+        measure("getFieldU32 (view)", [&]() {
+            return view.getFieldU32(sfOwnerCount);
+        });
+        measure("getFieldAmount (view)", [&]() {
+            return view.getFieldAmount(sfBalance).mantissa();
+        });
+
+        BEAST_EXPECT(sink_ != 0);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(STObjectBench, protocol, ripple, 5);
+
+}  // namespace ripple
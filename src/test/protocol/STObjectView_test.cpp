@@ -0,0 +1,409 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/ledger/View.h>
+#include <ripple/protocol/STLedgerEntryView.h>
+#include <ripple/protocol/st.h>
+#include <test/jtx.h>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+namespace ripple {
+namespace test {
+
+class STObjectView_test : public beast::unit_test::suite
+{
+protected:
+    static Serializer
+    serialize(STObject const& object)
+    {
+        Serializer s;
+        object.add(s);
+        return s;
+    }
+
+    void
+    testFields()
+    {
+        testcase("fields");
+
+        AccountID const alice{1};
+        AccountID const bob{2};
+
+        // An account root, with integers, amounts, accounts and blobs
+        {
+            auto const sle = std::make_shared<SLE>(keylet::account(alice));
+            sle->setAccountID(sfAccount, alice);
+            sle->setAccountID(sfRegularKey, bob);
+            sle->setFieldAmount(sfBalance, STAmount(XRPAmount(12345678)));
+            sle->setFieldU32(sfSequence, 7);
+            sle->setFieldU32(sfOwnerCount, 3);
+            sle->setFieldU32(sfFlags, lsfRequireAuth | lsfDefaultRipple);
+            sle->setFieldVL(sfDomain, Blob{'a', 'b', 'c'});
+            sle->setFieldH256(sfPreviousTxnID, uint256{42});
+
+            auto const s = serialize(*sle);
+            SLEView const view(s.slice(), sle->key(), nullptr);
+
+            BEAST_EXPECT(view.key() == sle->key());
+            BEAST_EXPECT(view.getType() == ltACCOUNT_ROOT);
+            BEAST_EXPECT(view.getAccountID(sfAccount) == alice);
+            BEAST_EXPECT(view.getAccountID(sfRegularKey) == bob);
+            BEAST_EXPECT(
+                view.getFieldAmount(sfBalance) ==
+                sle->getFieldAmount(sfBalance));
+            BEAST_EXPECT(view.getFieldU32(sfSequence) == 7);
+            BEAST_EXPECT(view.getFieldU32(sfOwnerCount) == 3);
+            BEAST_EXPECT(view.isFlag(lsfRequireAuth));
+            BEAST_EXPECT(view.isFlag(lsfDefaultRipple));
+            BEAST_EXPECT(!view.isFlag(lsfGlobalFreeze));
+            BEAST_EXPECT(
+                view.getFieldVL(sfDomain) == sle->getFieldVL(sfDomain));
+            BEAST_EXPECT(view.getFieldH256(sfPreviousTxnID) == uint256{42});
+
+            // Absent fields read as their default value
+            BEAST_EXPECT(!view.isFieldPresent(sfTransferRate));
+            BEAST_EXPECT(view.getFieldU32(sfTransferRate) == 0);
+            BEAST_EXPECT(view.getFieldVL(sfMessageKey).empty());
+
+            auto const whole = view.sle();
+            BEAST_EXPECT(whole->isEquivalent(*sle));
+        }
+
+        // A trust line, with issued amounts
+        {
+            Issue const usd{to_currency("USD"), alice};
+            auto const sle = std::make_shared<SLE>(
+                keylet::line(alice, bob, usd.currency));
+            sle->setFieldAmount(sfBalance, STAmount(usd, 5, -1));
+            sle->setFieldAmount(sfLowLimit, STAmount(usd, 100));
+            sle->setFieldAmount(
+                sfHighLimit, STAmount(Issue{usd.currency, bob}, 0));
+            sle->setFieldU32(sfFlags, lsfLowReserve | lsfHighFreeze);
+
+            auto const s = serialize(*sle);
+            SLEView const view(s.slice(), sle->key(), nullptr);
+
+            BEAST_EXPECT(view.getType() == ltRIPPLE_STATE);
+            auto const balance = view.getFieldAmount(sfBalance);
+            BEAST_EXPECT(balance == STAmount(usd, 5, -1));
+            BEAST_EXPECT(balance.issue() == usd);
+            BEAST_EXPECT(
+                view.getFieldAmount(sfHighLimit) ==
+                sle->getFieldAmount(sfHighLimit));
+            BEAST_EXPECT(view.isFlag(lsfHighFreeze));
+            BEAST_EXPECT(!view.isFlag(lsfLowFreeze));
+        }
+
+        // A directory, with a vector of keys, and a signer list, with an
+        // array of inner objects
+        {
+            auto const sle = std::make_shared<SLE>(keylet::ownerDir(alice));
+            STVector256 indexes;
+            indexes.push_back(uint256{1});
+            indexes.push_back(uint256{2});
+            sle->setFieldV256(sfIndexes, indexes);
+            sle->setFieldH256(sfRootIndex, sle->key());
+            sle->setFieldU64(sfIndexNext, 9);
+
+            auto const s = serialize(*sle);
+            SLEView const view(s.slice(), sle->key(), nullptr);
+
+            BEAST_EXPECT(view.getFieldV256(sfIndexes) == indexes);
+            BEAST_EXPECT(view.getFieldH256(sfRootIndex) == sle->key());
+            BEAST_EXPECT(view.getFieldU64(sfIndexNext) == 9);
+            BEAST_EXPECT(view.getFieldU64(sfIndexPrevious) == 0);
+        }
+        {
+            auto const sle = std::make_shared<SLE>(keylet::signers(alice));
+            STArray entries(sfSignerEntries);
+            for (auto const& account : {alice, bob})
+            {
+                STObject entry(sfSignerEntry);
+                entry.setAccountID(sfAccount, account);
+                entry.setFieldU16(sfSignerWeight, 1);
+                entries.push_back(std::move(entry));
+            }
+            sle->setFieldArray(sfSignerEntries, entries);
+            sle->setFieldU32(sfSignerQuorum, 2);
+            sle->setFieldU64(sfOwnerNode, 4);
+
+            auto const s = serialize(*sle);
+            SLEView const view(s.slice(), sle->key(), nullptr);
+
+            // The fields after the array are found past it
+            BEAST_EXPECT(view.getFieldU32(sfSignerQuorum) == 2);
+            BEAST_EXPECT(view.getFieldU64(sfOwnerNode) == 4);
+            BEAST_EXPECT(view.getFieldArray(sfSignerEntries) == entries);
+        }
+
+        // A view over a deserialized entry reads from the entry
+        {
+            auto const sle = std::make_shared<SLE>(keylet::account(alice));
+            sle->setFieldU32(sfOwnerCount, 5);
+
+            SLEView const view(sle);
+            BEAST_EXPECT(view.getFieldU32(sfOwnerCount) == 5);
+            BEAST_EXPECT(view.sle() == sle);
+        }
+    }
+
+    void
+    testMalformed()
+    {
+        testcase("malformed");
+
+        auto const key = keylet::account(AccountID{1}).key;
+        auto const sle = std::make_shared<SLE>(keylet::account(AccountID{1}));
+        sle->setFieldU32(sfOwnerCount, 5);
+        auto const s = serialize(*sle);
+
+        // A field of another type may not be read
+        {
+            SLEView const view(s.slice(), key, nullptr);
+            try
+            {
+                view.getFieldU64(sfOwnerCount);
+                fail();
+            }
+            catch (std::runtime_error const&)
+            {
+                pass();
+            }
+        }
+
+        // Truncated entries are found when they are indexed
+        try
+        {
+            SLEView const view(
+                Slice(s.data(), s.getDataLength() - 1), key, nullptr);
+            fail();
+        }
+        catch (std::runtime_error const&)
+        {
+            pass();
+        }
+
+        // As are duplicated fields
+        {
+            Serializer dup(s.data(), s.getDataLength());
+            dup.addFieldID(STI_UINT32, sfOwnerCount.fieldValue);
+            dup.add32(6);
+            try
+            {
+                SLEView const view(dup.slice(), key, nullptr);
+                fail();
+            }
+            catch (std::runtime_error const&)
+            {
+                pass();
+            }
+        }
+    }
+
+    void
+    testReadLazy()
+    {
+        testcase("readLazy");
+
+        using namespace jtx;
+        Env env(*this);
+        Account const gw("gw");
+        Account const alice("alice");
+        auto const USD = gw["USD"];
+        env.fund(XRP(10000), gw, alice);
+        env.trust(USD(1000), alice);
+        env(pay(gw, alice, USD(10)));
+        env.close();
+
+        // From the state map of a closed ledger
+        {
+            auto const ledger = env.closed();
+            auto const view = ledger->readLazy(keylet::account(alice));
+            auto const sle = ledger->read(keylet::account(alice));
+            BEAST_EXPECT(view && sle);
+            BEAST_EXPECT(
+                view->getFieldAmount(sfBalance) ==
+                sle->getFieldAmount(sfBalance));
+            BEAST_EXPECT(view->sle()->isEquivalent(*sle));
+
+            BEAST_EXPECT(!ledger->readLazy(keylet::account(Account("bob"))));
+
+            // The type must match
+            BEAST_EXPECT(!ledger->readLazy(Keylet(ltOFFER, sle->key())));
+
+            auto const line = ledger->readLazy(keylet::line(alice, USD));
+            BEAST_EXPECT(line && line->getType() == ltRIPPLE_STATE);
+        }
+
+        // Entries modified by an open ledger are seen as modified
+        env(pay(gw, alice, USD(5)));
+        {
+            auto const view = env.current()->readLazy(keylet::line(alice, USD));
+            auto const sle = env.current()->read(keylet::line(alice, USD));
+            BEAST_EXPECT(view && sle);
+            BEAST_EXPECT(
+                view->getFieldAmount(sfBalance) ==
+                sle->getFieldAmount(sfBalance));
+            BEAST_EXPECT(
+                accountHolds(
+                    *env.current(),
+                    alice,
+                    USD.currency,
+                    gw,
+                    fhZERO_IF_FROZEN,
+                    env.journal) == USD(15));
+        }
+    }
+
+public:
+    void
+    run() override
+    {
+        testFields();
+        testMalformed();
+        testReadLazy();
+    }
+};
+
+// Compare reading a few fields of ledger entries through read and through
+// readLazy, as account_info and the payment engine do.
+class STObjectViewBench_test : public STObjectView_test
+{
+    using clock_type = std::chrono::steady_clock;
+
+    template <class F>
+    void
+    measure(std::string const& name, std::size_t reads, F&& f)
+    {
+        auto const start = clock_type::now();
+        f();
+        auto const elapsed =
+            std::chrono::duration<double>(clock_type::now() - start);
+
+        std::stringstream ss;
+        ss << std::left << std::setw(28) << name << std::right << std::fixed
+           << std::setprecision(0) << std::setw(12) << elapsed.count() * 1000
+           << std::setw(14) << reads / elapsed.count();
+        log << ss.str() << std::endl;
+    }
+
+public:
+    void
+    run() override
+    {
+        testcase("Field reads");
+
+        using namespace jtx;
+
+        Env env(*this, envconfig(), nullptr, beast::severities::kError);
+        env.disable_sigs();
+
+        Account const gw("gw");
+        auto const USD = gw["USD"];
+        env.fund(XRP(100000), gw);
+
+        std::vector<Account> accounts;
+        for (int i = 0; i < 500; ++i)
+        {
+            accounts.emplace_back("account" + std::to_string(i));
+            env.fund(XRP(1000), accounts.back());
+            env.trust(USD(1000), accounts.back());
+            env(pay(gw, accounts.back(), USD(10)));
+            if (i % 50 == 0)
+                env.close();
+        }
+        env.close();
+
+        auto const ledger = env.closed();
+        int const rounds = 200;
+        std::size_t const reads = rounds * accounts.size();
+        std::uint64_t sink = 0;
+
+        log << std::left << std::setw(28) << "reader" << std::right
+            << std::setw(12) << "ms" << std::setw(14) << "reads/s"
+            << std::endl;
+
+        // The account root: flags, balance and owner count
+        measure("account root (read)", reads, [&]() {
+            for (int r = 0; r < rounds; ++r)
+                for (auto const& a : accounts)
+                {
+                    auto const sle = ledger->read(keylet::account(a));
+                    sink += sle->isFlag(lsfDefaultRipple) +
+                        sle->getFieldU32(sfOwnerCount) +
+                        sle->getFieldAmount(sfBalance).mantissa();
+                }
+        });
+        measure("account root (readLazy)", reads, [&]() {
+            for (int r = 0; r < rounds; ++r)
+                for (auto const& a : accounts)
+                {
+                    auto const sle = ledger->readLazy(keylet::account(a));
+                    sink += sle->isFlag(lsfDefaultRipple) +
+                        sle->getFieldU32(sfOwnerCount) +
+                        sle->getFieldAmount(sfBalance).mantissa();
+                }
+        });
+
+        // The trust line: balance and freeze flags
+        measure("trust line (read)", reads, [&]() {
+            for (int r = 0; r < rounds; ++r)
+                for (auto const& a : accounts)
+                {
+                    auto const sle = ledger->read(keylet::line(a, USD));
+                    sink += sle->isFlag(lsfLowFreeze) +
+                        sle->getFieldAmount(sfBalance).mantissa();
+                }
+        });
+        measure("trust line (readLazy)", reads, [&]() {
+            for (int r = 0; r < rounds; ++r)
+                for (auto const& a : accounts)
+                {
+                    auto const sle = ledger->readLazy(keylet::line(a, USD));
+                    sink += sle->isFlag(lsfLowFreeze) +
+                        sle->getFieldAmount(sfBalance).mantissa();
+                }
+        });
+
+        // What the payment engine asks of a closed ledger
+        measure("accountHolds", reads, [&]() {
+            for (int r = 0; r < rounds; ++r)
+                for (auto const& a : accounts)
+                    sink += accountHolds(
+                                *ledger,
+                                a,
+                                USD.currency,
+                                gw,
+                                fhZERO_IF_FROZEN,
+                                env.journal)
+                                .mantissa();
+        });
+
+        BEAST_EXPECT(sink != 0);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(STObjectView, protocol, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(STObjectViewBench, protocol, ripple, 5);
+
+}  // namespace test
+}  // namespace ripple
@@ -704,6 +704,31 @@ testMalformed()
     }
 }
 
+void
+testFieldTypes()
+{
+    testcase("field types");
+
+    STObject st(sfGeneric);
+    st.setFieldU32(sfFlags, 1);
+    st.setFieldAmount(sfBalance, STAmount(XRPAmount(10)));
+
+    BEAST_EXPECT(st.getFieldU32(sfFlags) == 1);
+    BEAST_EXPECT(st[sfBalance] == STAmount(XRPAmount(10)));
+    BEAST_EXPECT(st[~sfFlags] == 1u);
+
+    // A field may only be read as its own type
+    try
+    {
+        st.getFieldU32(sfBalance);
+        fail();
+    }
+    catch (std::runtime_error const& e)
+    {
+        BEAST_EXPECT(strcmp(e.what(), "Wrong field type") == 0);
+    }
+}
+
 void
 run() override
 {
@@ -716,6 +741,7 @@ run() override
     testParseJSONArrayWithInvalidChildrenObjects();
     testParseJSONEdgeCases();
     testMalformed();
+    testFieldTypes();
 }
 }
 ;
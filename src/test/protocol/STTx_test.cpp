@@ -61,6 +61,47 @@ public:
 
         testcase("STObject constructor errors");
         testObjectCtorErrors();
+
+        testcase("Scratch serializers");
+        testScratchSerializer();
+    }
+
+    void
+    testScratchSerializer()
+    {
+        auto const before = ScratchSerializer::stats();
+        void const* buffer = nullptr;
+        {
+            ScratchSerializer s;
+            BEAST_EXPECT(s->size() == 0);
+            s->add32(HashPrefix::transactionID);
+            buffer = s->data();
+        }
+        {
+            // The buffer released last on this thread is used next, empty
+            ScratchSerializer s;
+            BEAST_EXPECT(s->size() == 0);
+            BEAST_EXPECT(s->data() == buffer);
+
+            // While it is in use, another one is handed out
+            ScratchSerializer t;
+            BEAST_EXPECT(t->data() != buffer);
+        }
+        {
+            // Large buffers are not kept
+            ScratchSerializer s;
+            s->resize(1024 * 1024);
+            buffer = s->data();
+        }
+        {
+            ScratchSerializer s;
+            BEAST_EXPECT(s->capacity() < 1024 * 1024);
+        }
+        auto const after = ScratchSerializer::stats();
+        BEAST_EXPECT(
+            after.reused + after.allocated >=
+            before.reused + before.allocated + 5);
+        BEAST_EXPECT(after.reused >= before.reused + 2);
     }
 
     void
@@ -1589,7 +1630,15 @@ public:
             obj.setFieldVL(sfMessageKey, keypair.first.slice());
             obj.setFieldVL(sfSigningPubKey, keypair.first.slice());
         });
+        BEAST_EXPECT(j.getSerialized() == j.getSerializer().slice());
+        BEAST_EXPECT(
+            j.getTransactionID() == j.getHash(HashPrefix::transactionID));
+
+        // Signing serializes the transaction again
         j.sign(keypair.first, keypair.second);
+        BEAST_EXPECT(j.getSerialized() == j.getSerializer().slice());
+        BEAST_EXPECT(
+            j.getTransactionID() == j.getHash(HashPrefix::transactionID));
 
         Rules defaultRules{{}};
 
@@ -1601,6 +1650,8 @@ public:
         j.add(rawTxn);
         SerialIter sit(rawTxn.slice());
         STTx copy(sit);
+        BEAST_EXPECT(copy.getSerialized() == rawTxn.slice());
+        BEAST_EXPECT(copy.getTransactionID() == j.getTransactionID());
 
         if (copy != j)
         {
@@ -0,0 +1,373 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/StringUtilities.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/Indexes.h>
+#include <ripple/protocol/STLedgerEntry.h>
+#include <ripple/protocol/STTx.h>
+#include <ripple/protocol/jss.h>
+#include <ripple/rpc/BinaryEncoding.h>
+#include <ripple/server/WSSession.h>
+#include <test/jtx.h>
+#include <test/jtx/WSClient.h>
+
+namespace ripple {
+namespace test {
+
+class BinaryEncoding_test : public beast::unit_test::suite
+{
+    static std::unique_ptr<WSClient>
+    makeBinaryClient(jtx::Env& env)
+    {
+        return makeWSClient(
+            env.app().config(),
+            true,
+            2,
+            {{"Sec-WebSocket-Protocol", binaryWSProtocol}});
+    }
+
+    // Check the header of a binary message and return the whole message.
+    Blob
+    binaryMessage(Json::Value const& jv, RPC::BinaryMessage type)
+    {
+        if (!BEAST_EXPECT(jv.isMember(jss::binary)))
+            return {};
+        auto const blob = strUnHex(jv[jss::binary].asString());
+        if (!BEAST_EXPECT(blob && blob->size() >= 2))
+            return {};
+        BEAST_EXPECT((*blob)[0] == RPC::binaryEncodingVersion);
+        BEAST_EXPECT((*blob)[1] == static_cast<std::uint8_t>(type));
+        return *blob;
+    }
+
+    static Blob
+    getBlob(SerialIter& sit)
+    {
+        auto const size = sit.get32();
+        return sit.getRaw(size);
+    }
+
+    static std::string
+    getString(SerialIter& sit)
+    {
+        auto const blob = getBlob(sit);
+        return std::string(blob.begin(), blob.end());
+    }
+
+    Json::Value
+    subscribe(WSClient& wsc, char const* field, std::string const& name)
+    {
+        Json::Value params;
+        params[field] = Json::arrayValue;
+        params[field].append(name);
+        return wsc.invoke("subscribe", params);
+    }
+
+public:
+    void
+    testNegotiation()
+    {
+        testcase("Negotiation");
+
+        using namespace std::chrono_literals;
+        using namespace jtx;
+        Env env(*this);
+
+        // Without the subprotocol everything is JSON.
+        auto json = makeWSClient(env.app().config());
+        BEAST_EXPECT(
+            subscribe(*json, "streams", "ledger")[jss::status] == "success");
+
+        // With it, commands without a binary form still answer in JSON.
+        auto wsc = makeBinaryClient(env);
+        BEAST_EXPECT(
+            subscribe(*wsc, "streams", "ledger")[jss::status] == "success");
+        BEAST_EXPECT(
+            wsc->invoke("server_info")[jss::result].isMember(jss::info));
+
+        env.close();
+        auto const ledger = env.closed();
+
+        BEAST_EXPECT(json->findMsg(5s, [&](auto const& jv) {
+            return jv[jss::type] == "ledgerClosed" &&
+                jv[jss::ledger_index] == ledger->seq();
+        }));
+
+        auto const jv = wsc->findMsg(5s, [&](auto const& jv) {
+            return jv[jss::type] == jss::binary;
+        });
+        if (!BEAST_EXPECT(jv))
+            return;
+
+        auto const msg = binaryMessage(*jv, RPC::BinaryMessage::ledgerClosed);
+        if (msg.empty())
+            return;
+        SerialIter sit(makeSlice(msg));
+        sit.skip(2);
+        BEAST_EXPECT(sit.get32() == ledger->seq());
+        BEAST_EXPECT(sit.get256() == ledger->info().hash);
+        BEAST_EXPECT(
+            sit.get32() == ledger->info().closeTime.time_since_epoch().count());
+        BEAST_EXPECT(sit.get64() == ledger->fees().base.drops());
+        BEAST_EXPECT(sit.get64() == ledger->fees().accountReserve(0).drops());
+        BEAST_EXPECT(sit.get64() == ledger->fees().increment.drops());
+        BEAST_EXPECT(sit.get32() == 0);
+        getString(sit);
+        BEAST_EXPECT(sit.empty());
+    }
+
+    void
+    testTransactionStreams()
+    {
+        testcase("Transaction streams");
+
+        using namespace std::chrono_literals;
+        using namespace jtx;
+        Env env(*this);
+        Account const alice("alice");
+        env.fund(XRP(10000), alice);
+        env.close();
+
+        auto wsc = makeBinaryClient(env);
+        BEAST_EXPECT(
+            subscribe(*wsc, "streams", "transactions")[jss::status] ==
+            "success");
+        BEAST_EXPECT(
+            subscribe(*wsc, "accounts", alice.human())[jss::status] ==
+            "success");
+
+        env(pay(env.master, alice, XRP(100)));
+        auto const id = env.tx()->getTransactionID();
+        env.close();
+        auto const ledger = env.closed();
+
+        // One message for each stream.
+        for (int i = 0; i < 2; ++i)
+        {
+            auto const jv = wsc->findMsg(5s, [&](auto const& jv) {
+                return jv[jss::type] == jss::binary;
+            });
+            if (!BEAST_EXPECT(jv))
+                return;
+
+            auto const msg =
+                binaryMessage(*jv, RPC::BinaryMessage::transaction);
+            if (msg.empty())
+                return;
+            SerialIter sit(makeSlice(msg));
+            sit.skip(2);
+            BEAST_EXPECT(sit.get8() == 1);
+            BEAST_EXPECT(sit.get32() == ledger->seq());
+            BEAST_EXPECT(sit.get256() == ledger->info().hash);
+            BEAST_EXPECT(
+                sit.get32() ==
+                ledger->info().closeTime.time_since_epoch().count());
+            BEAST_EXPECT(sit.get32() == TERtoInt(tesSUCCESS));
+
+            auto const txBlob = getBlob(sit);
+            SerialIter txSit(makeSlice(txBlob));
+            BEAST_EXPECT(STTx(txSit).getTransactionID() == id);
+
+            auto const metaBlob = getBlob(sit);
+            SerialIter metaSit(makeSlice(metaBlob));
+            STObject const meta(metaSit, sfMetadata);
+            BEAST_EXPECT(meta.getFieldU8(sfTransactionResult) == tesSUCCESS);
+            BEAST_EXPECT(sit.empty());
+        }
+    }
+
+    void
+    testCommands()
+    {
+        testcase("Commands");
+
+        using namespace jtx;
+        Env env(*this);
+        Account const alice("alice");
+        env.fund(XRP(10000), alice);
+        env.close();
+        env(noop(alice));
+        auto const id = env.tx()->getTransactionID();
+        env.close();
+
+        auto wsc = makeBinaryClient(env);
+
+        auto const response = [&](Json::Value const& jv,
+                                  std::string const& command) {
+            auto msg = binaryMessage(jv, RPC::BinaryMessage::response);
+            if (msg.empty())
+                return msg;
+            SerialIter sit(makeSlice(msg));
+            sit.skip(2);
+            BEAST_EXPECT(sit.get8() == 0);
+            BEAST_EXPECT(getString(sit) == "5");
+            BEAST_EXPECT(getString(sit) == command);
+            // Strip the envelope, leaving the payload.
+            return Blob(msg.end() - sit.getBytesLeft(), msg.end());
+        };
+
+        {
+            Json::Value params;
+            params[jss::transaction] = to_string(id);
+            auto const payload = response(wsc->invoke("tx", params), "tx");
+            if (!payload.empty())
+            {
+                SerialIter sit(makeSlice(payload));
+                BEAST_EXPECT(sit.get8() == 1);
+                BEAST_EXPECT(sit.get32() == env.closed()->seq());
+                BEAST_EXPECT(sit.get32() != 0);
+                auto const txBlob = getBlob(sit);
+                SerialIter txSit(makeSlice(txBlob));
+                BEAST_EXPECT(STTx(txSit).getTransactionID() == id);
+                BEAST_EXPECT(!getBlob(sit).empty());
+                BEAST_EXPECT(sit.empty());
+            }
+        }
+
+        {
+            Json::Value params;
+            params[jss::account] = alice.human();
+            auto const payload =
+                response(wsc->invoke("account_tx", params), "account_tx");
+            if (!payload.empty())
+            {
+                SerialIter sit(makeSlice(payload));
+                BEAST_EXPECT(
+                    (sit.getBitString<160, ripple::detail::AccountIDTag>() ==
+                     alice.id()));
+                sit.get32();
+                BEAST_EXPECT(sit.get32() == env.closed()->seq());
+                sit.get32();
+                BEAST_EXPECT(sit.get8() == 0);
+                // The noop, and the payment and account set which funded
+                // alice.
+                auto const count = sit.get32();
+                BEAST_EXPECT(count == 3);
+                for (std::uint32_t i = 0; i < count; ++i)
+                {
+                    sit.get32();
+                    auto const txBlob = getBlob(sit);
+                    SerialIter txSit(makeSlice(txBlob));
+                    STTx const tx(txSit);
+                    if (i == 0)
+                        BEAST_EXPECT(tx.getTransactionID() == id);
+                    BEAST_EXPECT(!getBlob(sit).empty());
+                }
+                BEAST_EXPECT(sit.empty());
+            }
+        }
+
+        {
+            Json::Value params;
+            params[jss::account_root] = alice.human();
+            params[jss::ledger_index] = "validated";
+            auto const payload =
+                response(wsc->invoke("ledger_entry", params), "ledger_entry");
+            if (!payload.empty())
+            {
+                SerialIter sit(makeSlice(payload));
+                BEAST_EXPECT(sit.get32() == env.closed()->seq());
+                BEAST_EXPECT(sit.get256() == env.closed()->info().hash);
+                BEAST_EXPECT(sit.get8() == 1);
+                auto const key = keylet::account(alice).key;
+                BEAST_EXPECT(sit.get256() == key);
+                auto const sleBlob = getBlob(sit);
+                SerialIter sleSit(makeSlice(sleBlob));
+                STLedgerEntry const sle(sleSit, key);
+                BEAST_EXPECT(sle[sfBalance] == env.balance(alice).value());
+                BEAST_EXPECT(sit.empty());
+            }
+        }
+
+        // Errors are always JSON.
+        {
+            Json::Value params;
+            params[jss::transaction] = to_string(uint256{1});
+            auto const jv = wsc->invoke("tx", params);
+            BEAST_EXPECT(!jv.isMember(jss::binary));
+            BEAST_EXPECT(jv[jss::error] == "txnNotFound");
+        }
+        {
+            Json::Value params;
+            params[jss::index] = "bad";
+            auto const jv = wsc->invoke("ledger_entry", params);
+            BEAST_EXPECT(!jv.isMember(jss::binary));
+            BEAST_EXPECT(jv[jss::error] == "malformedRequest");
+        }
+    }
+
+    void
+    testLoadWarning()
+    {
+        testcase("Load warning");
+
+        using namespace jtx;
+        Env env(*this, no_admin(envconfig()));
+        Account const alice("alice");
+        env.fund(XRP(10000), alice);
+        env.close();
+        env(noop(alice));
+        auto const id = env.tx()->getTransactionID();
+        env.close();
+
+        auto wsc = makeBinaryClient(env);
+        Json::Value params;
+        params[jss::transaction] = to_string(id);
+
+        // The flags of a binary response, or nullopt if it is not one.
+        // BEAST_EXPECT is not used in the loop so the number of tests run
+        // stays the same.
+        auto const flags = [&]() -> std::optional<std::uint8_t> {
+            auto const jv = wsc->invoke("tx", params);
+            if (!jv.isMember(jss::binary))
+                return std::nullopt;
+            auto const msg = strUnHex(jv[jss::binary].asString());
+            if (!msg || msg->size() < 3)
+                return std::nullopt;
+            return (*msg)[2];
+        };
+
+        BEAST_EXPECT(flags() == 0);
+
+        // A client which keeps asking is warned in the flags, as it would
+        // be by the warning field of a JSON response.
+        bool warned = false;
+        for (int i = 0; i < 2000 && !warned; ++i)
+        {
+            auto const f = flags();
+            if (!f)
+                break;
+            warned = (*f & RPC::binaryLoadWarning) != 0;
+        }
+        BEAST_EXPECT(warned);
+    }
+
+    void
+    run() override
+    {
+        testNegotiation();
+        testTransactionStreams();
+        testCommands();
+        testLoadWarning();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(BinaryEncoding, rpc, ripple);
+
+}  // namespace test
+}  // namespace ripple
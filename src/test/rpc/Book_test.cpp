@@ -1306,6 +1306,98 @@ public:
         BEAST_EXPECT(jv[jss::status] == "success");
     }
 
+    void
+    testBookChanges(FeatureBitset features)
+    {
+        testcase("Book changes");
+
+        using namespace jtx;
+        using namespace std::chrono_literals;
+        Env env(*this, features);
+
+        auto const gw = Account("gateway");
+        auto const alice = Account("alice");
+        auto const bob = Account("bob");
+        auto const charlie = Account("charlie");
+        auto const USD = gw["USD"];
+        auto const EUR = gw["EUR"];
+
+        env.fund(XRP(1000000), gw, alice, bob, charlie);
+        env.close();
+
+        for (auto const& account : {alice, bob, charlie})
+        {
+            for (auto const& iou : {USD, EUR})
+            {
+                env(trust(account, iou(1)));
+            }
+        }
+        env.close();
+
+        env(pay(gw, alice, USD(1)));
+        env(pay(gw, charlie, EUR(1)));
+        env.close();
+
+        env(offer(alice, XRP(100), USD(1)));
+        env(offer(bob, EUR(1), XRP(100)));
+        env.close();
+
+        auto wsc = makeWSClient(env.app().config());
+        Json::Value streams;
+        streams[jss::streams] = Json::arrayValue;
+        streams[jss::streams].append("book_changes");
+        {
+            auto jv = wsc->invoke("subscribe", streams);
+            if (!BEAST_EXPECT(jv[jss::status] == "success"))
+                return;
+        }
+
+        // Charlie's offer auto-bridges, and changes both books
+        env(offer(charlie, USD(1), EUR(1)));
+        env.close();
+
+        Json::Value published;
+        BEAST_EXPECT(wsc->findMsg(5s, [&](auto const& jv) {
+            if (jv[jss::type] != "bookChanges" ||
+                jv[jss::changes].size() == 0)
+                return false;
+            published = jv;
+            return true;
+        }));
+        if (!BEAST_EXPECT(published.isObject()))
+            return;
+
+        auto const& changes = published[jss::changes];
+        if (BEAST_EXPECT(changes.size() == 2))
+        {
+            // The books are ordered by the names of their sides
+            BEAST_EXPECT(changes[0u][jss::currency_a] == "XRP_drops");
+            BEAST_EXPECT(
+                changes[0u][jss::currency_b] == to_string(EUR.issue()));
+            BEAST_EXPECT(changes[1u][jss::currency_a] == "XRP_drops");
+            BEAST_EXPECT(
+                changes[1u][jss::currency_b] == to_string(USD.issue()));
+            BEAST_EXPECT(changes[0u][jss::volume_a] == "100000000");
+            BEAST_EXPECT(changes[0u][jss::volume_b] == "1");
+        }
+
+        // The command returns the changes computed when the ledger was
+        // published
+        env.close();
+        Json::Value params;
+        params[jss::ledger_index] = published[jss::ledger_index].asInt();
+        for (int i = 0; i < 2; ++i)
+        {
+            auto const jrr = env.rpc(
+                "json", "book_changes", to_string(params))[jss::result];
+            BEAST_EXPECT(jrr[jss::ledger_hash] == published[jss::ledger_hash]);
+            BEAST_EXPECT(jrr[jss::changes] == changes);
+        }
+
+        auto jv = wsc->invoke("unsubscribe", streams);
+        BEAST_EXPECT(jv[jss::status] == "success");
+    }
+
     void
     testBookOfferErrors(FeatureBitset features)
     {
@@ -1725,6 +1817,7 @@ public:
         testTrackOffers(all);
         testCrossingSingleBookOffer(all);
         testCrossingMultiBookOffer(all);
+        testBookChanges(all);
         testBookOfferErrors(all);
         testBookOfferLimits(all, true);
         testBookOfferLimits(all, false);
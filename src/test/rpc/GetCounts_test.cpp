@@ -50,6 +50,12 @@ class GetCounts_test : public beast::unit_test::suite
             BEAST_EXPECT(
                 result.isMember(jss::dbKBTotal) &&
                 result[jss::dbKBTotal].asInt() > 0);
+            BEAST_EXPECT(
+                result[jss::scratch_serializers].isMember(jss::reused) &&
+                result[jss::scratch_serializers].isMember(jss::allocated));
+            BEAST_EXPECT(
+                result[jss::shamapitem_slabs].isMember(jss::heap) &&
+                result[jss::shamapitem_slabs][jss::slabs].size() == 12);
         }
 
         // create some transactions
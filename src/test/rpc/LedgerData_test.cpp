@@ -646,6 +646,100 @@ public:
         }
     }
 
+    void
+    testParallelism()
+    {
+        testcase("Parallelism");
+
+        using namespace test::jtx;
+        Env env{*this};
+        Account const gw{"gateway"};
+        auto const USD = gw["USD"];
+        env.fund(XRP(100000), gw);
+
+        for (auto i = 0; i < 300; i++)
+        {
+            Account const bob{std::string("bob") + std::to_string(i)};
+            env.fund(XRP(1000), bob);
+            if (i % 3 == 0)
+            {
+                env.trust(USD(1000), bob);
+                env(pay(gw, bob, USD(10)));
+            }
+        }
+        env.close();
+
+        auto const ledgerData = [&env](Json::Value const& jvParams) {
+            return env.rpc(
+                "json",
+                "ledger_data",
+                boost::lexical_cast<std::string>(jvParams))[jss::result];
+        };
+
+        for (bool const binary : {false, true})
+        {
+            for (auto const& type : {"", "state"})
+            {
+                Json::Value jvParams;
+                jvParams[jss::ledger_index] = "closed";
+                jvParams[jss::binary] = binary;
+                jvParams[jss::limit] = 100;
+                if (*type)
+                    jvParams[jss::type] = type;
+
+                // Page through the whole ledger both ways, and expect the
+                // same pages.
+                for (int page = 0;; ++page)
+                {
+                    auto const expected = ledgerData(jvParams);
+                    BEAST_EXPECT(expected[jss::state].isArray());
+                    for (int parallelism : {2, 8, 100})
+                    {
+                        auto params = jvParams;
+                        params[jss::parallelism] = parallelism;
+                        BEAST_EXPECT(ledgerData(params) == expected);
+                    }
+
+                    if (!expected.isMember(jss::marker) || page > 100)
+                        break;
+                    jvParams[jss::marker] = expected[jss::marker];
+                }
+            }
+        }
+
+        {
+            // The parallelism must be an integer.
+            Json::Value jvParams;
+            jvParams[jss::ledger_index] = "closed";
+            jvParams[jss::parallelism] = "many";
+            auto const jrr = ledgerData(jvParams);
+            BEAST_EXPECT(jrr[jss::error] == "invalidParams");
+            BEAST_EXPECT(
+                jrr[jss::error_message] ==
+                "Invalid field 'parallelism', not integer.");
+        }
+
+        {
+            // It is ignored for callers which are not admins.
+            Env userEnv{*this, envconfig(no_admin)};
+            userEnv.fund(XRP(10000), gw);
+
+            Json::Value jvParams;
+            jvParams[jss::ledger_index] = "current";
+            auto const expected = userEnv.rpc(
+                "json",
+                "ledger_data",
+                boost::lexical_cast<std::string>(jvParams))[jss::result];
+            jvParams[jss::parallelism] = "many";
+            auto const jrr = userEnv.rpc(
+                "json",
+                "ledger_data",
+                boost::lexical_cast<std::string>(jvParams))[jss::result];
+            BEAST_EXPECT(!jrr.isMember(jss::error));
+            BEAST_EXPECT(jrr == expected);
+        }
+    }
+
     void
     run() override
     {
@@ -656,6 +750,7 @@ public:
         testMarkerFollow();
         testLedgerHeader();
         testLedgerType();
+        testParallelism();
     }
 };
 
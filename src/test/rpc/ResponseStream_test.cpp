@@ -0,0 +1,389 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/json/json_reader.h>
+#include <ripple/json/to_string.h>
+#include <ripple/protocol/jss.h>
+#include <ripple/rpc/ResponseStream.h>
+#include <test/jtx.h>
+#include <test/jtx/WSClient.h>
+#include <boost/asio/connect.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+#include <boost/beast/http.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace ripple {
+namespace test {
+
+class ResponseStream_test : public beast::unit_test::suite
+{
+    using ResponseStream = RPC::ResponseStream;
+    using Next = ResponseStream::Next;
+
+    static constexpr auto chunkSize = ResponseStream::chunkSize;
+    static constexpr auto highWater = ResponseStream::highWater;
+
+    struct HTTPResponse
+    {
+        bool chunked = false;
+        Json::Value json;
+    };
+
+    // Send a JSON-RPC request the way a plain HTTP client would, so that
+    // the framing of the response can be checked.
+    static HTTPResponse
+    post(
+        jtx::Env& env,
+        std::string const& method,
+        Json::Value const& params,
+        unsigned version = 11)
+    {
+        namespace http = boost::beast::http;
+        using boost::asio::ip::tcp;
+
+        auto const& section = env.app().config()["port_rpc"];
+        boost::asio::io_service ios;
+        tcp::socket socket(ios);
+        tcp::resolver resolver(ios);
+        boost::asio::connect(
+            socket,
+            resolver.resolve(
+                *section.get("ip"), *section.get("port")));
+
+        Json::Value jr;
+        jr[jss::method] = method;
+        jr[jss::params] = Json::arrayValue;
+        jr[jss::params].append(params);
+
+        http::request<http::string_body> req{http::verb::post, "/", version};
+        req.set(http::field::host, *section.get("ip"));
+        req.set(http::field::content_type, "application/json");
+        req.body() = to_string(jr);
+        req.prepare_payload();
+        http::write(socket, req);
+
+        boost::beast::flat_buffer buffer;
+        http::response<http::string_body> res;
+        http::read(socket, buffer, res);
+
+        HTTPResponse result;
+        result.chunked = res.chunked();
+        Json::Reader{}.parse(res.body(), result.json);
+        return result;
+    }
+
+    static Json::Value
+    rpc(jtx::Env& env, std::string const& method, Json::Value const& params)
+    {
+        return env.rpc("json", method, to_string(params))[jss::result];
+    }
+
+public:
+    void
+    testChunks()
+    {
+        testcase("Chunks");
+
+        ResponseStream stream;
+        std::string chunk;
+        bool resumed = false;
+        auto const resume = [&resumed] { resumed = true; };
+
+        BEAST_EXPECT(stream.next(chunk, resume) == Next::wait);
+
+        // Small writes are gathered into chunks.
+        std::string const text(chunkSize / 4, 'a');
+        for (int i = 0; i < 3; ++i)
+            stream.write(text);
+        BEAST_EXPECT(!resumed);
+        stream.write(text);
+        BEAST_EXPECT(resumed);
+
+        BEAST_EXPECT(stream.next(chunk, resume) == Next::chunk);
+        BEAST_EXPECT(chunk == std::string(chunkSize, 'a'));
+        stream.sent(chunk.size());
+
+        // The remainder is sent when the response is finished.
+        resumed = false;
+        stream.write("tail");
+        BEAST_EXPECT(stream.next(chunk, resume) == Next::wait);
+        BEAST_EXPECT(!resumed);
+        stream.finish();
+        BEAST_EXPECT(resumed);
+
+        BEAST_EXPECT(stream.next(chunk, resume) == Next::last);
+        BEAST_EXPECT(chunk == "tail");
+        stream.sent(chunk.size());
+        BEAST_EXPECT(stream.next(chunk, resume) == Next::done);
+        BEAST_EXPECT(stream.size() == chunkSize + 4);
+
+        // An aborted response is not sent any further.
+        ResponseStream aborted;
+        aborted.write(std::string(chunkSize, 'b'));
+        aborted.abort();
+        BEAST_EXPECT(aborted.next(chunk, resume) == Next::aborted);
+    }
+
+    void
+    testBackpressure()
+    {
+        testcase("Backpressure");
+
+        ResponseStream stream;
+        std::string const text(1000, 'x');
+        std::atomic<std::size_t> written{0};
+        std::size_t const total = 4 * highWater;
+
+        std::thread producer([&] {
+            while (written < total)
+            {
+                stream.write(text);
+                written += text.size();
+            }
+            stream.finish();
+        });
+
+        // The producer stops once it is far enough ahead of the
+        // connection.
+        while (written < highWater)
+            std::this_thread::yield();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        BEAST_EXPECT(written < 2 * highWater);
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool ready = false;
+        auto const resume = [&] {
+            std::lock_guard lock(mutex);
+            ready = true;
+            cv.notify_one();
+        };
+
+        std::size_t received = 0;
+        std::size_t ahead = 0;
+        for (;;)
+        {
+            std::string chunk;
+            auto const next = stream.next(chunk, resume);
+            if (next == Next::wait)
+            {
+                std::unique_lock lock(mutex);
+                cv.wait(lock, [&ready] { return ready; });
+                ready = false;
+                continue;
+            }
+            if (next == Next::done)
+                break;
+
+            received += chunk.size();
+            if (auto const w = written.load(); w > received)
+                ahead = std::max(ahead, w - received);
+            stream.sent(chunk.size());
+            if (next == Next::last)
+                break;
+        }
+
+        producer.join();
+        BEAST_EXPECT(received == written);
+        BEAST_EXPECT(received == stream.size());
+        BEAST_EXPECT(ahead <= highWater + 2 * chunkSize);
+    }
+
+    void
+    testAbandon()
+    {
+        testcase("Abandon");
+
+        ResponseStream stream;
+        std::string const text(1000, 'x');
+        std::atomic<std::size_t> written{0};
+        std::atomic<bool> finished{false};
+
+        std::thread producer([&] {
+            while (written < 4 * highWater)
+            {
+                stream.write(text);
+                written += text.size();
+            }
+            stream.finish();
+            finished = true;
+        });
+
+        while (written < highWater)
+            std::this_thread::yield();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        BEAST_EXPECT(!finished);
+
+        // Losing the connection releases the producer, and the rest of
+        // the response is discarded.
+        stream.abandon();
+        producer.join();
+        BEAST_EXPECT(finished);
+
+        std::string chunk;
+        BEAST_EXPECT(stream.next(chunk, [] {}) == Next::done);
+        BEAST_EXPECT(chunk.empty());
+    }
+
+    void
+    testHandlers()
+    {
+        testcase("Handlers");
+
+        using namespace jtx;
+        Env env{*this};
+
+        Account const gw{"gateway"};
+        auto const USD = gw["USD"];
+        env.fund(XRP(100000), gw);
+        env.close();
+
+        // Enough ledger entries and transactions for several chunks.
+        for (int i = 0; i < 200; ++i)
+        {
+            env.fund(XRP(1000), Account{"acct" + std::to_string(i)});
+            if (i % 50 == 49)
+                env.close();
+        }
+        for (int i = 0; i < 40; ++i)
+            env(offer(gw, XRP(10 + i), USD(10)));
+        env.close();
+
+        auto const seq = env.closed()->seq();
+        auto wsc = makeWSClient(env.app().config());
+
+        auto check = [&](std::string const& method, Json::Value params) {
+            params[jss::streamed] = true;
+            auto const expected = rpc(env, method, params);
+            BEAST_EXPECT(expected[jss::status] == jss::success);
+
+            auto const http = post(env, method, params);
+            BEAST_EXPECT(http.chunked);
+            BEAST_EXPECT(http.json[jss::result] == expected);
+
+            auto const ws = wsc->invoke(method, params);
+            BEAST_EXPECT(ws[jss::result] == expected);
+        };
+
+        {
+            Json::Value params;
+            params[jss::ledger_index] = seq;
+            params[jss::transactions] = true;
+            params[jss::accounts] = true;
+            params[jss::expand] = true;
+            check("ledger", params);
+            params[jss::binary] = true;
+            check("ledger", params);
+        }
+        {
+            Json::Value params;
+            params[jss::ledger_index] = seq;
+            params[jss::limit] = 1000;
+            check("ledger_data", params);
+            params[jss::binary] = true;
+            check("ledger_data", params);
+        }
+        {
+            Json::Value params;
+            params[jss::ledger_index] = seq;
+            params[jss::limit] = 10;
+            check("ledger_data", params);
+        }
+        {
+            Json::Value params;
+            params[jss::account] = gw.human();
+            params[jss::ledger_index] = seq;
+            check("account_objects", params);
+            params[jss::limit] = 10;
+            check("account_objects", params);
+        }
+        {
+            Json::Value params;
+            params[jss::account] = gw.human();
+            check("account_tx", params);
+            params[jss::binary] = true;
+            check("account_tx", params);
+        }
+
+        // Only clients that ask for it get a streamed response.
+        {
+            Json::Value params;
+            params[jss::ledger_index] = seq;
+            auto const expected = rpc(env, "ledger_data", params);
+            auto const http = post(env, "ledger_data", params);
+            BEAST_EXPECT(!http.chunked);
+            BEAST_EXPECT(http.json[jss::result] == expected);
+        }
+
+        // Errors are found before the response starts, and are sent as
+        // usual.
+        {
+            Json::Value params;
+            params[jss::streamed] = true;
+            params[jss::marker] = "not a marker";
+            auto const expected = rpc(env, "ledger_data", params);
+            BEAST_EXPECT(expected[jss::status] == "error");
+
+            auto const http = post(env, "ledger_data", params);
+            BEAST_EXPECT(!http.chunked);
+            BEAST_EXPECT(
+                http.json[jss::result][jss::error] == expected[jss::error]);
+        }
+
+        // HTTP/1.0 clients can not receive chunked responses.
+        {
+            Json::Value params;
+            params[jss::streamed] = true;
+            params[jss::ledger_index] = seq;
+            auto const expected = rpc(env, "ledger_data", params);
+            auto const http = post(env, "ledger_data", params, 10);
+            BEAST_EXPECT(!http.chunked);
+            BEAST_EXPECT(http.json[jss::result] == expected);
+        }
+
+        // Other commands are not streamed.
+        {
+            Json::Value params;
+            params[jss::streamed] = true;
+            auto const http = post(env, "server_info", params);
+            BEAST_EXPECT(!http.chunked);
+            BEAST_EXPECT(http.json[jss::result][jss::status] == "success");
+        }
+    }
+
+    void
+    run() override
+    {
+        testChunks();
+        testBackpressure();
+        testAbandon();
+        testHandlers();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(ResponseStream, rpc, ripple);
+
+}  // namespace test
+}  // namespace ripple
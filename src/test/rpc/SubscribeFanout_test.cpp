@@ -0,0 +1,302 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/misc/NetworkOPs.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/json/json_writer.h>
+#include <ripple/json/to_string.h>
+#include <ripple/net/InfoSub.h>
+#include <ripple/protocol/jss.h>
+#include <test/jtx.h>
+
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+namespace ripple {
+namespace test {
+
+// Exercise the fan-out of subscription streams to many subscribers.
+class SubscribeFanout_test : public beast::unit_test::suite
+{
+protected:
+    // A subscriber that does no I/O, but pays the cost of serializing
+    // each message the same way a WebSocket session would.
+    class NullSub : public InfoSub
+    {
+        bool const shared_;
+
+    public:
+        std::atomic<std::size_t> messages = 0;
+        std::atomic<std::size_t> bytes = 0;
+        std::atomic<std::size_t> disconnects = 0;
+
+        NullSub(Source& source, bool shared) : InfoSub(source), shared_(shared)
+        {
+        }
+
+        void
+        send(Json::Value const& jv, bool) override
+        {
+            std::string s;
+            Json::stream(jv, [&s](void const* data, std::size_t n) {
+                s.append(static_cast<char const*>(data), n);
+            });
+            ++messages;
+            bytes += s.size();
+        }
+
+        void
+        send(StreamMessage::pointer const& msg, bool broadcast) override
+        {
+            if (!shared_)
+                return InfoSub::send(msg, broadcast);
+            ++messages;
+            bytes += msg->size();
+        }
+
+        void
+        disconnect() override
+        {
+            ++disconnects;
+        }
+    };
+
+    struct Result
+    {
+        std::chrono::microseconds elapsed;
+        std::size_t messages = 0;
+        std::size_t bytes = 0;
+    };
+
+    // Build a closed ledger containing `txns` payments.
+    std::shared_ptr<ReadView const>
+    makeLedger(jtx::Env& env, std::size_t txns)
+    {
+        using namespace jtx;
+        Account const alice("alice");
+        Account const bob("bob");
+        env.fund(XRP(1000000), alice, bob);
+        env.close();
+        for (std::size_t i = 0; i < txns; ++i)
+            env(pay(alice, bob, XRP(1)));
+        env.close();
+        return env.closed();
+    }
+
+    // Publish `ledger` to `subscribers` subscribers of the `ledger` and
+    // `transactions` streams.
+    Result
+    publish(
+        jtx::Env& env,
+        std::shared_ptr<ReadView const> const& ledger,
+        std::size_t subscribers,
+        bool shared)
+    {
+        using clock_type = std::chrono::steady_clock;
+
+        auto& ops = env.app().getOPs();
+
+        std::vector<std::shared_ptr<NullSub>> subs;
+        subs.reserve(subscribers);
+        for (std::size_t i = 0; i < subscribers; ++i)
+        {
+            auto sub = std::make_shared<NullSub>(ops, shared);
+            Json::Value jv;
+            ops.subLedger(sub, jv);
+            ops.subTransactions(sub);
+            subs.push_back(std::move(sub));
+        }
+
+        auto const start = clock_type::now();
+        ops.pubLedger(ledger);
+        Result result;
+        result.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            clock_type::now() - start);
+
+        for (auto const& sub : subs)
+        {
+            result.messages += sub->messages;
+            result.bytes += sub->bytes;
+        }
+        return result;
+    }
+
+    void
+    testSharedMessage()
+    {
+        testcase("Shared message");
+
+        jtx::Env env(*this);
+        auto const ledger = makeLedger(env, 3);
+
+        auto const legacy = publish(env, ledger, 3, false);
+        auto const shared = publish(env, ledger, 3, true);
+
+        // One ledgerClosed message and one message per transaction.
+        BEAST_EXPECT(legacy.messages == 3 * (1 + 3));
+        BEAST_EXPECT(shared.messages == legacy.messages);
+        BEAST_EXPECT(shared.bytes == legacy.bytes);
+
+        auto const msg = makeStreamMessage(Json::Value("text"));
+        BEAST_EXPECT(msg->text() == "\"text\"\n");
+        BEAST_EXPECT(msg->json() == Json::Value("text"));
+    }
+
+    void
+    testDeliveryQueue()
+    {
+        testcase("Delivery queue");
+
+        jtx::Env env(*this);
+        auto sub = std::make_shared<NullSub>(env.app().getOPs(), true);
+
+        int delivered = 0;
+        auto const deliver = [&delivered](InfoSub&) { ++delivered; };
+
+        BEAST_EXPECT(sub->queueDelivery(deliver, 2) == InfoSub::Queued::drain);
+        BEAST_EXPECT(
+            sub->queueDelivery(deliver, 2) == InfoSub::Queued::pending);
+        BEAST_EXPECT(
+            sub->queueDelivery(deliver, 2) == InfoSub::Queued::overflow);
+        BEAST_EXPECT(sub->getDroppedDeliveries() == 1);
+
+        sub->drainDeliveries();
+        BEAST_EXPECT(delivered == 2);
+
+        // Once drained, the next delivery needs a new drain
+        BEAST_EXPECT(sub->queueDelivery(deliver, 2) == InfoSub::Queued::drain);
+        sub->drainDeliveries();
+        BEAST_EXPECT(delivered == 3);
+    }
+
+    void
+    testAccountDelivery()
+    {
+        testcase("Account delivery");
+
+        using namespace jtx;
+        Env env(*this);
+        Account const alice("alice");
+        Account const bob("bob");
+        Account const carol("carol");
+        env.fund(XRP(10000), alice, bob, carol);
+        env.close();
+
+        auto& ops = env.app().getOPs();
+        auto sub = std::make_shared<NullSub>(ops, true);
+        ops.subAccount(sub, {alice.id(), bob.id()}, false);
+
+        // Affects alice and bob: delivered once, not once per account.
+        env(pay(alice, bob, XRP(10)));
+        // Affects neither.
+        env(pay(carol, env.master, XRP(10)));
+        env.close();
+
+        using namespace std::chrono_literals;
+        for (int i = 0; i < 50 && sub->messages < 1; ++i)
+            std::this_thread::sleep_for(100ms);
+
+        BEAST_EXPECT(sub->messages == 1);
+        BEAST_EXPECT(sub->getDroppedDeliveries() == 0);
+        BEAST_EXPECT(sub->disconnects == 0);
+    }
+
+    void
+    testRPCSubDisconnect()
+    {
+        testcase("Disconnect a URL subscriber");
+
+        jtx::Env env(*this);
+        auto& ops = env.app().getOPs();
+
+        std::string const url = "http://127.0.0.1:9/";
+        Json::Value jv;
+        jv[jss::url] = url;
+        jv[jss::streams] = Json::arrayValue;
+        jv[jss::streams].append("ledger");
+        auto const jr = env.rpc("json", "subscribe", to_string(jv));
+        BEAST_EXPECT(jr[jss::result][jss::status] == "success");
+
+        auto sub = ops.findRpcSub(url);
+        if (!BEAST_EXPECT(sub))
+            return;
+
+        // A slow subscriber is forgotten, which ends its subscriptions
+        sub->disconnect();
+        BEAST_EXPECT(!ops.findRpcSub(url));
+        std::weak_ptr<InfoSub> const weak = sub;
+        sub.reset();
+        BEAST_EXPECT(weak.expired());
+    }
+
+public:
+    void
+    run() override
+    {
+        testSharedMessage();
+        testDeliveryQueue();
+        testAccountDelivery();
+        testRPCSubDisconnect();
+    }
+};
+
+// Measure ledger publish latency against the number of subscribers.
+class SubscribeFanoutBench_test : public SubscribeFanout_test
+{
+public:
+    void
+    run() override
+    {
+        testcase("Publish latency");
+
+        jtx::Env env(
+            *this, jtx::envconfig(), nullptr, beast::severities::kError);
+        env.disable_sigs();
+        auto const ledger = makeLedger(env, 200);
+
+        // Warm up the accepted ledger cache.
+        publish(env, ledger, 1, true);
+
+        log << std::left << std::setw(12) << "subscribers" << std::right
+            << std::setw(14) << "legacy (us)" << std::setw(14) << "shared (us)"
+            << std::setw(14) << "messages" << std::endl;
+
+        for (std::size_t const n : {1, 10, 100, 500, 1000, 2000})
+        {
+            auto const legacy = publish(env, ledger, n, false);
+            auto const shared = publish(env, ledger, n, true);
+            BEAST_EXPECT(shared.bytes == legacy.bytes);
+
+            std::stringstream ss;
+            ss << std::left << std::setw(12) << n << std::right
+               << std::setw(14) << legacy.elapsed.count() << std::setw(14)
+               << shared.elapsed.count() << std::setw(14) << shared.messages;
+            log << ss.str() << std::endl;
+        }
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(SubscribeFanout, app, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(SubscribeFanoutBench, app, ripple, 5);
+
+}  // namespace test
+}  // namespace ripple
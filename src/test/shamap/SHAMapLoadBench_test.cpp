@@ -0,0 +1,127 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/random.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/digest.h>
+#include <ripple/shamap/SHAMap.h>
+#include <boost/predef.h>
+#include <test/shamap/common.h>
+#include <test/unit_test/SuiteJournal.h>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#if BOOST_OS_LINUX
+#include <unistd.h>
+#endif
+
+namespace ripple {
+namespace tests {
+
+// Loads a state map with as many leaves as a full ledger has (or as many as
+// given with --unittest-arg), with payloads of the sizes ledger entries
+// typically have, and reports how much resident memory each leaf costs and
+// how the items were spread over the slabs.
+class SHAMapLoadBench_test : public beast::unit_test::suite
+{
+    // The resident set size of this process, in bytes, or zero if unknown
+    static std::size_t
+    rss()
+    {
+#if BOOST_OS_LINUX
+        std::ifstream statm("/proc/self/statm");
+        std::size_t size = 0;
+        std::size_t resident = 0;
+        if (statm >> size >> resident)
+            return resident * ::sysconf(_SC_PAGESIZE);
+#endif
+        return 0;
+    }
+
+public:
+    void
+    run() override
+    {
+        test::SuiteJournal journal("SHAMapLoadBench_test", *this);
+
+        std::size_t count = 2000000;
+        if (!arg().empty())
+            count = std::stoul(arg());
+
+        // The ranges of sizes of an account, an offer, a trust line and a
+        // directory page, in serialized form.
+        std::array<std::pair<std::size_t, std::size_t>, 4> const sizes{
+            {{100, 140}, {150, 190}, {180, 230}, {90, 400}}};
+
+        beast::xor_shift_engine eng(42);
+        Buffer payload(400);
+        std::size_t payloadBytes = 0;
+
+        TestNodeFamily f(journal);
+        SHAMap map(SHAMapType::STATE, f);
+        map.setUnbacked();
+
+        auto const before = rss();
+        auto const start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto const [low, high] = sizes[i % sizes.size()];
+            auto const size = rand_int(eng, low, high);
+            for (std::size_t j = 0; j < size; ++j)
+                payload.data()[j] = rand_byte<std::uint8_t>(eng);
+            payloadBytes += size;
+
+            map.addItem(
+                SHAMapNodeType::tnACCOUNT_STATE,
+                make_shamapitem(sha512Half(i), Slice(payload.data(), size)));
+        }
+        BEAST_EXPECT(map.getHash().isNonZero());
+        auto const elapsed = std::chrono::duration<double>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count();
+        auto const after = rss();
+
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(1) << count << " leaves, "
+           << payloadBytes / double(count) << " payload bytes/leaf, "
+           << elapsed * 1e9 / count << " ns/leaf to load";
+        if (after > before)
+            ss << ", " << (after - before) / double(count)
+               << " resident bytes/leaf, " << (after - before) / 1048576.0
+               << " MiB in all";
+        log << ss.str() << std::endl;
+
+        for (auto const& s : detail::slabber.stats())
+        {
+            if (s.slabs == 0)
+                continue;
+            log << "  " << s.size << " byte blocks: " << s.used << " used of "
+                << s.capacity << " in " << s.slabs << " slabs" << std::endl;
+        }
+        log << "  on the heap: " << detail::shamapItemsOnHeap << std::endl;
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(SHAMapLoadBench, shamap, ripple, 5);
+
+}  // namespace tests
+}  // namespace ripple
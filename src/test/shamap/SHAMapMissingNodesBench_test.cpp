@@ -0,0 +1,136 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/random.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/utility/temp_dir.h>
+#include <ripple/protocol/digest.h>
+#include <ripple/shamap/SHAMap.h>
+#include <test/shamap/common.h>
+#include <test/unit_test/SuiteJournal.h>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+namespace ripple {
+namespace tests {
+
+// Stores a state map with a million leaves (or as many as given with
+// --unittest-arg) in a NuDB node store, then times a search for missing
+// nodes over the whole map, as InboundLedger::tryDB makes when the ledger
+// is already on disk, with from one to sixteen threads.
+//
+// Each search opens the store afresh, so the tree node and full below
+// caches start out empty, but the operating system's page cache does not.
+// The first search warms it up and is not reported. To time reads from the
+// device, drop the page cache between runs of this suite with a single
+// thread count.
+class SHAMapMissingNodesBench_test : public beast::unit_test::suite
+{
+public:
+    void
+    run() override
+    {
+        using namespace std::chrono;
+
+        test::SuiteJournal journal("SHAMapMissingNodesBench_test", *this);
+
+        std::size_t count = 1000000;
+        if (!arg().empty())
+            count = std::stoul(arg());
+
+        // The node store reads with as many threads as a server would
+        int constexpr readThreads = 8;
+
+        beast::temp_dir tempDir;
+        Section config;
+        config.set("type", "nudb");
+        config.set("path", tempDir.path());
+
+        SHAMapHash hash;
+        {
+            beast::xor_shift_engine eng(42);
+            Buffer payload(256);
+
+            TestNodeFamily f(journal);
+            SHAMap map(SHAMapType::STATE, f);
+            map.setUnbacked();
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                auto const size = rand_int(eng, 90, 250);
+                for (std::size_t j = 0; j < size; ++j)
+                    payload.data()[j] = rand_byte<std::uint8_t>(eng);
+
+                Slice const data(payload.data(), size);
+                map.addItem(
+                    SHAMapNodeType::tnACCOUNT_STATE,
+                    make_shamapitem(sha512Half(i), data));
+            }
+            hash = map.getHash();
+
+            TestNodeFamily store(journal, config, readThreads);
+            std::size_t nodes = 0;
+            map.visitNodes([&](SHAMapTreeNode& node) {
+                Serializer s;
+                node.serializeWithPrefix(s);
+                store.db().store(
+                    hotACCOUNT_NODE,
+                    std::move(s.modData()),
+                    node.getHash().as_uint256(),
+                    0);
+                ++nodes;
+                return true;
+            });
+            log << count << " leaves, " << nodes << " nodes stored"
+                << std::endl;
+        }
+
+        auto search = [&](std::size_t threads) {
+            TestNodeFamily f(journal, config, readThreads);
+            SHAMap map(SHAMapType::STATE, hash.as_uint256(), f);
+            BEAST_EXPECT(map.fetchRoot(hash, nullptr));
+
+            SHAMap::ScanProgress progress;
+            auto const start = steady_clock::now();
+            auto const missing =
+                map.getMissingNodes(1, nullptr, threads, &progress);
+            auto const elapsed =
+                duration<double>(steady_clock::now() - start).count();
+            BEAST_EXPECT(missing.empty());
+            BEAST_EXPECT(!map.isSynching());
+
+            std::stringstream ss;
+            ss << std::fixed << std::setprecision(3) << std::setw(2)
+               << threads << (threads == 1 ? " thread:  " : " threads: ")
+               << elapsed << " s, " << std::setprecision(0)
+               << progress.readsDone / elapsed << " reads/s, "
+               << progress.innerNodes << " inner nodes";
+            return ss.str();
+        };
+
+        search(1);
+        for (std::size_t threads : {1, 2, 4, 8, 16})
+            log << search(threads) << std::endl;
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(SHAMapMissingNodesBench, shamap, ripple, 5);
+
+}  // namespace tests
+}  // namespace ripple
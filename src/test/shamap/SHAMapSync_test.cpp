@@ -34,14 +34,14 @@ class SHAMapSync_test : public beast::unit_test::suite
 public:
     beast::xor_shift_engine eng_;
 
-    std::shared_ptr<SHAMapItem>
+    boost::intrusive_ptr<SHAMapItem>
     makeRandomAS()
     {
         Serializer s;
 
         for (int d = 0; d < 3; ++d)
             s.add32(rand_int<std::uint32_t>(eng_));
-        return std::make_shared<SHAMapItem>(s.getSHA512Half(), s.slice());
+        return make_shamapitem(s.getSHA512Half(), s.slice());
     }
 
     bool
@@ -55,10 +55,10 @@ public:
 
         for (int i = 0; i < count; ++i)
         {
-            std::shared_ptr<SHAMapItem> item = makeRandomAS();
+            auto item = makeRandomAS();
             items.push_back(item->key());
 
-            if (!map.addItem(SHAMapNodeType::tnACCOUNT_STATE, std::move(*item)))
+            if (!map.addItem(SHAMapNodeType::tnACCOUNT_STATE, std::move(item)))
             {
                 log << "Unable to add item to map\n";
                 return false;
@@ -85,8 +85,12 @@ public:
     }
 
     void
-    run() override
+    testSync(std::size_t threads)
     {
+        testcase(
+            "sync, adding nodes on " + std::to_string(threads) +
+            (threads == 1 ? " thread" : " threads"));
+
         using namespace beast::severities;
         test::SuiteJournal journal("SHAMapSync_test", *this);
 
@@ -97,8 +101,7 @@ public:
         int items = 10000;
         for (int i = 0; i < items; ++i)
         {
-            source.addItem(
-                SHAMapNodeType::tnACCOUNT_STATE, std::move(*makeRandomAS()));
+            source.addItem(SHAMapNodeType::tnACCOUNT_STATE, makeRandomAS());
             if (i % 100 == 0)
                 source.invariants();
         }
@@ -167,15 +170,33 @@ public:
             if (b.empty())
                 fail("", __FILE__, __LINE__);
 
-            for (std::size_t i = 0; i < b.size(); ++i)
+            if (threads == 1)
             {
-                // Don't use BEAST_EXPECT here b/c it will be called a
-                // non-deterministic number of times and the number of tests run
-                // should be deterministic
-                if (!destination
-                         .addKnownNode(
-                             b[i].first, makeSlice(b[i].second), nullptr)
-                         .isUseful())
+                for (std::size_t i = 0; i < b.size(); ++i)
+                {
+                    // Don't use BEAST_EXPECT here b/c it will be called a
+                    // non-deterministic number of times and the number of
+                    // tests run should be deterministic
+                    if (!destination
+                             .addKnownNode(
+                                 b[i].first, makeSlice(b[i].second), nullptr)
+                             .isUseful())
+                        fail("", __FILE__, __LINE__);
+                }
+            }
+            else
+            {
+                std::vector<std::pair<SHAMapNodeID, Slice>> batch;
+                batch.reserve(b.size());
+                for (auto const& [id, data] : b)
+                    batch.emplace_back(id, makeSlice(data));
+
+                // A fat reply lists each node before its children, so
+                // every node in the batch can be hooked.
+                auto const san =
+                    destination.addKnownNodes(batch, nullptr, threads);
+                if (!san.isUseful() || san.isInvalid() ||
+                    san.getGood() != static_cast<int>(batch.size()))
                     fail("", __FILE__, __LINE__);
             }
         } while (true);
@@ -186,6 +207,74 @@ public:
 
         destination.invariants();
     }
+
+    void
+    testMissingNodes()
+    {
+        testcase("missing nodes in the node store");
+
+        test::SuiteJournal journal("SHAMapSync_test", *this);
+
+        TestNodeFamily f(journal);
+        SHAMap source(SHAMapType::STATE, f);
+        for (int i = 0; i < 10000; ++i)
+            source.addItem(SHAMapNodeType::tnACCOUNT_STATE, makeRandomAS());
+        source.setImmutable();
+
+        for (std::size_t threads : {1, 4})
+        {
+            // Store every node but about one leaf in sixteen
+            TestNodeFamily f2(journal);
+            std::set<uint256> lost;
+            source.visitNodes([&](SHAMapTreeNode& node) {
+                auto const hash = node.getHash().as_uint256();
+                if (node.isLeaf() && *hash.begin() < 16)
+                {
+                    lost.insert(hash);
+                    return true;
+                }
+
+                Serializer s;
+                node.serializeWithPrefix(s);
+                f2.db().store(hotACCOUNT_NODE, std::move(s.modData()), hash, 0);
+                return true;
+            });
+
+            SHAMap destination(
+                SHAMapType::STATE, source.getHash().as_uint256(), f2);
+            BEAST_EXPECT(destination.fetchRoot(source.getHash(), nullptr));
+
+            SHAMap::ScanProgress progress;
+            auto const missing = destination.getMissingNodes(
+                100000, nullptr, threads, &progress);
+
+            std::set<uint256> found;
+            for (auto const& [id, hash] : missing)
+                found.insert(hash);
+            BEAST_EXPECT(missing.size() == lost.size());
+            BEAST_EXPECT(found == lost);
+
+            BEAST_EXPECT(progress.scans == 1);
+            BEAST_EXPECT(progress.running == 0);
+            BEAST_EXPECT(progress.missing == lost.size());
+            BEAST_EXPECT(progress.reads != 0);
+            BEAST_EXPECT(progress.reads == progress.readsDone);
+            BEAST_EXPECT(progress.innerNodes != 0);
+
+            // The search stops once enough nodes have been found
+            auto const one = destination.getMissingNodes(1, nullptr, threads);
+            BEAST_EXPECT(one.size() == 1 && lost.count(one[0].second) == 1);
+            BEAST_EXPECT(destination.isSynching());
+        }
+    }
+
+    void
+    run() override
+    {
+        testSync(1);
+        testSync(4);
+        testMissingNodes();
+    }
 };
 
 BEAST_DEFINE_TESTSUITE(SHAMapSync, shamap, ripple);
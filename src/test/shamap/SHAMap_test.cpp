@@ -21,8 +21,10 @@
 #include <ripple/basics/Buffer.h>
 #include <ripple/beast/unit_test.h>
 #include <ripple/beast/utility/Journal.h>
+#include <ripple/protocol/digest.h>
 #include <ripple/shamap/SHAMap.h>
 #include <algorithm>
+#include <atomic>
 #include <test/shamap/common.h>
 #include <test/unit_test/SuiteJournal.h>
 
@@ -45,10 +47,10 @@ static_assert(std::is_move_assignable<SHAMap::const_iterator>{}, "");
 
 static_assert(std::is_nothrow_destructible<SHAMapItem>{}, "");
 static_assert(!std::is_default_constructible<SHAMapItem>{}, "");
-static_assert(std::is_copy_constructible<SHAMapItem>{}, "");
-static_assert(std::is_copy_assignable<SHAMapItem>{}, "");
-static_assert(std::is_move_constructible<SHAMapItem>{}, "");
-static_assert(std::is_move_assignable<SHAMapItem>{}, "");
+static_assert(!std::is_copy_constructible<SHAMapItem>{}, "");
+static_assert(!std::is_copy_assignable<SHAMapItem>{}, "");
+static_assert(!std::is_move_constructible<SHAMapItem>{}, "");
+static_assert(!std::is_move_assignable<SHAMapItem>{}, "");
 
 static_assert(std::is_nothrow_destructible<SHAMapNodeID>{}, "");
 static_assert(std::is_default_constructible<SHAMapNodeID>{}, "");
@@ -124,10 +126,63 @@ public:
         using namespace beast::severities;
         test::SuiteJournal journal("SHAMap_test", *this);
 
+        testItems();
         run(true, journal);
         run(false, journal);
     }
 
+    void
+    testItems()
+    {
+        testcase("items");
+
+        auto const used = [] {
+            std::size_t n = 0;
+            for (auto const& s : detail::slabber.stats())
+                n += s.used;
+            return n;
+        };
+
+        auto const slabbed = used();
+        auto const onHeap = detail::shamapItemsOnHeap.load();
+
+        std::vector<boost::intrusive_ptr<SHAMapItem const>> items;
+        for (std::size_t size : {0, 1, 80, 500, 1000, 1100, 5000})
+        {
+            Buffer data(size);
+            std::fill_n(
+                data.data(), size, static_cast<std::uint8_t>(size & 0xff));
+
+            auto item = make_shamapitem(sha512Half(size), data);
+            BEAST_EXPECT(item->key() == sha512Half(size));
+            BEAST_EXPECT(item->size() == size);
+            BEAST_EXPECT(item->slice() == Slice(data));
+
+            // The payload follows the header in the same allocation.
+            BEAST_EXPECT(
+                item->data() ==
+                reinterpret_cast<std::uint8_t const*>(item.get()) +
+                    sizeof(SHAMapItem));
+
+            auto copy = make_shamapitem(*item);
+            BEAST_EXPECT(copy.get() != item.get());
+            BEAST_EXPECT(copy->key() == item->key());
+            BEAST_EXPECT(copy->slice() == item->slice());
+
+            items.push_back(item);
+            items.push_back(item);
+        }
+
+        // Each distinct item is counted once: the largest sizes are too
+        // big for any slab and come from the heap instead.
+        BEAST_EXPECT(used() == slabbed + 5);
+        BEAST_EXPECT(detail::shamapItemsOnHeap == onHeap + 2);
+
+        items.clear();
+        BEAST_EXPECT(used() == slabbed);
+        BEAST_EXPECT(detail::shamapItemsOnHeap == onHeap);
+    }
+
     void
     run(bool backed, beast::Journal const& journal)
     {
@@ -155,37 +210,43 @@ public:
         if (!backed)
             sMap.setUnbacked();
 
-        SHAMapItem i1(h1, IntToVUC(1)), i2(h2, IntToVUC(2)),
-            i3(h3, IntToVUC(3)), i4(h4, IntToVUC(4)), i5(h5, IntToVUC(5));
+        auto i1 = make_shamapitem(h1, IntToVUC(1));
+        auto i2 = make_shamapitem(h2, IntToVUC(2));
+        auto i3 = make_shamapitem(h3, IntToVUC(3));
+        auto i4 = make_shamapitem(h4, IntToVUC(4));
+        auto i5 = make_shamapitem(h5, IntToVUC(5));
+
         unexpected(
-            !sMap.addItem(SHAMapNodeType::tnTRANSACTION_NM, SHAMapItem{i2}),
+            !sMap.addItem(
+                SHAMapNodeType::tnTRANSACTION_NM, make_shamapitem(*i2)),
             "no add");
         sMap.invariants();
         unexpected(
-            !sMap.addItem(SHAMapNodeType::tnTRANSACTION_NM, SHAMapItem{i1}),
+            !sMap.addItem(
+                SHAMapNodeType::tnTRANSACTION_NM, make_shamapitem(*i1)),
             "no add");
         sMap.invariants();
 
         auto i = sMap.begin();
         auto e = sMap.end();
-        unexpected(i == e || (*i != i1), "bad traverse");
+        unexpected(i == e || (*i != *i1), "bad traverse");
         ++i;
-        unexpected(i == e || (*i != i2), "bad traverse");
+        unexpected(i == e || (*i != *i2), "bad traverse");
         ++i;
         unexpected(i != e, "bad traverse");
-        sMap.addItem(SHAMapNodeType::tnTRANSACTION_NM, SHAMapItem{i4});
+        sMap.addItem(SHAMapNodeType::tnTRANSACTION_NM, make_shamapitem(*i4));
         sMap.invariants();
-        sMap.delItem(i2.key());
+        sMap.delItem(i2->key());
         sMap.invariants();
-        sMap.addItem(SHAMapNodeType::tnTRANSACTION_NM, SHAMapItem{i3});
+        sMap.addItem(SHAMapNodeType::tnTRANSACTION_NM, make_shamapitem(*i3));
         sMap.invariants();
         i = sMap.begin();
         e = sMap.end();
-        unexpected(i == e || (*i != i1), "bad traverse");
+        unexpected(i == e || (*i != *i1), "bad traverse");
         ++i;
-        unexpected(i == e || (*i != i3), "bad traverse");
+        unexpected(i == e || (*i != *i3), "bad traverse");
         ++i;
-        unexpected(i == e || (*i != i4), "bad traverse");
+        unexpected(i == e || (*i != *i4), "bad traverse");
         ++i;
         unexpected(i != e, "bad traverse");
 
@@ -265,9 +326,9 @@ public:
             BEAST_EXPECT(map.getHash() == beast::zero);
             for (int k = 0; k < keys.size(); ++k)
             {
-                SHAMapItem item(keys[k], IntToVUC(k));
                 BEAST_EXPECT(map.addItem(
-                    SHAMapNodeType::tnTRANSACTION_NM, std::move(item)));
+                    SHAMapNodeType::tnTRANSACTION_NM,
+                    make_shamapitem(keys[k], IntToVUC(k))));
                 BEAST_EXPECT(map.getHash().as_uint256() == hashes[k]);
                 map.invariants();
             }
@@ -312,7 +373,7 @@ public:
             {
                 map.addItem(
                     SHAMapNodeType::tnTRANSACTION_NM,
-                    SHAMapItem{k, IntToVUC(0)});
+                    make_shamapitem(k, IntToVUC(0)));
                 map.invariants();
             }
 
@@ -323,6 +384,103 @@ public:
                 --h;
             }
         }
+
+        if (backed)
+            testcase("parallel visit backed");
+        else
+            testcase("parallel visit unbacked");
+
+        {
+            tests::TestNodeFamily tf{journal};
+            SHAMap map{SHAMapType::FREE, tf};
+            if (!backed)
+                map.setUnbacked();
+            for (int i = 0; i < 1000; ++i)
+            {
+                map.addItem(
+                    SHAMapNodeType::tnTRANSACTION_NM,
+                    make_shamapitem(sha512Half(i), IntToVUC(i)));
+            }
+
+            auto const sequential = [&map](uint256 const& start) {
+                std::vector<uint256> keys;
+                for (auto it = map.upper_bound(start); it != map.end(); ++it)
+                    keys.push_back(it->key());
+                return keys;
+            };
+
+            auto const parallel = [this, &map](
+                                      uint256 const& start,
+                                      std::size_t threads,
+                                      std::size_t limit) {
+                std::vector<uint256> keys;
+                std::atomic<std::size_t> prepared = 0;
+                map.visitLeavesParallel(
+                    start,
+                    limit,
+                    threads,
+                    [&prepared](SHAMapItem const& item) {
+                        ++prepared;
+                        return item.key();
+                    },
+                    [&](SHAMapItem const& item, uint256 key) {
+                        if (item.key() != key)
+                            return false;
+                        keys.push_back(key);
+                        return true;
+                    });
+                // Nothing past the limit is walked.
+                BEAST_EXPECT(prepared == keys.size());
+                return keys;
+            };
+
+            auto const all = sequential(uint256());
+            BEAST_EXPECT(all.size() == 1000);
+
+            // Start from the beginning, from within the first range, from
+            // the middle of the map and from past the last key.
+            std::vector<uint256> const starts{
+                uint256(), all[3], all[500], all.back()};
+
+            for (auto const& start : starts)
+            {
+                auto const expected = sequential(start);
+                for (std::size_t threads : {1, 2, 4, 8, 32})
+                {
+                    BEAST_EXPECT(parallel(start, threads, 5000) == expected);
+
+                    for (std::size_t limit : {17, 600})
+                    {
+                        auto const some = parallel(start, threads, limit);
+                        BEAST_EXPECT(
+                            some.size() ==
+                            std::min<std::size_t>(limit, expected.size()));
+                        BEAST_EXPECT(std::equal(
+                            some.begin(), some.end(), expected.begin()));
+                    }
+                }
+            }
+
+            // An exception thrown while preparing a leaf is passed on.
+            try
+            {
+                map.visitLeavesParallel(
+                    uint256(),
+                    5000,
+                    4,
+                    [&](SHAMapItem const& item) {
+                        if (item.key() == all[700])
+                            Throw<std::runtime_error>("prepare");
+                        return 0;
+                    },
+                    [](SHAMapItem const&, int) { return true; });
+                fail();
+            }
+            catch (std::runtime_error const& e)
+            {
+                BEAST_EXPECT(e.what() == std::string("prepare"));
+            }
+        }
     }
 };
 
@@ -346,7 +504,7 @@ class SHAMapPathProof_test : public beast::unit_test::suite
             uint256 k(c);
             map.addItem(
                 SHAMapNodeType::tnACCOUNT_STATE,
-                SHAMapItem{k, Slice{k.data(), k.size()}});
+                make_shamapitem(k, Slice{k.data(), k.size()}));
             map.invariants();
 
             auto root = map.getHash().as_uint256();
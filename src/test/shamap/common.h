@@ -25,6 +25,7 @@
 #include <ripple/nodestore/DummyScheduler.h>
 #include <ripple/nodestore/Manager.h>
 #include <ripple/shamap/Family.h>
+#include <thread>
 
 namespace ripple {
 namespace tests {
@@ -44,6 +45,21 @@ private:
 
 public:
     TestNodeFamily(beast::Journal j)
+        : TestNodeFamily(
+              j,
+              [] {
+                  Section testSection;
+                  testSection.set("type", "memory");
+                  testSection.set("path", "SHAMap_test");
+                  return testSection;
+              }(),
+              1)
+    {
+    }
+
+    // A family whose nodes are kept in the given node store, which reads
+    // asynchronously on readThreads threads.
+    TestNodeFamily(beast::Journal j, Section const& config, int readThreads)
         : fbCache_(std::make_shared<FullBelowCache>(
               "App family full below cache",
               clock_,
@@ -56,11 +72,8 @@ public:
               j))
         , j_(j)
     {
-        Section testSection;
-        testSection.set("type", "memory");
-        testSection.set("path", "SHAMap_test");
         db_ = NodeStore::Manager::instance().make_Database(
-            megabytes(4), scheduler_, 1, testSection, j);
+            megabytes(4), scheduler_, readThreads, config, j);
     }
 
     NodeStore::Database&
@@ -125,6 +138,13 @@ public:
         tnCache_->reset();
     }
 
+    bool
+    post(std::function<void()> work) override
+    {
+        std::thread(std::move(work)).detach();
+        return true;
+    }
+
     beast::manual_clock<std::chrono::steady_clock>
     clock()
     {